@@ -1592,8 +1592,9 @@ struct ICompileRequest : public ISlangUnknown
 
     virtual SLANG_NO_THROW void SLANG_MCALL setIgnoreCapabilityCheck(bool value) = 0;
 
-    // return a copy of internal profiling results, and if `shouldClear` is true, clear the internal
-    // profiling results before returning.
+    // return a copy of the profiling results recorded since this request was created, or since
+    // they were last cleared for it, and if `shouldClear` is true, clear them for this request
+    // before returning. Results recorded by other requests at the same time are included.
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL
     getCompileTimeProfile(ISlangProfiler** compileTimeProfile, bool shouldClear) = 0;
 
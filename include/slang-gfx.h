@@ -62,7 +62,9 @@ enum class StructType
     D3D12DeviceExtendedDesc,
     D3D12ExperimentalFeaturesDesc,
     SlangSessionExtendedDesc,
-    RayTracingValidationDesc
+    RayTracingValidationDesc,
+    CPUDeviceExtendedDesc,
+    PipelineSpecializationDesc
 };
 
 // TODO: Rename to Stage
@@ -2979,4 +2981,40 @@ struct RayTracingValidationDesc
     bool enableRaytracingValidation = false;
 };
 
+/// Options for the CPU device.
+struct CPUDeviceExtendedDesc
+{
+    StructType structType = StructType::CPUDeviceExtendedDesc;
+    /// The number of threads used to run the thread groups of a dispatch, where 0 means one
+    /// thread per hardware thread. With more than one thread, thread groups run concurrently,
+    /// so they must only communicate through atomics.
+    uint32_t workerThreadCount = 1;
+};
+
+/// Options for the specialization of pipelines to the types of the shader objects bound to them.
+struct PipelineSpecializationDesc
+{
+    StructType structType = StructType::PipelineSpecializationDesc;
+    /// Specialize pipelines on background threads instead of at the draw or dispatch that first
+    /// needs them. Until a specialized pipeline is ready, a program whose specialization
+    /// parameters are all interface types runs with a pipeline specialized to `__Dynamic`, and
+    /// any other program waits for its specialization to finish.
+    ///
+    /// The background threads use the Slang session of the device (`SlangDesc`), which the
+    /// device locks around each use. Once a specializable pipeline has been used, the
+    /// application must not call that `slang::ISession` directly, nor any component type created
+    /// from it, as those calls would not take the lock. It must either go through the device
+    /// (e.g. with `createProgram2`), or load its own modules with a separate session.
+    bool asynchronous = false;
+    /// The number of background threads, where 0 means one per hardware thread. The threads
+    /// take turns with the lock on the Slang session.
+    uint32_t workerThreadCount = 1;
+    /// Called on a background thread when the specialization of `pipeline` to the types of the
+    /// shader objects bound with it has completed, with the result of the specialization. Draws
+    /// and dispatches recorded after the call use the specialized pipeline. Can be null.
+    void (*onSpecializationCompleted)(void* userData, IPipelineState* pipeline, Result result) =
+        nullptr;
+    void* userData = nullptr;
+};
+
 } // namespace gfx
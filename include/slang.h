@@ -1044,6 +1044,24 @@ typedef uint32_t SlangSizeT;
         DenormalModeFp32,
         DenormalModeFp64,
 
+        // Persistent compilation cache
+        CompilationCacheDirectory,     // string, directory of the cache
+        CompilationCacheMaxEntryCount, // int, maximum number of cached entry points (0 = no limit)
+
+        CodeGenThreadCount, // int, number of threads used for code generation (0 = one per
+                            // hardware thread, 1 = serial)
+
+        ReportPerfTrace, // string, path to write a Chrome trace event JSON profile of compilation
+
+        ImportThreadCount, // int, number of threads used to preprocess imported modules in the
+                           // background (0 = one per hardware thread, 1 = serial)
+
+        MapBinaryModules, // bool, map precompiled modules found in the file system into memory
+                          // instead of reading them
+
+        ReuseIRMemory, // bool, reuse the memory of IR instructions removed while optimizing the
+                       // linked IR for the instructions created by later passes
+
         CountOf,
     };
 
@@ -1755,6 +1773,35 @@ public:                                                              \
     };
 #define SLANG_UUID_ISlangProfiler ISlangProfiler::getTypeGuid()
 
+    /* An extension of `ISlangProfiler`, introduced to avoid breaking backwards compatibility of
+    the `ISlangProfiler` interface. It can be queried from the profiler returned by
+    `getCompileTimeProfile`. */
+    struct ISlangProfiler2 : public ISlangProfiler
+    {
+        SLANG_COM_INTERFACE(
+            0x5d3a8c41,
+            0xe2b7,
+            0x4f06,
+            {0x9a, 0x1d, 0x37, 0xc4, 0x82, 0x6e, 0xb5, 0x0f})
+        /** Get the profile as JSON in the Chrome trace event format, which can be viewed with
+        `chrome://tracing` or Perfetto. It holds the functions, sections and passes entered on
+        each thread, nested as they ran, and the values of counters over time. Events are only
+        recorded while tracing is enabled, which is the case during `compile` of a request with
+        the `ReportPerfTrace` option set.
+        @param outTrace Receives a blob holding the JSON text
+        @returns SLANG_OK on success */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getTraceJSON(ISlangBlob** outTrace) = 0;
+
+        /** Get the number of counters in the profile. Counters count events of the compiler,
+        such as cache hits, and are reported separately from the timed entries. */
+        virtual SLANG_NO_THROW size_t SLANG_MCALL getCounterCount() = 0;
+        /** Get the name of the counter at `index`, or null if there is no such counter. */
+        virtual SLANG_NO_THROW const char* SLANG_MCALL getCounterName(uint32_t index) = 0;
+        /** Get the value of the counter at `index`, or 0 if there is no such counter. */
+        virtual SLANG_NO_THROW int64_t SLANG_MCALL getCounterValue(uint32_t index) = 0;
+    };
+#define SLANG_UUID_ISlangProfiler2 ISlangProfiler2::getTypeGuid()
+
     namespace slang
     {
     struct IGlobalSession;
@@ -2146,6 +2193,187 @@ public:                                                              \
 
     typedef SlangReflectionVariableLayout SlangReflectionParameter;
 
+    // Binary Reflection
+    //
+    // The layout reflection of a program can be written out as a compact binary blob
+    // with `spReflection_ToBinary`, and stored alongside the compiled kernels.
+    // `spBinaryReflection_Load` gives access to that data in place (for example
+    // when it is mapped into memory from a file), without a session and without
+    // deserializing anything. The handles it returns point into the data, and are
+    // valid for as long as the data is.
+    //
+    // The accessors mirror the corresponding `spReflection*` functions.
+
+    typedef struct SlangBinaryReflection SlangBinaryReflection;
+    typedef struct SlangBinaryReflectionTypeLayout SlangBinaryReflectionTypeLayout;
+    typedef struct SlangBinaryReflectionVariableLayout SlangBinaryReflectionVariableLayout;
+    typedef struct SlangBinaryReflectionEntryPoint SlangBinaryReflectionEntryPoint;
+
+    SLANG_API SlangResult spReflection_ToBinary(SlangReflection* reflection, ISlangBlob** outBlob);
+
+    /// Get the binary reflection stored in `data`, or null if it isn't valid binary reflection.
+    SLANG_API SlangBinaryReflection* spBinaryReflection_Load(void const* data, size_t size);
+
+    SLANG_API unsigned spBinaryReflection_GetParameterCount(SlangBinaryReflection* reflection);
+    SLANG_API SlangBinaryReflectionVariableLayout* spBinaryReflection_GetParameterByIndex(
+        SlangBinaryReflection* reflection,
+        unsigned index);
+    SLANG_API SlangUInt spBinaryReflection_getEntryPointCount(SlangBinaryReflection* reflection);
+    SLANG_API SlangBinaryReflectionEntryPoint* spBinaryReflection_getEntryPointByIndex(
+        SlangBinaryReflection* reflection,
+        SlangUInt index);
+    SLANG_API SlangBinaryReflectionEntryPoint* spBinaryReflection_findEntryPointByName(
+        SlangBinaryReflection* reflection,
+        char const* name);
+    SLANG_API SlangUInt
+    spBinaryReflection_getGlobalConstantBufferBinding(SlangBinaryReflection* reflection);
+    SLANG_API size_t
+    spBinaryReflection_getGlobalConstantBufferSize(SlangBinaryReflection* reflection);
+    SLANG_API SlangBinaryReflectionVariableLayout* spBinaryReflection_getGlobalParamsVarLayout(
+        SlangBinaryReflection* reflection);
+
+    SLANG_API SlangTypeKind spBinaryReflectionTypeLayout_getKind(
+        SlangBinaryReflectionTypeLayout* typeLayout);
+    SLANG_API char const* spBinaryReflectionTypeLayout_GetName(
+        SlangBinaryReflectionTypeLayout* typeLayout);
+    SLANG_API size_t spBinaryReflectionTypeLayout_GetSize(
+        SlangBinaryReflectionTypeLayout* typeLayout,
+        SlangParameterCategory category);
+    SLANG_API size_t spBinaryReflectionTypeLayout_GetStride(
+        SlangBinaryReflectionTypeLayout* typeLayout,
+        SlangParameterCategory category);
+    SLANG_API int32_t spBinaryReflectionTypeLayout_getAlignment(
+        SlangBinaryReflectionTypeLayout* typeLayout,
+        SlangParameterCategory category);
+    SLANG_API SlangParameterCategory spBinaryReflectionTypeLayout_GetParameterCategory(
+        SlangBinaryReflectionTypeLayout* typeLayout);
+    SLANG_API unsigned spBinaryReflectionTypeLayout_GetCategoryCount(
+        SlangBinaryReflectionTypeLayout* typeLayout);
+    SLANG_API SlangParameterCategory spBinaryReflectionTypeLayout_GetCategoryByIndex(
+        SlangBinaryReflectionTypeLayout* typeLayout,
+        unsigned index);
+    SLANG_API unsigned spBinaryReflectionTypeLayout_GetFieldCount(
+        SlangBinaryReflectionTypeLayout* typeLayout);
+    SLANG_API SlangBinaryReflectionVariableLayout* spBinaryReflectionTypeLayout_GetFieldByIndex(
+        SlangBinaryReflectionTypeLayout* typeLayout,
+        unsigned index);
+    SLANG_API SlangInt spBinaryReflectionTypeLayout_findFieldIndexByName(
+        SlangBinaryReflectionTypeLayout* typeLayout,
+        char const* nameBegin,
+        char const* nameEnd);
+    SLANG_API size_t spBinaryReflectionTypeLayout_GetElementCount(
+        SlangBinaryReflectionTypeLayout* typeLayout);
+    SLANG_API SlangBinaryReflectionTypeLayout* spBinaryReflectionTypeLayout_GetElementTypeLayout(
+        SlangBinaryReflectionTypeLayout* typeLayout);
+    SLANG_API SlangBinaryReflectionVariableLayout*
+    spBinaryReflectionTypeLayout_GetElementVarLayout(SlangBinaryReflectionTypeLayout* typeLayout);
+    SLANG_API SlangBinaryReflectionVariableLayout*
+    spBinaryReflectionTypeLayout_getContainerVarLayout(SlangBinaryReflectionTypeLayout* typeLayout);
+    SLANG_API SlangScalarType spBinaryReflectionTypeLayout_GetScalarType(
+        SlangBinaryReflectionTypeLayout* typeLayout);
+    SLANG_API unsigned spBinaryReflectionTypeLayout_GetRowCount(
+        SlangBinaryReflectionTypeLayout* typeLayout);
+    SLANG_API unsigned spBinaryReflectionTypeLayout_GetColumnCount(
+        SlangBinaryReflectionTypeLayout* typeLayout);
+    SLANG_API SlangResourceShape spBinaryReflectionTypeLayout_GetResourceShape(
+        SlangBinaryReflectionTypeLayout* typeLayout);
+    SLANG_API SlangResourceAccess spBinaryReflectionTypeLayout_GetResourceAccess(
+        SlangBinaryReflectionTypeLayout* typeLayout);
+    SLANG_API SlangInt spBinaryReflectionTypeLayout_getBindingRangeCount(
+        SlangBinaryReflectionTypeLayout* typeLayout);
+    SLANG_API SlangBindingType spBinaryReflectionTypeLayout_getBindingRangeType(
+        SlangBinaryReflectionTypeLayout* typeLayout,
+        SlangInt index);
+    SLANG_API SlangInt spBinaryReflectionTypeLayout_getBindingRangeBindingCount(
+        SlangBinaryReflectionTypeLayout* typeLayout,
+        SlangInt index);
+    SLANG_API SlangBinaryReflectionTypeLayout*
+    spBinaryReflectionTypeLayout_getBindingRangeLeafTypeLayout(
+        SlangBinaryReflectionTypeLayout* typeLayout,
+        SlangInt index);
+    SLANG_API SlangInt spBinaryReflectionTypeLayout_getBindingRangeDescriptorSetIndex(
+        SlangBinaryReflectionTypeLayout* typeLayout,
+        SlangInt index);
+    SLANG_API SlangInt spBinaryReflectionTypeLayout_getBindingRangeFirstDescriptorRangeIndex(
+        SlangBinaryReflectionTypeLayout* typeLayout,
+        SlangInt index);
+    SLANG_API SlangInt spBinaryReflectionTypeLayout_getBindingRangeDescriptorRangeCount(
+        SlangBinaryReflectionTypeLayout* typeLayout,
+        SlangInt index);
+    SLANG_API SlangInt spBinaryReflectionTypeLayout_getFieldBindingRangeOffset(
+        SlangBinaryReflectionTypeLayout* typeLayout,
+        SlangInt fieldIndex);
+    SLANG_API SlangInt spBinaryReflectionTypeLayout_getDescriptorSetCount(
+        SlangBinaryReflectionTypeLayout* typeLayout);
+    SLANG_API SlangInt spBinaryReflectionTypeLayout_getDescriptorSetSpaceOffset(
+        SlangBinaryReflectionTypeLayout* typeLayout,
+        SlangInt setIndex);
+    SLANG_API SlangInt spBinaryReflectionTypeLayout_getDescriptorSetDescriptorRangeCount(
+        SlangBinaryReflectionTypeLayout* typeLayout,
+        SlangInt setIndex);
+    SLANG_API SlangInt spBinaryReflectionTypeLayout_getDescriptorSetDescriptorRangeIndexOffset(
+        SlangBinaryReflectionTypeLayout* typeLayout,
+        SlangInt setIndex,
+        SlangInt rangeIndex);
+    SLANG_API SlangInt spBinaryReflectionTypeLayout_getDescriptorSetDescriptorRangeDescriptorCount(
+        SlangBinaryReflectionTypeLayout* typeLayout,
+        SlangInt setIndex,
+        SlangInt rangeIndex);
+    SLANG_API SlangBindingType spBinaryReflectionTypeLayout_getDescriptorSetDescriptorRangeType(
+        SlangBinaryReflectionTypeLayout* typeLayout,
+        SlangInt setIndex,
+        SlangInt rangeIndex);
+    SLANG_API SlangParameterCategory
+    spBinaryReflectionTypeLayout_getDescriptorSetDescriptorRangeCategory(
+        SlangBinaryReflectionTypeLayout* typeLayout,
+        SlangInt setIndex,
+        SlangInt rangeIndex);
+    SLANG_API SlangInt spBinaryReflectionTypeLayout_getSubObjectRangeCount(
+        SlangBinaryReflectionTypeLayout* typeLayout);
+    SLANG_API SlangInt spBinaryReflectionTypeLayout_getSubObjectRangeBindingRangeIndex(
+        SlangBinaryReflectionTypeLayout* typeLayout,
+        SlangInt subObjectRangeIndex);
+    SLANG_API SlangInt spBinaryReflectionTypeLayout_getSubObjectRangeSpaceOffset(
+        SlangBinaryReflectionTypeLayout* typeLayout,
+        SlangInt subObjectRangeIndex);
+
+    SLANG_API char const* spBinaryReflectionVariableLayout_GetName(
+        SlangBinaryReflectionVariableLayout* varLayout);
+    SLANG_API SlangBinaryReflectionTypeLayout* spBinaryReflectionVariableLayout_GetTypeLayout(
+        SlangBinaryReflectionVariableLayout* varLayout);
+    SLANG_API size_t spBinaryReflectionVariableLayout_GetOffset(
+        SlangBinaryReflectionVariableLayout* varLayout,
+        SlangParameterCategory category);
+    SLANG_API size_t spBinaryReflectionVariableLayout_GetSpace(
+        SlangBinaryReflectionVariableLayout* varLayout,
+        SlangParameterCategory category);
+    SLANG_API char const* spBinaryReflectionVariableLayout_GetSemanticName(
+        SlangBinaryReflectionVariableLayout* varLayout);
+    SLANG_API size_t spBinaryReflectionVariableLayout_GetSemanticIndex(
+        SlangBinaryReflectionVariableLayout* varLayout);
+    SLANG_API SlangStage spBinaryReflectionVariableLayout_getStage(
+        SlangBinaryReflectionVariableLayout* varLayout);
+
+    SLANG_API char const* spBinaryReflectionEntryPoint_getName(
+        SlangBinaryReflectionEntryPoint* entryPoint);
+    SLANG_API char const* spBinaryReflectionEntryPoint_getNameOverride(
+        SlangBinaryReflectionEntryPoint* entryPoint);
+    SLANG_API SlangStage spBinaryReflectionEntryPoint_getStage(
+        SlangBinaryReflectionEntryPoint* entryPoint);
+    SLANG_API unsigned spBinaryReflectionEntryPoint_getParameterCount(
+        SlangBinaryReflectionEntryPoint* entryPoint);
+    SLANG_API SlangBinaryReflectionVariableLayout* spBinaryReflectionEntryPoint_getParameterByIndex(
+        SlangBinaryReflectionEntryPoint* entryPoint,
+        unsigned index);
+    SLANG_API SlangBinaryReflectionVariableLayout* spBinaryReflectionEntryPoint_getVarLayout(
+        SlangBinaryReflectionEntryPoint* entryPoint);
+    SLANG_API SlangBinaryReflectionVariableLayout* spBinaryReflectionEntryPoint_getResultVarLayout(
+        SlangBinaryReflectionEntryPoint* entryPoint);
+    SLANG_API void spBinaryReflectionEntryPoint_getComputeThreadGroupSize(
+        SlangBinaryReflectionEntryPoint* entryPoint,
+        SlangUInt axisCount,
+        SlangUInt* outSizeAlongAxis);
+
 #ifdef __cplusplus
 }
 #endif
@@ -3428,8 +3656,471 @@ struct ShaderReflection
     {
         return spReflection_ToJson((SlangReflection*)this, nullptr, outBlob);
     }
+
+    /// Write the layout reflection as a blob that can be read with `BinaryProgramLayout::load`.
+    SlangResult toBinary(ISlangBlob** outBlob)
+    {
+        return spReflection_ToBinary((SlangReflection*)this, outBlob);
+    }
+};
+
+struct BinaryTypeLayoutReflection;
+struct BinaryVariableLayoutReflection;
+
+/// Read-only view of the layout reflection of a variable, in data written by
+/// `ProgramLayout::toBinary`.
+struct BinaryVariableLayoutReflection
+{
+    char const* getName()
+    {
+        return spBinaryReflectionVariableLayout_GetName((SlangBinaryReflectionVariableLayout*)this);
+    }
+
+    BinaryTypeLayoutReflection* getTypeLayout()
+    {
+        return (BinaryTypeLayoutReflection*)spBinaryReflectionVariableLayout_GetTypeLayout(
+            (SlangBinaryReflectionVariableLayout*)this);
+    }
+
+    size_t getOffset(SlangParameterCategory category)
+    {
+        return spBinaryReflectionVariableLayout_GetOffset(
+            (SlangBinaryReflectionVariableLayout*)this,
+            category);
+    }
+
+    size_t getOffset(slang::ParameterCategory category = slang::ParameterCategory::Uniform)
+    {
+        return getOffset(SlangParameterCategory(category));
+    }
+
+    size_t getBindingSpace(SlangParameterCategory category)
+    {
+        return spBinaryReflectionVariableLayout_GetSpace(
+            (SlangBinaryReflectionVariableLayout*)this,
+            category);
+    }
+
+    size_t getBindingSpace(slang::ParameterCategory category)
+    {
+        return getBindingSpace(SlangParameterCategory(category));
+    }
+
+    char const* getSemanticName()
+    {
+        return spBinaryReflectionVariableLayout_GetSemanticName(
+            (SlangBinaryReflectionVariableLayout*)this);
+    }
+
+    size_t getSemanticIndex()
+    {
+        return spBinaryReflectionVariableLayout_GetSemanticIndex(
+            (SlangBinaryReflectionVariableLayout*)this);
+    }
+
+    SlangStage getStage()
+    {
+        return spBinaryReflectionVariableLayout_getStage(
+            (SlangBinaryReflectionVariableLayout*)this);
+    }
 };
 
+/// Read-only view of the layout reflection of a type, in data written by
+/// `ProgramLayout::toBinary`.
+struct BinaryTypeLayoutReflection
+{
+    TypeReflection::Kind getKind()
+    {
+        return (TypeReflection::Kind)spBinaryReflectionTypeLayout_getKind(
+            (SlangBinaryReflectionTypeLayout*)this);
+    }
+
+    char const* getName()
+    {
+        return spBinaryReflectionTypeLayout_GetName((SlangBinaryReflectionTypeLayout*)this);
+    }
+
+    size_t getSize(SlangParameterCategory category)
+    {
+        return spBinaryReflectionTypeLayout_GetSize(
+            (SlangBinaryReflectionTypeLayout*)this,
+            category);
+    }
+
+    size_t getStride(SlangParameterCategory category)
+    {
+        return spBinaryReflectionTypeLayout_GetStride(
+            (SlangBinaryReflectionTypeLayout*)this,
+            category);
+    }
+
+    int32_t getAlignment(SlangParameterCategory category)
+    {
+        return spBinaryReflectionTypeLayout_getAlignment(
+            (SlangBinaryReflectionTypeLayout*)this,
+            category);
+    }
+
+    size_t getSize(slang::ParameterCategory category = slang::ParameterCategory::Uniform)
+    {
+        return getSize(SlangParameterCategory(category));
+    }
+
+    size_t getStride(slang::ParameterCategory category = slang::ParameterCategory::Uniform)
+    {
+        return getStride(SlangParameterCategory(category));
+    }
+
+    int32_t getAlignment(slang::ParameterCategory category = slang::ParameterCategory::Uniform)
+    {
+        return getAlignment(SlangParameterCategory(category));
+    }
+
+    ParameterCategory getParameterCategory()
+    {
+        return (ParameterCategory)spBinaryReflectionTypeLayout_GetParameterCategory(
+            (SlangBinaryReflectionTypeLayout*)this);
+    }
+
+    unsigned int getCategoryCount()
+    {
+        return spBinaryReflectionTypeLayout_GetCategoryCount(
+            (SlangBinaryReflectionTypeLayout*)this);
+    }
+
+    ParameterCategory getCategoryByIndex(unsigned int index)
+    {
+        return (ParameterCategory)spBinaryReflectionTypeLayout_GetCategoryByIndex(
+            (SlangBinaryReflectionTypeLayout*)this,
+            index);
+    }
+
+    unsigned int getFieldCount()
+    {
+        return spBinaryReflectionTypeLayout_GetFieldCount((SlangBinaryReflectionTypeLayout*)this);
+    }
+
+    BinaryVariableLayoutReflection* getFieldByIndex(unsigned int index)
+    {
+        return (BinaryVariableLayoutReflection*)spBinaryReflectionTypeLayout_GetFieldByIndex(
+            (SlangBinaryReflectionTypeLayout*)this,
+            index);
+    }
+
+    SlangInt findFieldIndexByName(char const* nameBegin, char const* nameEnd = nullptr)
+    {
+        return spBinaryReflectionTypeLayout_findFieldIndexByName(
+            (SlangBinaryReflectionTypeLayout*)this,
+            nameBegin,
+            nameEnd);
+    }
+
+    size_t getElementCount()
+    {
+        return spBinaryReflectionTypeLayout_GetElementCount((SlangBinaryReflectionTypeLayout*)this);
+    }
+
+    BinaryTypeLayoutReflection* getElementTypeLayout()
+    {
+        return (BinaryTypeLayoutReflection*)spBinaryReflectionTypeLayout_GetElementTypeLayout(
+            (SlangBinaryReflectionTypeLayout*)this);
+    }
+
+    BinaryVariableLayoutReflection* getElementVarLayout()
+    {
+        return (BinaryVariableLayoutReflection*)spBinaryReflectionTypeLayout_GetElementVarLayout(
+            (SlangBinaryReflectionTypeLayout*)this);
+    }
+
+    BinaryVariableLayoutReflection* getContainerVarLayout()
+    {
+        return (BinaryVariableLayoutReflection*)spBinaryReflectionTypeLayout_getContainerVarLayout(
+            (SlangBinaryReflectionTypeLayout*)this);
+    }
+
+    TypeReflection::ScalarType getScalarType()
+    {
+        return (TypeReflection::ScalarType)spBinaryReflectionTypeLayout_GetScalarType(
+            (SlangBinaryReflectionTypeLayout*)this);
+    }
+
+    unsigned getRowCount()
+    {
+        return spBinaryReflectionTypeLayout_GetRowCount((SlangBinaryReflectionTypeLayout*)this);
+    }
+
+    unsigned getColumnCount()
+    {
+        return spBinaryReflectionTypeLayout_GetColumnCount((SlangBinaryReflectionTypeLayout*)this);
+    }
+
+    SlangResourceShape getResourceShape()
+    {
+        return spBinaryReflectionTypeLayout_GetResourceShape(
+            (SlangBinaryReflectionTypeLayout*)this);
+    }
+
+    SlangResourceAccess getResourceAccess()
+    {
+        return spBinaryReflectionTypeLayout_GetResourceAccess(
+            (SlangBinaryReflectionTypeLayout*)this);
+    }
+
+    SlangInt getBindingRangeCount()
+    {
+        return spBinaryReflectionTypeLayout_getBindingRangeCount(
+            (SlangBinaryReflectionTypeLayout*)this);
+    }
+
+    BindingType getBindingRangeType(SlangInt index)
+    {
+        return (BindingType)spBinaryReflectionTypeLayout_getBindingRangeType(
+            (SlangBinaryReflectionTypeLayout*)this,
+            index);
+    }
+
+    SlangInt getBindingRangeBindingCount(SlangInt index)
+    {
+        return spBinaryReflectionTypeLayout_getBindingRangeBindingCount(
+            (SlangBinaryReflectionTypeLayout*)this,
+            index);
+    }
+
+    BinaryTypeLayoutReflection* getBindingRangeLeafTypeLayout(SlangInt index)
+    {
+        return (BinaryTypeLayoutReflection*)
+            spBinaryReflectionTypeLayout_getBindingRangeLeafTypeLayout(
+                (SlangBinaryReflectionTypeLayout*)this,
+                index);
+    }
+
+    SlangInt getBindingRangeDescriptorSetIndex(SlangInt index)
+    {
+        return spBinaryReflectionTypeLayout_getBindingRangeDescriptorSetIndex(
+            (SlangBinaryReflectionTypeLayout*)this,
+            index);
+    }
+
+    SlangInt getBindingRangeFirstDescriptorRangeIndex(SlangInt index)
+    {
+        return spBinaryReflectionTypeLayout_getBindingRangeFirstDescriptorRangeIndex(
+            (SlangBinaryReflectionTypeLayout*)this,
+            index);
+    }
+
+    SlangInt getBindingRangeDescriptorRangeCount(SlangInt index)
+    {
+        return spBinaryReflectionTypeLayout_getBindingRangeDescriptorRangeCount(
+            (SlangBinaryReflectionTypeLayout*)this,
+            index);
+    }
+
+    SlangInt getFieldBindingRangeOffset(SlangInt fieldIndex)
+    {
+        return spBinaryReflectionTypeLayout_getFieldBindingRangeOffset(
+            (SlangBinaryReflectionTypeLayout*)this,
+            fieldIndex);
+    }
+
+    SlangInt getDescriptorSetCount()
+    {
+        return spBinaryReflectionTypeLayout_getDescriptorSetCount(
+            (SlangBinaryReflectionTypeLayout*)this);
+    }
+
+    SlangInt getDescriptorSetSpaceOffset(SlangInt setIndex)
+    {
+        return spBinaryReflectionTypeLayout_getDescriptorSetSpaceOffset(
+            (SlangBinaryReflectionTypeLayout*)this,
+            setIndex);
+    }
+
+    SlangInt getDescriptorSetDescriptorRangeCount(SlangInt setIndex)
+    {
+        return spBinaryReflectionTypeLayout_getDescriptorSetDescriptorRangeCount(
+            (SlangBinaryReflectionTypeLayout*)this,
+            setIndex);
+    }
+
+    SlangInt getDescriptorSetDescriptorRangeIndexOffset(SlangInt setIndex, SlangInt rangeIndex)
+    {
+        return spBinaryReflectionTypeLayout_getDescriptorSetDescriptorRangeIndexOffset(
+            (SlangBinaryReflectionTypeLayout*)this,
+            setIndex,
+            rangeIndex);
+    }
+
+    SlangInt getDescriptorSetDescriptorRangeDescriptorCount(SlangInt setIndex, SlangInt rangeIndex)
+    {
+        return spBinaryReflectionTypeLayout_getDescriptorSetDescriptorRangeDescriptorCount(
+            (SlangBinaryReflectionTypeLayout*)this,
+            setIndex,
+            rangeIndex);
+    }
+
+    BindingType getDescriptorSetDescriptorRangeType(SlangInt setIndex, SlangInt rangeIndex)
+    {
+        return (BindingType)spBinaryReflectionTypeLayout_getDescriptorSetDescriptorRangeType(
+            (SlangBinaryReflectionTypeLayout*)this,
+            setIndex,
+            rangeIndex);
+    }
+
+    ParameterCategory getDescriptorSetDescriptorRangeCategory(
+        SlangInt setIndex,
+        SlangInt rangeIndex)
+    {
+        return (ParameterCategory)
+            spBinaryReflectionTypeLayout_getDescriptorSetDescriptorRangeCategory(
+                (SlangBinaryReflectionTypeLayout*)this,
+                setIndex,
+                rangeIndex);
+    }
+
+    SlangInt getSubObjectRangeCount()
+    {
+        return spBinaryReflectionTypeLayout_getSubObjectRangeCount(
+            (SlangBinaryReflectionTypeLayout*)this);
+    }
+
+    SlangInt getSubObjectRangeBindingRangeIndex(SlangInt subObjectRangeIndex)
+    {
+        return spBinaryReflectionTypeLayout_getSubObjectRangeBindingRangeIndex(
+            (SlangBinaryReflectionTypeLayout*)this,
+            subObjectRangeIndex);
+    }
+
+    SlangInt getSubObjectRangeSpaceOffset(SlangInt subObjectRangeIndex)
+    {
+        return spBinaryReflectionTypeLayout_getSubObjectRangeSpaceOffset(
+            (SlangBinaryReflectionTypeLayout*)this,
+            subObjectRangeIndex);
+    }
+};
+
+/// Read-only view of the reflection of an entry point, in data written by
+/// `ProgramLayout::toBinary`.
+struct BinaryEntryPointReflection
+{
+    char const* getName()
+    {
+        return spBinaryReflectionEntryPoint_getName((SlangBinaryReflectionEntryPoint*)this);
+    }
+
+    char const* getNameOverride()
+    {
+        return spBinaryReflectionEntryPoint_getNameOverride(
+            (SlangBinaryReflectionEntryPoint*)this);
+    }
+
+    SlangStage getStage()
+    {
+        return spBinaryReflectionEntryPoint_getStage((SlangBinaryReflectionEntryPoint*)this);
+    }
+
+    unsigned getParameterCount()
+    {
+        return spBinaryReflectionEntryPoint_getParameterCount(
+            (SlangBinaryReflectionEntryPoint*)this);
+    }
+
+    BinaryVariableLayoutReflection* getParameterByIndex(unsigned index)
+    {
+        return (BinaryVariableLayoutReflection*)spBinaryReflectionEntryPoint_getParameterByIndex(
+            (SlangBinaryReflectionEntryPoint*)this,
+            index);
+    }
+
+    BinaryVariableLayoutReflection* getVarLayout()
+    {
+        return (BinaryVariableLayoutReflection*)spBinaryReflectionEntryPoint_getVarLayout(
+            (SlangBinaryReflectionEntryPoint*)this);
+    }
+
+    BinaryTypeLayoutReflection* getTypeLayout() { return getVarLayout()->getTypeLayout(); }
+
+    BinaryVariableLayoutReflection* getResultVarLayout()
+    {
+        return (BinaryVariableLayoutReflection*)spBinaryReflectionEntryPoint_getResultVarLayout(
+            (SlangBinaryReflectionEntryPoint*)this);
+    }
+
+    void getComputeThreadGroupSize(SlangUInt axisCount, SlangUInt* outSizeAlongAxis)
+    {
+        return spBinaryReflectionEntryPoint_getComputeThreadGroupSize(
+            (SlangBinaryReflectionEntryPoint*)this,
+            axisCount,
+            outSizeAlongAxis);
+    }
+};
+
+/// Read-only view of the layout reflection of a program, in data written by
+/// `ProgramLayout::toBinary`.
+///
+/// The view points directly into the data, which has to outlive it.
+struct BinaryShaderReflection
+{
+    static BinaryShaderReflection* load(void const* data, size_t size)
+    {
+        return (BinaryShaderReflection*)spBinaryReflection_Load(data, size);
+    }
+
+    unsigned getParameterCount()
+    {
+        return spBinaryReflection_GetParameterCount((SlangBinaryReflection*)this);
+    }
+
+    BinaryVariableLayoutReflection* getParameterByIndex(unsigned index)
+    {
+        return (BinaryVariableLayoutReflection*)spBinaryReflection_GetParameterByIndex(
+            (SlangBinaryReflection*)this,
+            index);
+    }
+
+    SlangUInt getEntryPointCount()
+    {
+        return spBinaryReflection_getEntryPointCount((SlangBinaryReflection*)this);
+    }
+
+    BinaryEntryPointReflection* getEntryPointByIndex(SlangUInt index)
+    {
+        return (BinaryEntryPointReflection*)spBinaryReflection_getEntryPointByIndex(
+            (SlangBinaryReflection*)this,
+            index);
+    }
+
+    BinaryEntryPointReflection* findEntryPointByName(const char* name)
+    {
+        return (BinaryEntryPointReflection*)spBinaryReflection_findEntryPointByName(
+            (SlangBinaryReflection*)this,
+            name);
+    }
+
+    SlangUInt getGlobalConstantBufferBinding()
+    {
+        return spBinaryReflection_getGlobalConstantBufferBinding((SlangBinaryReflection*)this);
+    }
+
+    size_t getGlobalConstantBufferSize()
+    {
+        return spBinaryReflection_getGlobalConstantBufferSize((SlangBinaryReflection*)this);
+    }
+
+    BinaryVariableLayoutReflection* getGlobalParamsVarLayout()
+    {
+        return (BinaryVariableLayoutReflection*)spBinaryReflection_getGlobalParamsVarLayout(
+            (SlangBinaryReflection*)this);
+    }
+
+    BinaryTypeLayoutReflection* getGlobalParamsTypeLayout()
+    {
+        auto varLayout = getGlobalParamsVarLayout();
+        return varLayout ? varLayout->getTypeLayout() : nullptr;
+    }
+};
+
+typedef BinaryShaderReflection BinaryProgramLayout;
+
 
 struct DeclReflection
 {
@@ -4766,6 +5457,42 @@ struct ByteCodeRunnerDesc
     /** The size of this structure, in bytes.
      */
     size_t structSize = sizeof(ByteCodeRunnerDesc);
+
+    /** Whether common sequences of instructions are fused into single handlers
+        ("superinstructions") when a module is loaded. This only affects performance.
+     */
+    bool enableSuperInstructions = true;
+};
+
+/// Describes a batch of invocations of the selected byte code function.
+struct ByteCodeBatchDesc
+{
+    /** The size of this structure, in bytes.
+     */
+    size_t structSize = sizeof(ByteCodeBatchDesc);
+
+    /** The number of invocations to run.
+     */
+    uint32_t invocationCount = 0;
+
+    /** The arguments of the invocations. The arguments of invocation `i` are the
+        `argumentSize` bytes at `argumentData + i * argumentStride`.
+     */
+    const void* argumentData = nullptr;
+    size_t argumentSize = 0;
+    size_t argumentStride = 0;
+
+    /** An optional buffer that receives the return values of the invocations. The return
+        value of invocation `i` is written to `returnValueData + i * returnValueStride`.
+     */
+    void* returnValueData = nullptr;
+    size_t returnValueStride = 0;
+
+    /** The maximum number of threads to split the batch across, where 0 means one thread
+        per hardware thread. With more than one thread, invocations run concurrently, so
+        registered external functions and the print callback must be thread safe.
+     */
+    uint32_t threadCount = 1;
 };
 
 /// Represents a byte code runner that can execute Slang byte code.
@@ -4812,6 +5539,28 @@ public:
     setPrintCallback(VMPrintFunc callback, void* userData) = 0;
 };
 
+/// A byte code runner that can execute a batch of invocations of a function in one call.
+/// Obtained by querying an `IByteCodeRunner` for this interface.
+class IByteCodeBatchRunner : public IByteCodeRunner
+{
+public:
+    // {39199291-FA0D-4FB8-8A43-DBC5EFC05B03}
+    SLANG_COM_INTERFACE(
+        0x39199291,
+        0xfa0d,
+        0x4fb8,
+        {0x8a, 0x43, 0xdb, 0xc5, 0xef, 0xc0, 0x5b, 0x03})
+
+    /// Execute the selected function once for each invocation of a batch.
+    ///
+    /// This is equivalent to calling `execute` once for each invocation, except that the
+    /// invocations can be split across multiple threads. Each thread runs its invocations
+    /// one after another with the scalar interpreter, so an invocation costs as much as a
+    /// call to `execute`; invocations are not executed in lock step across SIMD lanes.
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+    executeBatch(const ByteCodeBatchDesc* desc) = 0;
+};
+
 } // namespace slang
 
 /// Create a byte code runner that can execute Slang byte code.
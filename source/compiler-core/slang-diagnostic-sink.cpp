@@ -528,6 +528,16 @@ void DiagnosticSink::init(SourceManager* sourceManager, SourceLocationLexer sour
     }
 }
 
+void DiagnosticSink::initFrom(const DiagnosticSink& other)
+{
+    init(other.m_sourceManager, other.m_sourceLocationLexer);
+
+    m_flags = other.m_flags;
+    m_sourceLineMaxLength = other.m_sourceLineMaxLength;
+    m_severityOverrides = other.m_severityOverrides;
+    m_sourceWarningStateTracker = other.m_sourceWarningStateTracker;
+}
+
 void DiagnosticSink::reset()
 {
     m_errorCount = 0;
@@ -620,6 +630,7 @@ Severity DiagnosticSink::getEffectiveMessageSeverity(
 
     if (effectiveSeverity <= Severity::Warning && m_sourceWarningStateTracker)
     {
+        std::lock_guard<std::mutex> lock(m_sourceWarningStateTracker->mutex);
         effectiveSeverity = m_sourceWarningStateTracker->consumeWarningSeverity(
             location,
             info.id,
@@ -8,6 +8,8 @@
 #include "slang-token.h"
 #include "slang.h"
 
+#include <mutex>
+
 namespace Slang
 {
 
@@ -84,6 +86,10 @@ public:
 struct SourceWarningStateTrackerBase : public RefObject
 {
     virtual Severity consumeWarningSeverity(SourceLoc loc, int id, Severity severity) = 0;
+
+    /// Held while consuming a warning state, since a tracker can be shared by sinks
+    /// used on different threads (see `DiagnosticSink::initFrom`).
+    std::mutex mutex;
 };
 
 class Name;
@@ -270,6 +276,10 @@ public:
     /// Initialize state.
     void init(SourceManager* sourceManager, SourceLocationLexer sourceLocationLexer);
 
+    /// Initialize state to format and filter diagnostics in the same way as `other`.
+    /// Output, error counts and the parent sink are not copied.
+    void initFrom(const DiagnosticSink& other);
+
     /// Ctor
     DiagnosticSink(SourceManager* sourceManager, SourceLocationLexer sourceLocationLexer)
     {
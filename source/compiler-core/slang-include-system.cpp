@@ -8,9 +8,33 @@
 #include "slang-artifact-representation-impl.h"
 #include "slang-slice-allocator.h"
 
+#include <chrono>
+
 namespace Slang
 {
 
+// Modification times are only accurate to the second on some file systems, and to two seconds
+// on FAT file systems.
+static const uint64_t kModificationTimeResolution = 2000000000;
+
+/* static */ SourceFile::FileStat IncludeSystem::getOSFileStat(const String& osPath)
+{
+    SourceFile::FileStat fileStat;
+    uint64_t modificationTime = 0;
+    if (SLANG_FAILED(File::getSizeAndModificationTime(osPath, fileStat.size, modificationTime)))
+        return fileStat;
+
+    // If the file was modified within the resolution of modification times before it is read,
+    // it could be modified again without its modification time changing, so the modification
+    // time can't be used to tell that the file is unchanged.
+    const uint64_t now = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                      std::chrono::system_clock::now().time_since_epoch())
+                                      .count());
+    if (modificationTime + kModificationTimeResolution <= now)
+        fileStat.modificationTime = modificationTime;
+    return fileStat;
+}
+
 IncludeSystem::IncludeSystem(
     SearchDirectoryList* searchDirectories,
     ISlangFileSystemExt* fileSystemExt,
@@ -150,15 +174,18 @@ SlangResult IncludeSystem::loadFile(
         if (!outSourceFile)
         {
             ComPtr<ISlangBlob> foundSourceBlob;
-            if (SLANG_FAILED(m_fileSystemExt->loadFile(
-                    pathInfo.foundPath.getBuffer(),
-                    foundSourceBlob.writeRef())))
+            SourceFile::FileStat fileStat;
+            if (SLANG_FAILED(_loadFileContents(pathInfo.foundPath, foundSourceBlob, fileStat)))
             {
                 return SLANG_E_CANNOT_OPEN;
             }
 
+            // If the file was loaded by another thread meanwhile, use the one that was
+            // registered first.
             outSourceFile = m_sourceManager->createSourceFileWithBlob(pathInfo, foundSourceBlob);
-            m_sourceManager->addSourceFile(pathInfo.uniqueIdentity, outSourceFile);
+            outSourceFile->setFileStat(fileStat);
+            outSourceFile =
+                m_sourceManager->addSourceFileIfNotExist(pathInfo.uniqueIdentity, outSourceFile);
 
             outBlob = foundSourceBlob;
             return SLANG_OK;
@@ -172,14 +199,14 @@ SlangResult IncludeSystem::loadFile(
             }
 
             ComPtr<ISlangBlob> foundSourceBlob;
-            if (SLANG_FAILED(m_fileSystemExt->loadFile(
-                    pathInfo.foundPath.getBuffer(),
-                    foundSourceBlob.writeRef())))
+            SourceFile::FileStat fileStat;
+            if (SLANG_FAILED(_loadFileContents(pathInfo.foundPath, foundSourceBlob, fileStat)))
             {
                 return SLANG_E_CANNOT_OPEN;
             }
 
             outSourceFile->setContents(foundSourceBlob);
+            outSourceFile->setFileStat(fileStat);
 
             outBlob = foundSourceBlob;
             return SLANG_OK;
@@ -189,8 +216,35 @@ SlangResult IncludeSystem::loadFile(
     {
         // If we don't have the source manager, just load
         outSourceFile = nullptr;
-        return m_fileSystemExt->loadFile(pathInfo.foundPath.getBuffer(), outBlob.writeRef());
+        SourceFile::FileStat fileStat;
+        return _loadFileContents(pathInfo.foundPath, outBlob, fileStat);
+    }
+}
+
+SlangResult IncludeSystem::_loadFileContents(
+    const String& path,
+    ComPtr<ISlangBlob>& outBlob,
+    SourceFile::FileStat& outFileStat)
+{
+    outFileStat = SourceFile::FileStat();
+
+    ComPtr<ISlangBlob> osPathBlob;
+    if (m_fileSystemExt->getOSPathKind() != OSPathKind::None &&
+        SLANG_SUCCEEDED(m_fileSystemExt->getPath(
+            PathKind::OperatingSystem,
+            path.getBuffer(),
+            osPathBlob.writeRef())))
+    {
+        // The stat is taken before the contents are read, so that a change made after
+        // that shows up as a different stat, rather than as contents the stat matches.
+        auto osPath = StringUtil::getString(osPathBlob);
+        outFileStat = getOSFileStat(osPath);
+
+        // If the file can't be mapped for some reason, it may still be possible to read it.
+        if (m_mapOSFiles && SLANG_SUCCEEDED(File::map(osPath, outBlob)))
+            return SLANG_OK;
     }
+    return m_fileSystemExt->loadFile(path.getBuffer(), outBlob.writeRef());
 }
 
 SlangResult IncludeSystem::findAndLoadFile(
@@ -65,6 +65,16 @@ struct IncludeSystem
     ISlangFileSystemExt* getFileSystem() const { return m_fileSystemExt; }
     SourceManager* getSourceManager() const { return m_sourceManager; }
 
+    /// If set, files of the operating system are mapped into memory by `loadFile` instead of
+    /// being read, see `File::map`. Files of other file systems are always read.
+    void setMapOSFiles(bool mapOSFiles) { m_mapOSFiles = mapOSFiles; }
+    bool getMapOSFiles() const { return m_mapOSFiles; }
+
+    /// Get the stat of a file of the operating system, to be taken right before it is read.
+    /// The modification time is 0 if it can't be used to tell that the file is unchanged,
+    /// see `SourceFile::FileStat`.
+    static SourceFile::FileStat getOSFileStat(const String& osPath);
+
     /// Ctor
     IncludeSystem() = default;
     IncludeSystem(
@@ -73,10 +83,16 @@ struct IncludeSystem
         SourceManager* sourceManager = nullptr);
 
 protected:
+    SlangResult _loadFileContents(
+        const String& path,
+        ComPtr<ISlangBlob>& outBlob,
+        SourceFile::FileStat& outFileStat);
+
     SearchDirectoryList* m_searchDirectories;
     ISlangFileSystemExt* m_fileSystemExt;
     SourceManager*
         m_sourceManager; ///< If not set, will not look up the content in the source manager
+    bool m_mapOSFiles = false;
 };
 
 } // namespace Slang
@@ -11,6 +11,12 @@
 #include "slang-name.h"
 #include "slang-source-loc.h"
 
+#if SLANG_PROCESSOR_X86_64
+#include <emmintrin.h>
+#elif SLANG_PROCESSOR_ARM_64
+#include <arm_neon.h>
+#endif
+
 namespace Slang
 {
 Token TokenReader::getEndOfFileToken()
@@ -323,6 +329,172 @@ static void diagnose(
     sink->diagnose(loc, info, args...);
 }
 
+// Bulk scanning
+//
+// Most of the input is made up of runs of ordinary ASCII characters in comments,
+// whitespace and identifiers. Going through `_peek`/`_advance` for each of them is
+// slow, since those have to check for escaped newlines and UTF-8 on every byte.
+//
+// The functions below find the end of a run of bytes that can be skipped without any
+// such handling, 16 bytes at a time where SIMD is available. Each one stops at (at
+// least) any `\`, newline, NUL or non-ASCII byte, so that the careful path sees all
+// of those. Skipping the bytes they return is the same as calling `_advance` for each.
+
+enum class ScanKind
+{
+    Identifier,      ///< `[A-Za-z0-9_]`
+    HorizontalSpace, ///< ` ` and `\t`
+    LineComment,     ///< Anything but `\`, newlines, NUL and non-ASCII
+    BlockComment,    ///< As for `LineComment`, and also stops at `*`
+};
+
+template<ScanKind kKind>
+SLANG_FORCE_INLINE static bool _isScanChar(Byte c)
+{
+    switch (kKind)
+    {
+    case ScanKind::Identifier:
+        return ((c | 0x20) >= 'a' && (c | 0x20) <= 'z') || (c >= '0' && c <= '9') || c == '_';
+    case ScanKind::HorizontalSpace:
+        return c == ' ' || c == '\t';
+    case ScanKind::LineComment:
+        return c != '\\' && c != '\n' && c != '\r' && c != 0 && c < 0x80;
+    case ScanKind::BlockComment:
+        return c != '*' && c != '\\' && c != '\n' && c != '\r' && c != 0 && c < 0x80;
+    }
+    return false;
+}
+
+#if SLANG_PROCESSOR_X86_64
+
+// Returns a mask with a bit set for each byte of `v` that ends the run.
+template<ScanKind kKind>
+SLANG_FORCE_INLINE static uint32_t _getScanStopMask(__m128i v)
+{
+    switch (kKind)
+    {
+    case ScanKind::Identifier:
+        {
+            // Compares are signed, so non-ASCII bytes are out of every range.
+            const __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+            const __m128i isAlpha = _mm_and_si128(
+                _mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                _mm_cmplt_epi8(lower, _mm_set1_epi8('z' + 1)));
+            const __m128i isDigit = _mm_and_si128(
+                _mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)),
+                _mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1)));
+            const __m128i isUnderscore = _mm_cmpeq_epi8(v, _mm_set1_epi8('_'));
+            const __m128i isIdentifier = _mm_or_si128(_mm_or_si128(isAlpha, isDigit), isUnderscore);
+            return ~uint32_t(_mm_movemask_epi8(isIdentifier)) & 0xffff;
+        }
+    case ScanKind::HorizontalSpace:
+        {
+            const __m128i isSpace = _mm_or_si128(
+                _mm_cmpeq_epi8(v, _mm_set1_epi8(' ')),
+                _mm_cmpeq_epi8(v, _mm_set1_epi8('\t')));
+            return ~uint32_t(_mm_movemask_epi8(isSpace)) & 0xffff;
+        }
+    case ScanKind::LineComment:
+    case ScanKind::BlockComment:
+        {
+            __m128i isStop = _mm_or_si128(
+                _mm_or_si128(
+                    _mm_cmpeq_epi8(v, _mm_set1_epi8('\\')),
+                    _mm_cmpeq_epi8(v, _mm_setzero_si128())),
+                _mm_or_si128(
+                    _mm_cmpeq_epi8(v, _mm_set1_epi8('\n')),
+                    _mm_cmpeq_epi8(v, _mm_set1_epi8('\r'))));
+            if (kKind == ScanKind::BlockComment)
+            {
+                isStop = _mm_or_si128(isStop, _mm_cmpeq_epi8(v, _mm_set1_epi8('*')));
+            }
+            // The top bit of each byte is set for non-ASCII bytes.
+            return uint32_t(_mm_movemask_epi8(isStop) | _mm_movemask_epi8(v));
+        }
+    }
+    return 0xffff;
+}
+
+#elif SLANG_PROCESSOR_ARM_64
+
+// Returns a mask with 4 bits set for each byte of `v` that ends the run.
+template<ScanKind kKind>
+SLANG_FORCE_INLINE static uint64_t _getScanStopMask(uint8x16_t v)
+{
+    uint8x16_t isStop;
+    switch (kKind)
+    {
+    case ScanKind::Identifier:
+        {
+            const uint8x16_t lower = vorrq_u8(v, vdupq_n_u8(0x20));
+            const uint8x16_t isAlpha = vcleq_u8(vsubq_u8(lower, vdupq_n_u8('a')), vdupq_n_u8(25));
+            const uint8x16_t isDigit = vcleq_u8(vsubq_u8(v, vdupq_n_u8('0')), vdupq_n_u8(9));
+            const uint8x16_t isUnderscore = vceqq_u8(v, vdupq_n_u8('_'));
+            isStop = vmvnq_u8(vorrq_u8(vorrq_u8(isAlpha, isDigit), isUnderscore));
+            break;
+        }
+    case ScanKind::HorizontalSpace:
+        isStop = vmvnq_u8(vorrq_u8(vceqq_u8(v, vdupq_n_u8(' ')), vceqq_u8(v, vdupq_n_u8('\t'))));
+        break;
+    case ScanKind::LineComment:
+    case ScanKind::BlockComment:
+        isStop = vorrq_u8(
+            vorrq_u8(vceqq_u8(v, vdupq_n_u8('\\')), vceqq_u8(v, vdupq_n_u8(0))),
+            vorrq_u8(vceqq_u8(v, vdupq_n_u8('\n')), vceqq_u8(v, vdupq_n_u8('\r'))));
+        isStop = vorrq_u8(isStop, vcgeq_u8(v, vdupq_n_u8(0x80)));
+        if (kKind == ScanKind::BlockComment)
+        {
+            isStop = vorrq_u8(isStop, vceqq_u8(v, vdupq_n_u8('*')));
+        }
+        break;
+    }
+    // Narrow each byte to 4 bits, giving a 64 bit mask.
+    const uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(isStop), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+}
+
+#endif
+
+// Returns the end of the run of bytes of kind `kKind` starting at `cursor`.
+template<ScanKind kKind>
+static const char* _scan(const char* cursor, const char* end)
+{
+#if SLANG_PROCESSOR_X86_64
+    while (end - cursor >= 16)
+    {
+        const __m128i v = _mm_loadu_si128((const __m128i*)cursor);
+        if (const uint32_t stopMask = _getScanStopMask<kKind>(v))
+        {
+            return cursor + bitscanForward(stopMask);
+        }
+        cursor += 16;
+    }
+#elif SLANG_PROCESSOR_ARM_64
+    while (end - cursor >= 16)
+    {
+        const uint8x16_t v = vld1q_u8((const uint8_t*)cursor);
+        if (const uint64_t stopMask = _getScanStopMask<kKind>(v))
+        {
+            return cursor + (bitscanForward(stopMask) >> 2);
+        }
+        cursor += 16;
+    }
+#endif
+    while (cursor < end && _isScanChar<kKind>(Byte(*cursor)))
+    {
+        cursor++;
+    }
+    return cursor;
+}
+
+template<ScanKind kKind>
+SLANG_FORCE_INLINE static void _skip(Lexer* lexer)
+{
+    if (lexer->m_lexerFlags & kLexerFlag_DisableBulkScan)
+        return;
+    lexer->m_cursor = _scan<kKind>(lexer->m_cursor, lexer->m_end);
+}
+
 static void _handleNewLine(Lexer* lexer)
 {
     int c = _advance(lexer);
@@ -333,6 +505,7 @@ static void _lexLineComment(Lexer* lexer)
 {
     for (;;)
     {
+        _skip<ScanKind::LineComment>(lexer);
         switch (_peek(lexer))
         {
         case '\n':
@@ -351,6 +524,7 @@ static void _lexBlockComment(Lexer* lexer)
 {
     for (;;)
     {
+        _skip<ScanKind::BlockComment>(lexer);
         switch (_peek(lexer))
         {
         case kEOF:
@@ -385,6 +559,7 @@ static void _lexHorizontalSpace(Lexer* lexer)
 {
     for (;;)
     {
+        _skip<ScanKind::HorizontalSpace>(lexer);
         switch (_peek(lexer))
         {
         case ' ':
@@ -407,6 +582,7 @@ static void _lexIdentifier(Lexer* lexer)
 {
     for (;;)
     {
+        _skip<ScanKind::Identifier>(lexer);
         int c = _peek(lexer);
         if (('a' <= c) && (c <= 'z') || ('A' <= c) && (c <= 'Z') || ('0' <= c) && (c <= '9') ||
             (c == '_') || isNonAsciiCodePoint((unsigned int)c))
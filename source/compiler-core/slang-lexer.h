@@ -108,6 +108,7 @@ enum
 {
     kLexerFlag_SuppressDiagnostics = 1
                                      << 2, ///< Suppress errors about invalid/unsupported characters
+    kLexerFlag_DisableBulkScan = 1 << 3, ///< Lex one character at a time (to test bulk scanning)
 };
 
 struct Lexer
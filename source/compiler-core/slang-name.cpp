@@ -21,18 +21,147 @@ const char* getCstr(Name* name)
     return name ? name->text.getBuffer() : nullptr;
 }
 
-Name* NamePool::getName(UnownedStringSlice text)
+RootNamePool::RootNamePool()
+    : m_arena(16 * 1024)
+{
+    m_table.store(_allocateTable(1024), std::memory_order_relaxed);
+}
+
+RootNamePool::~RootNamePool()
+{
+    // Every name is in the current table. The memory of the names is owned by the arena,
+    // so they are only destructed here.
+    Table* table = m_table.load(std::memory_order_relaxed);
+    for (Index i = 0; i < table->capacity; ++i)
+    {
+        if (Name* name = table->slots[i].load(std::memory_order_relaxed))
+        {
+            // Only the reference of the pool can remain. Any other would be released after
+            // the memory of the name has been freed.
+            SLANG_ASSERT(name->isUniquelyReferenced());
+            name->~Name();
+        }
+    }
+}
+
+RootNamePool::Table* RootNamePool::_allocateTable(Count capacity)
+{
+    SLANG_ASSERT((capacity & (capacity - 1)) == 0);
+
+    Table* table = m_arena.allocate<Table>();
+    table->capacity = capacity;
+    table->slots = (std::atomic<Name*>*)m_arena.allocateAligned(
+        sizeof(std::atomic<Name*>) * capacity,
+        alignof(std::atomic<Name*>));
+    for (Index i = 0; i < capacity; ++i)
+    {
+        new (&table->slots[i]) std::atomic<Name*>(nullptr);
+    }
+    return table;
+}
+
+/* static */ Name* RootNamePool::_find(
+    const Table* table,
+    UnownedStringSlice text,
+    HashCode64 hash)
+{
+    const Count mask = table->capacity - 1;
+    for (Index i = Index(hash & mask);; i = (i + 1) & mask)
+    {
+        // Pairs with the release store in `_insert`, so that the name is fully constructed.
+        Name* name = table->slots[i].load(std::memory_order_acquire);
+        if (!name)
+        {
+            return nullptr;
+        }
+        if (name->hash == hash && name->text.getUnownedSlice() == text)
+        {
+            return name;
+        }
+    }
+}
+
+/* static */ void RootNamePool::_insert(Table* table, Name* name)
 {
-    RefPtr<Name> name;
-    if (rootPool->names.tryGetValue(text, name))
+    const Count mask = table->capacity - 1;
+    for (Index i = Index(name->hash & mask);; i = (i + 1) & mask)
+    {
+        if (!table->slots[i].load(std::memory_order_relaxed))
+        {
+            table->slots[i].store(name, std::memory_order_release);
+            return;
+        }
+    }
+}
+
+Name* RootNamePool::tryGetName(UnownedStringSlice text, HashCode64 hash) const
+{
+    if (Name* name = _find(m_table.load(std::memory_order_acquire), text, hash))
+    {
         return name;
+    }
 
-    name = new Name();
+    // The name may have been added to a newer table since we loaded it.
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return _find(m_table.load(std::memory_order_relaxed), text, hash);
+}
+
+Name* RootNamePool::getName(UnownedStringSlice text, HashCode64 hash)
+{
+    if (Name* name = _find(m_table.load(std::memory_order_acquire), text, hash))
+    {
+        return name;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Another thread may have added the name (or grown the table) in the meantime.
+    Table* table = m_table.load(std::memory_order_relaxed);
+    if (Name* name = _find(table, text, hash))
+    {
+        return name;
+    }
+
+    // Keep the load factor at most 1/2, so that probe sequences stay short.
+    if ((m_nameCount + 1) * 2 > table->capacity)
+    {
+        Table* newTable = _allocateTable(table->capacity * 2);
+        for (Index i = 0; i < table->capacity; ++i)
+        {
+            if (Name* existing = table->slots[i].load(std::memory_order_relaxed))
+            {
+                _insert(newTable, existing);
+            }
+        }
+        // The old table is left in the arena, as lookups on other threads may still be
+        // reading it. It holds all the names it did before, so remains correct to read.
+        m_table.store(newTable, std::memory_order_release);
+        table = newTable;
+    }
+
+    Name* name = new (m_arena.allocateAligned(sizeof(Name), alignof(Name))) Name();
     name->text = text;
-    rootPool->names.add(text, name);
+    name->hash = hash;
+    // The pool holds a reference for its lifetime, so that a `RefPtr` to the name
+    // elsewhere can never free it.
+    name->addReference();
+
+    _insert(table, name);
+    m_nameCount++;
     return name;
 }
 
+Count RootNamePool::getNameCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_nameCount;
+}
+
+Name* NamePool::getName(UnownedStringSlice text)
+{
+    return rootPool->getName(text, RootNamePool::getHash(text));
+}
+
 Name* NamePool::getName(String const& text)
 {
     return getName(text.getUnownedSlice());
@@ -40,10 +169,8 @@ Name* NamePool::getName(String const& text)
 
 Name* NamePool::tryGetName(String const& text)
 {
-    RefPtr<Name> name;
-    if (rootPool->names.tryGetValue(text, name))
-        return name;
-    return nullptr;
+    const auto slice = text.getUnownedSlice();
+    return rootPool->tryGetName(slice, RootNamePool::getHash(slice));
 }
 
 } // namespace Slang
@@ -6,6 +6,10 @@
 // the name of types, variables, etc. in the AST.
 
 #include "../core/slang-basic.h"
+#include "../core/slang-memory-arena.h"
+
+#include <atomic>
+#include <mutex>
 
 namespace Slang
 {
@@ -22,6 +26,11 @@ namespace Slang
 // cleaned up when the pool is deleted), and which is responsible for
 // ensuring the uniqueness of name objects.
 //
+// A name lives exactly as long as the `RootNamePool` that created it, whose
+// arena owns its memory. Names should only be held with plain pointers: a
+// `RefPtr` doesn't keep a name alive, and one that outlives the pool would
+// free memory the pool has already released.
+//
 class Name : public RefObject
 {
 public:
@@ -31,6 +40,9 @@ public:
     // of name than "simple" names, and so this might change to a structured
     // ADT instead of a simple string.
     String text;
+
+    // The hash of `text`, as computed by `RootNamePool::getHash`.
+    HashCode64 hash = 0;
 };
 
 // Get the textual string representation of a name
@@ -48,10 +60,57 @@ const char* getCstr(Name* name);
 // get equivalent names for a string like `"Foo"`, then they need to use
 // the same root name pool (directly or indirectly).
 //
+// Names are allocated from an arena owned by the pool, and are found with an
+// open addressing hash table keyed on the text of the name, so that looking up
+// an existing name (the common case, for every identifier token that is lexed)
+// doesn't allocate.
+//
+// Lookups can be made from multiple threads at once, and don't take a lock.
+// Creating a name takes a lock, and when the table grows the previous table is
+// kept alive (in the arena) for any lookups still using it.
+//
+// All the names of the pool are destroyed with it, so it must outlive every
+// pointer to them (see `Name`).
+//
 struct RootNamePool
 {
-    // The mapping from text strings to the corresponding name.
-    Dictionary<String, RefPtr<Name>> names;
+    RootNamePool();
+    ~RootNamePool();
+
+    RootNamePool(const RootNamePool&) = delete;
+    RootNamePool& operator=(const RootNamePool&) = delete;
+
+    // Get the hash of `text` used to look it up.
+    static HashCode64 getHash(UnownedStringSlice text) { return getHashCode(text); }
+
+    // Find the `Name` for `text` (with the hash `hash`), or return nullptr if there isn't one.
+    Name* tryGetName(UnownedStringSlice text, HashCode64 hash) const;
+
+    // Find or create the `Name` for `text` (with the hash `hash`).
+    Name* getName(UnownedStringSlice text, HashCode64 hash);
+
+    // Get the number of names in the pool.
+    Count getNameCount() const;
+
+private:
+    struct Table
+    {
+        // Always a power of 2.
+        Count capacity;
+        // `capacity` slots, each either null or holding a name.
+        std::atomic<Name*>* slots;
+    };
+
+    static Name* _find(const Table* table, UnownedStringSlice text, HashCode64 hash);
+    Table* _allocateTable(Count capacity);
+    static void _insert(Table* table, Name* name);
+
+    std::atomic<Table*> m_table;
+
+    // Guards the creation of names, and everything below.
+    mutable std::mutex m_mutex;
+    Count m_nameCount = 0;
+    MemoryArena m_arena;
 };
 
 // A `NamePool` is effectively a way of storing a subset of the
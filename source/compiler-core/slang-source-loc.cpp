@@ -185,8 +185,7 @@ void SourceView::addLineDirective(
 
 void SourceView::addLineDirective(SourceLoc directiveLoc, const String& path, int line)
 {
-    StringSlicePool::Handle pathHandle =
-        getSourceManager()->getStringSlicePool().add(path.getUnownedSlice());
+    StringSlicePool::Handle pathHandle = getSourceManager()->addStringSlice(path.getUnownedSlice());
     return addLineDirective(directiveLoc, pathHandle, line);
 }
 
@@ -328,11 +327,10 @@ static SlangResult _findLocWithSourceMap(
     // We need to add the pool of the originating source view/file
     const auto originatingSourceManager = sourceView->getSourceManager();
 
-    auto& managerPool = originatingSourceManager->getStringSlicePool();
-
     outLoc.line = entry.sourceLine + 1;
     outLoc.column = entry.sourceColumn + 1;
-    outLoc.pathHandle = managerPool.add(sourceMap->getSourceFileName(entry.sourceFileIndex));
+    outLoc.pathHandle = originatingSourceManager->addStringSlice(
+        sourceMap->getSourceFileName(entry.sourceFileIndex));
 
     return SLANG_OK;
 }
@@ -417,16 +415,15 @@ HumaneSourceLoc SourceView::getHumaneLoc(SourceLoc loc, SourceLocType type)
 
 PathInfo SourceView::getViewPathInfo() const
 {
-    if (m_viewPath.getLength())
-    {
-        PathInfo pathInfo(m_sourceFile->getPathInfo());
-        pathInfo.foundPath = m_viewPath;
-        return pathInfo;
-    }
-    else
-    {
-        return m_sourceFile->getPathInfo();
-    }
+    // The source file may be shared with other threads, and String reference counts are not
+    // atomic, so the paths are copied rather than shared.
+    const PathInfo& fileInfo = m_sourceFile->getPathInfo();
+    PathInfo pathInfo;
+    pathInfo.type = fileInfo.type;
+    const String& foundPath = m_viewPath.getLength() ? m_viewPath : fileInfo.foundPath;
+    pathInfo.foundPath = String(foundPath.getUnownedSlice());
+    pathInfo.uniqueIdentity = String(fileInfo.uniqueIdentity.getUnownedSlice());
+    return pathInfo;
 }
 
 PathInfo SourceView::_getPathInfoFromHandle(StringSlicePool::Handle pathHandle) const
@@ -438,7 +435,7 @@ PathInfo SourceView::_getPathInfoFromHandle(StringSlicePool::Handle pathHandle)
     }
     else
     {
-        return PathInfo::makePath(getSourceManager()->getStringSlicePool().getSlice(pathHandle));
+        return PathInfo::makePath(getSourceManager()->getStringSlice(pathHandle));
     }
 }
 
@@ -466,8 +463,10 @@ PathInfo SourceView::getPathInfo(SourceLoc loc, SourceLocType type)
 
 void SourceFile::setLineBreakOffsets(const uint32_t* offsets, UInt numOffsets)
 {
+    std::lock_guard<std::mutex> lock(m_lineBreakOffsetsMutex);
     m_lineBreakOffsets.clear();
     m_lineBreakOffsets.addRange(offsets, numOffsets);
+    m_hasLineBreakOffsets = true;
 }
 
 const List<uint32_t>& SourceFile::getLineBreakOffsets()
@@ -475,7 +474,13 @@ const List<uint32_t>& SourceFile::getLineBreakOffsets()
     // We now have a raw input file that we can search for line breaks.
     // We obviously don't want to do a linear scan over and over, so we will
     // cache an array of line break locations in the file.
-    if (m_lineBreakOffsets.getCount() == 0)
+    if (m_hasLineBreakOffsets)
+    {
+        return m_lineBreakOffsets;
+    }
+
+    std::lock_guard<std::mutex> lock(m_lineBreakOffsetsMutex);
+    if (!m_hasLineBreakOffsets)
     {
         UnownedStringSlice content(getContent()), line;
         char const* contentBegin = content.begin();
@@ -487,6 +492,7 @@ const List<uint32_t>& SourceFile::getLineBreakOffsets()
         // break, because otherwise we would report errors like
         // "end of file inside string literal" with a line number
         // that points at a line that doesn't exist.
+        m_hasLineBreakOffsets = true;
     }
 
     return m_lineBreakOffsets;
@@ -654,6 +660,7 @@ SourceFile::~SourceFile() {}
 
 SHA1::Digest SourceFile::getDigest()
 {
+    std::lock_guard<std::mutex> lock(m_digestMutex);
     if (m_digest == SHA1::Digest())
     {
         DigestBuilder<SHA1> builder;
@@ -751,6 +758,7 @@ void SourceManager::reset()
 
 UnownedStringSlice SourceManager::allocateStringSlice(const UnownedStringSlice& slice)
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
     const UInt numChars = slice.getLength();
 
     char* dst = (char*)m_memoryArena.allocate(numChars);
@@ -759,11 +767,26 @@ UnownedStringSlice SourceManager::allocateStringSlice(const UnownedStringSlice&
     return UnownedStringSlice(dst, numChars);
 }
 
-SourceRange SourceManager::allocateSourceRange(UInt size)
+StringSlicePool::Handle SourceManager::addStringSlice(const UnownedStringSlice& slice)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_slicePool.add(slice);
+}
+
+UnownedStringSlice SourceManager::getStringSlice(StringSlicePool::Handle handle) const
 {
-    // TODO: consider using atomics here
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_slicePool.getSlice(handle);
+}
 
+SourceRange SourceManager::allocateSourceRange(UInt size)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return _allocateSourceRange(size);
+}
 
+SourceRange SourceManager::_allocateSourceRange(UInt size)
+{
     SourceLoc beginLoc = m_nextLoc;
     SourceLoc endLoc = beginLoc + size;
 
@@ -779,6 +802,7 @@ SourceRange SourceManager::allocateSourceRange(UInt size)
 SourceFile* SourceManager::createSourceFileWithSize(const PathInfo& pathInfo, size_t contentSize)
 {
     SourceFile* sourceFile = new SourceFile(this, pathInfo, contentSize);
+    std::lock_guard<std::mutex> lock(m_mutex);
     m_sourceFiles.add(sourceFile);
     return sourceFile;
 }
@@ -788,16 +812,18 @@ SourceFile* SourceManager::createSourceFileWithString(
     const String& contents)
 {
     SourceFile* sourceFile = new SourceFile(this, pathInfo, contents.getLength());
-    m_sourceFiles.add(sourceFile);
     sourceFile->setContents(contents);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_sourceFiles.add(sourceFile);
     return sourceFile;
 }
 
 SourceFile* SourceManager::createSourceFileWithBlob(const PathInfo& pathInfo, ISlangBlob* blob)
 {
     SourceFile* sourceFile = new SourceFile(this, pathInfo, blob->getBufferSize());
-    m_sourceFiles.add(sourceFile);
     sourceFile->setContents(blob);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_sourceFiles.add(sourceFile);
     return sourceFile;
 }
 
@@ -806,7 +832,10 @@ SourceView* SourceManager::createSourceView(
     const PathInfo* pathInfo,
     SourceLoc initiatingSourceLoc)
 {
-    SourceRange range = allocateSourceRange(sourceFile->getContentSize());
+    // The range is allocated and the view added under the same lock, so that the views
+    // stay ordered by range.
+    std::lock_guard<std::mutex> lock(m_mutex);
+    SourceRange range = _allocateSourceRange(sourceFile->getContentSize());
 
     SourceView* sourceView = nullptr;
     if (pathInfo && (pathInfo->foundPath.getLength() &&
@@ -826,6 +855,7 @@ SourceView* SourceManager::createSourceView(
 
 SourceView* SourceManager::findSourceView(SourceLoc loc) const
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
     Index hi = m_sourceViews.getCount();
     // It must be in the range of this manager and have associated views for it to possibly be a hit
     if (!getSourceRange().contains(loc) || hi == 0)
@@ -919,6 +949,7 @@ SourceFile* SourceManager::findSourceFileByPathRecursively(const String& name) c
 
 SourceFile* SourceManager::findSourceFileByPath(const String& name) const
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
     for (auto sourceFile : m_sourceFiles)
     {
         if (sourceFile->getPathInfo().foundPath == name)
@@ -931,6 +962,7 @@ SourceFile* SourceManager::findSourceFileByPath(const String& name) const
 
 SourceFile* SourceManager::findSourceFile(const String& uniqueIdentity) const
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
     SourceFile* const* filePtr = m_sourceFileMap.tryGetValue(uniqueIdentity);
     return (filePtr) ? *filePtr : nullptr;
 }
@@ -967,7 +999,8 @@ SourceFile* SourceManager::findSourceFileByContentRecursively(const char* text)
 
 SourceFile* SourceManager::findSourceFileByContent(const char* text) const
 {
-    for (SourceFile* sourceFile : getSourceFiles())
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (SourceFile* sourceFile : m_sourceFiles)
     {
         auto content = sourceFile->getContent();
 
@@ -982,14 +1015,41 @@ SourceFile* SourceManager::findSourceFileByContent(const char* text) const
 void SourceManager::addSourceFile(const String& uniqueIdentity, SourceFile* sourceFile)
 {
     SLANG_ASSERT(!findSourceFileRecursively(uniqueIdentity));
-    m_sourceFileMap.add(uniqueIdentity, sourceFile);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_sourceFileMap.add(String(uniqueIdentity.getUnownedSlice()), sourceFile);
 }
 
-void SourceManager::addSourceFileIfNotExist(const String& uniqueIdentity, SourceFile* sourceFile)
+SourceFile* SourceManager::addSourceFileIfNotExist(
+    const String& uniqueIdentity,
+    SourceFile* sourceFile)
 {
-    if (findSourceFileRecursively(uniqueIdentity))
-        return;
-    m_sourceFileMap.addIfNotExists(uniqueIdentity, sourceFile);
+    if (m_parent)
+    {
+        if (SourceFile* parentSourceFile = m_parent->findSourceFileRecursively(uniqueIdentity))
+            return parentSourceFile;
+    }
+
+    // The check and the add are done under the same lock, so if several threads add a file
+    // with the same identity, they all get the one that was added first.
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // The key is a copy, so that its reference count is only touched under the lock.
+    if (SourceFile* const* filePtr = m_sourceFileMap.tryGetValue(uniqueIdentity))
+        return *filePtr;
+    m_sourceFileMap.add(String(uniqueIdentity.getUnownedSlice()), sourceFile);
+    return sourceFile;
+}
+
+void SourceManager::removeSourceFile(SourceFile* sourceFile)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    List<String> uniqueIdentities;
+    for (const auto& [uniqueIdentity, file] : m_sourceFileMap)
+    {
+        if (file == sourceFile)
+            uniqueIdentities.add(uniqueIdentity);
+    }
+    for (const auto& uniqueIdentity : uniqueIdentities)
+        m_sourceFileMap.remove(uniqueIdentity);
 }
 
 HumaneSourceLoc SourceManager::getHumaneLoc(SourceLoc loc, SourceLocType type)
@@ -11,6 +11,9 @@
 #include "slang-source-map.h"
 #include "slang.h"
 
+#include <atomic>
+#include <mutex>
+
 namespace Slang
 {
 
@@ -344,6 +347,22 @@ public:
 
     SHA1::Digest getDigest();
 
+    /// The size and modification time of a file of the operating system, taken right
+    /// before its contents were read.
+    struct FileStat
+    {
+        uint64_t size = 0;
+        /// In nanoseconds since the Unix epoch (see `File::getSizeAndModificationTime`),
+        /// or 0 if it isn't known. It is also 0 if the file was modified so shortly before
+        /// it was read that a later change could keep the same modification time.
+        uint64_t modificationTime = 0;
+    };
+
+    /// Get the stat of the file when it was read, with a modification time of 0 if it
+    /// wasn't read from a file of the operating system.
+    const FileStat& getFileStat() const { return m_fileStat; }
+    void setFileStat(const FileStat& fileStat) { m_fileStat = fileStat; }
+
 protected:
     SourceManager* m_sourceManager; ///< The source manager this belongs to
     PathInfo
@@ -354,12 +373,18 @@ protected:
     UnownedStringSlice m_content;     ///< The actual contents of the file.
     size_t m_contentSize;             ///< The size of the actual contents
 
+    // The digest is computed on demand, possibly by preprocessors running on multiple threads.
     SHA1::Digest m_digest;
+    std::mutex m_digestMutex;
 
     // In order to speed up lookup of line number information,
     // we will cache the starting offset of each line break in
     // the input file:
     List<uint32_t> m_lineBreakOffsets;
+    // The offsets are computed on demand, possibly by code generation
+    // running on multiple threads, so creation is guarded by a mutex.
+    std::atomic<bool> m_hasLineBreakOffsets = false;
+    std::mutex m_lineBreakOffsetsMutex;
 
     // If set then the locations in this file are really from locations from elsewhere,
     // where the SourceMap specifies that mapping
@@ -369,6 +394,8 @@ protected:
 
     // Indicate if the source file is an included file
     bool m_included = false;
+
+    FileStat m_fileStat;
 };
 
 enum class SourceLocType
@@ -554,6 +581,9 @@ protected:
     List<AbsoluteSegment> m_absSegments;            ///< Segments of absolute location mapping.
 };
 
+/// Source files and views can be created and looked up from several threads at once (as when
+/// imported modules are preprocessed in parallel). Resetting the manager, and the accessors that
+/// return references to its lists or pools, are not synchronized.
 struct SourceManager
 {
     // Initialize a source manager, with an optional parent
@@ -619,13 +649,23 @@ struct SourceManager
 
     /// Add a source file, uniqueIdentity must be unique for this manager AND any parents
     void addSourceFile(const String& uniqueIdentity, SourceFile* sourceFile);
-    void addSourceFileIfNotExist(const String& uniqueIdentity, SourceFile* sourceFile);
+    /// Add a source file if there isn't one with the uniqueIdentity already.
+    /// Returns the source file that is registered for the uniqueIdentity.
+    SourceFile* addSourceFileIfNotExist(const String& uniqueIdentity, SourceFile* sourceFile);
+    /// Remove a source file from the files that can be found by unique identity on this
+    /// manager, so that the next load of the file reads its contents again.
+    /// The source file is still owned by the manager, as locations may refer to it.
+    void removeSourceFile(SourceFile* sourceFile);
 
     // Maps a SourceLoc to an absolute location
     SourceLoc::RawValue getAbsoluteLocation(SourceLoc location) const;
 
     /// Get the slice pool
     StringSlicePool& getStringSlicePool() { return m_slicePool; }
+    /// Add a slice to the slice pool, returning its handle
+    StringSlicePool::Handle addStringSlice(const UnownedStringSlice& slice);
+    /// Get the slice in the slice pool for a handle
+    UnownedStringSlice getStringSlice(StringSlicePool::Handle handle) const;
 
     /// Get the source range for just this manager
     /// Caution - the range will change if allocations are made to this manager.
@@ -659,6 +699,8 @@ protected:
     void _resetLoc();
     void _resetSource();
 
+    SourceRange _allocateSourceRange(UInt size);
+
     // The first location available to this source manager
     // (may not be the first location of all, because we might
     // have a parent source manager)
@@ -686,6 +728,9 @@ protected:
     Dictionary<String, SourceFile*> m_sourceFileMap;
 
     ComPtr<ISlangFileSystemExt> m_fileSystemExt;
+
+    // Guards the members above that are modified as source is loaded
+    mutable std::mutex m_mutex;
 };
 
 } // namespace Slang
@@ -52,6 +52,26 @@ SlangResult loadArchiveFileSystem(
     return SLANG_OK;
 }
 
+SlangResult loadArchiveFileSystem(
+    ISlangBlob* archiveBlob,
+    ComPtr<ISlangFileSystemExt>& outFileSystem)
+{
+    const void* data = archiveBlob->getBufferPointer();
+    const size_t dataSizeInBytes = archiveBlob->getBufferSize();
+    if (!RiffFileSystem::isArchive(data, dataSizeInBytes))
+    {
+        // Other kinds of archive are copied as they are loaded.
+        return loadArchiveFileSystem(data, dataSizeInBytes, outFileSystem);
+    }
+
+    RiffFileSystem* riffFileSystem = new RiffFileSystem(nullptr);
+    ComPtr<ISlangFileSystemExt> fileSystem(riffFileSystem);
+    SLANG_RETURN_ON_FAIL(riffFileSystem->loadArchiveBlob(archiveBlob));
+
+    outFileSystem = fileSystem;
+    return SLANG_OK;
+}
+
 SlangResult createArchiveFileSystem(
     SlangArchiveType type,
     ComPtr<ISlangMutableFileSystem>& outFileSystem)
@@ -32,6 +32,11 @@ SlangResult loadArchiveFileSystem(
     const void* data,
     size_t dataSizeInBytes,
     ComPtr<ISlangFileSystemExt>& outFileSystem);
+/// Like `loadArchiveFileSystem` above, but the file system may reference the contents of the
+/// archive blob in place instead of copying them, keeping the blob alive.
+SlangResult loadArchiveFileSystem(
+    ISlangBlob* archiveBlob,
+    ComPtr<ISlangFileSystemExt>& outFileSystem);
 SlangResult createArchiveFileSystem(
     SlangArchiveType type,
     ComPtr<ISlangMutableFileSystem>& outFileSystem);
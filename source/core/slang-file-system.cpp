@@ -358,6 +358,7 @@ void CacheFileSystem::setInnerFileSystem(
     UniqueIdentityMode uniqueIdentityMode,
     PathStyle pathStyle)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
     m_fileSystem = fileSystem;
 
     m_uniqueIdentityMode = uniqueIdentityMode;
@@ -407,6 +408,7 @@ void CacheFileSystem::setInnerFileSystem(
 
 void CacheFileSystem::clearCache()
 {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
     for (const auto& [_, pathInfo] : m_uniqueIdentityMap)
         delete pathInfo;
 
@@ -443,6 +445,7 @@ SlangResult CacheFileSystem::enumeratePathContents(
     FileSystemContentsCallBack callback,
     void* userData)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
     if (m_fileSystemExt)
     {
         return m_fileSystemExt->enumeratePathContents(path, callback, userData);
@@ -685,6 +688,7 @@ CacheFileSystem::PathInfo* CacheFileSystem::_resolvePathCacheInfo(const String&
 
 SlangResult CacheFileSystem::loadFile(char const* pathIn, ISlangBlob** blobOut)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
     *blobOut = nullptr;
     String path(pathIn);
     PathInfo* info = _resolvePathCacheInfo(path);
@@ -709,6 +713,7 @@ SlangResult CacheFileSystem::loadFile(char const* pathIn, ISlangBlob** blobOut)
 
 SlangResult CacheFileSystem::getFileUniqueIdentity(const char* path, ISlangBlob** outUniqueIdentity)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
     *outUniqueIdentity = nullptr;
     PathInfo* info = _resolvePathCacheInfo(path);
     if (!info || info->m_uniqueIdentity.getLength() <= 0)
@@ -775,6 +780,7 @@ SlangResult CacheFileSystem::_getPathType(
 
 SlangResult CacheFileSystem::getPathType(const char* inPath, SlangPathType* outPathType)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
     PathInfo* info = _resolvePathCacheInfo(inPath);
     if (!info)
     {
@@ -786,6 +792,7 @@ SlangResult CacheFileSystem::getPathType(const char* inPath, SlangPathType* outP
 
 SlangResult CacheFileSystem::getPath(PathKind kind, const char* path, ISlangBlob** outPath)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
     switch (kind)
     {
     case PathKind::Simplified:
@@ -8,6 +8,8 @@
 #include "slang-com-ptr.h"
 #include "slang.h"
 
+#include <mutex>
+
 namespace Slang
 {
 
@@ -266,6 +268,11 @@ protected:
                          ///< emulate all the other methods of ISlangFileSystemExt
 
     OSPathKind m_osPathKind = OSPathKind::None; ///< OS path kind
+
+    /// Guards the caches, so the file system can be used from several threads at once (as when
+    /// imported modules are preprocessed in parallel). Recursive as some methods are implemented
+    /// in terms of others.
+    std::recursive_mutex m_mutex;
 };
 
 class RelativeFileSystem : public ComBaseObject, public ISlangMutableFileSystem
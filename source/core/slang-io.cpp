@@ -33,6 +33,10 @@
 #include <sys/stat.h>
 #endif
 
+#if defined(__linux__) || defined(__CYGWIN__) || SLANG_APPLE_FAMILY
+#include <sys/mman.h>
+#endif
+
 #if SLANG_APPLE_FAMILY
 #include <mach-o/dyld.h>
 #endif
@@ -64,6 +68,68 @@ namespace Slang
 #endif
 }
 
+/* static */ SlangResult File::replace(const String& fromFileName, const String& toFileName)
+{
+#ifdef _WIN32
+    // https://learn.microsoft.com/en-us/windows/win32/api/winbase/nf-winbase-movefileexw
+    if (::MoveFileExW(fromFileName.toWString(), toFileName.toWString(), MOVEFILE_REPLACE_EXISTING))
+    {
+        return SLANG_OK;
+    }
+
+    // A file that is mapped can't be replaced or deleted. It can be renamed though, as `map`
+    // opens files with `FILE_SHARE_DELETE`, so move it out of the way first, and delete it under
+    // its new name. The delete stays pending until nothing maps the file, and the name can't be
+    // used again until then, so each replace moves the file to a name of its own.
+    const DWORD error = ::GetLastError();
+    if (error != ERROR_ACCESS_DENIED && error != ERROR_SHARING_VIOLATION &&
+        error != ERROR_USER_MAPPED_FILE)
+    {
+        return SLANG_FAIL;
+    }
+    String oldFileName;
+    for (uint32_t attempt = 0;; attempt++)
+    {
+        if (attempt == 16)
+        {
+            return SLANG_FAIL;
+        }
+        oldFileName = toFileName;
+        oldFileName.append(".old.");
+        oldFileName.append(uint32_t(::GetCurrentProcessId()));
+        oldFileName.append(".");
+        oldFileName.append(uint64_t(::GetTickCount64()));
+        oldFileName.append(".");
+        oldFileName.append(attempt);
+        if (::MoveFileExW(toFileName.toWString(), oldFileName.toWString(), 0))
+        {
+            break;
+        }
+        // Another file has the name, possibly one that is pending delete, so try another one.
+        const DWORD moveError = ::GetLastError();
+        if (moveError != ERROR_ALREADY_EXISTS && moveError != ERROR_FILE_EXISTS &&
+            moveError != ERROR_ACCESS_DENIED)
+        {
+            return SLANG_FAIL;
+        }
+    }
+    if (!::MoveFileExW(fromFileName.toWString(), toFileName.toWString(), 0))
+    {
+        ::MoveFileExW(oldFileName.toWString(), toFileName.toWString(), 0);
+        return SLANG_FAIL;
+    }
+    ::DeleteFileW(oldFileName.toWString());
+    return SLANG_OK;
+#else
+    // https://man7.org/linux/man-pages/man2/rename.2.html
+    // Processes that have the replaced file open or mapped keep using it.
+    if (::rename(fromFileName.getBuffer(), toFileName.getBuffer()) == 0)
+    {
+        return SLANG_OK;
+    }
+    return SLANG_FAIL;
+#endif
+}
 
 #ifdef _WIN32
 /* static */ SlangResult File::generateTemporary(
@@ -182,6 +248,155 @@ namespace Slang
 #endif
 }
 
+/* static */ SlangResult File::getSizeAndModificationTime(
+    const String& fileName,
+    uint64_t& outSize,
+    uint64_t& outModificationTime)
+{
+#ifdef _WIN32
+    struct _stat64 statVar;
+    if (::_wstat64(String(fileName).toWString(), &statVar) != 0)
+        return SLANG_E_NOT_FOUND;
+    if (!(statVar.st_mode & _S_IFREG))
+        return SLANG_FAIL;
+    outSize = uint64_t(statVar.st_size);
+    outModificationTime = uint64_t(statVar.st_mtime) * 1000000000;
+#else
+    struct stat statVar;
+    if (::stat(fileName.getBuffer(), &statVar) != 0)
+        return SLANG_E_NOT_FOUND;
+    if (!S_ISREG(statVar.st_mode))
+        return SLANG_FAIL;
+    outSize = uint64_t(statVar.st_size);
+#    if SLANG_APPLE_FAMILY
+    const struct timespec& modificationTime = statVar.st_mtimespec;
+#    else
+    const struct timespec& modificationTime = statVar.st_mtim;
+#    endif
+    outModificationTime =
+        uint64_t(modificationTime.tv_sec) * 1000000000 + uint64_t(modificationTime.tv_nsec);
+#endif
+    return SLANG_OK;
+}
+
+namespace
+{ // anonymous
+
+// A blob holding a read only mapping of a file.
+class MappedFileBlob : public BlobBase
+{
+public:
+    // ISlangBlob
+    SLANG_NO_THROW void const* SLANG_MCALL getBufferPointer() SLANG_OVERRIDE { return m_data; }
+    SLANG_NO_THROW size_t SLANG_MCALL getBufferSize() SLANG_OVERRIDE { return m_dataSizeInBytes; }
+
+#ifdef _WIN32
+    MappedFileBlob(const void* data, size_t size, HANDLE mapping)
+        : m_data(data), m_dataSizeInBytes(size), m_mapping(mapping)
+    {
+    }
+    ~MappedFileBlob()
+    {
+        ::UnmapViewOfFile(m_data);
+        ::CloseHandle(m_mapping);
+    }
+#else
+    MappedFileBlob(const void* data, size_t size)
+        : m_data(data), m_dataSizeInBytes(size)
+    {
+    }
+    ~MappedFileBlob() { ::munmap(const_cast<void*>(m_data), m_dataSizeInBytes); }
+#endif
+
+protected:
+    const void* m_data;
+    size_t m_dataSizeInBytes;
+#ifdef _WIN32
+    HANDLE m_mapping;
+#endif
+};
+
+} // namespace
+
+/* static */ SlangResult File::map(const String& fileName, ComPtr<ISlangBlob>& outBlob)
+{
+#ifdef _WIN32
+    HANDLE file = ::CreateFileW(
+        fileName.toWString(),
+        GENERIC_READ,
+        // Delete access is shared so that `replace` can move the file out of the way.
+        FILE_SHARE_READ | FILE_SHARE_DELETE,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return SLANG_E_NOT_FOUND;
+
+    LARGE_INTEGER fileSize;
+    if (!::GetFileSizeEx(file, &fileSize))
+    {
+        ::CloseHandle(file);
+        return SLANG_FAIL;
+    }
+    const size_t size = size_t(fileSize.QuadPart);
+    if (size == 0)
+    {
+        // Empty files can't be mapped.
+        ::CloseHandle(file);
+        outBlob = RawBlob::create("", 0);
+        return SLANG_OK;
+    }
+
+    // The mapping keeps the file open, so the handle to the file isn't needed after this.
+    HANDLE mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    ::CloseHandle(file);
+    if (!mapping)
+        return SLANG_FAIL;
+
+    const void* data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!data)
+    {
+        ::CloseHandle(mapping);
+        return SLANG_FAIL;
+    }
+    outBlob = ComPtr<ISlangBlob>(new MappedFileBlob(data, size, mapping));
+    return SLANG_OK;
+#elif defined(__linux__) || defined(__CYGWIN__) || SLANG_APPLE_FAMILY
+    const int file = ::open(fileName.getBuffer(), O_RDONLY);
+    if (file < 0)
+        return SLANG_E_NOT_FOUND;
+
+    struct stat statVar;
+    if (::fstat(file, &statVar) != 0 || !S_ISREG(statVar.st_mode))
+    {
+        ::close(file);
+        return SLANG_FAIL;
+    }
+    const size_t size = size_t(statVar.st_size);
+    if (size == 0)
+    {
+        // Empty files can't be mapped.
+        ::close(file);
+        outBlob = RawBlob::create("", 0);
+        return SLANG_OK;
+    }
+
+    // The mapping holds its own reference to the file, so it can be closed straight away.
+    void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    ::close(file);
+    if (data == MAP_FAILED)
+        return SLANG_FAIL;
+
+    outBlob = ComPtr<ISlangBlob>(new MappedFileBlob(data, size));
+    return SLANG_OK;
+#else
+    ScopedAllocation contents;
+    SLANG_RETURN_ON_FAIL(readAllBytes(fileName, contents));
+    outBlob = RawBlob::moveCreate(contents);
+    return SLANG_OK;
+#endif
+}
 
 bool File::exists(const String& fileName)
 {
@@ -30,8 +30,27 @@ public:
 
     static SlangResult remove(const String& fileName);
 
+    /// Rename `fromFileName` to `toFileName`, replacing `toFileName` if it exists. Blobs that
+    /// `map` returned for the replaced file keep the old contents. Both names must be on the
+    /// same volume.
+    static SlangResult replace(const String& fromFileName, const String& toFileName);
+
     static SlangResult makeExecutable(const String& fileName);
 
+    /// Get the size in bytes of the file, and the time it was last modified, in nanoseconds
+    /// since the Unix epoch (only the seconds are available on some platforms).
+    static SlangResult getSizeAndModificationTime(
+        const String& fileName,
+        uint64_t& outSize,
+        uint64_t& outModificationTime);
+
+    /// Map the contents of the file into memory, read only, as a blob that keeps the mapping
+    /// alive. Pages are loaded as they are accessed and are shared with other processes that
+    /// map or read the same file. The file must not be modified or truncated while the blob is
+    /// alive, so use `replace` to update it. On platforms without support for mapping files the
+    /// contents are read instead.
+    static SlangResult map(const String& fileName, ComPtr<ISlangBlob>& outBlob);
+
     /// Creates a temporary file typically in some way based on the prefix
     /// The file will be *created* with the outFileName, on success.
     /// It's creation in necessary to lock that particular name.
@@ -1,88 +1,980 @@
 #include "slang-performance-profiler.h"
 
+#include "slang-blob.h"
 #include "slang-dictionary.h"
+#include "slang-math.h"
+#include "slang-string-escape-util.h"
+
+#include <atomic>
+#include <mutex>
 
 namespace Slang
 {
-class PerformanceProfilerImpl : public PerformanceProfiler
+
+void PassProfileInfo::addInvocation(const PassInvocationInfo& info)
+{
+    sizeChange += info.sizeChange;
+    minSizeChange = Math::Min(minSizeChange, info.sizeChange);
+    maxSizeChange = Math::Max(maxSizeChange, info.sizeChange);
+    allocatedBytes += info.allocatedBytes;
+    maxAllocatedBytes = Math::Max(maxAllocatedBytes, info.allocatedBytes);
+}
+
+namespace
+{ // anonymous
+
+typedef std::chrono::high_resolution_clock ProfileClock;
+
+static Int64 _getTimeNS(ProfileClock::time_point time)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+template<typename TKey, typename TValue>
+static TValue& _getOrAdd(OrderedDictionary<TKey, TValue>& dict, const TKey& key)
+{
+    auto value = dict.tryGetValue(key);
+    if (!value)
+    {
+        dict.add(key, TValue());
+        value = dict.tryGetValue(key);
+    }
+    return *value;
+}
+
+static void _addInfo(PassProfileInfo& ioInfo, const PassProfileInfo& info)
+{
+    ioInfo.invocationCount += info.invocationCount;
+    ioInfo.duration += info.duration;
+    ioInfo.sizeChange += info.sizeChange;
+    ioInfo.minSizeChange = Math::Min(ioInfo.minSizeChange, info.minSizeChange);
+    ioInfo.maxSizeChange = Math::Max(ioInfo.maxSizeChange, info.maxSizeChange);
+    ioInfo.allocatedBytes += info.allocatedBytes;
+    ioInfo.maxAllocatedBytes = Math::Max(ioInfo.maxAllocatedBytes, info.maxAllocatedBytes);
+}
+
+// The smallest and largest values are left alone, see `PassProfileInfo`.
+static void _subtractInfo(PassProfileInfo& ioInfo, const PassProfileInfo& info)
+{
+    ioInfo.invocationCount -= info.invocationCount;
+    ioInfo.duration -= info.duration;
+    ioInfo.sizeChange -= info.sizeChange;
+    ioInfo.allocatedBytes -= info.allocatedBytes;
+}
+
+/// A scope in the call tree of a thread. The same function entered from different
+/// parents has a scope for each of them.
+struct ProfileScope
+{
+    const char* name = nullptr;
+    bool isPass = false;
+    Index parent = -1;
+    List<Index> children;
+    /// The sizes and allocated bytes are only set for passes.
+    PassProfileInfo info;
+};
+
+/// A scope that was exited while tracing was enabled.
+struct ProfileTraceEvent
+{
+    const char* name;
+    bool isPass;
+    Int64 startTimeNS;
+    Int64 durationNS;
+};
+
+/// The value of a counter after it was changed while tracing was enabled.
+struct ProfileCounterSample
+{
+    const char* name;
+    Int64 timeNS;
+    Int64 value;
+};
+
+/// The results recorded by a thread. The totals of functions and passes are taken from the
+/// call tree when reported.
+struct ProfileResults
+{
+    /// The call tree, with the root at index 0.
+    List<ProfileScope> scopes;
+    OrderedDictionary<const char*, Int64> counters;
+
+    List<ProfileTraceEvent> traceEvents;
+    List<ProfileCounterSample> counterSamples;
+
+    ProfileResults() { scopes.add(ProfileScope()); }
+
+    bool isEmpty() const
+    {
+        return scopes.getCount() == 1 && counters.getCount() == 0 &&
+               traceEvents.getCount() == 0 && counterSamples.getCount() == 0;
+    }
+
+    void clear()
+    {
+        scopes.clear();
+        scopes.add(ProfileScope());
+        counters.clear();
+        clearTrace();
+    }
+
+    void clearTrace()
+    {
+        traceEvents.clear();
+        counterSamples.clear();
+    }
+
+    Index findChild(Index parentIndex, const char* name, bool isPass) const
+    {
+        for (auto childIndex : scopes[parentIndex].children)
+        {
+            const auto& child = scopes[childIndex];
+            if (child.name == name && child.isPass == isPass)
+                return childIndex;
+        }
+        return -1;
+    }
+
+    Index findOrAddChild(Index parentIndex, const char* name, bool isPass)
+    {
+        Index childIndex = findChild(parentIndex, name, isPass);
+        if (childIndex < 0)
+        {
+            childIndex = scopes.getCount();
+            ProfileScope scope;
+            scope.name = name;
+            scope.isPass = isPass;
+            scope.parent = parentIndex;
+            scopes.add(scope);
+            scopes[parentIndex].children.add(childIndex);
+        }
+        return childIndex;
+    }
+
+    /// Add the call tree and counters of `other`.
+    void addTotals(const ProfileResults& other)
+    {
+        _addScopes(0, other, 0);
+        for (const auto& counter : other.counters)
+        {
+            _getOrAdd(counters, counter.key) += counter.value;
+        }
+    }
+
+    void addTrace(const ProfileResults& other)
+    {
+        traceEvents.addRange(other.traceEvents);
+        counterSamples.addRange(other.counterSamples);
+    }
+
+    /// Remove the call tree and counters of `before`, which were recorded before these.
+    void subtractTotals(const ProfileResults& before)
+    {
+        _subtractScopes(0, before, 0);
+        for (const auto& counter : before.counters)
+        {
+            if (auto value = counters.tryGetValue(counter.key))
+                *value -= counter.value;
+        }
+    }
+
+    /// Remove the trace events and counter samples from before `timeNS`.
+    void removeTraceBefore(Int64 timeNS)
+    {
+        List<ProfileTraceEvent> events;
+        for (const auto& event : traceEvents)
+        {
+            if (event.startTimeNS >= timeNS)
+                events.add(event);
+        }
+        traceEvents = _Move(events);
+
+        List<ProfileCounterSample> samples;
+        for (const auto& sample : counterSamples)
+        {
+            if (sample.timeNS >= timeNS)
+                samples.add(sample);
+        }
+        counterSamples = _Move(samples);
+    }
+
+    /// Remove the trace events and counter samples from after `timeNS`.
+    void removeTraceAfter(Int64 timeNS)
+    {
+        List<ProfileTraceEvent> events;
+        for (const auto& event : traceEvents)
+        {
+            if (event.startTimeNS + event.durationNS <= timeNS)
+                events.add(event);
+        }
+        traceEvents = _Move(events);
+
+        List<ProfileCounterSample> samples;
+        for (const auto& sample : counterSamples)
+        {
+            if (sample.timeNS <= timeNS)
+                samples.add(sample);
+        }
+        counterSamples = _Move(samples);
+    }
+
+private:
+    void _addScopes(Index scopeIndex, const ProfileResults& other, Index otherIndex)
+    {
+        for (auto otherChildIndex : other.scopes[otherIndex].children)
+        {
+            const auto& otherChild = other.scopes[otherChildIndex];
+            Index childIndex = findOrAddChild(scopeIndex, otherChild.name, otherChild.isPass);
+            _addInfo(scopes[childIndex].info, otherChild.info);
+            _addScopes(childIndex, other, otherChildIndex);
+        }
+    }
+
+    void _subtractScopes(Index scopeIndex, const ProfileResults& before, Index beforeIndex)
+    {
+        for (auto beforeChildIndex : before.scopes[beforeIndex].children)
+        {
+            const auto& beforeChild = before.scopes[beforeChildIndex];
+            Index childIndex = findChild(scopeIndex, beforeChild.name, beforeChild.isPass);
+            if (childIndex < 0)
+                continue;
+            _subtractInfo(scopes[childIndex].info, beforeChild.info);
+            _subtractScopes(childIndex, before, beforeChildIndex);
+        }
+    }
+};
+
+/// The results of a thread that can be read from any thread, under `mutex`.
+///
+/// Only the owning thread adds to them, when its outermost scope exits, so that entering
+/// and exiting scopes does not need to lock.
+struct SharedThreadProfile
+{
+    std::mutex mutex;
+    Index threadIndex = 0;
+    /// Set when the thread has exited, after which the results are only kept until cleared.
+    bool hasExited = false;
+    ProfileResults results;
+};
+
+/// What a thread is recording. Only accessed by the thread itself.
+struct ThreadProfileData
+{
+    /// The results since the outermost scope was entered, which have not been added to the
+    /// shared results yet.
+    ProfileResults results;
+    Index currentScope = 0;
+    /// The number of scopes that are open, including those entered before the results
+    /// were cleared.
+    Index depth = 0;
+    /// The generation of the profiler's results that `results` belong to.
+    UInt generation = 0;
+    /// The totals of the counters, for the values written to the trace.
+    OrderedDictionary<const char*, Int64> counterTotals;
+
+    SharedThreadProfile* shared = nullptr;
+
+    ~ThreadProfileData();
+};
+
+static thread_local ThreadProfileData t_threadProfileData;
+
+/// The results of a thread, as reported.
+struct ThreadProfileResults
+{
+    Index threadIndex = 0;
+    ProfileResults results;
+};
+
+class ProfileSnapshotImpl : public ProfileSnapshot
 {
 public:
-    OrderedDictionary<const char*, FuncProfileInfo> data;
+    /// The generation of the profiler's results when the snapshot was taken.
+    UInt generation = 0;
+    Int64 timeNS = 0;
+    /// The call trees and counters of the threads. The trace events are not needed, since
+    /// they are told apart by time.
+    List<ThreadProfileResults> threads;
+};
 
-    virtual FuncProfileContext enterFunction(const char* funcName) override
+/// The results of all threads, combined by name.
+struct MergedProfileResults
+{
+    OrderedDictionary<UnownedStringSlice, FuncProfileInfo> funcs;
+    OrderedDictionary<UnownedStringSlice, PassProfileInfo> passes;
+    OrderedDictionary<UnownedStringSlice, Int64> counters;
+};
+
+class PerformanceProfilerImpl : public PerformanceProfiler
+{
+public:
+    ~PerformanceProfilerImpl()
     {
-        auto entry = data.tryGetValue(funcName);
-        if (!entry)
+        for (auto sharedData : m_threads)
         {
-            data.add(funcName, FuncProfileInfo());
-            entry = data.tryGetValue(funcName);
+            delete sharedData;
         }
-        entry->invocationCount++;
+    }
+
+    virtual FuncProfileContext enterFunction(const char* funcName) override
+    {
         FuncProfileContext ctx;
-        ctx.funcName = funcName;
-        ctx.startTime = std::chrono::high_resolution_clock::now();
+        _enterScope(funcName, false, ctx);
+        ctx.startTime = ProfileClock::now();
         return ctx;
     }
     virtual void exitFunction(FuncProfileContext ctx) override
     {
-        auto endTime = std::chrono::high_resolution_clock::now();
-        auto duration = endTime - ctx.startTime;
-        auto entry = data.tryGetValue(ctx.funcName);
-        entry->duration += duration;
+        auto duration = ProfileClock::now() - ctx.startTime;
+        _exitScope(ctx, duration, nullptr);
     }
-    virtual void getResult(StringBuilder& out) override
+    virtual FuncProfileContext enterPass(const char* passName) override
     {
+        FuncProfileContext ctx;
+        _enterScope(passName, true, ctx);
+        ctx.startTime = ProfileClock::now();
+        return ctx;
+    }
+    virtual void exitPass(FuncProfileContext ctx, const PassInvocationInfo& info) override
+    {
+        auto duration = ProfileClock::now() - ctx.startTime;
+        _exitScope(ctx, duration, &info);
+    }
+    virtual void addCounter(const char* counterName, Int64 value) override
+    {
+        auto& threadData = t_threadProfileData;
+        if (threadData.depth == 0)
+            _beginRecording(threadData);
+
+        _getOrAdd(threadData.results.counters, counterName) += value;
+        auto& total = _getOrAdd(threadData.counterTotals, counterName);
+        total += value;
+        if (isTracingEnabled())
+        {
+            ProfileCounterSample sample;
+            sample.name = counterName;
+            sample.timeNS = _getTimeNS(ProfileClock::now());
+            sample.value = total;
+            threadData.results.counterSamples.add(sample);
+        }
+
+        // Outside of any scope, the counter is added to the shared results right away.
+        if (threadData.depth == 0)
+            _flush(threadData);
+    }
+    virtual void beginPassProfiling() override
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_passProfilingCount++;
+    }
+    virtual void endPassProfiling() override
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_passProfilingCount > 0)
+            m_passProfilingCount--;
+    }
+    virtual bool isPassProfilingEnabled() override
+    {
+        return m_passProfilingCount.load(std::memory_order_relaxed) > 0;
+    }
+    virtual void beginTracing() override
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // The events of an earlier trace are only kept until the next one begins, so that
+        // they don't accumulate.
+        if (m_tracingCount == 0)
+        {
+            for (auto sharedData : m_threads)
+            {
+                std::lock_guard<std::mutex> threadLock(sharedData->mutex);
+                sharedData->results.clearTrace();
+            }
+        }
+        m_tracingCount++;
+    }
+    virtual void endTracing() override
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_tracingCount > 0)
+            m_tracingCount--;
+    }
+    virtual bool isTracingEnabled() override
+    {
+        return m_tracingCount.load(std::memory_order_relaxed) > 0;
+    }
+
+    virtual RefPtr<ProfileSnapshot> takeSnapshot() override
+    {
+        RefPtr<ProfileSnapshotImpl> snapshot = new ProfileSnapshotImpl();
+        snapshot->timeNS = _getTimeNS(ProfileClock::now());
+        snapshot->generation = _getThreadResults(snapshot->threads, false);
+        return snapshot;
+    }
+
+    virtual void getResult(StringBuilder& out, ProfileSnapshot* since) override
+    {
+        List<ThreadProfileResults> threads;
+        _getReportedResults(threads, since, false);
+
+        MergedProfileResults results;
+        _mergeResults(threads, results);
+
         char buffer[512];
-        for (const auto& func : data)
+        for (const auto& func : results.funcs)
         {
             memset(buffer, 0, sizeof(buffer));
-            snprintf(buffer, sizeof(buffer), "[*] %30s", func.key);
+            snprintf(buffer, sizeof(buffer), "[*] %30s", String(func.key).getBuffer());
             out << buffer << " \t";
             auto milliseconds =
                 std::chrono::duration_cast<std::chrono::milliseconds>(func.value.duration);
             out << func.value.invocationCount << " \t"
                 << static_cast<uint64_t>(milliseconds.count()) << "ms\n";
         }
+        // The remaining sections don't start lines with `[*]`, so that tools reading the
+        // function timings above can tell them apart.
+
+        if (results.passes.getCount())
+        {
+            out << "\nPasses (invocations, time, change in instructions total [min, max], "
+                   "bytes allocated total [max]):\n";
+            for (const auto& pass : results.passes)
+            {
+                memset(buffer, 0, sizeof(buffer));
+                snprintf(buffer, sizeof(buffer), "    %30s", String(pass.key).getBuffer());
+                out << buffer << " \t";
+                auto milliseconds =
+                    std::chrono::duration_cast<std::chrono::milliseconds>(pass.value.duration);
+                out << pass.value.invocationCount << " \t"
+                    << static_cast<uint64_t>(milliseconds.count()) << "ms \t"
+                    << pass.value.sizeChange << " [" << pass.value.minSizeChange << ", "
+                    << pass.value.maxSizeChange << "] \t" << pass.value.allocatedBytes << " ["
+                    << pass.value.maxAllocatedBytes << "] bytes\n";
+            }
+        }
+
+        if (results.counters.getCount())
+        {
+            out << "\nCounters:\n";
+            for (const auto& counter : results.counters)
+            {
+                memset(buffer, 0, sizeof(buffer));
+                snprintf(buffer, sizeof(buffer), "    %30s", String(counter.key).getBuffer());
+                out << buffer << " \t" << counter.value << "\n";
+            }
+        }
+
+        for (const auto& thread : threads)
+        {
+            if (!_hasInvocations(thread.results.scopes, 0))
+                continue;
+
+            out << "\nCall tree of thread " << thread.threadIndex
+                << " (invocations, time, time excluding children):\n";
+            for (auto childIndex : thread.results.scopes[0].children)
+            {
+                _appendScope(thread.results.scopes, childIndex, 1, out);
+            }
+        }
+    }
+    virtual void getTraceResult(StringBuilder& out, ProfileSnapshot* since) override
+    {
+        getTraceResult(out, since, INT64_MAX);
+    }
+
+    /// Write the trace events recorded after `since` and until `untilTimeNS`.
+    void getTraceResult(StringBuilder& out, ProfileSnapshot* since, Int64 untilTimeNS)
+    {
+        auto jsonHandler = StringEscapeUtil::getHandler(StringEscapeUtil::Style::JSON);
+
+        List<ThreadProfileResults> threads;
+        _getReportedResults(threads, since, true);
+        if (untilTimeNS != INT64_MAX)
+        {
+            for (auto& thread : threads)
+                thread.results.removeTraceAfter(untilTimeNS);
+        }
+
+        // Times are written in microseconds, relative to the first event.
+        Int64 baseTimeNS = 0;
+        bool hasBaseTime = false;
+        for (const auto& thread : threads)
+        {
+            for (const auto& event : thread.results.traceEvents)
+            {
+                if (!hasBaseTime || event.startTimeNS < baseTimeNS)
+                    baseTimeNS = event.startTimeNS;
+                hasBaseTime = true;
+            }
+            for (const auto& sample : thread.results.counterSamples)
+            {
+                if (!hasBaseTime || sample.timeNS < baseTimeNS)
+                    baseTimeNS = sample.timeNS;
+                hasBaseTime = true;
+            }
+        }
+
+        char buffer[64];
+        auto appendTime = [&](Int64 timeNS)
+        {
+            snprintf(buffer, sizeof(buffer), "%.3f", double(timeNS) / 1000.0);
+            out << buffer;
+        };
+
+        out << "{\"traceEvents\":[";
+        bool isFirst = true;
+        auto beginEvent = [&]()
+        {
+            out << (isFirst ? "\n" : ",\n");
+            isFirst = false;
+        };
+
+        for (const auto& thread : threads)
+        {
+            if (thread.results.traceEvents.getCount() == 0 &&
+                thread.results.counterSamples.getCount() == 0)
+                continue;
+
+            const Index tid = thread.threadIndex;
+
+            beginEvent();
+            out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid
+                << ",\"args\":{\"name\":\"Thread " << tid << "\"}}";
+
+            for (const auto& event : thread.results.traceEvents)
+            {
+                beginEvent();
+                out << "{\"name\":";
+                StringEscapeUtil::appendQuoted(
+                    jsonHandler,
+                    UnownedStringSlice(event.name),
+                    out);
+                out << ",\"cat\":\"" << (event.isPass ? "pass" : "function")
+                    << "\",\"ph\":\"X\",\"ts\":";
+                appendTime(event.startTimeNS - baseTimeNS);
+                out << ",\"dur\":";
+                appendTime(event.durationNS);
+                out << ",\"pid\":1,\"tid\":" << tid << "}";
+            }
+
+            for (const auto& sample : thread.results.counterSamples)
+            {
+                beginEvent();
+                out << "{\"name\":";
+                StringEscapeUtil::appendQuoted(
+                    jsonHandler,
+                    UnownedStringSlice(sample.name),
+                    out);
+                out << ",\"ph\":\"C\",\"ts\":";
+                appendTime(sample.timeNS - baseTimeNS);
+                out << ",\"pid\":1,\"tid\":" << tid << ",\"id\":" << tid
+                    << ",\"args\":{\"value\":" << sample.value << "}}";
+            }
+        }
+        out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    }
+    virtual void clear() override
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // Other threads find out that their buffers are out of date when they next add them
+        // to their shared results.
+        m_generation++;
+        _removeExitedThreads();
+        for (auto sharedData : m_threads)
+        {
+            std::lock_guard<std::mutex> threadLock(sharedData->mutex);
+            sharedData->results.clear();
+        }
+        _resetCurrentThread();
+    }
+    virtual void dispose() override
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_generation++;
+        _removeExitedThreads();
+        for (auto sharedData : m_threads)
+        {
+            std::lock_guard<std::mutex> threadLock(sharedData->mutex);
+            sharedData->results = ProfileResults();
+        }
+        _resetCurrentThread();
+        auto& threadData = t_threadProfileData;
+        threadData.results = ProfileResults();
+        threadData.counterTotals = OrderedDictionary<const char*, Int64>();
+    }
+
+    /// Combine the results of all threads, recorded since `since` if it is set.
+    void getMergedResults(MergedProfileResults& outResults, ProfileSnapshot* since = nullptr)
+    {
+        List<ThreadProfileResults> threads;
+        _getReportedResults(threads, since, false);
+        _mergeResults(threads, outResults);
+    }
+
+    /// Called when a thread that has recorded results exits.
+    void onThreadExit(ThreadProfileData& threadData)
+    {
+        _flush(threadData);
+        std::lock_guard<std::mutex> threadLock(threadData.shared->mutex);
+        threadData.shared->hasExited = true;
+    }
+
+private:
+    void _enterScope(const char* name, bool isPass, FuncProfileContext& ioContext)
+    {
+        auto& threadData = t_threadProfileData;
+        if (threadData.depth == 0)
+            _beginRecording(threadData);
+        threadData.depth++;
+
+        auto& results = threadData.results;
+        Index scopeIndex = results.findOrAddChild(threadData.currentScope, name, isPass);
+        results.scopes[scopeIndex].info.invocationCount++;
+        threadData.currentScope = scopeIndex;
+
+        ioContext.funcName = name;
+        ioContext.scopeIndex = scopeIndex;
+        ioContext.generation = threadData.generation;
+    }
+
+    void _exitScope(
+        const FuncProfileContext& context,
+        std::chrono::nanoseconds duration,
+        const PassInvocationInfo* passInfo)
+    {
+        auto& threadData = t_threadProfileData;
+        if (threadData.depth == 0)
+            return;
+        threadData.depth--;
+
+        // Scopes entered before the results were cleared are not reported.
+        if (context.generation == threadData.generation && context.scopeIndex > 0)
+        {
+            auto& scope = threadData.results.scopes[context.scopeIndex];
+            scope.info.duration += duration;
+            if (passInfo)
+                scope.info.addInvocation(*passInfo);
+            threadData.currentScope = scope.parent;
+
+            if (isTracingEnabled())
+            {
+                ProfileTraceEvent event;
+                event.name = context.funcName;
+                event.isPass = passInfo != nullptr;
+                event.startTimeNS = _getTimeNS(context.startTime);
+                event.durationNS = duration.count();
+                threadData.results.traceEvents.add(event);
+            }
+        }
+
+        if (threadData.depth == 0)
+            _flush(threadData);
+    }
+
+    /// Called before the thread enters its outermost scope.
+    void _beginRecording(ThreadProfileData& threadData)
+    {
+        if (!threadData.shared)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto sharedData = new SharedThreadProfile();
+            sharedData->threadIndex = m_nextThreadIndex++;
+            m_threads.add(sharedData);
+            threadData.shared = sharedData;
+            threadData.generation = m_generation;
+        }
+
+        auto generation = m_generation.load(std::memory_order_relaxed);
+        if (threadData.generation != generation)
+        {
+            threadData.results.clear();
+            threadData.counterTotals.clear();
+            threadData.currentScope = 0;
+            threadData.generation = generation;
+        }
+    }
+
+    /// Add the buffer of a thread to its shared results, once its outermost scope has
+    /// exited.
+    void _flush(ThreadProfileData& threadData)
+    {
+        if (threadData.shared && !threadData.results.isEmpty())
+        {
+            std::lock_guard<std::mutex> threadLock(threadData.shared->mutex);
+            // The results are dropped if they were cleared while the thread was recording.
+            // The generation is checked under the lock, so the results cannot be added after
+            // `clear` has cleared the shared results.
+            if (threadData.generation == m_generation)
+            {
+                threadData.shared->results.addTotals(threadData.results);
+                threadData.shared->results.addTrace(threadData.results);
+            }
+        }
+        threadData.results.clear();
+        threadData.currentScope = 0;
+    }
+
+    /// Clear the buffer of the current thread. Must be called with `m_mutex` held.
+    void _resetCurrentThread()
+    {
+        auto& threadData = t_threadProfileData;
+        threadData.results.clear();
+        threadData.counterTotals.clear();
+        threadData.currentScope = 0;
+        threadData.generation = m_generation;
+    }
+
+    /// Copy the shared results of all threads, along with the buffer of the current thread,
+    /// which is the only one that can be read without waiting for its scopes to exit.
+    /// Returns the generation of the results.
+    UInt _getThreadResults(List<ThreadProfileResults>& outThreads, bool includeTrace)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const UInt generation = m_generation;
+
+        auto& currentThreadData = t_threadProfileData;
+        for (auto sharedData : m_threads)
+        {
+            ThreadProfileResults thread;
+            thread.threadIndex = sharedData->threadIndex;
+            {
+                std::lock_guard<std::mutex> threadLock(sharedData->mutex);
+                thread.results.addTotals(sharedData->results);
+                if (includeTrace)
+                    thread.results.addTrace(sharedData->results);
+            }
+            if (sharedData == currentThreadData.shared &&
+                currentThreadData.generation == generation)
+            {
+                thread.results.addTotals(currentThreadData.results);
+                if (includeTrace)
+                    thread.results.addTrace(currentThreadData.results);
+            }
+            outThreads.add(_Move(thread));
+        }
+        return generation;
+    }
+
+    /// Get the results of all threads to report, recorded since `since` if it is set.
+    void _getReportedResults(
+        List<ThreadProfileResults>& outThreads,
+        ProfileSnapshot* since,
+        bool includeTrace)
+    {
+        const UInt generation = _getThreadResults(outThreads, includeTrace);
+
+        // If the results have been cleared since the snapshot, all of them are reported.
+        auto snapshot = static_cast<ProfileSnapshotImpl*>(since);
+        if (!snapshot || snapshot->generation != generation)
+            return;
+
+        for (auto& thread : outThreads)
+        {
+            for (const auto& before : snapshot->threads)
+            {
+                if (before.threadIndex == thread.threadIndex)
+                    thread.results.subtractTotals(before.results);
+            }
+            if (includeTrace)
+                thread.results.removeTraceBefore(snapshot->timeNS);
+        }
+    }
+
+    static void _mergeResults(
+        const List<ThreadProfileResults>& threads,
+        MergedProfileResults& outResults)
+    {
+        for (const auto& thread : threads)
+        {
+            _mergeScopes(thread.results, 0, outResults);
+            for (const auto& counter : thread.results.counters)
+            {
+                if (counter.value != 0)
+                    _getOrAdd(outResults.counters, UnownedStringSlice(counter.key)) +=
+                        counter.value;
+            }
+        }
+    }
+
+    static void _mergeScopes(
+        const ProfileResults& results,
+        Index scopeIndex,
+        MergedProfileResults& outResults)
+    {
+        for (auto childIndex : results.scopes[scopeIndex].children)
+        {
+            const auto& scope = results.scopes[childIndex];
+            if (scope.info.invocationCount != 0)
+            {
+                if (scope.isPass)
+                {
+                    _addInfo(
+                        _getOrAdd(outResults.passes, UnownedStringSlice(scope.name)),
+                        scope.info);
+                }
+                else
+                {
+                    auto& entry = _getOrAdd(outResults.funcs, UnownedStringSlice(scope.name));
+                    entry.invocationCount += scope.info.invocationCount;
+                    entry.duration += scope.info.duration;
+                }
+            }
+            _mergeScopes(results, childIndex, outResults);
+        }
+    }
+
+    /// Must be called with `m_mutex` held.
+    void _removeExitedThreads()
+    {
+        for (Index i = 0; i < m_threads.getCount();)
+        {
+            bool hasExited;
+            {
+                std::lock_guard<std::mutex> threadLock(m_threads[i]->mutex);
+                hasExited = m_threads[i]->hasExited;
+            }
+            if (hasExited)
+            {
+                delete m_threads[i];
+                m_threads.removeAt(i);
+            }
+            else
+            {
+                i++;
+            }
+        }
     }
-    virtual void clear() override { data.clear(); }
-    virtual void dispose() override { data = decltype(data)(); }
+
+    static bool _hasInvocations(const List<ProfileScope>& scopes, Index scopeIndex)
+    {
+        for (auto childIndex : scopes[scopeIndex].children)
+        {
+            if (scopes[childIndex].info.invocationCount != 0 ||
+                _hasInvocations(scopes, childIndex))
+                return true;
+        }
+        return false;
+    }
+
+    static void _appendScope(
+        const List<ProfileScope>& scopes,
+        Index scopeIndex,
+        Index depth,
+        StringBuilder& out)
+    {
+        const auto& scope = scopes[scopeIndex];
+
+        // Scopes that were only run before a snapshot are left out.
+        if (scope.info.invocationCount == 0 && !_hasInvocations(scopes, scopeIndex))
+            return;
+
+        auto childDuration = std::chrono::nanoseconds::zero();
+        for (auto childIndex : scope.children)
+        {
+            childDuration += scopes[childIndex].info.duration;
+        }
+
+        for (Index i = 0; i < depth; ++i)
+        {
+            out << "  ";
+        }
+        if (scope.isPass)
+        {
+            out << "pass:";
+        }
+        auto milliseconds =
+            std::chrono::duration_cast<std::chrono::milliseconds>(scope.info.duration);
+        auto selfMilliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
+            scope.info.duration - childDuration);
+        out << scope.name << " \t" << scope.info.invocationCount << " \t"
+            << static_cast<uint64_t>(milliseconds.count()) << "ms \t"
+            << static_cast<uint64_t>(selfMilliseconds.count()) << "ms\n";
+
+        for (auto childIndex : scope.children)
+        {
+            _appendScope(scopes, childIndex, depth + 1, out);
+        }
+    }
+
+    /// Guards the list of threads. When both are held, it is taken before the
+    /// mutex of a thread.
+    std::mutex m_mutex;
+    /// Owned by the profiler, and only deleted once the thread has exited.
+    List<SharedThreadProfile*> m_threads;
+    Index m_nextThreadIndex = 0;
+
+    /// Incremented whenever the results are cleared.
+    std::atomic<UInt> m_generation = 0;
+    /// The number of callers that have begun tracing and not ended it.
+    std::atomic<Index> m_tracingCount = 0;
+    /// The number of callers that have begun profiling passes and not ended it.
+    std::atomic<Index> m_passProfilingCount = 0;
 };
 
+ThreadProfileData::~ThreadProfileData()
+{
+    if (shared)
+    {
+        static_cast<PerformanceProfilerImpl*>(PerformanceProfiler::getProfiler())
+            ->onThreadExit(*this);
+    }
+}
+
+} // namespace
+
 PerformanceProfiler* Slang::PerformanceProfiler::getProfiler()
 {
-    thread_local static PerformanceProfilerImpl profiler = PerformanceProfilerImpl();
+    static PerformanceProfilerImpl profiler;
     return &profiler;
 }
 
-SlangProfiler::SlangProfiler(PerformanceProfiler* profiler)
+SlangProfiler::SlangProfiler(PerformanceProfiler* profiler, ProfileSnapshot* since)
+    : m_profiler(profiler), m_since(since), m_timeNS(_getTimeNS(ProfileClock::now()))
 {
     PerformanceProfilerImpl* profilerImpl = static_cast<PerformanceProfilerImpl*>(profiler);
-    size_t entryCount = profilerImpl->data.getCount();
 
-    m_profilEntries.reserve(entryCount);
+    MergedProfileResults results;
+    profilerImpl->getMergedResults(results, since);
 
-    int index = 0;
-    for (auto func : profilerImpl->data)
-    {
-        ProfileInfo profileEntry{};
-        size_t strSize = std::min(sizeof(profileEntry.funcName) - 1, strlen(func.key));
+    m_profilEntries.reserve(results.funcs.getCount() + results.passes.getCount());
 
-        if (strSize > 0)
-        {
-            memcpy(profileEntry.funcName, func.key, strSize);
-        }
+    for (const auto& func : results.funcs)
+    {
+        ProfileInfo profileEntry;
+        profileEntry.funcName = func.key;
         profileEntry.invocationCount = func.value.invocationCount;
         profileEntry.duration = func.value.duration;
 
-        m_profilEntries.insert(index, profileEntry);
-        index++;
+        m_profilEntries.add(profileEntry);
+    }
+
+    // Passes are reported after the functions, with a prefix to tell them apart
+    // from functions of the same name.
+    for (const auto& pass : results.passes)
+    {
+        ProfileInfo profileEntry;
+        profileEntry.funcName = String("pass:") + pass.key;
+        profileEntry.invocationCount = pass.value.invocationCount;
+        profileEntry.duration = pass.value.duration;
+
+        m_profilEntries.add(profileEntry);
+    }
+
+    m_counters.reserve(results.counters.getCount());
+    for (const auto& counter : results.counters)
+    {
+        CounterInfo counterInfo;
+        counterInfo.name = counter.key;
+        counterInfo.value = counter.value;
+
+        m_counters.add(counterInfo);
     }
 }
 
 ISlangUnknown* SlangProfiler::getInterface(const Guid& guid)
 {
-    if (guid == SlangProfiler::getTypeGuid())
-        return static_cast<ISlangUnknown*>(this);
+    if (guid == ISlangUnknown::getTypeGuid() || guid == ISlangProfiler::getTypeGuid() ||
+        guid == ISlangProfiler2::getTypeGuid())
+        return static_cast<ISlangProfiler2*>(this);
     else
         return nullptr;
 }
@@ -97,7 +989,7 @@ const char* SlangProfiler::getEntryName(uint32_t index)
     if (index >= (uint32_t)m_profilEntries.getCount())
         return nullptr;
 
-    return m_profilEntries[index].funcName;
+    return m_profilEntries[index].funcName.getBuffer();
 }
 
 long SlangProfiler::getEntryTimeMS(uint32_t index)
@@ -117,4 +1009,44 @@ uint32_t SlangProfiler::getEntryInvocationTimes(uint32_t index)
 
     return m_profilEntries[index].invocationCount;
 }
+
+size_t SlangProfiler::getCounterCount()
+{
+    return m_counters.getCount();
+}
+
+const char* SlangProfiler::getCounterName(uint32_t index)
+{
+    if (index >= (uint32_t)m_counters.getCount())
+        return nullptr;
+
+    return m_counters[index].name.getBuffer();
+}
+
+int64_t SlangProfiler::getCounterValue(uint32_t index)
+{
+    if (index >= (uint32_t)m_counters.getCount())
+        return 0;
+
+    return m_counters[index].value;
+}
+
+SlangResult SlangProfiler::getTraceJSON(ISlangBlob** outTrace)
+{
+    if (!outTrace)
+        return SLANG_E_INVALID_ARG;
+
+    // The trace can be large, so it is only written when asked for, with the events that
+    // were recorded up to when the profile was taken.
+    if (!m_hasTrace)
+    {
+        StringBuilder trace;
+        static_cast<PerformanceProfilerImpl*>(m_profiler)->getTraceResult(trace, m_since, m_timeNS);
+        m_trace = trace.produceString();
+        m_hasTrace = true;
+    }
+
+    *outTrace = StringBlob::create(m_trace).detach();
+    return SLANG_OK;
+}
 } // namespace Slang
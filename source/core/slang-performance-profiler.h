@@ -3,6 +3,7 @@
 
 #include "../core/slang-list.h"
 #include "slang-com-helper.h"
+#include "slang-smart-pointer.h"
 #include "slang-string.h"
 
 #include <chrono>
@@ -17,22 +18,121 @@ struct FuncProfileInfo
     std::chrono::nanoseconds duration = std::chrono::nanoseconds::zero();
 };
 
+/// Statistics about a single run of a compiler pass.
+struct PassInvocationInfo
+{
+    /// How much the size of the code (e.g. number of IR instructions) changed
+    Int64 sizeChange = 0;
+    /// The number of bytes allocated for code while the pass ran
+    UInt64 allocatedBytes = 0;
+};
+
+/// Statistics about the runs of a compiler pass, over all its invocations.
+///
+/// The totals are those of the invocations since the results were cleared, or since a
+/// snapshot. The smallest and largest values are always over the invocations since the
+/// results were cleared, as they can't be taken back to a snapshot.
+struct PassProfileInfo
+{
+    int invocationCount = 0;
+    std::chrono::nanoseconds duration = std::chrono::nanoseconds::zero();
+    /// The total change in the size of the code
+    Int64 sizeChange = 0;
+    /// The smallest and the largest change in the size of the code made by an invocation
+    Int64 minSizeChange = INT64_MAX;
+    Int64 maxSizeChange = INT64_MIN;
+    /// The total number of bytes allocated for code
+    UInt64 allocatedBytes = 0;
+    /// The largest number of bytes allocated for code by an invocation
+    UInt64 maxAllocatedBytes = 0;
+
+    void addInvocation(const PassInvocationInfo& info);
+};
+
 struct FuncProfileContext
 {
     const char* funcName = nullptr;
     std::chrono::time_point<std::chrono::high_resolution_clock> startTime;
+    /// The scope in the call tree of the thread that was entered, or -1 if none was.
+    Index scopeIndex = -1;
+    /// The generation of the thread's results when the scope was entered. If the results
+    /// have been cleared since, exiting the scope has no effect.
+    UInt generation = 0;
+};
+
+/// The results a profiler had recorded at some point, so that what was recorded since can
+/// be reported.
+class ProfileSnapshot : public RefObject
+{
 };
 
+/// Collects timings of functions, sections and passes of the compiler.
+///
+/// Each thread records into its own buffer without locking, so scopes can be entered on any
+/// thread. When the outermost scope of a thread exits, its buffer is added to the results of
+/// the thread, which can be read from any thread. The results of a scope are therefore only
+/// reported once the outermost scope around it has exited, except on the thread that reports
+/// them. Results are combined over all threads when reported.
+///
+/// Scopes nest, and the profiler keeps a call tree per thread with the time spent in each
+/// scope and its children.
+///
+/// If tracing is enabled, every exited scope is also recorded as an event, so the results
+/// can be written in the Chrome trace event format (as used by `chrome://tracing` and
+/// Perfetto).
+///
+/// There is a single profiler for all threads, so compiles that run at the same time should
+/// take a snapshot when they start and report what was recorded since, rather than clearing
+/// the results.
+///
+/// Names are identified by their pointer while profiling, so must outlive the profiler,
+/// and are typically string literals or `__func__`.
 class PerformanceProfiler
 {
 public:
     virtual FuncProfileContext enterFunction(const char* funcName) = 0;
     virtual void exitFunction(FuncProfileContext context) = 0;
-    virtual void getResult(StringBuilder& out) = 0;
+
+    /// Enter a run of the pass named `passName`. The pass is timed like a function, but
+    /// reported separately, along with the statistics given to `exitPass`.
+    virtual FuncProfileContext enterPass(const char* passName) = 0;
+    /// Exit a run of a pass, with statistics about the run.
+    virtual void exitPass(FuncProfileContext context, const PassInvocationInfo& info) = 0;
+
+    /// Add `value` to the counter named `counterName`.
+    virtual void addCounter(const char* counterName, Int64 value) = 0;
+
+    /// Enable recording of the passes run with `enterPass` until the matching
+    /// `endPassProfiling`. Passes are only recorded while any caller has begun it, since
+    /// gathering their statistics costs more than timing a function.
+    virtual void beginPassProfiling() = 0;
+    virtual void endPassProfiling() = 0;
+    virtual bool isPassProfilingEnabled() = 0;
+
+    /// Enable recording of trace events until the matching `endTracing`. Tracing is enabled
+    /// while any caller has begun it. The events of an earlier trace are discarded when
+    /// tracing is enabled again.
+    virtual void beginTracing() = 0;
+    virtual void endTracing() = 0;
+    virtual bool isTracingEnabled() = 0;
+
+    /// Take a snapshot of the results recorded so far.
+    virtual RefPtr<ProfileSnapshot> takeSnapshot() = 0;
+
+    /// Write the results. If `since` is set, only what was recorded after it was taken is
+    /// written, unless the results have been cleared since.
+    virtual void getResult(StringBuilder& out, ProfileSnapshot* since = nullptr) = 0;
+    /// Write the trace events and counters recorded as a JSON document in the
+    /// Chrome trace event format. If `since` is set, only the events after it was taken are
+    /// written.
+    virtual void getTraceResult(StringBuilder& out, ProfileSnapshot* since = nullptr) = 0;
+    /// Clear the results of all threads. Scopes that are open on other threads are not
+    /// reported.
     virtual void clear() = 0;
     virtual void dispose() = 0;
 
 public:
+    /// Get the profiler shared by all threads.
     static PerformanceProfiler* getProfiler();
 };
 
@@ -49,30 +149,52 @@ struct PerformanceProfilerFuncRAIIContext
     }
 };
 
-struct SlangProfiler : public ISlangProfiler, public RefObject
+struct SlangProfiler : public ISlangProfiler2, public RefObject
 {
 public:
     SLANG_REF_OBJECT_IUNKNOWN_ALL
     struct ProfileInfo
     {
-        char funcName[256] = {0};
+        String funcName;
         int invocationCount = 0;
         std::chrono::nanoseconds duration = std::chrono::nanoseconds::zero();
     };
-    SlangProfiler(PerformanceProfiler* profiler);
+    struct CounterInfo
+    {
+        String name;
+        Int64 value = 0;
+    };
+    /// Take the results of `profiler`, recorded since `since` if it is set.
+    SlangProfiler(PerformanceProfiler* profiler, ProfileSnapshot* since = nullptr);
     ISlangUnknown* getInterface(const Guid& guid);
 
     virtual SLANG_NO_THROW size_t SLANG_MCALL getEntryCount() override;
     virtual SLANG_NO_THROW const char* SLANG_MCALL getEntryName(uint32_t index) override;
     virtual SLANG_NO_THROW long SLANG_MCALL getEntryTimeMS(uint32_t index) override;
     virtual SLANG_NO_THROW uint32_t SLANG_MCALL getEntryInvocationTimes(uint32_t index) override;
+    virtual SLANG_NO_THROW size_t SLANG_MCALL getCounterCount() override;
+    virtual SLANG_NO_THROW const char* SLANG_MCALL getCounterName(uint32_t index) override;
+    virtual SLANG_NO_THROW int64_t SLANG_MCALL getCounterValue(uint32_t index) override;
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL getTraceJSON(ISlangBlob** outTrace) override;
 
 private:
     List<ProfileInfo> m_profilEntries;
+    List<CounterInfo> m_counters;
+
+    /// Used to write the trace when it is first asked for.
+    PerformanceProfiler* m_profiler = nullptr;
+    RefPtr<ProfileSnapshot> m_since;
+    /// When the results were taken.
+    Int64 m_timeNS = 0;
+
+    bool m_hasTrace = false;
+    String m_trace;
 };
 
 #define SLANG_PROFILE PerformanceProfilerFuncRAIIContext _profileContext(__func__)
 #define SLANG_PROFILE_SECTION(s) PerformanceProfilerFuncRAIIContext _profileContext##s(#s)
+#define SLANG_PROFILE_COUNTER(name, value) \
+    PerformanceProfiler::getProfiler()->addCounter(#name, Int64(value))
 
 } // namespace Slang
 
@@ -5,9 +5,427 @@
 #include "../core/slang-stream.h"
 #include "../core/slang-string-util.h"
 
+#include <chrono>
+
 namespace Slang
 {
 
+// The index file consists of a header followed by an open-addressing hash table
+// of `slotCount` fixed size slots. Slots are located by the key hash and linear
+// probing, so a lookup reads the header and a handful of slots, independent of the
+// number of entries in the cache.
+//
+// The occupied slots are also linked into a doubly linked list ordered by when the
+// entries were last used, so eviction takes the least recently used entry from the head
+// of the list. Readers only update `lastUsed` in place, so a slot can be used more
+// recently than its place in the list says. Eviction moves such slots to their correct
+// place in the list when it meets them at the head.
+
+struct CacheIndexHeader
+{
+    char magic[4];
+    uint32_t version;
+    // Number of slots in the table (always a power of two).
+    uint32_t slotCount;
+    // Number of occupied slots.
+    uint32_t entryCount;
+    // Number of occupied or removed slots. Used to decide when to rebuild the table.
+    uint32_t usedSlotCount;
+    // First (least recently used) and last slot of the eviction order list, or kNoSlot.
+    uint32_t lruHead;
+    uint32_t lruTail;
+    uint32_t reserved;
+    // Largest LRU clock value written by a writer.
+    uint64_t clock;
+};
+
+enum class CacheSlotState : uint32_t
+{
+    Empty,
+    Occupied,
+    Removed,
+};
+
+struct CacheIndexSlot
+{
+    PersistentCache::Key key;
+    CacheSlotState state;
+    // LRU clock value of the last access to the entry.
+    uint64_t lastUsed;
+    // LRU clock value the eviction order list is sorted by. Never larger than `lastUsed`.
+    uint64_t lruClock;
+    // Previous and next slot in the eviction order list, or kNoSlot.
+    uint32_t lruPrev;
+    uint32_t lruNext;
+};
+
+static_assert(sizeof(CacheIndexHeader) == 40, "Unexpected index header size");
+static_assert(sizeof(CacheIndexSlot) == 48, "Unexpected index slot size");
+
+static const char* kMagic = "SLS$";
+static const uint32_t kVersion = 3;
+
+static const uint32_t kNoSlot = 0xffffffff;
+
+static const uint32_t kInitialSlotCount = 64;
+// Number of slots read at once while probing.
+static const uint32_t kProbeSlotCount = 8;
+
+static Int64 _getSlotOffset(Index slotIndex)
+{
+    return Int64(sizeof(CacheIndexHeader)) + Int64(slotIndex) * Int64(sizeof(CacheIndexSlot));
+}
+
+static Index _getHomeSlotIndex(const CacheIndexHeader& header, const PersistentCache::Key& key)
+{
+    return Index(key.getHashCode() & (header.slotCount - 1));
+}
+
+static void _initHeader(CacheIndexHeader& header, uint32_t slotCount)
+{
+    ::memset(&header, 0, sizeof(header));
+    ::memcpy(header.magic, kMagic, 4);
+    header.version = kVersion;
+    header.slotCount = slotCount;
+    header.lruHead = kNoSlot;
+    header.lruTail = kNoSlot;
+}
+
+/// Open the index file and validate its header.
+/// Returns SLANG_E_NOT_FOUND if the index does not exist and SLANG_E_INTERNAL_FAIL if
+/// the index is corrupt.
+static SlangResult _openIndex(const String& fileName, FileStream& fs, CacheIndexHeader& outHeader)
+{
+    if (!File::exists(fileName))
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+
+    SLANG_RETURN_ON_FAIL(
+        fs.init(fileName, FileMode::Open, FileAccess::ReadWrite, FileShare::ReadWrite));
+
+    // Get file size.
+    SLANG_RETURN_ON_FAIL(fs.seek(SeekOrigin::End, 0));
+    uint64_t fileSize = (uint64_t)fs.getPosition();
+    SLANG_RETURN_ON_FAIL(fs.seek(SeekOrigin::Start, 0));
+
+    if (fileSize < sizeof(outHeader) ||
+        SLANG_FAILED(fs.readExactly(&outHeader, sizeof(outHeader))))
+    {
+        return SLANG_E_INTERNAL_FAIL;
+    }
+    if (::memcmp(outHeader.magic, kMagic, 4) != 0 || outHeader.version != kVersion)
+    {
+        return SLANG_E_INTERNAL_FAIL;
+    }
+
+    // The table size must be a power of two, and the table must never be full,
+    // otherwise probing would not terminate.
+    const uint32_t slotCount = outHeader.slotCount;
+    if (slotCount == 0 || (slotCount & (slotCount - 1)) != 0 ||
+        outHeader.usedSlotCount >= slotCount || outHeader.entryCount > outHeader.usedSlotCount)
+    {
+        return SLANG_E_INTERNAL_FAIL;
+    }
+
+    // The eviction order list is empty exactly if there are no entries.
+    const bool hasEntries = outHeader.entryCount != 0;
+    if ((outHeader.lruHead != kNoSlot) != hasEntries ||
+        (outHeader.lruTail != kNoSlot) != hasEntries ||
+        (hasEntries && (outHeader.lruHead >= slotCount || outHeader.lruTail >= slotCount)))
+    {
+        return SLANG_E_INTERNAL_FAIL;
+    }
+
+    // Return if payload does not have the right size.
+    if (uint64_t(slotCount) * sizeof(CacheIndexSlot) != fileSize - sizeof(outHeader))
+    {
+        return SLANG_E_INTERNAL_FAIL;
+    }
+
+    return SLANG_OK;
+}
+
+static SlangResult _writeHeader(FileStream& fs, const CacheIndexHeader& header)
+{
+    SLANG_RETURN_ON_FAIL(fs.seek(SeekOrigin::Start, 0));
+    return fs.write(&header, sizeof(header));
+}
+
+static SlangResult _writeSlot(FileStream& fs, Index slotIndex, const CacheIndexSlot& slot)
+{
+    SLANG_RETURN_ON_FAIL(fs.seek(SeekOrigin::Start, _getSlotOffset(slotIndex)));
+    return fs.write(&slot, sizeof(slot));
+}
+
+static SlangResult _readAllSlots(
+    FileStream& fs,
+    const CacheIndexHeader& header,
+    List<CacheIndexSlot>& outSlots,
+    Count& ioSlotReadCount)
+{
+    outSlots.setCount(header.slotCount);
+    SLANG_RETURN_ON_FAIL(fs.seek(SeekOrigin::Start, _getSlotOffset(0)));
+    ioSlotReadCount += header.slotCount;
+    return fs.readExactly(outSlots.getBuffer(), header.slotCount * sizeof(CacheIndexSlot));
+}
+
+/// Read an occupied slot that is in the eviction order list.
+/// Returns SLANG_E_INTERNAL_FAIL if the slot index is out of range or the slot is not
+/// occupied, which means the list is corrupt.
+static SlangResult _readListedSlot(
+    FileStream& fs,
+    const CacheIndexHeader& header,
+    uint32_t slotIndex,
+    CacheIndexSlot& outSlot,
+    Count& ioSlotReadCount)
+{
+    if (slotIndex >= header.slotCount)
+    {
+        return SLANG_E_INTERNAL_FAIL;
+    }
+    SLANG_RETURN_ON_FAIL(fs.seek(SeekOrigin::Start, _getSlotOffset(slotIndex)));
+    SLANG_RETURN_ON_FAIL(fs.readExactly(&outSlot, sizeof(outSlot)));
+    ++ioSlotReadCount;
+    return outSlot.state == CacheSlotState::Occupied ? SLANG_OK : SLANG_E_INTERNAL_FAIL;
+}
+
+/// Unlink `ioSlot` from the eviction order list.
+/// Writes the neighboring slots, but not `ioSlot` or the header.
+static SlangResult _unlinkSlot(
+    FileStream& fs,
+    CacheIndexHeader& ioHeader,
+    CacheIndexSlot& ioSlot,
+    Count& ioSlotReadCount)
+{
+    CacheIndexSlot neighbor;
+    if (ioSlot.lruPrev == kNoSlot)
+    {
+        ioHeader.lruHead = ioSlot.lruNext;
+    }
+    else
+    {
+        SLANG_RETURN_ON_FAIL(
+            _readListedSlot(fs, ioHeader, ioSlot.lruPrev, neighbor, ioSlotReadCount));
+        neighbor.lruNext = ioSlot.lruNext;
+        SLANG_RETURN_ON_FAIL(_writeSlot(fs, ioSlot.lruPrev, neighbor));
+    }
+    if (ioSlot.lruNext == kNoSlot)
+    {
+        ioHeader.lruTail = ioSlot.lruPrev;
+    }
+    else
+    {
+        SLANG_RETURN_ON_FAIL(
+            _readListedSlot(fs, ioHeader, ioSlot.lruNext, neighbor, ioSlotReadCount));
+        neighbor.lruPrev = ioSlot.lruPrev;
+        SLANG_RETURN_ON_FAIL(_writeSlot(fs, ioSlot.lruNext, neighbor));
+    }
+    ioSlot.lruPrev = kNoSlot;
+    ioSlot.lruNext = kNoSlot;
+    return SLANG_OK;
+}
+
+/// Link `ioSlot` into the eviction order list by its `lruClock` and write it to `slotIndex`.
+/// The header is not written.
+static SlangResult _linkSlot(
+    FileStream& fs,
+    CacheIndexHeader& ioHeader,
+    uint32_t slotIndex,
+    CacheIndexSlot& ioSlot,
+    Count& ioSlotReadCount)
+{
+    // Search from the tail, since the slot is usually the most recently used one.
+    uint32_t prevIndex = ioHeader.lruTail;
+    CacheIndexSlot prev;
+    for (uint32_t stepCount = 0; prevIndex != kNoSlot; ++stepCount)
+    {
+        // A list longer than the table has a cycle.
+        if (stepCount >= ioHeader.slotCount)
+        {
+            return SLANG_E_INTERNAL_FAIL;
+        }
+        SLANG_RETURN_ON_FAIL(_readListedSlot(fs, ioHeader, prevIndex, prev, ioSlotReadCount));
+        if (prev.lruClock <= ioSlot.lruClock)
+        {
+            break;
+        }
+        prevIndex = prev.lruPrev;
+    }
+
+    ioSlot.lruPrev = prevIndex;
+    if (prevIndex == kNoSlot)
+    {
+        ioSlot.lruNext = ioHeader.lruHead;
+        ioHeader.lruHead = slotIndex;
+    }
+    else
+    {
+        ioSlot.lruNext = prev.lruNext;
+        prev.lruNext = slotIndex;
+        SLANG_RETURN_ON_FAIL(_writeSlot(fs, prevIndex, prev));
+    }
+    if (ioSlot.lruNext == kNoSlot)
+    {
+        ioHeader.lruTail = slotIndex;
+    }
+    else
+    {
+        CacheIndexSlot next;
+        SLANG_RETURN_ON_FAIL(
+            _readListedSlot(fs, ioHeader, ioSlot.lruNext, next, ioSlotReadCount));
+        next.lruPrev = slotIndex;
+        SLANG_RETURN_ON_FAIL(_writeSlot(fs, ioSlot.lruNext, next));
+    }
+    return _writeSlot(fs, slotIndex, ioSlot);
+}
+
+/// Find the slot for `key` by linear probing, reading a few slots at a time.
+/// Returns SLANG_OK and sets `outSlotIndex` if the key was found.
+/// Returns SLANG_E_NOT_FOUND otherwise. In both cases `outFreeSlotIndex` (if given) is
+/// set to the first empty or removed slot on the probe sequence, or -1 if there is none.
+static SlangResult _findSlot(
+    FileStream& fs,
+    const CacheIndexHeader& header,
+    const PersistentCache::Key& key,
+    Count& ioSlotReadCount,
+    Index& outSlotIndex,
+    Index* outFreeSlotIndex = nullptr,
+    CacheIndexSlot* outFreeSlot = nullptr)
+{
+    outSlotIndex = -1;
+    if (outFreeSlotIndex)
+        *outFreeSlotIndex = -1;
+
+    const Index slotCount = header.slotCount;
+    const Index homeSlotIndex = _getHomeSlotIndex(header, key);
+
+    CacheIndexSlot slots[kProbeSlotCount];
+    Index probeCount = 0;
+    while (probeCount < slotCount)
+    {
+        // Read a run of slots, without wrapping around the end of the table.
+        const Index startSlotIndex = (homeSlotIndex + probeCount) & (slotCount - 1);
+        const Index readCount = Math::Min(Index(kProbeSlotCount), slotCount - startSlotIndex);
+        SLANG_RETURN_ON_FAIL(fs.seek(SeekOrigin::Start, _getSlotOffset(startSlotIndex)));
+        SLANG_RETURN_ON_FAIL(fs.readExactly(slots, readCount * sizeof(CacheIndexSlot)));
+        ioSlotReadCount += readCount;
+
+        for (Index i = 0; i < readCount; ++i)
+        {
+            const CacheIndexSlot& slot = slots[i];
+            const Index slotIndex = startSlotIndex + i;
+            if (slot.state == CacheSlotState::Occupied)
+            {
+                if (slot.key == key)
+                {
+                    outSlotIndex = slotIndex;
+                    return SLANG_OK;
+                }
+                continue;
+            }
+
+            if (outFreeSlotIndex && *outFreeSlotIndex < 0)
+            {
+                *outFreeSlotIndex = slotIndex;
+                if (outFreeSlot)
+                    *outFreeSlot = slot;
+            }
+
+            // An empty slot terminates the probe sequence.
+            if (slot.state == CacheSlotState::Empty)
+            {
+                return SLANG_E_NOT_FOUND;
+            }
+        }
+        probeCount += readCount;
+    }
+
+    return SLANG_E_NOT_FOUND;
+}
+
+/// Insert a slot into an in-memory table and return its index.
+static Index _insertSlot(List<CacheIndexSlot>& slots, const CacheIndexSlot& slot)
+{
+    const Index slotCount = slots.getCount();
+    Index slotIndex = Index(slot.key.getHashCode() & (slotCount - 1));
+    while (slots[slotIndex].state != CacheSlotState::Empty)
+    {
+        slotIndex = (slotIndex + 1) & (slotCount - 1);
+    }
+    slots[slotIndex] = slot;
+    return slotIndex;
+}
+
+/// Write a complete index file containing `entries`, which may be reordered.
+static SlangResult _writeIndex(
+    const String& fileName,
+    CacheIndexHeader& ioHeader,
+    List<CacheIndexSlot>& entries)
+{
+    // Keep the load factor at or below 1/2 after rebuilding.
+    uint32_t slotCount = Math::Max(ioHeader.slotCount, kInitialSlotCount);
+    while (uint64_t(entries.getCount()) * 2 > slotCount)
+    {
+        slotCount *= 2;
+    }
+
+    List<CacheIndexSlot> slots;
+    slots.setCount(slotCount);
+    for (auto& slot : slots)
+    {
+        slot = CacheIndexSlot{};
+    }
+
+    CacheIndexHeader header;
+    _initHeader(header, slotCount);
+
+    // Insert the entries from least to most recently used, appending each to the
+    // eviction order list, which puts entries that were read back in their exact place.
+    entries.sort([](const CacheIndexSlot& a, const CacheIndexSlot& b)
+                 { return a.lastUsed < b.lastUsed; });
+    for (auto& entry : entries)
+    {
+        entry.lruClock = entry.lastUsed;
+        entry.lruPrev = header.lruTail;
+        entry.lruNext = kNoSlot;
+        const uint32_t slotIndex = (uint32_t)_insertSlot(slots, entry);
+        if (header.lruTail == kNoSlot)
+        {
+            header.lruHead = slotIndex;
+        }
+        else
+        {
+            slots[header.lruTail].lruNext = slotIndex;
+        }
+        header.lruTail = slotIndex;
+    }
+
+    header.entryCount = (uint32_t)entries.getCount();
+    header.usedSlotCount = header.entryCount;
+    header.clock = ioHeader.clock;
+
+    FileStream fs;
+    SLANG_RETURN_ON_FAIL(fs.init(fileName, FileMode::Create));
+    SLANG_RETURN_ON_FAIL(fs.write(&header, sizeof(header)));
+    SLANG_RETURN_ON_FAIL(fs.write(slots.getBuffer(), slots.getCount() * sizeof(CacheIndexSlot)));
+
+    ioHeader = header;
+    return SLANG_OK;
+}
+
+struct PersistentCache::SharedLockGuard
+{
+    SharedLockGuard(PersistentCache& cache)
+        : m_cache(cache)
+    {
+        m_cache._lockShared();
+    }
+    ~SharedLockGuard() { m_cache._unlockShared(); }
+
+    PersistentCache& m_cache;
+};
+
 PersistentCache::PersistentCache(const Desc& desc)
 {
     m_cacheDirectory = Path::simplify(desc.directory);
@@ -35,7 +453,7 @@ SlangResult PersistentCache::clear()
     }
 
     // Acquire the exclusive lock.
-    std::lock_guard<std::mutex> mutexLock(m_mutex);
+    std::lock_guard<std::shared_mutex> mutexLock(m_mutex);
     LockFileGuard fileLock(m_lockFile);
 
     struct Visitor : Path::Visitor
@@ -62,78 +480,123 @@ SlangResult PersistentCache::clear()
     Visitor visitor(m_cacheDirectory, m_lockFileName);
     Path::find(m_cacheDirectory, nullptr, &visitor);
 
-    m_stats.entryCount = 0;
+    _setEntryCount(0);
 
     return SLANG_OK;
 }
 
 void PersistentCache::resetStats()
 {
+    std::lock_guard<std::mutex> statsLock(m_statsMutex);
     m_stats.entryCount = 0;
     m_stats.hitCount = 0;
     m_stats.missCount = 0;
+    m_stats.slotReadCount = 0;
 }
 
 SlangResult PersistentCache::readEntry(const Key& key, ISlangBlob** outData)
 {
-    // Be pessimistic and assume we have a cache miss.
-    ++m_stats.missCount;
+    SlangResult result = _readEntry(key, outData);
 
-    if (!m_lockFile.isOpen())
+    std::lock_guard<std::mutex> statsLock(m_statsMutex);
+    if (result == SLANG_OK)
     {
-        return SLANG_E_CANNOT_OPEN;
+        ++m_stats.hitCount;
     }
-
-    // Acquire the exclusive lock.
-    std::lock_guard<std::mutex> mutexLock(m_mutex);
-    LockFileGuard fileLock(m_lockFile);
-
-    // Return if index does not exist.
-    if (!File::exists(m_indexFileName))
+    else
     {
-        return SLANG_E_NOT_FOUND;
+        ++m_stats.missCount;
     }
 
-    // Read the cache index.
-    CacheIndex cacheIndex;
-    SLANG_RETURN_ON_FAIL(readIndex(m_indexFileName, cacheIndex));
+    return result;
+}
 
-    // Increase the age of all entries in the cache.
-    for (auto& entry : cacheIndex)
+SlangResult PersistentCache::_readEntry(const Key& key, ISlangBlob** outData)
+{
+    if (!m_lockFile.isOpen())
     {
-        ++entry.age;
+        return SLANG_E_CANNOT_OPEN;
     }
 
-    // Find the entry.
-    Index entryIndex =
-        cacheIndex.findFirstIndex([&key](const CacheEntry& entry) { return entry.key == key; });
-    if (entryIndex == -1)
+    SlangResult result = SLANG_OK;
     {
-        return SLANG_E_NOT_FOUND;
-    }
+        // Acquire the shared lock.
+        std::shared_lock<std::shared_mutex> mutexLock(m_mutex);
+        SharedLockGuard fileLock(*this);
+
+        // Open the cache index. Returns SLANG_E_NOT_FOUND if the index does not exist.
+        FileStream fs;
+        CacheIndexHeader header;
+        SLANG_RETURN_ON_FAIL(_openIndex(m_indexFileName, fs, header));
+        _setEntryCount(header.entryCount);
+
+        // Find the entry.
+        Count slotReadCount = 0;
+        SLANG_DEFER(_addSlotReadCount(slotReadCount));
+        Index slotIndex = -1;
+        SLANG_RETURN_ON_FAIL(_findSlot(fs, header, key, slotReadCount, slotIndex));
+
+        // Read the entry.
+        ScopedAllocation data;
+        result = File::readAllBytes(getEntryFileName(key), data);
+        if (result == SLANG_OK)
+        {
+            // Mark the entry as most recently used. Only the slot's clock is written,
+            // which is fine under the shared lock: concurrent readers hitting the same
+            // entry can at worst overwrite each other's (equally recent) clock value.
+            // Failing to update the clock only affects eviction order, so the error
+            // is ignored.
+            const uint64_t clock = _advanceClock(header.clock);
+            if (SLANG_SUCCEEDED(fs.seek(
+                    SeekOrigin::Start,
+                    _getSlotOffset(slotIndex) + SLANG_OFFSET_OF(CacheIndexSlot, lastUsed))))
+            {
+                fs.write(&clock, sizeof(clock));
+            }
 
-    // Read the entry.
-    String entryFileName = getEntryFileName(key);
-    ScopedAllocation data;
-    SlangResult result = File::readAllBytes(entryFileName, data);
-    if (result == SLANG_OK)
-    {
-        --m_stats.missCount;
-        ++m_stats.hitCount;
-        cacheIndex[entryIndex].age = 0;
-        auto blob = RawBlob::moveCreate(data);
-        *outData = blob.detach();
+            auto blob = RawBlob::moveCreate(data);
+            *outData = blob.detach();
+            return SLANG_OK;
+        }
     }
-    else
+
+    // The entry file could not be read, remove the entry from the index.
+    _removeEntry(key);
+
+    return result;
+}
+
+SlangResult PersistentCache::_removeEntry(const Key& key)
+{
+    // Acquire the exclusive lock.
+    std::lock_guard<std::shared_mutex> mutexLock(m_mutex);
+    LockFileGuard fileLock(m_lockFile);
+
+    FileStream fs;
+    CacheIndexHeader header;
+    SLANG_RETURN_ON_FAIL(_openIndex(m_indexFileName, fs, header));
+
+    // The entry might have been removed or rewritten in the meantime.
+    Count slotReadCount = 0;
+    SLANG_DEFER(_addSlotReadCount(slotReadCount));
+    Index slotIndex = -1;
+    SLANG_RETURN_ON_FAIL(_findSlot(fs, header, key, slotReadCount, slotIndex));
+    if (File::exists(getEntryFileName(key)))
     {
-        cacheIndex.removeAt(entryIndex);
+        return SLANG_OK;
     }
 
-    // Write the cache index.
-    SLANG_RETURN_ON_FAIL(writeIndex(m_indexFileName, cacheIndex));
-    m_stats.entryCount = (Count)cacheIndex.getCount();
+    CacheIndexSlot slot;
+    SLANG_RETURN_ON_FAIL(_readListedSlot(fs, header, uint32_t(slotIndex), slot, slotReadCount));
+    SLANG_RETURN_ON_FAIL(_unlinkSlot(fs, header, slot, slotReadCount));
+    slot.state = CacheSlotState::Removed;
+    SLANG_RETURN_ON_FAIL(_writeSlot(fs, slotIndex, slot));
 
-    return result;
+    --header.entryCount;
+    SLANG_RETURN_ON_FAIL(_writeHeader(fs, header));
+    _setEntryCount(header.entryCount);
+
+    return SLANG_OK;
 }
 
 SlangResult PersistentCache::writeEntry(const Key& key, ISlangBlob* data)
@@ -146,27 +609,20 @@ SlangResult PersistentCache::writeEntry(const Key& key, ISlangBlob* data)
     }
 
     // Acquire the exclusive lock.
-    std::lock_guard<std::mutex> mutexLock(m_mutex);
+    std::lock_guard<std::shared_mutex> mutexLock(m_mutex);
     LockFileGuard fileLock(m_lockFile);
 
-    // Read the cache index.
-    // We ignore any errors when reading the index and just write a new one.
-    CacheIndex cacheIndex;
-    readIndex(m_indexFileName, cacheIndex);
-
-    // Increase the age of all entries in the cache and get the index of
-    // the oldest entry.
-    Index oldestEntryIndex = -1;
-    uint32_t oldestEntryAge = 0;
-    for (Index entryIndex = 0; entryIndex < cacheIndex.getCount(); ++entryIndex)
+    // Open the cache index.
+    // If the index is missing or corrupt we just write a new one.
+    FileStream fs;
+    CacheIndexHeader header;
+    if (SLANG_FAILED(_openIndex(m_indexFileName, fs, header)))
     {
-        auto& entry = cacheIndex[entryIndex];
-        ++entry.age;
-        if (entry.age > oldestEntryAge)
-        {
-            oldestEntryIndex = entryIndex;
-            oldestEntryAge = entry.age;
-        }
+        fs.close();
+        _initHeader(header, kInitialSlotCount);
+        List<CacheIndexSlot> entries;
+        SLANG_RETURN_ON_FAIL(_writeIndex(m_indexFileName, header, entries));
+        SLANG_RETURN_ON_FAIL(_openIndex(m_indexFileName, fs, header));
     }
 
     // Write the cache entry.
@@ -174,25 +630,131 @@ SlangResult PersistentCache::writeEntry(const Key& key, ISlangBlob* data)
     SLANG_RETURN_ON_FAIL(
         File::writeAllBytes(entryFileName, data->getBufferPointer(), data->getBufferSize()));
 
-    // Update the index.
-    if (m_maxEntryCount > 0 && cacheIndex.getCount() >= m_maxEntryCount)
+    CacheIndexSlot newSlot = {};
+    newSlot.key = key;
+    newSlot.state = CacheSlotState::Occupied;
+    newSlot.lastUsed = _advanceClock(header.clock);
+    newSlot.lruClock = newSlot.lastUsed;
+    header.clock = newSlot.lastUsed;
+
+    Count slotReadCount = 0;
+    SLANG_DEFER(_addSlotReadCount(slotReadCount));
+
+    // Evict the least recently used entry, which is at the head of the eviction order list
+    // unless it was read since it was put there.
+    auto evictEntry = [&]() -> SlangResult
     {
-        // Replace oldest entry.
-        SLANG_ASSERT(oldestEntryIndex >= 0);
-        File::remove(getEntryFileName(cacheIndex[oldestEntryIndex].key));
-        cacheIndex[oldestEntryIndex] = CacheEntry{key, 0};
-    }
-    else
+        // Each entry is moved at most once, so more steps than slots means a cycle.
+        for (uint32_t stepCount = 0; stepCount <= header.slotCount; ++stepCount)
+        {
+            const uint32_t slotIndex = header.lruHead;
+            CacheIndexSlot slot;
+            SLANG_RETURN_ON_FAIL(_readListedSlot(fs, header, slotIndex, slot, slotReadCount));
+            SLANG_RETURN_ON_FAIL(_unlinkSlot(fs, header, slot, slotReadCount));
+
+            if (slot.lastUsed > slot.lruClock)
+            {
+                // The entry was read since it was put in the list, move it to where it
+                // belongs. Every entry still has `lastUsed` of at least its `lruClock`,
+                // so once the head's clock is current it is the least recently used.
+                slot.lruClock = slot.lastUsed;
+                SLANG_RETURN_ON_FAIL(_linkSlot(fs, header, slotIndex, slot, slotReadCount));
+                continue;
+            }
+
+            File::remove(getEntryFileName(slot.key));
+            slot.state = CacheSlotState::Removed;
+            SLANG_RETURN_ON_FAIL(_writeSlot(fs, slotIndex, slot));
+            --header.entryCount;
+            return SLANG_OK;
+        }
+        return SLANG_E_INTERNAL_FAIL;
+    };
+
+    auto updateIndex = [&]() -> SlangResult
+    {
+        // If the entry already exists, we just need to update its clock, which moves it to
+        // the end of the eviction order list.
+        Index slotIndex = -1;
+        Index freeSlotIndex = -1;
+        CacheIndexSlot freeSlot = {};
+        SlangResult findResult =
+            _findSlot(fs, header, key, slotReadCount, slotIndex, &freeSlotIndex, &freeSlot);
+        if (findResult == SLANG_OK)
+        {
+            CacheIndexSlot oldSlot;
+            SLANG_RETURN_ON_FAIL(
+                _readListedSlot(fs, header, uint32_t(slotIndex), oldSlot, slotReadCount));
+            SLANG_RETURN_ON_FAIL(_unlinkSlot(fs, header, oldSlot, slotReadCount));
+            SLANG_RETURN_ON_FAIL(
+                _linkSlot(fs, header, uint32_t(slotIndex), newSlot, slotReadCount));
+            return _writeHeader(fs, header);
+        }
+        if (findResult != SLANG_E_NOT_FOUND)
+        {
+            return findResult;
+        }
+
+        // Evict the least recently used entry if the cache is full.
+        if (m_maxEntryCount > 0 && Count(header.entryCount) >= m_maxEntryCount)
+        {
+            SLANG_RETURN_ON_FAIL(evictEntry());
+
+            // The removed slot might come earlier in the probe sequence of the new key.
+            findResult =
+                _findSlot(fs, header, key, slotReadCount, slotIndex, &freeSlotIndex, &freeSlot);
+            if (findResult != SLANG_E_NOT_FOUND)
+            {
+                return SLANG_FAILED(findResult) ? findResult : SLANG_E_INTERNAL_FAIL;
+            }
+        }
+
+        // Reuse a free slot on the probe sequence, unless that would fill the table
+        // above a load factor of 3/4 (counting removed slots).
+        const bool consumesEmptySlot =
+            freeSlotIndex < 0 || freeSlot.state == CacheSlotState::Empty;
+        const uint64_t usedSlotCount = header.usedSlotCount + (consumesEmptySlot ? 1 : 0);
+        if (freeSlotIndex >= 0 && usedSlotCount * 4 <= uint64_t(header.slotCount) * 3)
+        {
+            SLANG_RETURN_ON_FAIL(
+                _linkSlot(fs, header, uint32_t(freeSlotIndex), newSlot, slotReadCount));
+            ++header.entryCount;
+            header.usedSlotCount = (uint32_t)usedSlotCount;
+            return _writeHeader(fs, header);
+        }
+
+        // Rebuild the table, which grows it if needed and drops removed slots.
+        List<CacheIndexSlot> slots;
+        SLANG_RETURN_ON_FAIL(_readAllSlots(fs, header, slots, slotReadCount));
+        List<CacheIndexSlot> entries;
+        for (const auto& slot : slots)
+        {
+            if (slot.state == CacheSlotState::Occupied)
+            {
+                entries.add(slot);
+            }
+        }
+        entries.add(newSlot);
+        fs.close();
+        return _writeIndex(m_indexFileName, header, entries);
+    };
+
+    SlangResult result = updateIndex();
+    if (result == SLANG_E_INTERNAL_FAIL)
     {
-        // Add new entry.
-        cacheIndex.add(CacheEntry{key, 0});
+        // The eviction order list is corrupt, so start over with an empty index as we do
+        // for a corrupt header.
+        fs.close();
+        _initHeader(header, kInitialSlotCount);
+        header.clock = newSlot.lastUsed;
+        List<CacheIndexSlot> entries;
+        entries.add(newSlot);
+        result = _writeIndex(m_indexFileName, header, entries);
     }
 
-    // Write the cache index.
-    SlangResult result = writeIndex(m_indexFileName, cacheIndex);
     if (result == SLANG_OK)
     {
-        m_stats.entryCount = (Count)cacheIndex.getCount();
+        _setEntryCount(header.entryCount);
     }
     else
     {
@@ -210,14 +772,16 @@ SlangResult PersistentCache::initialize()
         return SLANG_E_CANNOT_OPEN;
     }
 
-    // Acquire the exclusive lock.
-    std::lock_guard<std::mutex> mutexLock(m_mutex);
-    LockFileGuard fileLock(m_lockFile);
+    // Acquire the shared lock.
+    std::shared_lock<std::shared_mutex> mutexLock(m_mutex);
+    SharedLockGuard fileLock(*this);
 
-    CacheIndex cacheIndex;
-    if (SLANG_SUCCEEDED(readIndex(m_indexFileName, cacheIndex)))
+    FileStream fs;
+    CacheIndexHeader header;
+    if (SLANG_SUCCEEDED(_openIndex(m_indexFileName, fs, header)))
     {
-        m_stats.entryCount = (Count)cacheIndex.getCount();
+        _setEntryCount(header.entryCount);
+        _advanceClock(header.clock);
     }
 
     return SLANG_OK;
@@ -230,61 +794,52 @@ String PersistentCache::getEntryFileName(const Key& key)
     return str;
 }
 
-struct CacheIndexHeader
+uint64_t PersistentCache::_advanceClock(uint64_t indexClock)
 {
-    char magic[4];
-    uint32_t version;
-    uint32_t count;
-    uint32_t reserved;
-};
+    // The clock is based on wall-clock time, so that values handed out by different
+    // processes sharing the cache are ordered, but it never goes backwards.
+    const uint64_t now = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+                             std::chrono::system_clock::now().time_since_epoch())
+                             .count();
+
+    uint64_t clock = m_clock.load();
+    uint64_t nextClock;
+    do
+    {
+        nextClock = Math::Max(now, Math::Max(clock, indexClock) + 1);
+    } while (!m_clock.compare_exchange_weak(clock, nextClock));
 
-static const char* kMagic = "SLS$";
-static const uint32_t kVersion = 1;
+    return nextClock;
+}
 
-SlangResult PersistentCache::readIndex(const String& fileName, CacheIndex& outIndex)
+void PersistentCache::_setEntryCount(Count entryCount)
 {
-    FileStream fs;
-    SLANG_RETURN_ON_FAIL(fs.init(fileName, FileMode::Open));
-
-    // Get file size.
-    SLANG_RETURN_ON_FAIL(fs.seek(SeekOrigin::End, 0));
-    size_t fileSize = (size_t)fs.getPosition();
-    SLANG_RETURN_ON_FAIL(fs.seek(SeekOrigin::Start, 0));
+    std::lock_guard<std::mutex> statsLock(m_statsMutex);
+    m_stats.entryCount = entryCount;
+}
 
-    CacheIndexHeader header;
-    SLANG_RETURN_ON_FAIL(fs.readExactly(&header, sizeof(header)));
-    if (::memcmp(header.magic, kMagic, 4) != 0 || header.version != kVersion)
-    {
-        return SLANG_E_INTERNAL_FAIL;
-    }
+void PersistentCache::_addSlotReadCount(Count slotReadCount)
+{
+    std::lock_guard<std::mutex> statsLock(m_statsMutex);
+    m_stats.slotReadCount += slotReadCount;
+}
 
-    // Return if payload does not have the right size.
-    if (header.count * sizeof(CacheEntry) != fileSize - sizeof(header))
+void PersistentCache::_lockShared()
+{
+    std::lock_guard<std::mutex> lock(m_sharedLockMutex);
+    if (m_sharedLockCount++ == 0)
     {
-        return SLANG_E_INTERNAL_FAIL;
+        m_lockFile.lock(LockFile::LockType::Shared);
     }
-
-    outIndex.setCount(header.count);
-    SLANG_RETURN_ON_FAIL(fs.readExactly(outIndex.getBuffer(), header.count * sizeof(CacheEntry)));
-
-    return SLANG_OK;
 }
 
-SlangResult PersistentCache::writeIndex(const String& fileName, const CacheIndex& index)
+void PersistentCache::_unlockShared()
 {
-    FileStream fs;
-    SLANG_RETURN_ON_FAIL(fs.init(fileName, FileMode::Create));
-
-    CacheIndexHeader header;
-    ::memcpy(header.magic, kMagic, 4);
-    header.version = kVersion;
-    header.count = (uint32_t)index.getCount();
-    header.reserved = 0;
-    SLANG_RETURN_ON_FAIL(fs.write(&header, sizeof(header)));
-
-    SLANG_RETURN_ON_FAIL(fs.write(index.getBuffer(), index.getCount() * sizeof(CacheEntry)));
-
-    return SLANG_OK;
+    std::lock_guard<std::mutex> lock(m_sharedLockMutex);
+    if (--m_sharedLockCount == 0)
+    {
+        m_lockFile.unlock();
+    }
 }
 
 } // namespace Slang
@@ -4,7 +4,9 @@
 #include "../core/slang-string.h"
 #include "slang.h"
 
+#include <atomic>
 #include <mutex>
+#include <shared_mutex>
 
 namespace Slang
 {
@@ -14,6 +16,12 @@ namespace Slang
 /// The cache is save for concurrent access from multiple threads/processes by using
 /// a lock file within the cache directory. Furthermore, the cache implements a LRU
 /// eviction policy.
+///
+/// The cache index is stored as an open-addressing hash table of fixed size slots,
+/// so reading or writing an entry only touches the index header and a few slots
+/// instead of the whole index. Readers only take a shared lock and update the LRU
+/// clock of the slot they hit in place. The slots also form a list in eviction order,
+/// so evicting an entry doesn't need to scan the index either.
 class PersistentCache : public RefObject
 {
 public:
@@ -33,6 +41,8 @@ public:
         Count missCount;
         // Current number of entries in the cache.
         Count entryCount;
+        // Number of index slots read since last resetting the stats.
+        Count slotReadCount;
     };
 
     using Key = SHA1::Digest;
@@ -55,33 +65,52 @@ public:
     SlangResult writeEntry(const Key& key, ISlangBlob* data);
 
 private:
-    struct CacheEntry
-    {
-        Key key;
-        uint32_t age;
-    };
-
-    using CacheIndex = List<CacheEntry>;
-
     SlangResult initialize();
 
     String getEntryFileName(const Key& key);
 
-    SlangResult readIndex(const String& fileName, CacheIndex& outIndex);
-    SlangResult writeIndex(const String& fileName, const CacheIndex& index);
+    /// Read an entry while holding the shared lock.
+    SlangResult _readEntry(const Key& key, ISlangBlob** outData);
+
+    /// Remove an entry from the index (if present) while holding the exclusive lock.
+    SlangResult _removeEntry(const Key& key);
+
+    /// Returns the next value of the LRU clock, which is larger than any value
+    /// handed out before by this cache and larger than `indexClock`.
+    uint64_t _advanceClock(uint64_t indexClock);
+
+    void _setEntryCount(Count entryCount);
+    void _addSlotReadCount(Count slotReadCount);
+
+    /// Helpers for acquiring the shared file lock. The file lock is only held once
+    /// per process, the first reader acquires it and the last reader releases it.
+    void _lockShared();
+    void _unlockShared();
+
+    struct SharedLockGuard;
 
     String m_cacheDirectory;
     String m_lockFileName;
     String m_indexFileName;
 
-    // For exclusive locking we need both a mutex (acquired first)
-    // followed by a a file lock. The mutex is needed because on Linux
-    // the file lock is only locking between processes, not threads.
-    std::mutex m_mutex;
+    // For locking we need both a mutex (acquired first) followed by a file lock.
+    // The mutex is needed because on Linux the file lock is only locking between
+    // processes, not threads. Readers acquire both in shared mode, writers in
+    // exclusive mode.
+    std::shared_mutex m_mutex;
     Slang::LockFile m_lockFile;
 
+    // Guards the shared file lock reference count.
+    std::mutex m_sharedLockMutex;
+    Count m_sharedLockCount = 0;
+
+    // Largest LRU clock value handed out by this cache.
+    std::atomic<uint64_t> m_clock{0};
+
     Count m_maxEntryCount;
 
+    // Guards the stats, which can be updated from concurrent readers.
+    std::mutex m_statsMutex;
     Stats m_stats;
 
     // Used for unit tests.
@@ -67,6 +67,14 @@ SlangResult RiffFileSystem::loadFile(char const* path, ISlangBlob** outBlob)
         *outBlob = blob.detach();
         return SLANG_OK;
     }
+    else if (size_t(contents->getBufferPointer()) % RiffFileSystemBinary::kContentsAlignment)
+    {
+        // The contents are in an archive, at an offset that isn't suitably aligned for
+        // reading the data in place, so return a copy.
+        auto blob = RawBlob::create(contents->getBufferPointer(), contents->getBufferSize());
+        *outBlob = blob.detach();
+        return SLANG_OK;
+    }
     else
     {
         // Just return as is
@@ -115,9 +123,17 @@ SlangResult RiffFileSystem::saveFileBlob(const char* path, ISlangBlob* dataBlob)
 }
 
 SlangResult RiffFileSystem::loadArchive(const void* archive, size_t archiveSizeInBytes)
+{
+    // The contents of the files will reference a single copy of the archive.
+    return loadArchiveBlob(RawBlob::create(archive, archiveSizeInBytes));
+}
+
+SlangResult RiffFileSystem::loadArchiveBlob(ISlangBlob* archiveBlob)
 {
     // Load the riff
-    auto rootList = RIFF::RootChunk::getFromBlob(archive, archiveSizeInBytes);
+    auto rootList = RIFF::RootChunk::getFromBlob(
+        archiveBlob->getBufferPointer(),
+        archiveBlob->getBufferSize());
 
     // Make sure it's the right type
     if (rootList == nullptr || rootList->getType() != RiffFileSystemBinary::kContainerFourCC)
@@ -130,8 +146,23 @@ SlangResult RiffFileSystem::loadArchive(const void* archive, size_t archiveSizeI
 
     // Find the header
     auto headerChunk = rootList->findDataChunk(RiffFileSystemBinary::kHeaderFourCC);
+    if (!headerChunk || headerChunk->getPayloadSize() < sizeof(uint32_t))
+    {
+        return SLANG_FAIL;
+    }
 
-    const auto header = headerChunk->readPayloadAs<RiffFileSystemBinary::Header>();
+    // The header of version 0 archives only holds the compression system.
+    RiffFileSystemBinary::Header header = {};
+    headerChunk->writePayloadInto(
+        &header,
+        Math::Min(size_t(headerChunk->getPayloadSize()), sizeof(header)));
+    if (header.version > RiffFileSystemBinary::kVersion)
+    {
+        return SLANG_FAIL;
+    }
+    // The most padding there can be between the path and the contents of an entry.
+    const size_t maxPaddingSize =
+        header.version >= 1 ? RiffFileSystemBinary::kContentsAlignment - 1 : 0;
 
     CompressionSystemType compressionType = CompressionSystemType(header.compressionSystemType);
     switch (compressionType)
@@ -182,8 +213,9 @@ SlangResult RiffFileSystem::loadArchive(const void* archive, size_t archiveSizeI
             reader.read(srcEntry);
 
             // Check if seems plausible
-            if (sizeof(RiffFileSystemBinary::Entry) + srcEntry.compressedSize + srcEntry.pathSize !=
-                payloadSize)
+            const size_t unpaddedSize = sizeof(RiffFileSystemBinary::Entry) +
+                                        size_t(srcEntry.compressedSize) + srcEntry.pathSize;
+            if (unpaddedSize > payloadSize || payloadSize - unpaddedSize > maxPaddingSize)
             {
                 return SLANG_FAIL;
             }
@@ -191,7 +223,11 @@ SlangResult RiffFileSystem::loadArchive(const void* archive, size_t archiveSizeI
             Entry dstEntry;
 
             const char* path = (const char*)reader.getRemainingData();
-            reader.skip(srcEntry.pathSize);
+            if (srcEntry.pathSize == 0 || path[srcEntry.pathSize - 1] != 0)
+            {
+                return SLANG_FAIL;
+            }
+            reader.skip(srcEntry.pathSize + (payloadSize - unpaddedSize));
 
             dstEntry.m_canonicalPath = UnownedStringSlice(path, srcEntry.pathSize - 1);
             dstEntry.m_type = (SlangPathType)srcEntry.pathType;
@@ -206,9 +242,12 @@ SlangResult RiffFileSystem::loadArchive(const void* archive, size_t archiveSizeI
                         return SLANG_FAIL;
                     }
 
-                    // Get the compressed data
-                    dstEntry.m_contents =
-                        RawBlob::create(reader.getRemainingData(), srcEntry.compressedSize);
+                    // Reference the compressed data in the archive
+                    dstEntry.m_contents = ScopeBlob::create(
+                        UnownedRawBlob::create(
+                            reader.getRemainingData(),
+                            srcEntry.compressedSize),
+                        archiveBlob);
                     break;
                 }
             case SLANG_PATH_TYPE_DIRECTORY:
@@ -246,9 +285,15 @@ SlangResult RiffFileSystem::storeArchive(bool blobOwnsContent, ISlangBlob** outB
                                                           ? m_compressionSystem->getSystemType()
                                                           : CompressionSystemType::None;
         header.compressionSystemType = uint32_t(compressionSystemType);
+        header.version = RiffFileSystemBinary::kVersion;
         cursor.addDataChunk(RiffFileSystemBinary::kHeaderFourCC, &header, sizeof(header));
     }
 
+    // The offset of the next chunk from the start of the archive, which follows the header of
+    // the root chunk and the header chunk. It is tracked to align the contents of files.
+    size_t chunkOffset = (sizeof(RIFF::Chunk::Header) + sizeof(FourCC)) +
+                         (sizeof(RIFF::Chunk::Header) + sizeof(RiffFileSystemBinary::Header));
+
     for (const auto& [_, srcEntry] : m_entries)
     {
         // Ignore the root entry
@@ -262,9 +307,18 @@ SlangResult RiffFileSystem::storeArchive(bool blobOwnsContent, ISlangBlob** outB
         RiffFileSystemBinary::Entry dstEntry;
         dstEntry.uncompressedSize = 0;
         dstEntry.compressedSize = 0;
-        dstEntry.pathSize = uint32_t(srcEntry.m_canonicalPath.getLength() + 1);
         dstEntry.pathType = srcEntry.m_type;
 
+        // Pad after the path with 0s, so that the contents start at an aligned offset. The
+        // padding is not part of `pathSize`, so readers that predate version 1 reject it.
+        const size_t pathOffset =
+            chunkOffset + sizeof(RIFF::Chunk::Header) + sizeof(RiffFileSystemBinary::Entry);
+        const size_t pathSize = srcEntry.m_canonicalPath.getLength() + 1;
+        const size_t alignmentMask = RiffFileSystemBinary::kContentsAlignment - 1;
+        const size_t paddingSize =
+            ((pathOffset + pathSize + alignmentMask) & ~alignmentMask) - (pathOffset + pathSize);
+        dstEntry.pathSize = uint32_t(pathSize);
+
         ISlangBlob* blob = srcEntry.m_contents;
 
         if (srcEntry.m_type == SLANG_PATH_TYPE_FILE)
@@ -277,9 +331,11 @@ SlangResult RiffFileSystem::storeArchive(bool blobOwnsContent, ISlangBlob** outB
         cursor.addData(&dstEntry, sizeof(dstEntry));
 
         // Path
-        cursor.addData(
-            srcEntry.m_canonicalPath.getBuffer(),
-            srcEntry.m_canonicalPath.getLength() + 1);
+        cursor.addData(srcEntry.m_canonicalPath.getBuffer(), pathSize);
+
+        // Padding
+        static const char kPadding[RiffFileSystemBinary::kContentsAlignment] = {};
+        cursor.addData(kPadding, paddingSize);
 
         // Add the contained data without copying
         if (blob)
@@ -288,6 +344,13 @@ SlangResult RiffFileSystem::storeArchive(bool blobOwnsContent, ISlangBlob** outB
                 const_cast<void*>(blob->getBufferPointer()),
                 blob->getBufferSize());
         }
+
+        // Chunks start at offsets that are a multiple of `RIFF::Chunk::kChunkAlignment`.
+        const size_t chunkSize = sizeof(RIFF::Chunk::Header) +
+                                 sizeof(RiffFileSystemBinary::Entry) + pathSize + paddingSize +
+                                 (blob ? blob->getBufferSize() : 0);
+        chunkOffset += (chunkSize + RIFF::Chunk::kChunkAlignment - 1) &
+                       ~size_t(RIFF::Chunk::kChunkAlignment - 1);
     }
 
     SLANG_RETURN_ON_FAIL(builder.writeToBlob(outBlob));
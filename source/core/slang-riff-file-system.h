@@ -15,9 +15,18 @@ struct RiffFileSystemBinary
     static const FourCC::RawValue kEntryFourCC = SLANG_FOUR_CC('S', 'f', 'i', 'l');
     static const FourCC::RawValue kHeaderFourCC = SLANG_FOUR_CC('S', 'h', 'e', 'a');
 
+    /// The contents of files are stored at offsets from the start of the archive that are a
+    /// multiple of this, by padding after the path, so that they can be used in place.
+    static const size_t kContentsAlignment = 16;
+
+    /// The version of the archive format. Archives written before the version was stored in
+    /// the header are version 0, and have no padding after paths.
+    static const uint32_t kVersion = 1;
+
     struct Header
     {
         uint32_t compressionSystemType; /// One of CompressionSystemType
+        uint32_t version;               ///< The version of the archive format
     };
 
     struct Entry
@@ -28,6 +37,7 @@ struct RiffFileSystemBinary
         uint32_t pathType; ///< One of SlangPathType
 
         // Followed by the path (including terminating 0)
+        // Followed by up to `kContentsAlignment - 1` 0s of padding, from version 1
         // Followed by the compressed data
     };
 };
@@ -45,6 +55,11 @@ data is stored uncompressed. When compression is used, files 'contents' blob is
 *compressed* version of the contents. Calling loadFile/saveFile will uncompress/compress as need. If
 there is no compression contents is identical to the file contents.
 
+An archive loaded with `loadArchiveBlob` is not copied: the contents of files reference the
+archive blob, which is kept alive for as long as they are. This allows an archive that is mapped
+into memory (see `File::map`) to be used without reading parts of it that are not accessed.
+Uncompressed files whose contents are not suitably aligned in memory are copied when loaded.
+
 NOTE:
 * The RIFF chunk IDs are *slang specific*. It conforms to RIFF but is unlikely to be usable with
 other tooling.
@@ -82,6 +97,10 @@ public:
         m_compressionStyle = style;
     }
 
+    /// Loads an archive, referencing the contents of files in the archive blob instead of copying
+    /// them.
+    SlangResult loadArchiveBlob(ISlangBlob* archiveBlob);
+
     /// Pass in nullptr, if no compression is wanted.
     explicit RiffFileSystem(ICompressionSystem* compressionSystem);
 
@@ -0,0 +1,146 @@
+#include "slang-thread-pool.h"
+
+namespace Slang
+{
+
+/* static */ Count ThreadPool::getHardwareThreadCount()
+{
+    const unsigned int count = std::thread::hardware_concurrency();
+    return count ? Count(count) : 1;
+}
+
+ThreadPool::ThreadPool(Count threadCount)
+{
+    if (threadCount <= 0)
+    {
+        threadCount = getHardwareThreadCount();
+    }
+
+    // The calling thread of `forEach` also runs tasks, so we need one less worker.
+    for (Index i = 1; i < threadCount; ++i)
+    {
+        m_workers.add(std::thread([this]() { _workerThread(); }));
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shutdown = true;
+    }
+    m_taskAvailable.notify_all();
+
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+void ThreadPool::_runTasks(std::unique_lock<std::mutex>& lock)
+{
+    while (m_func && m_nextTask < m_taskCount)
+    {
+        const Index taskIndex = m_nextTask++;
+        const TaskFunc* func = m_func;
+
+        lock.unlock();
+        (*func)(taskIndex);
+        lock.lock();
+
+        if (--m_pendingTaskCount == 0)
+        {
+            m_batchDone.notify_all();
+        }
+    }
+}
+
+void ThreadPool::_workerThread()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;)
+    {
+        m_taskAvailable.wait(
+            lock,
+            [this]()
+            {
+                return m_shutdown || (m_func && m_nextTask < m_taskCount) ||
+                       m_nextAsyncTask < m_asyncTasks.getCount();
+            });
+        if (m_shutdown)
+        {
+            return;
+        }
+
+        // Batch tasks come first, as the thread that called `forEach` is waiting on them.
+        if (m_func && m_nextTask < m_taskCount)
+        {
+            _runTasks(lock);
+            continue;
+        }
+
+        AsyncTaskFunc func = _Move(m_asyncTasks[m_nextAsyncTask++]);
+        if (m_nextAsyncTask == m_asyncTasks.getCount())
+        {
+            m_asyncTasks.clear();
+            m_nextAsyncTask = 0;
+        }
+
+        lock.unlock();
+        func();
+        lock.lock();
+    }
+}
+
+void ThreadPool::runAsync(AsyncTaskFunc func)
+{
+    if (m_workers.getCount() == 0)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_asyncTasks.add(_Move(func));
+    }
+    m_taskAvailable.notify_one();
+}
+
+void ThreadPool::forEach(Index count, const TaskFunc& func)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+
+    // If there are no workers, or just a single task, there is nothing to gain from
+    // handing the work to other threads.
+    if (m_workers.getCount() == 0 || count == 1)
+    {
+        for (Index i = 0; i < count; ++i)
+        {
+            func(i);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> batchLock(m_batchMutex);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_func = &func;
+    m_taskCount = count;
+    m_nextTask = 0;
+    m_pendingTaskCount = count;
+
+    m_taskAvailable.notify_all();
+
+    // Help out with the work, and then wait for any tasks still running on workers.
+    _runTasks(lock);
+    m_batchDone.wait(lock, [this]() { return m_pendingTaskCount == 0; });
+
+    m_func = nullptr;
+    m_taskCount = 0;
+    m_nextTask = 0;
+}
+
+} // namespace Slang
@@ -0,0 +1,75 @@
+#pragma once
+#include "../core/slang-basic.h"
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Slang
+{
+
+/// A simple fixed size pool of worker threads.
+///
+/// Work is submitted as a batch of independent tasks identified by index, and `forEach`
+/// only returns once all tasks of the batch have completed. The calling thread takes part
+/// in running the tasks, so a pool with a thread count of 1 runs everything serially on
+/// the calling thread.
+///
+/// Batches are run one at a time, so `forEach` can be called from multiple threads, but it
+/// must not be called from inside a task. Tasks must not throw.
+///
+/// Single tasks can also be queued with `runAsync`, which returns without waiting for
+/// them. Workers run them when there is no batch task to start.
+class ThreadPool : public RefObject
+{
+public:
+    typedef std::function<void(Index)> TaskFunc;
+    typedef std::function<void()> AsyncTaskFunc;
+
+    /// Run `func` for each index in [0, count), and wait for all invocations to complete.
+    void forEach(Index count, const TaskFunc& func);
+
+    /// Queue `func` to be run on a worker thread, and return without waiting for it.
+    ///
+    /// If there are no workers `func` is never run, so the caller must be able to do the
+    /// work itself. Tasks that haven't started when the pool is destroyed are not run.
+    void runAsync(AsyncTaskFunc func);
+
+    /// Get the number of threads (including the calling thread) used to run tasks.
+    Count getThreadCount() const { return m_workers.getCount() + 1; }
+
+    /// Get the number of threads available on the hardware (at least 1).
+    static Count getHardwareThreadCount();
+
+    /// Ctor. A thread count of 0 will use one thread per hardware thread.
+    explicit ThreadPool(Count threadCount);
+    ~ThreadPool();
+
+private:
+    void _workerThread();
+    /// Run tasks from the current batch until there are none left to start.
+    /// Must be called with m_mutex held via `lock`.
+    void _runTasks(std::unique_lock<std::mutex>& lock);
+
+    List<std::thread> m_workers;
+
+    /// Serializes batches submitted from different threads.
+    std::mutex m_batchMutex;
+
+    std::mutex m_mutex;
+    std::condition_variable m_taskAvailable;
+    std::condition_variable m_batchDone;
+
+    const TaskFunc* m_func = nullptr; ///< The function of the current batch (null if none)
+    Index m_taskCount = 0;            ///< The number of tasks in the current batch
+    Index m_nextTask = 0;             ///< The index of the next task to start
+    Index m_pendingTaskCount = 0;     ///< The number of tasks of the batch not yet completed
+
+    List<AsyncTaskFunc> m_asyncTasks; ///< Tasks queued by `runAsync`, in order
+    Index m_nextAsyncTask = 0;        ///< The index of the next of `m_asyncTasks` to start
+
+    bool m_shutdown = false;
+};
+
+} // namespace Slang
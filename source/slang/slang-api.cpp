@@ -2,6 +2,7 @@
 
 #include "../core/slang-performance-profiler.h"
 #include "../core/slang-platform.h"
+#include "../core/slang-process.h"
 #include "../core/slang-rtti-info.h"
 #include "../core/slang-shared-library.h"
 #include "../core/slang-signal.h"
@@ -25,6 +26,22 @@ SLANG_API SlangSession* spCreateSession(const char*)
     return globalSession.detach();
 }
 
+// Load a builtin module from a blob that remains valid, using its contents in place if possible.
+static SlangResult _loadBuiltinModuleBlob(
+    slang::IGlobalSession* globalSession,
+    slang::BuiltinModuleName builtinModuleName,
+    ISlangBlob* moduleBlob)
+{
+    if (auto session = Slang::asInternal(globalSession))
+    {
+        return session->loadBuiltinModuleBlob(builtinModuleName, moduleBlob);
+    }
+    return globalSession->loadBuiltinModule(
+        builtinModuleName,
+        moduleBlob->getBufferPointer(),
+        moduleBlob->getBufferSize());
+}
+
 // Attempt to load a previously compiled builtin module from the same file system location as the
 // slang dll. Returns SLANG_OK when the cache is sucessfully loaded. Also returns the filename to
 // the builtin module cache and the timestamp of current slang dll.
@@ -49,20 +66,25 @@ SlangResult tryLoadBuiltinModuleFromCache(
     {
         return SLANG_FAIL;
     }
-    Slang::ScopedAllocation cacheData;
-    SLANG_RETURN_ON_FAIL(Slang::File::readAllBytes(cacheFileName, cacheData));
+    // The cache is mapped into memory, so that processes using it share the same pages, and
+    // only the parts of the module that are used are read.
+    Slang::ComPtr<ISlangBlob> cacheBlob;
+    SLANG_RETURN_ON_FAIL(Slang::File::map(cacheFileName, cacheBlob));
 
     // The first 8 bytes stores the timestamp of the slang dll that created this core module cache.
-    if (cacheData.getSizeInBytes() < sizeof(uint64_t))
+    if (cacheBlob->getBufferSize() < sizeof(uint64_t))
         return SLANG_FAIL;
-    auto cacheTimestamp = *(uint64_t*)(cacheData.getData());
+    auto cacheData = (const uint8_t*)cacheBlob->getBufferPointer();
+    uint64_t cacheTimestamp;
+    memcpy(&cacheTimestamp, cacheData, sizeof(cacheTimestamp));
     if (cacheTimestamp != currentLibTimestamp)
         return SLANG_FAIL;
-    SLANG_RETURN_ON_FAIL(globalSession->loadBuiltinModule(
-        builtinModuleName,
-        (uint8_t*)cacheData.getData() + sizeof(uint64_t),
-        cacheData.getSizeInBytes() - sizeof(uint64_t)));
-    return SLANG_OK;
+    auto moduleBlob = Slang::ScopeBlob::create(
+        Slang::UnownedRawBlob::create(
+            cacheData + sizeof(uint64_t),
+            cacheBlob->getBufferSize() - sizeof(uint64_t)),
+        cacheBlob);
+    return _loadBuiltinModuleBlob(globalSession, builtinModuleName, moduleBlob);
 }
 
 // Attempt to load a precompiled builtin module from slang-xxx-module.dll.
@@ -83,12 +105,9 @@ SlangResult tryLoadBuiltinModuleFromDLL(
         return SLANG_FAIL;
     typedef ISlangBlob*(GetEmbeddedModuleFunc)();
     auto getEmbeddedModule = (GetEmbeddedModuleFunc*)ptr;
+    // The library is never unloaded, so the module can be used in place.
     auto blob = getEmbeddedModule();
-    SLANG_RETURN_ON_FAIL(globalSession->loadBuiltinModule(
-        builtinModuleName,
-        (uint8_t*)blob->getBufferPointer(),
-        blob->getBufferSize()));
-    return SLANG_OK;
+    return _loadBuiltinModuleBlob(globalSession, builtinModuleName, blob);
 }
 
 SlangResult trySaveBuiltinModuleToCache(
@@ -99,19 +118,37 @@ SlangResult trySaveBuiltinModuleToCache(
 {
     if (dllTimestamp != 0 && cacheFilename.getLength() != 0)
     {
+        // The cache is not compressed, so that it can be used in place when it is mapped into
+        // memory.
         Slang::ComPtr<ISlangBlob> coreModuleBlobPtr;
         SLANG_RETURN_ON_FAIL(globalSession->saveBuiltinModule(
             builtinModuleName,
-            SLANG_ARCHIVE_TYPE_RIFF_LZ4,
+            SLANG_ARCHIVE_TYPE_RIFF,
             coreModuleBlobPtr.writeRef()));
 
-        Slang::FileStream fileStream;
-        SLANG_RETURN_ON_FAIL(fileStream.init(cacheFilename, Slang::FileMode::Create));
+        // An out of date cache isn't overwritten, as other processes may have it mapped into
+        // memory. The new cache is written to a file of its own (named for the process, so that
+        // processes saving at the same time don't clash) which then replaces it.
+        Slang::StringBuilder tempFilename;
+        tempFilename << cacheFilename << "." << Slang::Process::getId() << ".tmp";
+        SlangResult result = SLANG_OK;
+        {
+            Slang::FileStream fileStream;
+            SLANG_RETURN_ON_FAIL(fileStream.init(tempFilename, Slang::FileMode::Create));
 
-        SLANG_RETURN_ON_FAIL(fileStream.write(&dllTimestamp, sizeof(dllTimestamp)));
-        SLANG_RETURN_ON_FAIL(fileStream.write(
-            coreModuleBlobPtr->getBufferPointer(),
-            coreModuleBlobPtr->getBufferSize()))
+            result = fileStream.write(&dllTimestamp, sizeof(dllTimestamp));
+            if (SLANG_SUCCEEDED(result))
+            {
+                result = fileStream.write(
+                    coreModuleBlobPtr->getBufferPointer(),
+                    coreModuleBlobPtr->getBufferSize());
+            }
+        }
+        if (SLANG_SUCCEEDED(result))
+            result = Slang::File::replace(tempFilename, cacheFilename);
+        if (SLANG_FAILED(result))
+            Slang::File::remove(tempFilename);
+        return result;
     }
 
     return SLANG_OK;
@@ -145,9 +182,8 @@ SLANG_API SlangResult slang_createGlobalSessionImpl(
     ISlangBlob* coreModuleBlob = slang_getEmbeddedCoreModule();
     if (coreModuleBlob)
     {
-        SLANG_RETURN_ON_FAIL(globalSession->loadCoreModule(
-            coreModuleBlob->getBufferPointer(),
-            coreModuleBlob->getBufferSize()));
+        SLANG_RETURN_ON_FAIL(
+            _loadBuiltinModuleBlob(globalSession, slang::BuiltinModuleName::Core, coreModuleBlob));
     }
     else
     {
@@ -242,6 +278,7 @@ SLANG_API void slang_shutdown()
     Slang::PerformanceProfiler::getProfiler()->dispose();
     Slang::SPIRVCoreGrammarInfo::freeEmbeddedGrammerInfo();
     Slang::RttiInfo::deallocateAll();
+    Slang::freeCapabilitySets();
     Slang::freeCapabilityDefs();
 }
 
@@ -8,6 +8,7 @@
 #include "slang-ast-support-types.h"
 #include "slang-ir.h"
 
+#include <mutex>
 #include <type_traits>
 
 namespace Slang
@@ -194,6 +195,7 @@ class ASTBuilder : public RefObject
 public:
     Val* _getOrCreateImpl(ValNodeDesc&& desc)
     {
+        auto lock = lockIfUsedFromMultipleThreads();
         if (auto found = m_cachedNodes.tryGetValue(desc))
             return *found;
 
@@ -216,6 +218,7 @@ public:
     template<typename T>
     T* createImpl()
     {
+        auto lock = lockIfUsedFromMultipleThreads();
         auto alloced = m_arena.allocate(sizeof(T));
         memset(alloced, 0, sizeof(T));
         auto result = _initAndAdd(new (alloced) T);
@@ -225,6 +228,7 @@ public:
     template<typename T, typename... TArgs>
     T* createImpl(TArgs&&... args)
     {
+        auto lock = lockIfUsedFromMultipleThreads();
         auto alloced = m_arena.allocate(sizeof(T));
         memset(alloced, 0, sizeof(T));
         auto result = _initAndAdd(new (alloced) T(std::forward<TArgs>(args)...));
@@ -264,6 +268,19 @@ public:
 
     void incrementEpoch();
 
+    /// Set whether the builder is used from multiple threads at the same time, such as
+    /// by code generation tasks that run in parallel. While it is, creating nodes and
+    /// resolving vals take a lock.
+    void setUsedFromMultipleThreads(bool value) { m_usedFromMultipleThreads = value; }
+
+    /// Lock the builder if it is used from multiple threads, or return an empty lock.
+    std::unique_lock<std::recursive_mutex> lockIfUsedFromMultipleThreads()
+    {
+        if (!m_usedFromMultipleThreads)
+            return std::unique_lock<std::recursive_mutex>();
+        return std::unique_lock<std::recursive_mutex>(m_mutex);
+    }
+
     MemoryArena& getArena() { return m_arena; }
 
     NamePool* getNamePool() { return getSharedASTBuilder()->getNamePool(); }
@@ -709,6 +726,9 @@ protected:
     SharedASTBuilder* m_sharedASTBuilder;
 
     MemoryArena m_arena;
+
+    bool m_usedFromMultipleThreads = false;
+    std::recursive_mutex m_mutex;
 };
 
 // Retrieves the ASTBuilder for the current compilation session.
@@ -3,6 +3,7 @@
 
 #include "slang-ast-builder.h"
 #include "slang-ast-dispatch.h"
+#include "slang-compiler.h"
 #include "slang-syntax.h"
 
 #include <assert.h>
@@ -372,6 +373,14 @@ void ContainerDecl::addDirectMemberDecl(Decl* decl)
 
     decl->parentDecl = this;
     _directMemberDecls.decls.add(decl);
+
+    // Members of statement scopes and functions (such as temporaries and
+    // lambdas synthesized while checking a function body) can't be found by
+    // lookup from a module or namespace scope, so they don't affect the
+    // cached results of those lookups.
+    //
+    if (!as<ScopeDecl>(this) && !as<FunctionDeclBase>(this))
+        invalidateCachedLookups();
 }
 
 List<Decl*> const& ContainerDecl::getTransparentDirectMemberDecls()
@@ -397,6 +406,24 @@ bool ContainerDecl::_areLookupAcceleratorsValid()
 void ContainerDecl::_invalidateLookupAccelerators()
 {
     _directMemberDecls._invalidateLookupAccelerators();
+    invalidateCachedLookups();
+}
+
+void ContainerDecl::invalidateCachedLookups()
+{
+    // The change is recorded on the linkage the module of this decl was loaded
+    // into, so that checking whether a cached result is still valid costs the
+    // same however many scopes the lookup went through.
+    //
+    // A decl that isn't in a module yet can't be found by lookup, and the change
+    // is recorded when it is added to one.
+    //
+    ContainerDecl* rootDecl = this;
+    while (rootDecl->parentDecl)
+        rootDecl = rootDecl->parentDecl;
+    auto moduleDecl = as<ModuleDecl>(rootDecl);
+    if (moduleDecl && moduleDecl->module)
+        moduleDecl->module->getLinkage()->invalidateCachedLookups();
 }
 
 void ContainerDecl::_ensureLookupAcceleratorsAreValid()
@@ -211,6 +211,15 @@ class ContainerDecl : public Decl
     ///
     List<Decl*> const& getTransparentDirectMemberDecls();
 
+    /// Make the cached results of lookups that can reach the members of this
+    /// container decl invalid, because they changed.
+    ///
+    /// Lookups that start from module and namespace scopes are cached, and a cached
+    /// result is only used while the lookup version of the linkage of the module
+    /// (see `Linkage::getLookupVersion`) is unchanged.
+    ///
+    void invalidateCachedLookups();
+
     // Note: Just an alias for `getDirectMemberDecls()`,
     // but left in place because of just how many call sites were
     // already using this name.
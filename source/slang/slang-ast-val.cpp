@@ -62,6 +62,7 @@ Val* Val::resolve()
     // If we are not in a proper checking context, just return the previously resolved val.
     if (!astBuilder)
         return m_resolvedVal ? m_resolvedVal : this;
+    auto lock = astBuilder->lockIfUsedFromMultipleThreads();
     if (m_resolvedVal && m_resolvedValEpoch == astBuilder->getEpoch())
     {
         SLANG_ASSERT(as<Val>(m_resolvedVal));
@@ -3,6 +3,9 @@
 
 #include "../core/slang-dictionary.h"
 
+#include <atomic>
+#include <mutex>
+
 // This file implements the core of the "capability" system.
 
 namespace Slang
@@ -291,8 +294,308 @@ CapabilityAtom getStageAtomInSet(const CapabilityAtomSet& atomSet)
     return asAtom(*iter);
 }
 
+//
+// CapabilitySetNode
+//
+
+// Every distinct capability set is stored once, in a `CapabilitySetNode` that is never
+// modified. Two sets are only considered the same if their targets and stages are also in the
+// same order, because some queries (`getCompileTarget`, diagnostics) depend on that order.
+//
+// Up to `kMaxInternedNodeCount` nodes are interned in a table shared by all sessions, and
+// live until `freeCapabilitySets`. Once the table is full, new sets get a node of their own,
+// which is reference counted by the sets using it. The results of operations are only cached
+// for interned nodes, so that the memory used by the shared state is bounded.
+//
+struct CapabilitySetNode
+{
+    CapabilityTargetSets targetSets;
+    HashCode64 hashCode = 0;
+    bool isInvalid = false;
+    /// True if the node is owned by the intern table, rather than by the sets using it.
+    bool isInterned = false;
+    /// The number of sets using a node that isn't interned.
+    mutable std::atomic<UInt> referenceCount = 0;
+};
+
+static HashCode64 _calcHashCode(const CapabilityTargetSets& targetSets)
+{
+    HashCode64 hashCode = 0;
+    for (auto& targetSet : targetSets)
+    {
+        hashCode = combineHash(
+            hashCode,
+            HashCode64(targetSet.first),
+            HashCode64(targetSet.second.target));
+        for (auto& stageSet : targetSet.second.shaderStageSets)
+        {
+            hashCode = combineHash(
+                hashCode,
+                HashCode64(stageSet.first),
+                HashCode64(stageSet.second.stage));
+            if (stageSet.second.atomSet)
+                hashCode = combineHash(hashCode, stageSet.second.atomSet->getHashCode());
+        }
+    }
+    return hashCode;
+}
+
+static bool _isSameTargetSets(const CapabilityTargetSets& a, const CapabilityTargetSets& b)
+{
+    if (a.getCount() != b.getCount())
+        return false;
+
+    auto bTargetSet = b.begin();
+    for (auto& aTargetSet : a)
+    {
+        auto& aStageSets = aTargetSet.second.shaderStageSets;
+        auto& bStageSets = bTargetSet->second.shaderStageSets;
+        if (aTargetSet.first != bTargetSet->first ||
+            aTargetSet.second.target != bTargetSet->second.target ||
+            aStageSets.getCount() != bStageSets.getCount())
+            return false;
+
+        auto bStageSet = bStageSets.begin();
+        for (auto& aStageSet : aStageSets)
+        {
+            if (aStageSet.first != bStageSet->first ||
+                aStageSet.second.stage != bStageSet->second.stage ||
+                aStageSet.second.atomSet != bStageSet->second.atomSet)
+                return false;
+            ++bStageSet;
+        }
+        ++bTargetSet;
+    }
+    return true;
+}
+
+namespace
+{
+/// A table of the results of an operation on pairs of interned nodes.
+///
+/// The table has a fixed number of entries, each holding the result for one pair, and a
+/// result replaces whatever was in its entry before. Entries are read without locking: each
+/// has a sequence number that is odd while the entry is being written, and a reader that
+/// sees the sequence number change retries as a miss.
+///
+/// Interned nodes aren't freed while the table is in use, so a pair of pointers identifies
+/// the same pair of sets for as long as it is in the table.
+///
+struct CapabilitySetOperationCache
+{
+    static const Count kEntryCount = 4096;
+
+    struct Entry
+    {
+        std::atomic<uint32_t> sequence = 0;
+        std::atomic<const CapabilitySetNode*> first = nullptr;
+        std::atomic<const CapabilitySetNode*> second = nullptr;
+        std::atomic<UInt> result = 0;
+    };
+
+    static Entry& _getEntry(Entry* entries, const CapabilitySetNode* a, const CapabilitySetNode* b)
+    {
+        const HashCode64 hashCode = combineHash(getHashCode(a), getHashCode(b));
+        return entries[hashCode & (kEntryCount - 1)];
+    }
+
+    bool tryGet(const CapabilitySetNode* a, const CapabilitySetNode* b, UInt& outResult)
+    {
+        Entry& entry = _getEntry(m_entries, a, b);
+        const uint32_t sequence = entry.sequence.load(std::memory_order_acquire);
+        if (sequence & 1)
+            return false;
+
+        const CapabilitySetNode* first = entry.first.load(std::memory_order_relaxed);
+        const CapabilitySetNode* second = entry.second.load(std::memory_order_relaxed);
+        const UInt result = entry.result.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (entry.sequence.load(std::memory_order_relaxed) != sequence || first != a ||
+            second != b)
+            return false;
+
+        outResult = result;
+        return true;
+    }
+
+    void set(const CapabilitySetNode* a, const CapabilitySetNode* b, UInt result)
+    {
+        Entry& entry = _getEntry(m_entries, a, b);
+
+        // If another thread is writing the entry, the result is just not cached.
+        uint32_t sequence = entry.sequence.load(std::memory_order_relaxed);
+        if ((sequence & 1) ||
+            !entry.sequence.compare_exchange_strong(
+                sequence,
+                sequence + 1,
+                std::memory_order_relaxed))
+            return;
+        std::atomic_thread_fence(std::memory_order_release);
+
+        entry.first.store(a, std::memory_order_relaxed);
+        entry.second.store(b, std::memory_order_relaxed);
+        entry.result.store(result, std::memory_order_relaxed);
+        entry.sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    /// Must only be called when no other thread is using the table.
+    void clear()
+    {
+        for (auto& entry : m_entries)
+        {
+            entry.first.store(nullptr, std::memory_order_relaxed);
+            entry.second.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    Entry m_entries[kEntryCount];
+};
+
+/// The interned nodes, and the cached results of operations on them.
+///
+/// Lookups don't take a lock. Interning a new node takes `mutex`.
+///
+struct CapabilitySetCache
+{
+    /// The most nodes that are interned.
+    static const Count kMaxInternedNodeCount = 16 * 1024;
+    /// Always a power of 2, and at least twice `kMaxInternedNodeCount`, so probe
+    /// sequences stay short.
+    static const Count kTableCapacity = 32 * 1024;
+
+    ~CapabilitySetCache() { clear(); }
+
+    /// Free the interned nodes. Must only be called when no other thread is using the cache.
+    void clear()
+    {
+        for (auto& slot : nodes)
+        {
+            delete slot.load(std::memory_order_relaxed);
+            slot.store(nullptr, std::memory_order_relaxed);
+        }
+        nodeCount = 0;
+        for (auto& atomNode : atomNodes)
+            atomNode.store(nullptr, std::memory_order_relaxed);
+        joins.clear();
+        implications.clear();
+        incompatibilities.clear();
+    }
+
+    /// Find the interned node with the same contents as `targetSets`, or return nullptr.
+    const CapabilitySetNode* find(const CapabilityTargetSets& targetSets, HashCode64 hashCode)
+    {
+        const Count mask = kTableCapacity - 1;
+        for (Index i = Index(hashCode & mask);; i = (i + 1) & mask)
+        {
+            // Pairs with the release store in `intern`, so that the node is fully constructed.
+            const CapabilitySetNode* node = nodes[i].load(std::memory_order_acquire);
+            if (!node)
+                return nullptr;
+            if (node->hashCode == hashCode && _isSameTargetSets(node->targetSets, targetSets))
+                return node;
+        }
+    }
+
+    /// Add `node` to the table, if it isn't full. Must be called with `mutex` held.
+    bool intern(CapabilitySetNode* node)
+    {
+        if (nodeCount >= kMaxInternedNodeCount)
+            return false;
+
+        node->isInterned = true;
+        const Count mask = kTableCapacity - 1;
+        for (Index i = Index(node->hashCode & mask);; i = (i + 1) & mask)
+        {
+            if (!nodes[i].load(std::memory_order_relaxed))
+            {
+                nodes[i].store(node, std::memory_order_release);
+                nodeCount++;
+                return true;
+            }
+        }
+    }
+
+    /// Guards the interning of nodes.
+    std::mutex mutex;
+
+    std::atomic<CapabilitySetNode*> nodes[kTableCapacity] = {};
+    Count nodeCount = 0;
+
+    /// The node of the set made from each atom, so that each atom is only expanded once.
+    std::atomic<const CapabilitySetNode*> atomNodes[Count(CapabilityName::Count)] = {};
+
+    CapabilitySetOperationCache joins;
+    CapabilitySetOperationCache implications;
+    CapabilitySetOperationCache incompatibilities;
+};
+} // namespace
+
+static CapabilitySetCache& _getCapabilitySetCache()
+{
+    static CapabilitySetCache cache;
+    return cache;
+}
+
+/// Get the node for `targetSets`, which is not referenced by any set yet if it isn't interned.
+static const CapabilitySetNode* _internTargetSets(CapabilityTargetSets&& targetSets)
+{
+    if (targetSets.getCount() == 0)
+        return nullptr;
+
+    const HashCode64 hashCode = _calcHashCode(targetSets);
+
+    auto& cache = _getCapabilitySetCache();
+    if (auto node = cache.find(targetSets, hashCode))
+        return node;
+
+    auto node = new CapabilitySetNode();
+    node->targetSets = std::move(targetSets);
+    node->hashCode = hashCode;
+    node->isInvalid = node->targetSets.containsKey(CapabilityAtom::Invalid);
+
+    std::lock_guard<std::mutex> lock(cache.mutex);
+
+    // Another thread may have interned the same set in the meantime.
+    if (auto existingNode = cache.find(node->targetSets, hashCode))
+    {
+        delete node;
+        return existingNode;
+    }
+    cache.intern(node);
+    return node;
+}
+
+static void _addReference(const CapabilitySetNode* node)
+{
+    if (node && !node->isInterned)
+        node->referenceCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+static void _releaseReference(const CapabilitySetNode* node)
+{
+    if (node && !node->isInterned &&
+        node->referenceCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        delete node;
+    }
+}
+
+/// Results of operations are only cached for interned nodes, as the pointers to other nodes
+/// may be reused once they are freed.
+static bool _canCacheResult(const CapabilitySetNode* a, const CapabilitySetNode* b)
+{
+    return a && a->isInterned && b && b->isInterned;
+}
+
+void freeCapabilitySets()
+{
+    _getCapabilitySetCache().clear();
+}
+
 template<CapabilityName keyholeAtomToPermuteWith>
 void CapabilitySet::addPermutationsOfConjunctionForEachInContainer(
+    CapabilityTargetSets& ioTargetSets,
     CapabilityAtomSet& setToPermutate,
     const CapabilityAtomSet& elementsToPermutateWith,
     CapabilityAtom knownTargetAtom,
@@ -309,20 +612,25 @@ void CapabilitySet::addPermutationsOfConjunctionForEachInContainer(
 
         if constexpr (keyholeAtomToPermuteWith == CapabilityName::target)
         {
-            addConjunction(conjunctionPermutation, asAtom(atom), knownStageAtom);
+            addConjunction(ioTargetSets, conjunctionPermutation, asAtom(atom), knownStageAtom);
         }
         else if constexpr (keyholeAtomToPermuteWith == CapabilityName::stage)
         {
-            addConjunction(conjunctionPermutation, knownTargetAtom, asAtom(atom));
+            addConjunction(ioTargetSets, conjunctionPermutation, knownTargetAtom, asAtom(atom));
         }
         else
         {
-            addConjunction(conjunctionPermutation, knownTargetAtom, knownStageAtom);
+            addConjunction(
+                ioTargetSets,
+                conjunctionPermutation,
+                knownTargetAtom,
+                knownStageAtom);
         }
     }
 }
 
 void CapabilitySet::addConjunction(
+    CapabilityTargetSets& ioTargetSets,
     CapabilityAtomSet conjunction,
     CapabilityAtom knownTargetAtom,
     CapabilityAtom knownStageAtom)
@@ -334,6 +642,7 @@ void CapabilitySet::addConjunction(
         if (knownTargetAtom == CapabilityAtom::Invalid)
         {
             addPermutationsOfConjunctionForEachInContainer<CapabilityName::target>(
+                ioTargetSets,
                 conjunction,
                 getAtomSetOfTargets(),
                 CapabilityAtom::Invalid,
@@ -341,7 +650,7 @@ void CapabilitySet::addConjunction(
             return;
         }
     }
-    auto& capabilitySetToTargetSet = m_targetSets[knownTargetAtom];
+    auto& capabilitySetToTargetSet = ioTargetSets[knownTargetAtom];
     capabilitySetToTargetSet.target = knownTargetAtom;
 
     if (knownStageAtom == CapabilityAtom::Invalid)
@@ -352,6 +661,7 @@ void CapabilitySet::addConjunction(
         {
             capabilitySetToTargetSet.shaderStageSets.reserve(kCapabilityStageCount);
             addPermutationsOfConjunctionForEachInContainer<CapabilityName::stage>(
+                ioTargetSets,
                 conjunction,
                 getAtomSetOfStages(),
                 knownTargetAtom,
@@ -364,17 +674,19 @@ void CapabilitySet::addConjunction(
     targetSetToStageSet.addNewSet(std::move(conjunction));
 }
 
-void CapabilitySet::addUnexpandedCapabilites(CapabilityName atom)
+void CapabilitySet::addUnexpandedCapabilites(
+    CapabilityTargetSets& ioTargetSets,
+    CapabilityName atom)
 {
     auto info = _getInfo(atom);
     for (const auto cr : info.canonicalRepresentation)
-        addConjunction(*cr, CapabilityAtom::Invalid, CapabilityAtom::Invalid);
+        addConjunction(ioTargetSets, *cr, CapabilityAtom::Invalid, CapabilityAtom::Invalid);
 }
 
 CapabilityAtom CapabilitySet::getUniquelyImpliedStageAtom() const
 {
     CapabilityAtom result = CapabilityAtom::Invalid;
-    for (auto& targetKV : m_targetSets)
+    for (auto& targetKV : getCapabilityTargetSets())
     {
         if (targetKV.second.shaderStageSets.getCount() == 1)
         {
@@ -390,6 +702,48 @@ CapabilityAtom CapabilitySet::getUniquelyImpliedStageAtom() const
 
 CapabilitySet::CapabilitySet() {}
 
+CapabilitySet::CapabilitySet(CapabilitySet const& other)
+    : m_node(other.m_node)
+{
+    _addReference(m_node);
+}
+
+CapabilitySet& CapabilitySet::operator=(CapabilitySet const& other)
+{
+    _setNode(other.m_node);
+    return *this;
+}
+
+CapabilitySet::CapabilitySet(CapabilitySet&& other)
+    : m_node(other.m_node)
+{
+    other.m_node = nullptr;
+}
+
+CapabilitySet& CapabilitySet::operator=(CapabilitySet&& other)
+{
+    if (this != &other)
+    {
+        _releaseReference(m_node);
+        m_node = other.m_node;
+        other.m_node = nullptr;
+    }
+    return *this;
+}
+
+CapabilitySet::~CapabilitySet()
+{
+    _releaseReference(m_node);
+}
+
+void CapabilitySet::_setNode(const CapabilitySetNode* node)
+{
+    // The reference is added first, in case `node` is only kept alive by this set.
+    _addReference(node);
+    _releaseReference(m_node);
+    m_node = node;
+}
+
 CapabilitySet::CapabilitySet(Int atomCount, CapabilityName const* atoms)
 {
     for (Int i = 0; i < atomCount; i++)
@@ -398,8 +752,25 @@ CapabilitySet::CapabilitySet(Int atomCount, CapabilityName const* atoms)
 
 CapabilitySet::CapabilitySet(CapabilityName atom)
 {
-    this->m_targetSets.reserve(kCapabilityTargetCount);
-    addUnexpandedCapabilites(atom);
+    auto& atomNode = _getCapabilitySetCache().atomNodes[Index(atom)];
+    if (auto node = atomNode.load(std::memory_order_acquire))
+    {
+        m_node = node;
+        return;
+    }
+
+    CapabilityTargetSets targetSets;
+    targetSets.reserve(kCapabilityTargetCount);
+    addUnexpandedCapabilites(targetSets, atom);
+    _setTargetSets(std::move(targetSets));
+
+    if (m_node && m_node->isInterned)
+        atomNode.store(m_node, std::memory_order_release);
+}
+
+CapabilitySet::CapabilitySet(CapabilityTargetSets&& targetSets)
+{
+    _setTargetSets(std::move(targetSets));
 }
 
 CapabilitySet::CapabilitySet(List<CapabilityName> const& atoms)
@@ -415,10 +786,21 @@ CapabilitySet CapabilitySet::makeEmpty()
 
 CapabilitySet CapabilitySet::makeInvalid()
 {
-    CapabilitySet result;
-    result.m_targetSets[CapabilityAtom::Invalid].target = CapabilityAtom::Invalid;
+    CapabilityTargetSets targetSets;
+    targetSets[CapabilityAtom::Invalid].target = CapabilityAtom::Invalid;
 
-    return result;
+    return CapabilitySet(std::move(targetSets));
+}
+
+const CapabilityTargetSets& CapabilitySet::getCapabilityTargetSets() const
+{
+    static const CapabilityTargetSets kEmptyTargetSets;
+    return m_node ? m_node->targetSets : kEmptyTargetSets;
+}
+
+void CapabilitySet::_setTargetSets(CapabilityTargetSets&& targetSets)
+{
+    _setNode(_internTargetSets(std::move(targetSets)));
 }
 
 void CapabilitySet::addCapability(CapabilityName name)
@@ -428,12 +810,12 @@ void CapabilitySet::addCapability(CapabilityName name)
 
 bool CapabilitySet::isEmpty() const
 {
-    return m_targetSets.getCount() == 0;
+    return m_node == nullptr;
 }
 
 bool CapabilitySet::isInvalid() const
 {
-    return m_targetSets.containsKey(CapabilityAtom::Invalid);
+    return m_node && m_node->isInvalid;
 }
 
 bool CapabilitySet::isIncompatibleWith(CapabilityAtom other) const
@@ -462,24 +844,36 @@ bool CapabilitySet::isIncompatibleWith(CapabilitySet const& other) const
     if (other.isEmpty())
         return false;
 
+    auto& cache = _getCapabilitySetCache();
+    const bool canCacheResult = _canCacheResult(m_node, other.m_node);
+    UInt cachedResult = 0;
+    if (canCacheResult && cache.incompatibilities.tryGet(m_node, other.m_node, cachedResult))
+        return cachedResult != 0;
+
     // Incompatible means there are 0 intersecting abstract nodes from sets in `other` with sets in
     // `this`
-    for (auto& otherSet : other.m_targetSets)
+    bool result = true;
+    for (auto& otherSet : other.m_node->targetSets)
     {
-        auto targetSet = this->m_targetSets.tryGetValue(otherSet.first);
+        auto targetSet = m_node->targetSets.tryGetValue(otherSet.first);
         if (!targetSet)
             continue;
 
         for (auto& otherStageSet : otherSet.second.shaderStageSets)
         {
-            auto stageSet = targetSet->shaderStageSets.tryGetValue(otherStageSet.first);
-            if (!stageSet)
-                continue;
-
-            return false;
+            if (targetSet->shaderStageSets.containsKey(otherStageSet.first))
+            {
+                result = false;
+                break;
+            }
         }
+        if (!result)
+            break;
     }
-    return true;
+
+    if (canCacheResult)
+        cache.incompatibilities.set(m_node, other.m_node, result);
+    return result;
 }
 
 const CapabilityAtomSet& getAtomSetOfTargets()
@@ -525,9 +919,9 @@ CapabilitySet::ImpliesReturnFlags CapabilitySet::_implies(
     if (otherSet.isEmpty())
         return CapabilitySet::ImpliesReturnFlags::Implied;
 
-    for (const auto& otherTarget : otherSet.m_targetSets)
+    for (const auto& otherTarget : otherSet.getCapabilityTargetSets())
     {
-        auto thisTarget = this->m_targetSets.tryGetValue(otherTarget.first);
+        auto thisTarget = getCapabilityTargetSets().tryGetValue(otherTarget.first);
         if (!thisTarget)
         {
             if (onlyRequireSingleImply)
@@ -574,8 +968,21 @@ CapabilitySet::ImpliesReturnFlags CapabilitySet::_implies(
 
 bool CapabilitySet::implies(CapabilitySet const& other) const
 {
-    return (int)_implies(other, ImpliesFlags::None) &
-           (int)CapabilitySet::ImpliesReturnFlags::Implied;
+    if (other.isEmpty() || m_node == other.m_node)
+        return true;
+
+    auto& cache = _getCapabilitySetCache();
+    const bool canCacheResult = _canCacheResult(m_node, other.m_node);
+    UInt cachedResult = 0;
+    if (canCacheResult && cache.implications.tryGet(m_node, other.m_node, cachedResult))
+        return cachedResult != 0;
+
+    bool result = (int)_implies(other, ImpliesFlags::None) &
+                  (int)CapabilitySet::ImpliesReturnFlags::Implied;
+
+    if (canCacheResult)
+        cache.implications.set(m_node, other.m_node, result);
+    return result;
 }
 CapabilitySet::ImpliesReturnFlags CapabilitySet::atLeastOneSetImpliedInOther(
     CapabilitySet const& other) const
@@ -601,15 +1008,19 @@ void CapabilitySet::unionWith(const CapabilitySet& other)
 {
     if (this->isInvalid() || other.isInvalid())
         return;
+    if (other.isEmpty() || m_node == other.m_node)
+        return;
 
-    this->m_targetSets.reserve(other.m_targetSets.getCount());
-    for (auto otherTargetSet : other.m_targetSets)
+    CapabilityTargetSets targetSets = getCapabilityTargetSets();
+    targetSets.reserve(other.m_node->targetSets.getCount());
+    for (auto& otherTargetSet : other.m_node->targetSets)
     {
-        CapabilityTargetSet& thisTargetSet = this->m_targetSets[otherTargetSet.first];
+        CapabilityTargetSet& thisTargetSet = targetSets[otherTargetSet.first];
         thisTargetSet.target = otherTargetSet.first;
         thisTargetSet.shaderStageSets.reserve(otherTargetSet.second.shaderStageSets.getCount());
         thisTargetSet.unionWith(otherTargetSet.second);
     }
+    _setTargetSets(std::move(targetSets));
 }
 
 /// Join sets, but:
@@ -623,23 +1034,29 @@ void CapabilitySet::nonDestructiveJoin(const CapabilitySet& other)
 
     if (this->isEmpty())
     {
-        this->m_targetSets = other.m_targetSets;
+        _setNode(other.m_node);
         return;
     }
-    for (auto& thisTargetSet : this->m_targetSets)
+
+    CapabilityTargetSets targetSets = m_node->targetSets;
+    for (auto& thisTargetSet : targetSets)
     {
-        thisTargetSet.second.tryJoin(other.m_targetSets);
+        thisTargetSet.second.tryJoin(other.getCapabilityTargetSets());
     }
+    _setTargetSets(std::move(targetSets));
 }
 
 bool CapabilitySet::operator==(CapabilitySet const& that) const
 {
-    for (auto set : this->m_targetSets)
+    if (m_node == that.m_node)
+        return true;
+
+    for (auto& set : getCapabilityTargetSets())
     {
-        auto thatSet = that.m_targetSets.tryGetValue(set.first);
+        auto thatSet = that.getCapabilityTargetSets().tryGetValue(set.first);
         if (!thatSet)
             return false;
-        for (auto stageSet : set.second.shaderStageSets)
+        for (auto& stageSet : set.second.shaderStageSets)
         {
             auto thatStageSet = thatSet->shaderStageSets.tryGetValue(stageSet.first);
             if (!thatStageSet)
@@ -653,34 +1070,34 @@ bool CapabilitySet::operator==(CapabilitySet const& that) const
 
 CapabilitySet CapabilitySet::getTargetsThisHasButOtherDoesNot(const CapabilitySet& other)
 {
-    CapabilitySet newSet{};
-    for (auto& i : this->m_targetSets)
+    CapabilityTargetSets newTargetSets;
+    for (auto& i : getCapabilityTargetSets())
     {
-        if (other.m_targetSets.tryGetValue(i.first))
+        if (other.getCapabilityTargetSets().tryGetValue(i.first))
             continue;
 
-        newSet.m_targetSets[i.first] = i.second;
+        newTargetSets[i.first] = i.second;
     }
-    return newSet;
+    return CapabilitySet(std::move(newTargetSets));
 }
 
 CapabilitySet CapabilitySet::getStagesThisHasButOtherDoesNot(const CapabilitySet& other)
 {
-    CapabilitySet newSet{};
-    for (auto& i : this->m_targetSets)
+    CapabilityTargetSets newTargetSets;
+    for (auto& i : getCapabilityTargetSets())
     {
-        if (auto otherTarget = other.m_targetSets.tryGetValue(i.first))
+        if (auto otherTarget = other.getCapabilityTargetSets().tryGetValue(i.first))
         {
-            auto& thisTarget = m_targetSets[i.first];
+            auto& thisTarget = i.second;
             for (auto& stage : thisTarget.shaderStageSets)
             {
                 if (otherTarget->shaderStageSets.containsKey(stage.first))
                     continue;
-                newSet.m_targetSets[i.first].shaderStageSets[stage.first] = stage.second;
+                newTargetSets[i.first].shaderStageSets[stage.first] = stage.second;
             }
         }
     }
-    return newSet;
+    return CapabilitySet(std::move(newTargetSets));
 }
 
 bool CapabilityStageSet::tryJoin(const CapabilityTargetSet& other)
@@ -727,25 +1144,40 @@ CapabilitySet& CapabilitySet::join(const CapabilitySet& other)
     }
     if (this->isInvalid())
         return *this;
-    if (other.isEmpty())
+    if (other.isEmpty() || m_node == other.m_node)
         return *this;
 
+    auto& cache = _getCapabilitySetCache();
+    const CapabilitySetNode* node = m_node;
+    const bool canCacheResult = _canCacheResult(node, other.m_node);
+    UInt cachedResult = 0;
+    if (canCacheResult && cache.joins.tryGet(node, other.m_node, cachedResult))
+    {
+        _setNode((const CapabilitySetNode*)cachedResult);
+        return *this;
+    }
+
+    CapabilityTargetSets targetSets = m_node->targetSets;
     List<CapabilityAtom> destroySet;
-    destroySet.reserve(this->m_targetSets.getCount());
-    for (auto& thisTargetSet : this->m_targetSets)
+    destroySet.reserve(targetSets.getCount());
+    for (auto& thisTargetSet : targetSets)
     {
-        if (!thisTargetSet.second.tryJoin(other.m_targetSets))
+        if (!thisTargetSet.second.tryJoin(other.m_node->targetSets))
         {
             destroySet.add(thisTargetSet.first);
         }
     }
     for (const auto& i : destroySet)
     {
-        this->m_targetSets.remove(i);
+        targetSets.remove(i);
     }
     // join made a invalid CapabilitySet
-    if (this->m_targetSets.getCount() == 0)
-        this->m_targetSets[CapabilityAtom::Invalid].target = CapabilityAtom::Invalid;
+    if (targetSets.getCount() == 0)
+        targetSets[CapabilityAtom::Invalid].target = CapabilityAtom::Invalid;
+    _setTargetSets(std::move(targetSets));
+
+    if (canCacheResult && m_node->isInterned)
+        cache.joins.set(node, other.m_node, UInt(m_node));
     return *this;
 }
 
@@ -807,12 +1239,12 @@ static uint32_t _calcAtomListDifferenceScore(
 
 bool CapabilitySet::hasSameTargets(const CapabilitySet& other) const
 {
-    for (const auto& i : this->m_targetSets)
+    for (const auto& i : getCapabilityTargetSets())
     {
-        if (!other.m_targetSets.tryGetValue(i.first))
+        if (!other.getCapabilityTargetSets().tryGetValue(i.first))
             return false;
     }
-    return this->m_targetSets.getCount() == other.m_targetSets.getCount();
+    return getCapabilityTargetSets().getCount() == other.getCapabilityTargetSets().getCount();
 }
 
 
@@ -834,15 +1266,15 @@ bool CapabilitySet::isBetterForTarget(
     }
 
     // required to have target.
-    for (auto& targetWeNeed : targetCaps.m_targetSets)
+    for (auto& targetWeNeed : targetCaps.getCapabilityTargetSets())
     {
-        auto thisTarget = this->m_targetSets.tryGetValue(targetWeNeed.first);
+        auto thisTarget = getCapabilityTargetSets().tryGetValue(targetWeNeed.first);
         if (!thisTarget)
         {
             isEqual = hasSameTargets(that);
             return false;
         }
-        auto thatTarget = that.m_targetSets.tryGetValue(targetWeNeed.first);
+        auto thatTarget = that.getCapabilityTargetSets().tryGetValue(targetWeNeed.first);
         if (!thatTarget)
         {
             isEqual = hasSameTargets(that);
@@ -993,9 +1425,9 @@ bool CapabilitySet::checkCapabilityRequirement(
 
     // if all sets in `available` are not a super-set to at least 1 `required` set, then we have an
     // err
-    for (auto& availableTarget : available.m_targetSets)
+    for (auto& availableTarget : available.getCapabilityTargetSets())
     {
-        auto reqTarget = required.m_targetSets.tryGetValue(availableTarget.first);
+        auto reqTarget = required.getCapabilityTargetSets().tryGetValue(availableTarget.first);
         if (!reqTarget)
         {
             outFailedAvailableSet.add((UInt)availableTarget.first);
@@ -1053,12 +1485,15 @@ inline CapabilityName maybeConvertSpirvVersionToGlslSpirvVersion(CapabilityName&
 
 void CapabilitySet::addSpirvVersionFromOtherAsGlslSpirvVersion(CapabilitySet& other)
 {
-    if (auto* otherTargetSet = other.m_targetSets.tryGetValue(CapabilityAtom::spirv))
+    if (auto* otherTargetSet = other.getCapabilityTargetSets().tryGetValue(CapabilityAtom::spirv))
     {
-        auto* thisTargetSet = m_targetSets.tryGetValue(CapabilityAtom::glsl);
-        if (!thisTargetSet)
+        if (!getCapabilityTargetSets().containsKey(CapabilityAtom::glsl))
             return;
 
+        // `other` may be this set, so its target sets are only replaced once they have been read.
+        CapabilityTargetSets targetSets = getCapabilityTargetSets();
+        auto* thisTargetSet = targetSets.tryGetValue(CapabilityAtom::glsl);
+
         for (auto& otherStageSet : otherTargetSet->shaderStageSets)
         {
             if (!otherStageSet.second.atomSet)
@@ -1086,6 +1521,7 @@ void CapabilitySet::addSpirvVersionFromOtherAsGlslSpirvVersion(CapabilitySet& ot
                 thisStageSet->atomSet->add((UInt)maybeConvertedSpirvVersionAtom);
             }
         }
+        _setTargetSets(std::move(targetSets));
     }
 }
 
@@ -1235,7 +1671,7 @@ int TEST_findTargetCapSet(CapabilitySet& capSet, CapabilityAtom target)
 
 int TEST_findTargetStage(CapabilitySet& capSet, CapabilityAtom target, CapabilityAtom stage)
 {
-    return capSet.getCapabilityTargetSets()[target].shaderStageSets.containsKey(stage);
+    return capSet.getCapabilityTargetSets().getValue(target).shaderStageSets.containsKey(stage);
 }
 
 
@@ -1245,8 +1681,9 @@ int TEST_targetCapSetWithSpecificAtomInStage(
     CapabilityAtom stage,
     CapabilityAtom atom)
 {
-    return capSet.getCapabilityTargetSets()[target].shaderStageSets[stage].atomSet->contains(
-        (UInt)atom);
+    auto& stageSet =
+        capSet.getCapabilityTargetSets().getValue(target).shaderStageSets.getValue(stage);
+    return stageSet.atomSet->contains((UInt)atom);
 }
 
 int TEST_targetCapSetWithSpecificSetInStage(
@@ -1257,11 +1694,12 @@ int TEST_targetCapSetWithSpecificSetInStage(
 {
 
     bool containsStageKey =
-        capSet.getCapabilityTargetSets()[target].shaderStageSets.containsKey(stage);
+        capSet.getCapabilityTargetSets().getValue(target).shaderStageSets.containsKey(stage);
     if (!containsStageKey)
         return 0;
 
-    auto& stageSet = capSet.getCapabilityTargetSets()[target].shaderStageSets[stage];
+    auto& stageSet =
+        capSet.getCapabilityTargetSets().getValue(target).shaderStageSets.getValue(stage);
     if (stage != stageSet.stage)
         return -1;
 
@@ -100,16 +100,28 @@ struct CapabilityTargetSet
     void unionWith(const CapabilityTargetSet& other);
 };
 
+struct CapabilitySetNode;
+
+/// A set of capabilities.
+///
+/// The contents of a capability set are stored in an immutable `CapabilitySetNode`, and a
+/// `CapabilitySet` is only a handle to its node, so copying a set is cheap. Nodes are
+/// interned, up to a fixed number shared by all sessions that live until `slang_shutdown`,
+/// and the results of `join`, `implies` and `isIncompatibleWith` on interned nodes are cached
+/// in tables of a fixed size. Past that number, sets get nodes of their own, which are freed
+/// with the last set using them. Operations that modify a set build new target sets and
+/// intern them.
 struct CapabilitySet
 {
 public:
     /// Default-construct an empty capability set
     CapabilitySet();
 
-    CapabilitySet(CapabilitySet const& other) = default;
-    CapabilitySet& operator=(CapabilitySet const& other) = default;
-    CapabilitySet(CapabilitySet&& other) = default;
-    CapabilitySet& operator=(CapabilitySet&& other) = default;
+    CapabilitySet(CapabilitySet const& other);
+    CapabilitySet& operator=(CapabilitySet const& other);
+    CapabilitySet(CapabilitySet&& other);
+    CapabilitySet& operator=(CapabilitySet&& other);
+    ~CapabilitySet();
 
     /// Construct a capability set from an explicit list of atomic capabilities
     CapabilitySet(Int atomCount, CapabilityName const* atoms);
@@ -120,6 +132,9 @@ public:
     /// Construct a singleton set from a single atomic capability
     explicit CapabilitySet(CapabilityName atom);
 
+    /// Construct a capability set with the given target sets
+    explicit CapabilitySet(CapabilityTargetSets&& targetSets);
+
     /// Make an empty capability set
     static CapabilitySet makeEmpty();
 
@@ -196,7 +211,8 @@ public:
     // For each element in `elementsToPermutateWith`, create and add a different conjunction
     // permutation by adding to `setToPermutate`.
     template<CapabilityName keyholeAtomToPermuteWith>
-    void addPermutationsOfConjunctionForEachInContainer(
+    static void addPermutationsOfConjunctionForEachInContainer(
+        CapabilityTargetSets& ioTargetSets,
         CapabilityAtomSet& setToPermutate,
         const CapabilityAtomSet& elementsToPermutateWith,
         CapabilityAtom knownTargetAtom,
@@ -204,14 +220,16 @@ public:
     // This is used for adding conjunctions directly and efficently, this is not functionally a
     // join. if `knownStage`/`knownTarget` is not CapabilityAtom::Invalid, the given atom will be
     // assumed as an assigned key atom (faster)
-    inline void addConjunction(
+    static void addConjunction(
+        CapabilityTargetSets& ioTargetSets,
         CapabilityAtomSet conjunction,
         CapabilityAtom knownTarget,
         CapabilityAtom knownStage);
-    inline void addUnexpandedCapabilites(CapabilityName atom);
+    static void addUnexpandedCapabilites(CapabilityTargetSets& ioTargetSets, CapabilityName atom);
 
-    CapabilityTargetSets& getCapabilityTargetSets() { return m_targetSets; }
-    const CapabilityTargetSets& getCapabilityTargetSets() const { return m_targetSets; }
+    /// Get the target sets of this capability set. They are shared by every equal set, and so
+    /// can't be modified.
+    const CapabilityTargetSets& getCapabilityTargetSets() const;
 
     // If this capability set uniquely implies one stage atom, return it. Otherwise returns
     // CapabilityAtom::Invalid.
@@ -309,7 +327,7 @@ public:
     {
         if (isEmpty() || isInvalid())
             return CapabilityAtom::Invalid;
-        return (*m_targetSets.begin()).first;
+        return (*getCapabilityTargetSets().begin()).first;
     }
 
     /// Gets the first valid stage found in the CapabilitySet
@@ -317,12 +335,18 @@ public:
     {
         if (isEmpty() || isInvalid())
             return CapabilityAtom::Invalid;
-        return (*(*m_targetSets.begin()).second.shaderStageSets.begin()).first;
+        return (*(*getCapabilityTargetSets().begin()).second.shaderStageSets.begin()).first;
     }
 
 private:
-    /// underlying data of CapabilitySet.
-    CapabilityTargetSets m_targetSets{};
+    /// The data of this set, or null if the set is empty.
+    const CapabilitySetNode* m_node = nullptr;
+
+    /// Make this set use `node`, keeping a reference to it if it isn't interned.
+    void _setNode(const CapabilitySetNode* node);
+
+    /// Replace the data of this set with the interned `targetSets`.
+    void _setTargetSets(CapabilityTargetSets&& targetSets);
 
     void addCapability(CapabilityName name);
 
@@ -378,6 +402,10 @@ bool hasTargetAtom(const CapabilityAtomSet& setIn, CapabilityAtom& targetAtom);
 
 void freeCapabilityDefs();
 
+/// Free every interned capability set, along with the cached results of operations on them.
+/// No capability set may be used after this, and no other thread may be using capability sets.
+void freeCapabilitySets();
+
 // #define UNIT_TEST_CAPABILITIES
 #ifdef UNIT_TEST_CAPABILITIES
 void TEST_CapabilitySet();
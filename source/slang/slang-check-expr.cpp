@@ -273,6 +273,10 @@ void addSiblingScopeForContainerDecl(ASTBuilder* builder, Scope* destScope, Cont
 
     subScope->nextSibling = destScope->nextSibling;
     destScope->nextSibling = subScope;
+
+    // Lookups through `destScope` can now find the members of `source`.
+    if (destScope->containerDecl)
+        destScope->containerDecl->invalidateCachedLookups();
 }
 
 void SemanticsVisitor::diagnoseDeprecatedDeclRefUsage(
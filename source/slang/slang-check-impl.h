@@ -314,17 +314,106 @@ struct ResolvedOperatorOverload
     // if this `candidate` is valid for the current session. If not, we will
     // recreate it from `decl`.
     OverloadCandidate candidate;
-    // The version of the TypeCheckingCache for which the cached candidate is valid.
-    int cacheVersion;
+    // The version of the TypeCheckingCache for which the cached candidate is valid,
+    // or 0 if there is no candidate, as in the frozen caches shared between linkages.
+    int cacheVersion = 0;
 };
 
+/// Caches the results of resolving core module operator overloads and of basic type conversions.
+///
+/// Caches are layered. A `Linkage` adds results to a cache of its own, and looks up results it
+/// doesn't have in `parent`, which is a frozen cache shared by all linkages of a global session.
+/// A frozen cache is never modified, so it can be read from several threads without a lock.
+/// Reference counts are not atomic though, so references to frozen caches are only added and
+/// released while holding the lock of the session (see `Session::publishTypeCheckingCache`).
 struct TypeCheckingCache : public RefObject
 {
+    /// Find the resolved overload for `key` in this cache or its parents. Only the decl is
+    /// taken from a parent, as the candidates of other linkages can't be used, and copying
+    /// one would change reference counts that other threads may be changing too.
+    bool tryGetResolvedOperatorOverload(
+        const OperatorOverloadCacheKey& key,
+        ResolvedOperatorOverload& outOverload)
+    {
+        const ResolvedOperatorOverload* overload = nullptr;
+        auto level = findLevel(&TypeCheckingCache::resolvedOperatorOverloadCache, key, overload);
+        if (level == this)
+        {
+            outOverload = *overload;
+        }
+        else if (level)
+        {
+            outOverload = ResolvedOperatorOverload();
+            outOverload.decl = overload->decl;
+        }
+        return _countLookup(level);
+    }
+
+    /// Find the conversion cost for `key` in this cache or its parents.
+    bool tryGetConversionCost(const BasicTypeKeyPair& key, ConversionCost& outCost)
+    {
+        const ConversionCost* cost = nullptr;
+        auto level = findLevel(&TypeCheckingCache::conversionCostCache, key, cost);
+        if (level)
+            outCost = *cost;
+        return _countLookup(level);
+    }
+
+    /// Find the level of this cache or of its parents that has a result for `key` in
+    /// `results`, or nullptr, and point `outValue` at the result. Unlike the `tryGet`
+    /// functions, this doesn't count the lookup, and doesn't copy the result, so it can be
+    /// used on frozen caches without changing reference counts.
+    template<typename TKey, typename TValue>
+    const TypeCheckingCache* findLevel(
+        Dictionary<TKey, TValue> TypeCheckingCache::*results,
+        const TKey& key,
+        const TValue*& outValue) const
+    {
+        for (const TypeCheckingCache* cache = this; cache; cache = cache->parent)
+        {
+            if (auto value = (cache->*results).tryGetValue(key))
+            {
+                outValue = value;
+                return cache;
+            }
+        }
+        return nullptr;
+    }
+
+    /// Results added to this level of the cache. The overloads of a frozen cache only have
+    /// their decl set.
     Dictionary<OperatorOverloadCacheKey, ResolvedOperatorOverload> resolvedOperatorOverloadCache;
     Dictionary<BasicTypeKeyPair, ConversionCost> conversionCostCache;
 
+    /// The frozen cache that is searched for results not in this level, or nullptr.
+    RefPtr<TypeCheckingCache> parent;
+    /// The number of levels in the chain of parents.
+    Index depth = 0;
+
     // The version used to invalidate the cached declRefs in ResolvedOperatorOverload entries.
+    // It is unique to the linkage that owns the cache.
     int version = 0;
+
+    /// The number of lookups that found a result in this level, found one in a parent, or
+    /// found none.
+    Index hitCount = 0;
+    Index parentHitCount = 0;
+    Index missCount = 0;
+
+private:
+    bool _countLookup(const TypeCheckingCache* level)
+    {
+        if (!level)
+        {
+            missCount++;
+            return false;
+        }
+        if (level == this)
+            hitCount++;
+        else
+            parentHitCount++;
+        return true;
+    }
 };
 
 enum class CoercionSite
@@ -636,6 +725,55 @@ struct ImplicitCastMethodKey
     }
 };
 
+/// Identifies a lookup of a name that starts from a module or namespace scope.
+struct LookupCacheKey
+{
+    ASTBuilder* astBuilder;
+    Scope* scope;
+    Name* name;
+    LookupMask mask;
+    LookupOptions options;
+    HashCode getHashCode() const
+    {
+        return combineHash(
+            Slang::getHashCode(astBuilder),
+            Slang::getHashCode(scope),
+            Slang::getHashCode(name),
+            (HashCode32)mask,
+            (HashCode32)options);
+    }
+    bool operator==(const LookupCacheKey& other) const
+    {
+        return astBuilder == other.astBuilder && scope == other.scope && name == other.name &&
+               mask == other.mask && options == other.options;
+    }
+};
+
+/// A cached result of a lookup that started from a module or namespace scope.
+struct CachedLookupResult
+{
+    LookupResult result;
+    /// The lookup version of the linkages the lookup could reach when it was
+    /// performed, see `Linkage::getLookupVersion`.
+    UInt version = 0;
+};
+
+/// The cached results of lookups that start from module or namespace scopes.
+///
+/// A result is only valid while the version of the linkages it could reach is
+/// the same as when it was found.
+struct LookupCache
+{
+    ~LookupCache();
+
+    Dictionary<LookupCacheKey, CachedLookupResult> results;
+
+    /// The number of lookups that used a cached result.
+    Count hitCount = 0;
+    /// The number of lookups that could be cached but had to be performed.
+    Count missCount = 0;
+};
+
 /// Used to track offsets for atomic counter storage qualifiers.
 struct GLSLBindingOffsetTracker
 {
@@ -785,6 +923,8 @@ public:
         m_mapTypePairToImplicitCastMethod[key] = candidate;
     }
 
+    LookupCache& getLookupCache() { return m_lookupCache; }
+
     bool* isCStyleType(Type* type) { return m_isCStyleTypeCache.tryGetValue(type); }
 
     void cacheCStyleType(Type* type, bool isCStyle)
@@ -921,6 +1061,7 @@ private:
     Dictionary<TypePair, SubtypeWitness*> m_mapTypePairToSubtypeWitness;
     Dictionary<ImplicitCastMethodKey, ImplicitCastMethod> m_mapTypePairToImplicitCastMethod;
     Dictionary<Type*, bool> m_isCStyleTypeCache;
+    LookupCache m_lookupCache;
 };
 
 /// Local/scoped state of the semantic-checking system
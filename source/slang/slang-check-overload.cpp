@@ -2650,12 +2650,11 @@ Expr* SemanticsVisitor::ResolveInvoke(InvokeExpr* expr)
         {
             key.isGLSLMode = getShared()->glslModuleDecl != nullptr;
             ResolvedOperatorOverload candidate;
-            if (typeCheckingCache->resolvedOperatorOverloadCache.tryGetValue(key, candidate))
+            if (typeCheckingCache->tryGetResolvedOperatorOverload(key, candidate))
             {
-                // We should only use the cached candidate if it is persistent direct declref
-                // created from GlobalSession's ASTBuilder, or it is created in the current Linkage.
-                if (candidate.cacheVersion == typeCheckingCache->version ||
-                    findNextOuterGeneric(candidate.decl) == nullptr)
+                // We can only use the cached candidate if it was created in the current
+                // Linkage. The results of other linkages only have the decl.
+                if (candidate.cacheVersion == typeCheckingCache->version)
                 {
                     context.bestCandidateStorage = candidate.candidate;
                     context.bestCandidate = &context.bestCandidateStorage;
@@ -88,6 +88,9 @@ IDownstreamCompiler* Session::getOrLoadDownstreamCompiler(
     PassThroughMode type,
     DiagnosticSink* sink)
 {
+    // Code generation for different targets may run in parallel, and load compilers on demand.
+    std::lock_guard<std::recursive_mutex> lock(m_downstreamCompilerMutex);
+
     if (m_downstreamCompilerInitialized & (1 << int(type)))
     {
         return m_downstreamCompilers[int(type)];
@@ -167,6 +167,22 @@ void CompilerOptionSet::buildHash(DigestBuilder<SHA1>& builder)
 {
     for (auto& kv : options)
     {
+        // The location of the compilation cache, the number of code generation and import
+        // threads, where to write a profile and how precompiled modules are read do not affect
+        // the generated code, and must not affect the keys used for the cache.
+        switch (kv.key)
+        {
+        case CompilerOptionName::CompilationCacheDirectory:
+        case CompilerOptionName::CompilationCacheMaxEntryCount:
+        case CompilerOptionName::CodeGenThreadCount:
+        case CompilerOptionName::ReportPerfTrace:
+        case CompilerOptionName::ImportThreadCount:
+        case CompilerOptionName::MapBinaryModules:
+            continue;
+        default:
+            break;
+        }
+
         builder.append(kv.key);
         builder.append(kv.value.getCount());
         for (auto& v : kv.value)
@@ -17,8 +17,10 @@
 #include "slang-check.h"
 
 #include <chrono>
+#include <exception>
 
 // Artifact
+#include "../compiler-core/slang-artifact-associated-impl.h"
 #include "../compiler-core/slang-artifact-associated.h"
 #include "../compiler-core/slang-artifact-container-util.h"
 #include "../compiler-core/slang-artifact-desc-util.h"
@@ -31,6 +33,8 @@
 #include "slang-artifact-output-util.h"
 #include "slang-emit-cuda.h"
 #include "slang-extension-tracker.h"
+#include "slang-ir-link.h"
+#include "slang-ir-specialize-dispatch.h"
 #include "slang-lower-to-ir.h"
 #include "slang-mangle.h"
 #include "slang-parameter-binding.h"
@@ -1882,31 +1886,37 @@ SlangResult CodeGenContext::emitWithDownstreamForEntryPoints(ComPtr<IArtifact>&
 
     auto program = getProgram();
 
-    // Load embedded precompiled libraries from IR into library artifacts
-    program->enumerateIRModules(
-        [&](IRModule* irModule)
+    // Load embedded precompiled libraries from IR into library artifacts.
+    // Modules with unread serialized IR are only read if they could have any.
+    auto visitModule = [&](IRModule* irModule)
+    {
+        for (auto globalInst : irModule->getModuleInst()->getChildren())
         {
-            for (auto globalInst : irModule->getModuleInst()->getChildren())
+            if (target == CodeGenTarget::DXILAssembly || target == CodeGenTarget::DXIL)
             {
-                if (target == CodeGenTarget::DXILAssembly || target == CodeGenTarget::DXIL)
+                if (auto inst = as<IREmbeddedDownstreamIR>(globalInst))
                 {
-                    if (auto inst = as<IREmbeddedDownstreamIR>(globalInst))
+                    if (inst->getTarget() == CodeGenTarget::DXIL)
                     {
-                        if (inst->getTarget() == CodeGenTarget::DXIL)
-                        {
-                            auto slice = inst->getBlob()->getStringSlice();
-                            ArtifactDesc desc =
-                                ArtifactDescUtil::makeDescForCompileTarget(SLANG_DXIL);
-                            desc.kind = ArtifactKind::Library;
-
-                            auto library = ArtifactUtil::createArtifact(desc);
-
-                            library->addRepresentationUnknown(StringBlob::create(slice));
-                            libraries.add(library);
-                        }
+                        auto slice = inst->getBlob()->getStringSlice();
+                        ArtifactDesc desc = ArtifactDescUtil::makeDescForCompileTarget(SLANG_DXIL);
+                        desc.kind = ArtifactKind::Library;
+
+                        auto library = ArtifactUtil::createArtifact(desc);
+
+                        library->addRepresentationUnknown(StringBlob::create(slice));
+                        libraries.add(library);
                     }
                 }
             }
+        }
+    };
+    program->enumerateIRModules(
+        visitModule,
+        [&](Module* module)
+        {
+            if (module->mayHaveUnconditionalIRInsts())
+                visitModule(module->getIRModule(getSink()));
         });
 
     options.compilerSpecificArguments = allocator.allocate(compilerSpecificArguments);
@@ -2091,6 +2101,15 @@ struct CompileTimerRAII
     }
 };
 
+static void _addBytesEmittedCounter(IArtifact* artifact)
+{
+    // Only count output that is already in memory, to avoid producing it just for this.
+    if (auto blob = artifact ? findRepresentation<ISlangBlob>(artifact) : nullptr)
+    {
+        SLANG_PROFILE_COUNTER(bytesEmitted, blob->getBufferSize());
+    }
+}
+
 // Do emit logic for a zero or more entry points
 SlangResult CodeGenContext::emitEntryPoints(ComPtr<IArtifact>& outArtifact)
 {
@@ -2120,6 +2139,7 @@ SlangResult CodeGenContext::emitEntryPoints(ComPtr<IArtifact>& outArtifact)
             SLANG_RETURN_ON_FAIL(_emitEntryPoints(outArtifact));
 
             maybeDumpIntermediate(outArtifact);
+            _addBytesEmittedCounter(outArtifact);
             return SLANG_OK;
         }
         break;
@@ -2142,6 +2162,7 @@ SlangResult CodeGenContext::emitEntryPoints(ComPtr<IArtifact>& outArtifact)
             SLANG_RETURN_ON_FAIL(subContext.emitEntryPointsSource(sourceArtifact));
 
             subContext.maybeDumpIntermediate(sourceArtifact);
+            _addBytesEmittedCounter(sourceArtifact);
             outArtifact = sourceArtifact;
             return SLANG_OK;
         }
@@ -2348,14 +2369,270 @@ IArtifact* TargetProgram::_createEntryPointResult(
     CodeGenContext::EntryPointIndices entryPointIndices;
     entryPointIndices.add(entryPointIndex);
 
-    CodeGenContext::Shared sharedCodeGenContext(this, entryPointIndices, sink, endToEndReq);
+    // The diagnostics of code generation are stored in the persistent cache along
+    // with the code, so that they are reported again when the code is read from it.
+    // They are collected by a sink that passes them on to `sink`.
+    const bool usesCache = m_program->getLinkage()->getPersistentCache() != nullptr;
+    DiagnosticSink codeGenSink;
+    if (usesCache)
+    {
+        codeGenSink.initFrom(*sink);
+        codeGenSink.setParentSink(sink);
+    }
+
+    CodeGenContext::Shared sharedCodeGenContext(
+        this,
+        entryPointIndices,
+        usesCache ? &codeGenSink : sink,
+        endToEndReq);
     CodeGenContext codeGenContext(&sharedCodeGenContext);
 
     codeGenContext.emitEntryPoints(m_entryPointResults[entryPointIndex]);
 
+    // Pass-through compiles generate code from the source of a translation
+    // unit, which is not reflected in the entry point hash.
+    if (usesCache && sink->getErrorCount() == 0 &&
+        (!endToEndReq || endToEndReq->m_passThrough == PassThroughMode::None))
+    {
+        _writeEntryPointResultToCache(
+            entryPointIndex,
+            m_entryPointResults[entryPointIndex],
+            codeGenSink.outputBuffer.getUnownedSlice());
+    }
+
     return m_entryPointResults[entryPointIndex];
 }
 
+bool TargetProgram::_getEntryPointCacheKey(Int entryPointIndex, PersistentCache::Key& outKey)
+{
+    auto linkage = m_program->getLinkage();
+    if (!linkage->getPersistentCache())
+        return false;
+
+    // Results that are loaded as shared libraries, or that come with a
+    // separate debug artifact, can't be represented by a single cached blob.
+    switch (m_targetReq->getTarget())
+    {
+    case CodeGenTarget::HostHostCallable:
+    case CodeGenTarget::ShaderHostCallable:
+        return false;
+    default:
+        break;
+    }
+    if (m_optionSet.shouldEmitSeparateDebugInfo())
+        return false;
+
+    // The entry point hash is computed for a target of the linkage.
+    const Index targetIndex = linkage->targets.findFirstIndex(
+        [&](const RefPtr<TargetRequest>& targetReq) { return targetReq.get() == m_targetReq; });
+    if (targetIndex < 0)
+        return false;
+
+    ComPtr<ISlangBlob> hashBlob;
+    m_program->getEntryPointHash(entryPointIndex, targetIndex, hashBlob.writeRef());
+    if (!hashBlob)
+        return false;
+
+    outKey = PersistentCache::Key(hashBlob);
+    return true;
+}
+
+// The result of an entry point in the persistent cache is a RIFF holding the code, along
+// with the diagnostics and metadata that were produced with it.
+static const FourCC::RawValue kCachedEntryPointFourCC = SLANG_FOUR_CC('S', 'E', 'P', 'R');
+static const FourCC::RawValue kCachedCodeFourCC = SLANG_FOUR_CC('c', 'o', 'd', 'e');
+static const FourCC::RawValue kCachedDiagnosticsFourCC = SLANG_FOUR_CC('d', 'i', 'a', 'g');
+static const FourCC::RawValue kCachedMetadataFourCC = SLANG_FOUR_CC('m', 'e', 't', 'a');
+static const FourCC::RawValue kCachedBindingRangesFourCC = SLANG_FOUR_CC('b', 'i', 'n', 'd');
+static const FourCC::RawValue kCachedExportedNamesFourCC = SLANG_FOUR_CC('e', 'x', 'p', 'n');
+static const FourCC::RawValue kCachedDebugBuildIdFourCC = SLANG_FOUR_CC('d', 'b', 'g', 'i');
+
+static SlangResult _writeCachedEntryPoint(
+    ISlangBlob* code,
+    const UnownedStringSlice& diagnostics,
+    IArtifactPostEmitMetadata* metadata,
+    ISlangBlob** outBlob)
+{
+    RIFF::Builder riff;
+    RIFF::BuildCursor cursor(riff);
+
+    SLANG_SCOPED_RIFF_BUILDER_LIST_CHUNK(cursor, kCachedEntryPointFourCC);
+    cursor.addDataChunk(kCachedCodeFourCC, code->getBufferPointer(), code->getBufferSize());
+    cursor.addDataChunk(kCachedDiagnosticsFourCC, diagnostics.begin(), diagnostics.getLength());
+
+    if (metadata)
+    {
+        SLANG_SCOPED_RIFF_BUILDER_LIST_CHUNK(cursor, kCachedMetadataFourCC);
+        {
+            SLANG_SCOPED_RIFF_BUILDER_DATA_CHUNK(cursor, kCachedBindingRangesFourCC);
+            for (const auto& range : metadata->getUsedBindingRanges())
+            {
+                cursor.addData(UInt64(range.category));
+                cursor.addData(UInt64(range.spaceIndex));
+                cursor.addData(UInt64(range.registerIndex));
+                cursor.addData(UInt64(range.registerCount));
+            }
+        }
+        {
+            // The names are stored with their terminators.
+            SLANG_SCOPED_RIFF_BUILDER_DATA_CHUNK(cursor, kCachedExportedNamesFourCC);
+            for (const auto& name : metadata->getExportedFunctionMangledNames())
+            {
+                cursor.addData(name.getBuffer(), name.getLength() + 1);
+            }
+        }
+        if (auto debugBuildId = metadata->getDebugBuildIdentifier())
+        {
+            cursor.addDataChunk(kCachedDebugBuildIdFourCC, debugBuildId, strlen(debugBuildId));
+        }
+    }
+
+    return riff.writeToBlob(outBlob);
+}
+
+/// Read an entry point result written by `_writeCachedEntryPoint`.
+/// Returns nullptr if `blob` does not hold one.
+static ComPtr<ISlangBlob> _readCachedEntryPoint(
+    ISlangBlob* blob,
+    String& outDiagnostics,
+    ComPtr<IArtifactPostEmitMetadata>& outMetadata)
+{
+    auto rootChunk = RIFF::RootChunk::getFromBlob(blob);
+    if (!rootChunk || rootChunk->getType() != kCachedEntryPointFourCC)
+        return nullptr;
+
+    auto codeChunk = rootChunk->findDataChunk(kCachedCodeFourCC);
+    auto diagnosticsChunk = rootChunk->findDataChunk(kCachedDiagnosticsFourCC);
+    if (!codeChunk || !diagnosticsChunk)
+        return nullptr;
+
+    outDiagnostics = UnownedStringSlice(
+        (const char*)diagnosticsChunk->getPayload(),
+        diagnosticsChunk->getPayloadSize());
+
+    if (auto metadataChunk = rootChunk->findListChunk(kCachedMetadataFourCC))
+    {
+        auto metadata = new ArtifactPostEmitMetadata;
+        outMetadata = metadata;
+
+        if (auto rangesChunk = metadataChunk->findDataChunk(kCachedBindingRangesFourCC))
+        {
+            MemoryReader reader(rangesChunk->getPayload(), rangesChunk->getPayloadSize());
+            UInt64 fields[4];
+            while (SLANG_SUCCEEDED(reader.read(fields, sizeof(fields))))
+            {
+                ShaderBindingRange range;
+                range.category = slang::ParameterCategory(fields[0]);
+                range.spaceIndex = UInt(fields[1]);
+                range.registerIndex = UInt(fields[2]);
+                range.registerCount = UInt(fields[3]);
+                metadata->m_usedBindings.add(range);
+            }
+        }
+        if (auto namesChunk = metadataChunk->findDataChunk(kCachedExportedNamesFourCC))
+        {
+            auto names = (const char*)namesChunk->getPayload();
+            auto namesEnd = names + namesChunk->getPayloadSize();
+            while (names < namesEnd)
+            {
+                auto nameEnd = (const char*)memchr(names, 0, namesEnd - names);
+                if (!nameEnd)
+                    return nullptr;
+                metadata->m_exportedFunctionMangledNames.add(
+                    UnownedStringSlice(names, nameEnd));
+                names = nameEnd + 1;
+            }
+        }
+        if (auto debugBuildIdChunk = metadataChunk->findDataChunk(kCachedDebugBuildIdFourCC))
+        {
+            metadata->m_debugBuildIdentifier = UnownedStringSlice(
+                (const char*)debugBuildIdChunk->getPayload(),
+                debugBuildIdChunk->getPayloadSize());
+        }
+    }
+
+    return RawBlob::create(codeChunk->getPayload(), codeChunk->getPayloadSize());
+}
+
+IArtifact* TargetProgram::_readEntryPointResultFromCache(Int entryPointIndex, DiagnosticSink* sink)
+{
+    auto cache = m_program->getLinkage()->getPersistentCache();
+    if (!cache)
+        return nullptr;
+
+    // Only the diagnostics of code generation are stored with the code, so the program is
+    // laid out before the cache is read, and the key is computed after that. Layout is not
+    // repeated if it has already been done, and if it failed nothing is read.
+    if (!getOrCreateIRModuleForLayout(sink) || sink->getErrorCount() != 0)
+        return nullptr;
+
+    PersistentCache::Key key;
+    if (!_getEntryPointCacheKey(entryPointIndex, key))
+        return nullptr;
+
+    ComPtr<ISlangBlob> cachedBlob;
+    if (SLANG_FAILED(cache->readEntry(key, cachedBlob.writeRef())))
+        return nullptr;
+
+    String diagnostics;
+    ComPtr<IArtifactPostEmitMetadata> metadata;
+    auto code = _readCachedEntryPoint(cachedBlob, diagnostics, metadata);
+    if (!code)
+        return nullptr;
+
+    auto artifact =
+        ArtifactUtil::createArtifactForCompileTarget(asExternal(m_targetReq->getTarget()));
+    artifact->addRepresentationUnknown(code);
+    ArtifactUtil::addAssociated(artifact, metadata);
+
+    // Only results without errors are cached, so any diagnostics are warnings (or notes).
+    if (diagnostics.getLength())
+        sink->diagnoseRaw(Severity::Warning, diagnostics.getUnownedSlice());
+
+    if (entryPointIndex >= m_entryPointResults.getCount())
+        m_entryPointResults.setCount(entryPointIndex + 1);
+    m_entryPointResults[entryPointIndex] = artifact;
+
+    return artifact;
+}
+
+void TargetProgram::_writeEntryPointResultToCache(
+    Int entryPointIndex,
+    IArtifact* artifact,
+    const UnownedStringSlice& diagnostics)
+{
+    if (!artifact)
+        return;
+
+    PersistentCache::Key key;
+    if (!_getEntryPointCacheKey(entryPointIndex, key))
+        return;
+
+    // Other artifacts associated with the result, such as source maps, are not
+    // stored, so such results are not cached.
+    for (auto associated : artifact->getAssociated())
+    {
+        if (associated->getDesc().payload != ArtifactPayload::PostEmitMetadata &&
+            associated->getDesc().payload != ArtifactPayload::Diagnostics)
+        {
+            return;
+        }
+    }
+
+    // Failing to write to the cache is not an error, the
+    // result will just be generated again next time.
+    ComPtr<ISlangBlob> code;
+    if (SLANG_FAILED(artifact->loadBlob(ArtifactKeep::Yes, code.writeRef())))
+        return;
+
+    auto metadata = findAssociatedRepresentation<IArtifactPostEmitMetadata>(artifact);
+    ComPtr<ISlangBlob> cachedBlob;
+    if (SLANG_SUCCEEDED(_writeCachedEntryPoint(code, diagnostics, metadata, cachedBlob.writeRef())))
+    {
+        m_program->getLinkage()->getPersistentCache()->writeEntry(key, cachedBlob);
+    }
+}
+
 IArtifact* TargetProgram::getOrCreateWholeProgramResult(DiagnosticSink* sink)
 {
     if (m_wholeProgramResult)
@@ -2390,6 +2667,12 @@ IArtifact* TargetProgram::getOrCreateEntryPointResult(Int entryPointIndex, Diagn
         return nullptr;
     }
 
+    // If the code is in the persistent compilation cache, there
+    // is no need to generate it.
+    //
+    if (IArtifact* artifact = _readEntryPointResultFromCache(entryPointIndex, sink))
+        return artifact;
+
     return _createEntryPointResult(entryPointIndex, sink);
 }
 
@@ -2408,6 +2691,11 @@ void EndToEndCompileRequest::generateOutput(TargetProgram* targetProgram)
     {
         for (Index ii = 0; ii < entryPointCount; ++ii)
         {
+            if (m_passThrough == PassThroughMode::None &&
+                targetProgram->_readEntryPointResultFromCache(ii, getSink()))
+            {
+                continue;
+            }
             targetProgram->_createEntryPointResult(ii, getSink(), this);
         }
     }
@@ -2765,6 +3053,15 @@ void EndToEndCompileRequest::generateOutput(ComponentType* program)
     // has specified, and generate code for each of them.
     //
     auto linkage = getLinkage();
+    if (m_passThrough == PassThroughMode::None)
+    {
+        if (auto threadPool = linkage->getCodeGenThreadPool())
+        {
+            _generateOutputInParallel(program, threadPool);
+            return;
+        }
+    }
+
     for (auto targetReq : linkage->targets)
     {
         if (targetReq->getOptionSet().getBoolOption(CompilerOptionName::EmbedDownstreamIR))
@@ -2775,6 +3072,147 @@ void EndToEndCompileRequest::generateOutput(ComponentType* program)
     }
 }
 
+void EndToEndCompileRequest::_assignWitnessTableSequentialIDs(ComponentType* program)
+{
+    // The witness tables in serialized modules that haven't been read yet get their
+    // IDs when they are linked, in the same way they would without this.
+    List<IRModule*> irModules;
+    program->enumerateIRModules(
+        [&](IRModule* irModule) { irModules.add(irModule); },
+        [](Module*) {});
+    assignWitnessTableSequentialIDs(getLinkage(), irModules);
+}
+
+void EndToEndCompileRequest::_generateOutputInParallel(
+    ComponentType* program,
+    ThreadPool* threadPool)
+{
+    auto linkage = getLinkage();
+
+    // Every (target, entry point) pair that needs code generation becomes a task.
+    // A task without an entry point generates the whole program result of its target.
+    //
+    // The tasks are ordered in the same way a serial compile visits them, which is the
+    // order their diagnostics are reported in below.
+    //
+    struct CodeGenTask
+    {
+        TargetProgram* targetProgram;
+        Int entryPointIndex;
+        /// Set if the result was read from the persistent cache.
+        bool isCached = false;
+    };
+    List<CodeGenTask> tasks;
+
+    // The link index of a module is built on demand, which isn't thread-safe, so we
+    // build the indices of the modules of the program up front. This also reads the
+    // modules of the program that were loaded from serialized data, so that their
+    // witness tables are numbered below. The builtin modules are left to be read on
+    // demand by the tasks, since each task only needs a small part of them, and
+    // reading from a serialized module is thread-safe.
+    program->enumerateIRModules([](IRModule* irModule) { getIRModuleLinkIndex(irModule); });
+
+    // The tasks would allocate the IDs of witness tables in whatever order they get to
+    // them, so the IDs are allocated up front instead.
+    _assignWitnessTableSequentialIDs(program);
+
+    const auto entryPointCount = program->getEntryPointCount();
+    for (auto targetReq : linkage->targets)
+    {
+        if (targetReq->getOptionSet().getBoolOption(CompilerOptionName::EmbedDownstreamIR))
+            continue;
+
+        auto targetProgram = program->getTargetProgram(targetReq);
+        if (targetProgram->getOptionSet().getBoolOption(CompilerOptionName::GenerateWholeProgram))
+        {
+            tasks.add(CodeGenTask{targetProgram, -1});
+            continue;
+        }
+
+        // Results for different entry points are written concurrently, so the
+        // storage for them has to exist up front.
+        targetProgram->_reserveEntryPointResults(entryPointCount);
+        for (Index ii = 0; ii < entryPointCount; ++ii)
+        {
+            tasks.add(CodeGenTask{targetProgram, ii});
+        }
+    }
+
+    // Each task reports to its own sink, because a `DiagnosticSink` can't be shared
+    // between threads, and so that diagnostics don't depend on scheduling.
+    const Count taskCount = tasks.getCount();
+    List<DiagnosticSink> sinks;
+    sinks.setCount(taskCount);
+    List<std::exception_ptr> exceptions;
+    exceptions.setCount(taskCount);
+    for (auto& sink : sinks)
+        sink.initFrom(*getSink());
+
+    // Results are read from the cache up front, into the sinks of their tasks, so that
+    // their diagnostics are reported in the same order as those of generated results.
+    for (Index taskIndex = 0; taskIndex < taskCount; ++taskIndex)
+    {
+        auto& task = tasks[taskIndex];
+        if (task.entryPointIndex < 0)
+            continue;
+        auto artifact = task.targetProgram->_readEntryPointResultFromCache(
+            task.entryPointIndex,
+            &sinks[taskIndex]);
+        task.isCached = artifact != nullptr;
+    }
+
+    // Code generation can still create AST nodes, such as types for layout, and
+    // resolve vals, so the tasks share the builder under its lock.
+    ASTBuilder* astBuilder = getCurrentASTBuilder();
+    astBuilder->setUsedFromMultipleThreads(true);
+
+    threadPool->forEach(
+        taskCount,
+        [&](Index taskIndex)
+        {
+            SLANG_AST_BUILDER_RAII(astBuilder);
+
+            const auto& task = tasks[taskIndex];
+            if (task.isCached)
+                return;
+            auto sink = &sinks[taskIndex];
+            try
+            {
+                if (task.entryPointIndex < 0)
+                    task.targetProgram->_createWholeProgramResult(sink, this);
+                else
+                    task.targetProgram->_createEntryPointResult(task.entryPointIndex, sink, this);
+            }
+            catch (...)
+            {
+                // Exceptions (such as for a fatal diagnostic) are rethrown on
+                // the calling thread once the diagnostics have been reported.
+                exceptions[taskIndex] = std::current_exception();
+            }
+        });
+
+    astBuilder->setUsedFromMultipleThreads(false);
+
+    // Report diagnostics in task order. A serial compile stops at the first exception,
+    // so the diagnostics of any later tasks are dropped.
+    auto sink = getSink();
+    for (Index taskIndex = 0; taskIndex < taskCount; ++taskIndex)
+    {
+        auto& taskSink = sinks[taskIndex];
+        if (taskSink.outputBuffer.getLength() || taskSink.getErrorCount())
+        {
+            sink->diagnoseRaw(
+                taskSink.getErrorCount() ? Severity::Error : Severity::Warning,
+                taskSink.outputBuffer.getUnownedSlice());
+        }
+
+        if (exceptions[taskIndex])
+        {
+            std::rethrow_exception(exceptions[taskIndex]);
+        }
+    }
+}
+
 void EndToEndCompileRequest::generateOutput()
 {
     SLANG_PROFILE;
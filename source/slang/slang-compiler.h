@@ -13,6 +13,9 @@
 #include "../core/slang-command-options.h"
 #include "../core/slang-crypto.h"
 #include "../core/slang-file-system.h"
+#include "../core/slang-performance-profiler.h"
+#include "../core/slang-persistent-cache.h"
+#include "../core/slang-thread-pool.h"
 #include "../core/slang-shared-library.h"
 #include "../core/slang-std-writers.h"
 #include "slang-capability.h"
@@ -24,10 +27,14 @@
 #include "slang-preprocessor.h"
 #include "slang-profile.h"
 #include "slang-serialize-ir-types.h"
+#include "slang-serialize-ir.h"
 #include "slang-syntax.h"
 #include "slang.h"
 
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <mutex>
 
 namespace Slang
 {
@@ -492,6 +499,41 @@ public:
         enumerateIRModules(&Helper::helper, (void*)&callback);
     }
 
+    /// Callback for use with `enumerateIRModules`, for modules with IR that hasn't been read
+    typedef void (*EnumerateUnreadIRModulesCallback)(Module* module, void* userData);
+
+    /// Invoke `callback` on all the IR modules that are (transitively) linked into this component
+    /// type, except for modules whose serialized IR hasn't been read, which are passed to
+    /// `unreadCallback` instead. This allows the caller to decide whether to read them.
+    void enumerateIRModules(
+        EnumerateIRModulesCallback callback,
+        EnumerateUnreadIRModulesCallback unreadCallback,
+        void* userData);
+
+    /// Invoke `callback` on all the IR modules that are (transitively) linked into this component
+    /// type, except for modules whose serialized IR hasn't been read, which are passed to
+    /// `unreadCallback` instead.
+    template<typename F, typename G>
+    void enumerateIRModules(F const& callback, G const& unreadCallback)
+    {
+        struct Helper
+        {
+            F const& callback;
+            G const& unreadCallback;
+
+            static void helper(IRModule* irModule, void* userData)
+            {
+                ((Helper*)userData)->callback(irModule);
+            }
+            static void unreadHelper(Module* module, void* userData)
+            {
+                ((Helper*)userData)->unreadCallback(module);
+            }
+        };
+        Helper helper{callback, unreadCallback};
+        enumerateIRModules(&Helper::helper, &Helper::unreadHelper, (void*)&helper);
+    }
+
     /// Callback for use with `enumerateModules`
     typedef void (*EnumerateModulesCallback)(Module* module, void* userData);
 
@@ -1715,7 +1757,42 @@ public:
     ModuleDecl* getModuleDecl() { return m_moduleDecl; }
 
     /// The the IR for the module (if it has been generated)
-    IRModule* getIRModule() { return m_irModule; }
+    ///
+    /// If the module was loaded from serialized data that hasn't been read
+    /// yet, the IR is read first.
+    ///
+    /// If reading the IR fails, the module gets an empty IR module. Use the
+    /// overload that takes a sink where the failure should be reported.
+    IRModule* getIRModule()
+    {
+        if (m_hasUnreadSerializedIRModule)
+            _readSerializedIRModule();
+        return m_irModule;
+    }
+
+    /// Get the IR for the module, reading it first if needed, and report to `sink`
+    /// if the serialized IR of the module couldn't be read.
+    IRModule* getIRModule(DiagnosticSink* sink);
+
+    /// Get the serialized IR for the module, if it hasn't been read yet.
+    ///
+    /// This allows queries of the serialized IR (such as whether it defines a
+    /// symbol), and reading parts of it, without reading all of it.
+    SerializedIRModule* getUnreadSerializedIRModule()
+    {
+        return m_hasUnreadSerializedIRModule ? m_serializedIRModule.Ptr() : nullptr;
+    }
+
+    /// Whether the IR of the module may have instructions that are used whether
+    /// or not any of its symbols are referenced (see `IRModuleLinkRequirements`).
+    ///
+    /// This doesn't read the IR of the module.
+    bool mayHaveUnconditionalIRInsts()
+    {
+        auto serializedIRModule = getUnreadSerializedIRModule();
+        return !serializedIRModule ||
+               serializedIRModule->getLinkRequirements().hasUnconditionalInsts;
+    }
 
     /// Get the list of other modules this module depends on
     List<Module*> const& getModuleDependencyList()
@@ -1751,6 +1828,18 @@ public:
     ///
     void setIRModule(IRModule* irModule) { m_irModule = irModule; }
 
+    /// Set serialized IR for this module, to be read the first time the IR
+    /// is needed.
+    ///
+    /// This should only be called once, during creation of the module, and
+    /// instead of `setIRModule`.
+    ///
+    void setSerializedIRModule(SerializedIRModule* serializedIRModule)
+    {
+        m_serializedIRModule = serializedIRModule;
+        m_hasUnreadSerializedIRModule = serializedIRModule != nullptr;
+    }
+
     Index getEntryPointCount() SLANG_OVERRIDE { return 0; }
     RefPtr<EntryPoint> getEntryPoint(Index index) SLANG_OVERRIDE
     {
@@ -1874,6 +1963,16 @@ private:
     // The IR for the module
     RefPtr<IRModule> m_irModule = nullptr;
 
+    void _readSerializedIRModule();
+
+    // The serialized IR for the module, if it is read on demand. This is kept
+    // after the whole module has been read, because a linker on another thread
+    // may still be reading parts of it.
+    RefPtr<SerializedIRModule> m_serializedIRModule;
+    std::atomic<bool> m_hasUnreadSerializedIRModule{false};
+    SlangResult m_serializedIRModuleReadResult = SLANG_OK;
+    std::mutex m_serializedIRModuleMutex;
+
     List<ShaderParamInfo> m_shaderParams;
     SpecializationParams m_specializationParams;
 
@@ -2337,6 +2436,18 @@ public:
     /// Get the parent session for this linkage
     Session* getSessionImpl() { return m_session; }
 
+    /// Get a number that changes whenever the members of a container decl in a
+    /// module of this linkage change, or a module scope gets a new sibling scope.
+    ///
+    /// Lookups that start from module and namespace scopes are cached, and a
+    /// cached result is only used while the versions of the linkage doing the
+    /// lookup and of the builtin linkage are unchanged.
+    ///
+    UInt getLookupVersion() const { return m_lookupVersion.load(std::memory_order_relaxed); }
+
+    /// Make the cached results of lookups through the modules of this linkage invalid.
+    void invalidateCachedLookups() { m_lookupVersion.fetch_add(1, std::memory_order_relaxed); }
+
     // Information on the targets we are being asked to
     // generate code for.
     List<RefPtr<TargetRequest>> targets;
@@ -2357,6 +2468,10 @@ public:
 
     NamePool* getNamePool() { return &namePool; }
 
+    // Tokens of files included by the preprocessor, shared by all the modules
+    // and translation units preprocessed with this linkage.
+    PreprocessorTokenCache preprocessorTokenCache;
+
     ASTBuilder* getASTBuilder() { return m_astBuilder; }
 
     RefPtr<ASTBuilder> m_astBuilder;
@@ -2370,6 +2485,177 @@ public:
 
     RefPtr<RefObject> m_typeCheckingCache = nullptr;
 
+    /// Get the persistent compilation cache.
+    ///
+    /// Returns nullptr if no cache directory has been specified via
+    /// `CompilerOptionName::CompilationCacheDirectory`.
+    ///
+    PersistentCache* getPersistentCache();
+
+    RefPtr<PersistentCache> m_persistentCache;
+    std::once_flag m_persistentCacheInitialized;
+
+    /// Get the thread pool used for parallel code generation.
+    ///
+    /// Returns nullptr if code generation should run serially, as determined by
+    /// `CompilerOptionName::CodeGenThreadCount`.
+    ///
+    ThreadPool* getCodeGenThreadPool();
+
+    RefPtr<ThreadPool> m_codeGenThreadPool;
+
+    /// Guards state shared between code generation tasks running in parallel,
+    /// such as the RTTI object index maps below.
+    std::mutex m_codeGenMutex;
+
+    /// Get the thread pool used to preprocess imported modules in the background.
+    ///
+    /// Returns nullptr if imported modules should be preprocessed as they are imported,
+    /// as determined by `CompilerOptionName::ImportThreadCount`.
+    ///
+    ThreadPool* getImportThreadPool();
+
+    RefPtr<ThreadPool> m_importThreadPool;
+
+    /// The result of preprocessing the source file of a module ahead of it being imported.
+    ///
+    /// Only preprocessing is done ahead of time. Parsing and semantic checking share the
+    /// linkage's `ASTBuilder` and the caches of the semantic checker, which are not thread
+    /// safe, so they stay on the thread importing the module.
+    struct PreprocessedImport : RefObject
+    {
+        PreprocessedImport()
+            : memoryArena(4096)
+        {
+        }
+
+        enum class State
+        {
+            Queued,  ///< Waiting for a worker thread
+            Running, ///< Being preprocessed on a worker thread
+            Done,    ///< Preprocessed, or taken off the queue without being preprocessed
+        };
+
+        /// Guarded by `Linkage::m_preprocessedImportsMutex`.
+        State state = State::Queued;
+
+        SourceFile* sourceFile = nullptr;
+
+        // Where to find included files, and the sink diagnostics are reported to, with the
+        // settings of the importing sink. As reference counts are not atomic, the strings
+        // used by the worker thread don't share their representation with any others.
+        SearchDirectoryList searchDirectories;
+        DiagnosticSink sink;
+
+        // What the worker thread uses of the linkage, taken on the thread loading modules so
+        // that the worker doesn't read the linkage. The source manager can be used from any
+        // thread.
+        ComPtr<ISlangFileSystemExt> fileSystemExt;
+        SourceManager* sourceManager = nullptr;
+
+        // The names in the tokens. Formatting a diagnostic copies the text of names, which
+        // isn't safe while another thread does the same, so the worker has names of its
+        // own. They are replaced by names from the linkage when the import is taken.
+        RootNamePool rootNamePool;
+        NamePool namePool;
+
+        // The inputs to the preprocessor, which must match those used when the module
+        // is imported for the result to be used.
+        Dictionary<String, String> defines;
+        SourceLanguage language = SourceLanguage::Unknown;
+        SlangLanguageVersion languageVersion = SLANG_LANGUAGE_VERSION_UNKNOWN;
+
+        // The outputs of the preprocessor.
+        TokenList tokens;
+        SourceLanguage detectedLanguage = SourceLanguage::Unknown;
+        SlangLanguageVersion detectedLanguageVersion = SLANG_LANGUAGE_VERSION_UNKNOWN;
+        List<SourceFile*> fileDependencies;
+        RefPtr<SourceWarningStateTrackerBase> warningStateTracker;
+
+        /// Holds the contents of the tokens, so must live as long as the linkage.
+        MemoryArena memoryArena;
+
+        /// False if the module has to be preprocessed again when it is imported, such as
+        /// when preprocessing produced diagnostics.
+        bool isUsable = true;
+    };
+
+    /// Find the modules imported by `tokens` (the preprocessed source of a module), and
+    /// queue their source to be preprocessed on the import thread pool. The calling thread
+    /// goes on to parse and check the importing module meanwhile. When each of the imported
+    /// modules is parsed in turn, the modules it imports are queued in the same way.
+    ///
+    /// Does nothing if there is no import thread pool. Diagnostics are not reported on the
+    /// pool, so `sink` is only used for its settings. Any module that produces diagnostics
+    /// is preprocessed again, in the usual way, when it is imported.
+    ///
+    void preprocessImportsInParallel(TokenList const& tokens, DiagnosticSink* sink);
+
+    /// Take the result of preprocessing `sourceFile` ahead of it being imported, waiting for
+    /// a worker to preprocess it if it hasn't yet, if it was preprocessed with the given
+    /// inputs. Returns nullptr otherwise. The names in the tokens of the result are those of
+    /// the linkage.
+    ///
+    /// The result is kept alive by the linkage, as its memory arena holds the contents of
+    /// the tokens.
+    PreprocessedImport* takePreprocessedImport(
+        SourceFile* sourceFile,
+        Dictionary<String, String> const& defines,
+        SourceLanguage language,
+        SlangLanguageVersion languageVersion);
+
+    /// Add the modules imported by `tokens` that can be preprocessed ahead of time to `ioImports`
+    void _findImportsToPreprocess(
+        TokenList const& tokens,
+        IncludeSystem& includeSystem,
+        List<RefPtr<PreprocessedImport>>& ioImports);
+
+    /// Run on a worker thread to preprocess the oldest import in `m_queuedImports`.
+    void _preprocessQueuedImport();
+
+    /// Wait for `preprocessedImport` to be preprocessed on a worker thread. If `cancel` is
+    /// true, it is taken off the queue instead if no worker has started on it.
+    void _waitForImport(PreprocessedImport* preprocessedImport, bool cancel);
+
+    /// Drop the modules preprocessed ahead of being imported that haven't been used.
+    void _dropPreprocessedImports();
+
+    /// Counts the loads of modules in progress, so that modules preprocessed ahead of being
+    /// imported, but never imported, are dropped once the outermost load is done.
+    struct PreprocessedImportScopeRAII
+    {
+        PreprocessedImportScopeRAII(Linkage* linkage)
+            : linkage(linkage)
+        {
+            linkage->m_preprocessedImportScopeDepth++;
+        }
+        ~PreprocessedImportScopeRAII()
+        {
+            if (--linkage->m_preprocessedImportScopeDepth == 0)
+                linkage->_dropPreprocessedImports();
+        }
+        Linkage* linkage;
+    };
+    Index m_preprocessedImportScopeDepth = 0;
+
+    /// Modules being preprocessed ahead of being imported, by source file.
+    ///
+    /// Only used on the thread loading modules, as reference counts are not atomic. Worker
+    /// threads only see the imports in `m_queuedImports`, which are kept alive here until
+    /// they are done.
+    Dictionary<SourceFile*, RefPtr<PreprocessedImport>> m_preprocessedImports;
+
+    /// Guards `m_queuedImports` and the state of each import.
+    std::mutex m_preprocessedImportsMutex;
+    /// Signaled when an import is done.
+    std::condition_variable m_preprocessedImportDone;
+    /// Imports waiting for a worker thread, oldest first.
+    List<PreprocessedImport*> m_queuedImports;
+
+    /// Modules preprocessed ahead of being imported whose tokens were used, which hold
+    /// the contents of the tokens.
+    List<RefPtr<PreprocessedImport>> m_usedPreprocessedImports;
+
     // Modules that have been dynamically loaded via `import`
     //
     // This is a list of unique modules loaded, in the order they were encountered.
@@ -2382,7 +2668,7 @@ public:
     Dictionary<Name*, RefPtr<LoadedModule>> mapNameToLoadedModules;
 
     // Map from the mangled name of RTTI objects to sequential IDs
-    // used by `switch`-based dynamic dispatch.
+    // used by `switch`-based dynamic dispatch. Guarded by `m_codeGenMutex` during code generation.
     Dictionary<String, uint32_t> mapMangledNameToRTTIObjectIndex;
 
     // Counters for allocating sequential IDs to witness tables conforming to each interface type.
@@ -2395,6 +2681,10 @@ public:
 
     ContentAssistInfo contentAssistInfo;
 
+    /// See `getLookupVersion`. Atomic because the builtin linkage is shared by the
+    /// linkages of all the sessions of a global session.
+    std::atomic<UInt> m_lookupVersion{0};
+
     /// File system implementation to use when loading files from disk.
     ///
     /// If this member is `null`, a default implementation that tries
@@ -2507,6 +2797,16 @@ public:
 
     bool isBinaryModuleUpToDate(String fromPath, RIFF::ListChunk const* baseChunk);
 
+    /// Get the digest of the contents of `file`, a dependency of a precompiled module.
+    /// The file is only read if its size or modification time differ from `recordedStat`
+    /// (which can be null) and from those it had when the session last hashed it.
+    bool getFileDependencyDigest(
+        String const& fromPath,
+        String const& moduleSrcPath,
+        String const& file,
+        SerialFileDependencyStat const* recordedStat,
+        SHA1::Digest& outDigest);
+
     RefPtr<Module> findOrImportModule(
         Name* name,
         SourceLoc const& loc,
@@ -2870,6 +3170,14 @@ public:
         return m_entryPointResults[entryPointIndex];
     }
 
+    /// Make sure there is storage for the results of `count` entry points,
+    /// so that results for different entry points can be created in parallel.
+    void _reserveEntryPointResults(Count count)
+    {
+        if (count > m_entryPointResults.getCount())
+            m_entryPointResults.setCount(count);
+    }
+
     IArtifact* _createWholeProgramResult(
         DiagnosticSink* sink,
         EndToEndCompileRequest* endToEndReq = nullptr);
@@ -2886,6 +3194,19 @@ public:
         DiagnosticSink* sink,
         EndToEndCompileRequest* endToEndReq = nullptr);
 
+    /// Try to find the compiled code for an entry point in the
+    /// persistent compilation cache of the linkage.
+    ///
+    /// The program is laid out first, if it hasn't been, with the
+    /// diagnostics of layout reported to `sink`.
+    ///
+    /// Returns nullptr if no cache is used, layout failed, or the entry
+    /// point is not in the cache. Otherwise the cached code becomes the
+    /// result for the entry point, and the diagnostics that were
+    /// produced when it was generated are reported to `sink`.
+    ///
+    IArtifact* _readEntryPointResultFromCache(Int entryPointIndex, DiagnosticSink* sink);
+
     RefPtr<IRModule> getOrCreateIRModuleForLayout(DiagnosticSink* sink);
 
     RefPtr<IRModule> getExistingIRModuleForLayout() { return m_irModuleForLayout; }
@@ -2905,6 +3226,17 @@ public:
 private:
     RefPtr<IRModule> createIRModuleForLayout(DiagnosticSink* sink);
 
+    /// Get the key used for an entry point in the persistent compilation cache.
+    /// Returns false if the result for the entry point should not be cached.
+    bool _getEntryPointCacheKey(Int entryPointIndex, PersistentCache::Key& outKey);
+
+    /// Store the result of an entry point in the persistent cache, along with the
+    /// `diagnostics` produced when generating it.
+    void _writeEntryPointResultToCache(
+        Int entryPointIndex,
+        IArtifact* artifact,
+        const UnownedStringSlice& diagnostics);
+
     // The program being compiled or laid out
     ComponentType* m_program;
 
@@ -3511,12 +3843,23 @@ private:
     void generateOutput(ComponentType* program);
     void generateOutput(TargetProgram* targetProgram);
 
+    /// Generate output for all targets and entry points of `program`, with the
+    /// code generation for each target/entry point running as a task on `threadPool`.
+    void _generateOutputInParallel(ComponentType* program, ThreadPool* threadPool);
+
+    /// Allocate the sequential IDs of the witness tables in the IR modules of `program`
+    /// ahead of code generation, so they don't depend on the order it runs in.
+    void _assignWitnessTableSequentialIDs(ComponentType* program);
+
     void init();
 
     Session* m_session = nullptr;
     RefPtr<Linkage> m_linkage;
     DiagnosticSink m_sink;
     RefPtr<FrontEndCompileRequest> m_frontEndReq;
+    /// What the profiler had recorded when the compile time profile of this request
+    /// was last cleared, or when the request was created.
+    RefPtr<ProfileSnapshot> m_profileSnapshot;
     RefPtr<ComponentType> m_specializedGlobalComponentType;
     RefPtr<ComponentType> m_specializedGlobalAndEntryPointsComponentType;
     List<RefPtr<ComponentType>> m_specializedEntryPoints;
@@ -3688,6 +4031,11 @@ public:
         SlangArchiveType archiveType,
         ISlangBlob** outBlob) override;
 
+    /// Load a builtin module from an archive blob. Unlike `loadBuiltinModule`, the contents of
+    /// an uncompressed archive are used in place and the blob is kept alive while they are, so
+    /// a blob that maps a file into memory only has the parts that are accessed read.
+    SlangResult loadBuiltinModuleBlob(slang::BuiltinModuleName moduleName, ISlangBlob* moduleBlob);
+
     SLANG_NO_THROW SlangCapabilityID SLANG_MCALL findCapability(char const* name) override;
 
     SLANG_NO_THROW void SLANG_MCALL setDownstreamCompilerForTransition(
@@ -3830,6 +4178,7 @@ public:
     ComPtr<IDownstreamCompiler> m_downstreamCompilers[int(
         PassThroughMode::CountOf)]; ///< A downstream compiler for a pass through
     DownstreamCompilerLocatorFunc m_downstreamCompilerLocators[int(PassThroughMode::CountOf)];
+    std::recursive_mutex m_downstreamCompilerMutex; ///< Guards loading of downstream compilers
     Name* m_completionTokenName = nullptr; ///< The name of a completion request token.
 
     /// For parsing command line options
@@ -3837,10 +4186,44 @@ public:
 
     int m_typeDictionarySize = 0;
 
+    /// Instruction memory statistics summed over the IR modules linked for code
+    /// generation. Updated concurrently when generating code in parallel.
+    std::atomic<size_t> m_linkedIRArenaBytes{0};
+    std::atomic<size_t> m_linkedIRDeadInstBytes{0};
+    std::atomic<size_t> m_linkedIRReusedInstBytes{0};
+
+    void addLinkedIRMemoryStats(size_t arenaBytes, size_t deadInstBytes, size_t reusedInstBytes)
+    {
+        m_linkedIRArenaBytes += arenaBytes;
+        m_linkedIRDeadInstBytes += deadInstBytes;
+        m_linkedIRReusedInstBytes += reusedInstBytes;
+    }
+
+    /// Make the new type checking cache of a linkage look up the results it doesn't have in
+    /// the frozen cache shared by linkages of the session, and give it a unique version.
+    void initTypeCheckingCache(TypeCheckingCache* cache);
+    /// Publish the results in the level of `cache` that the shared cache doesn't have, by
+    /// replacing the shared cache with a new frozen cache that has them. Releases the
+    /// reference `cache` holds to its parent.
+    void publishTypeCheckingCache(TypeCheckingCache* cache);
+
+    /// The frozen `TypeCheckingCache` shared by linkages of the session, or nullptr. Older
+    /// frozen caches are kept alive by the caches that use them as a parent.
     RefPtr<RefObject> m_typeCheckingCache;
-    TypeCheckingCache* getTypeCheckingCache();
+    int m_typeCheckingCacheVersion = 0;
+    /// Guards `m_typeCheckingCache`, and the reference counts of the frozen caches.
     std::mutex m_typeCheckingCacheMutex;
 
+    /// Find the stat and contents digest a file had when it was last hashed as a dependency of
+    /// a precompiled module, by unique identity.
+    bool tryGetFileDependencyStat(String const& uniqueIdentity, SerialFileDependencyStat& outStat);
+    void setFileDependencyStat(String const& uniqueIdentity, SerialFileDependencyStat const& stat);
+
+    /// Lets a file that several precompiled modules depend on be hashed only once, for as long
+    /// as its size and modification time stay the same.
+    Dictionary<String, SerialFileDependencyStat> m_fileDependencyStats;
+    std::mutex m_fileDependencyStatsMutex;
+
 private:
     struct BuiltinModuleInfo
     {
@@ -3852,6 +4235,10 @@ private:
 
     void _initCodeGenTransitionMap();
 
+    SlangResult _loadBuiltinModule(
+        slang::BuiltinModuleName moduleName,
+        ISlangFileSystemExt* fileSystem);
+
     SlangResult _readBuiltinModule(
         ISlangFileSystem* fileSystem,
         Scope* scope,
@@ -323,6 +323,7 @@ DIAGNOSTIC(
     "downstream compiler '$0' doesn't support whole program compilation")
 DIAGNOSTIC(102, Note, downstreamCompileTime, "downstream compile time: $0s")
 DIAGNOSTIC(103, Note, performanceBenchmarkResult, "compiler performance benchmark:\n$0")
+DIAGNOSTIC(104, Error, unableToReadModuleIR, "unable to read the IR of module '$0'")
 DIAGNOSTIC(99999, Note, noteFailedToLoadDynamicLibrary, "failed to load dynamic library '$0'")
 
 //
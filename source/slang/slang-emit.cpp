@@ -86,6 +86,7 @@
 #include "slang-ir-metal-legalize.h"
 #include "slang-ir-missing-return.h"
 #include "slang-ir-optix-entry-point-uniforms.h"
+#include "slang-ir-pass-profile.h"
 #include "slang-ir-pytorch-cpp-binding.h"
 #include "slang-ir-redundancy-removal.h"
 #include "slang-ir-resolve-texture-format.h"
@@ -710,6 +711,11 @@ Result linkAndOptimizeIR(
     auto irModule = outLinkedIR.module;
     auto irEntryPoints = outLinkedIR.entryPoints;
 
+    // If requested, the passes below reclaim the instructions they deallocate at a few
+    // points, see `IRModule::reclaimDeallocatedInsts`.
+    if (targetProgram->getOptionSet().getBoolOption(CompilerOptionName::ReuseIRMemory))
+        irModule->enableInstReuse();
+
     // For now, only emit the debug build identifier if separate debug info is enabled
     // and only if there are targets.
     // TODO: We will ultimately need to change this to always emit the instruction.
@@ -737,29 +743,38 @@ Result linkAndOptimizeIR(
     // Scan the IR module and determine which lowering/legalization passes are needed.
     RequiredLoweringPassSet& requiredLoweringPassSet = codeGenContext->getRequiredLoweringPassSet();
     requiredLoweringPassSet = {};
-    calcRequiredLoweringPassSet(requiredLoweringPassSet, codeGenContext, irModule->getModuleInst());
+    SLANG_RUN_IR_PASS(
+        irModule,
+        calcRequiredLoweringPassSet,
+        requiredLoweringPassSet,
+        codeGenContext,
+        irModule->getModuleInst());
 
     // Debug info is added by the front-end, and therefore needs to be stripped out by targets that
     // opt out of debug info.
     if (requiredLoweringPassSet.debugInfo &&
         (targetCompilerOptions.getIntOption(CompilerOptionName::DebugInformation) ==
          SLANG_DEBUG_INFO_LEVEL_NONE))
-        stripDebugInfo(irModule);
+        SLANG_RUN_IR_PASS(irModule, stripDebugInfo, irModule);
 
     if (!isKhronosTarget(targetRequest) && requiredLoweringPassSet.glslSSBO)
-        lowerGLSLShaderStorageBufferObjectsToStructuredBuffers(irModule, sink);
+        SLANG_RUN_IR_PASS(
+            irModule,
+            lowerGLSLShaderStorageBufferObjectsToStructuredBuffers,
+            irModule,
+            sink);
 
     if (requiredLoweringPassSet.globalVaryingVar)
-        translateGlobalVaryingVar(codeGenContext, irModule);
+        SLANG_RUN_IR_PASS(irModule, translateGlobalVaryingVar, codeGenContext, irModule);
 
     if (requiredLoweringPassSet.resolveVaryingInputRef)
-        resolveVaryingInputRef(irModule);
+        SLANG_RUN_IR_PASS(irModule, resolveVaryingInputRef, irModule);
 
-    fixEntryPointCallsites(irModule);
+    SLANG_RUN_IR_PASS(irModule, fixEntryPointCallsites, irModule);
 
     // Replace any global constants with their values.
     //
-    replaceGlobalConstants(irModule);
+    SLANG_RUN_IR_PASS(irModule, replaceGlobalConstants, irModule);
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "GLOBAL CONSTANTS REPLACED");
 #endif
@@ -774,7 +789,7 @@ Result linkAndOptimizeIR(
     // use sites.
     //
     if (requiredLoweringPassSet.bindExistential)
-        bindExistentialSlots(irModule, sink);
+        SLANG_RUN_IR_PASS(irModule, bindExistentialSlots, irModule, sink);
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "EXISTENTIALS BOUND");
 #endif
@@ -798,18 +813,22 @@ Result linkAndOptimizeIR(
     // can assume that all ordinary/uniform data is strictly
     // passed using constant buffers.
     //
-    collectGlobalUniformParameters(irModule, outLinkedIR.globalScopeVarLayout);
+    SLANG_RUN_IR_PASS(
+        irModule,
+        collectGlobalUniformParameters,
+        irModule,
+        outLinkedIR.globalScopeVarLayout);
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "GLOBAL UNIFORMS COLLECTED");
 #endif
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
-    checkEntryPointDecorations(irModule, target, sink);
+    SLANG_RUN_IR_PASS(irModule, checkEntryPointDecorations, irModule, target, sink);
 
     // Add floating point denormal handling mode decorations to entry point functions based on
     // compiler options. This is done post-linking to ensure all entry points from linked modules
     // are processed.
-    addDenormalModeDecorations(irModule, codeGenContext);
+    SLANG_RUN_IR_PASS(irModule, addDenormalModeDecorations, irModule, codeGenContext);
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "FP DENORMAL MODE DECORATIONS ADDED");
 #endif
@@ -832,7 +851,7 @@ Result linkAndOptimizeIR(
         case CodeGenTarget::HostVM:
             break;
         case CodeGenTarget::CUDASource:
-            collectOptiXEntryPointUniformParams(irModule);
+            SLANG_RUN_IR_PASS(irModule, collectOptiXEntryPointUniformParams, irModule);
 #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "OPTIX ENTRY POINT UNIFORMS COLLECTED");
 #endif
@@ -843,7 +862,7 @@ Result linkAndOptimizeIR(
             passOptions.alwaysCreateCollectedParam = true;
             [[fallthrough]];
         default:
-            collectEntryPointUniformParams(irModule, passOptions);
+            SLANG_RUN_IR_PASS(irModule, collectEntryPointUniformParams, irModule, passOptions);
 #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "ENTRY POINT UNIFORMS COLLECTED");
 #endif
@@ -855,7 +874,7 @@ Result linkAndOptimizeIR(
     switch (target)
     {
     default:
-        moveEntryPointUniformParamsToGlobalScope(irModule);
+        SLANG_RUN_IR_PASS(irModule, moveEntryPointUniformParamsToGlobalScope, irModule);
 #if 0
         dumpIRIfEnabled(codeGenContext, irModule, "ENTRY POINT UNIFORMS MOVED");
 #endif
@@ -875,7 +894,7 @@ Result linkAndOptimizeIR(
         break;
 
     default:
-        removeTorchAndCUDAEntryPoints(irModule);
+        SLANG_RUN_IR_PASS(irModule, removeTorchAndCUDAEntryPoints, irModule);
         break;
     }
 
@@ -885,7 +904,7 @@ Result linkAndOptimizeIR(
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
     // Lower all the LValue implict casts (used for out/inout/ref scenarios)
-    lowerLValueCast(targetProgram, irModule);
+    SLANG_RUN_IR_PASS(irModule, lowerLValueCast, targetProgram, irModule);
 
     IRSimplificationOptions defaultIRSimplificationOptions =
         IRSimplificationOptions::getDefault(targetProgram);
@@ -898,23 +917,29 @@ Result linkAndOptimizeIR(
     deadCodeEliminationOptions.keepGlobalParamsAlive =
         targetProgram->getOptionSet().getBoolOption(CompilerOptionName::PreserveParameters);
 
-    simplifyIR(targetProgram, irModule, defaultIRSimplificationOptions, sink);
+    SLANG_RUN_IR_PASS(
+        irModule,
+        simplifyIR,
+        targetProgram,
+        irModule,
+        defaultIRSimplificationOptions,
+        sink);
 
     if (targetProgram->getOptionSet().getBoolOption(CompilerOptionName::ValidateUniformity))
     {
-        validateUniformity(irModule, sink);
+        SLANG_RUN_IR_PASS(irModule, validateUniformity, irModule, sink);
         if (sink->getErrorCount() != 0)
             return SLANG_FAIL;
     }
 
     // Fill in default matrix layout into matrix types that left layout unspecified.
-    specializeMatrixLayout(targetProgram, irModule);
+    SLANG_RUN_IR_PASS(irModule, specializeMatrixLayout, targetProgram, irModule);
 
     // It's important that this takes place before defunctionalization as we
     // want to be able to easily discover the cooperate and fallback funcitons
     // being passed to saturated_cooperation
     if (!targetProgram->getOptionSet().shouldPerformMinimumOptimizations())
-        fuseCallsToSaturatedCooperation(irModule);
+        SLANG_RUN_IR_PASS(irModule, fuseCallsToSaturatedCooperation, irModule);
 
     switch (target)
     {
@@ -923,7 +948,7 @@ Result linkAndOptimizeIR(
         {
             // Generate any requested derivative wrappers
             if (requiredLoweringPassSet.derivativePyBindWrapper)
-                generateDerivativeWrappers(irModule, sink);
+                SLANG_RUN_IR_PASS(irModule, generateDerivativeWrappers, irModule, sink);
             break;
         }
     default:
@@ -933,7 +958,7 @@ Result linkAndOptimizeIR(
     if (requiredLoweringPassSet.autodiff)
     {
         // Generate warnings for potentially incorrect or badly-performing autodiff patterns.
-        checkAutodiffPatterns(targetProgram, irModule, sink);
+        SLANG_RUN_IR_PASS(irModule, checkAutodiffPatterns, targetProgram, irModule, sink);
     }
 
     // Next, we need to ensure that the code we emit for
@@ -970,8 +995,13 @@ Result linkAndOptimizeIR(
             //
             SpecializationOptions specOptions;
             specOptions.lowerWitnessLookups = false;
-            changed |=
-                specializeModule(targetProgram, irModule, codeGenContext->getSink(), specOptions);
+            changed |= SLANG_RUN_IR_PASS(
+                irModule,
+                specializeModule,
+                targetProgram,
+                irModule,
+                codeGenContext->getSink(),
+                specOptions);
         }
 
         if (codeGenContext->getSink()->getErrorCount() != 0)
@@ -980,21 +1010,31 @@ Result linkAndOptimizeIR(
 
         if (changed)
         {
-            applySparseConditionalConstantPropagation(irModule, codeGenContext->getSink());
+            SLANG_RUN_IR_PASS(
+                irModule,
+                applySparseConditionalConstantPropagation,
+                irModule,
+                codeGenContext->getSink());
         }
         validateIRModuleIfEnabled(codeGenContext, irModule);
 
         // Inline calls to any functions marked with [__unsafeInlineEarly] again,
         // since we may be missing out cases prevented by the functions that we just specialzied.
-        performMandatoryEarlyInlining(irModule);
-        eliminateDeadCode(irModule, deadCodeEliminationOptions);
+        SLANG_RUN_IR_PASS(irModule, performMandatoryEarlyInlining, irModule);
+        SLANG_RUN_IR_PASS(irModule, eliminateDeadCode, irModule, deadCodeEliminationOptions);
+        irModule->reclaimDeallocatedInsts();
 
         // Unroll loops.
         if (!fastIRSimplificationOptions.minimalOptimization)
         {
             if (codeGenContext->getSink()->getErrorCount() == 0)
             {
-                if (!unrollLoopsInModule(targetProgram, irModule, codeGenContext->getSink()))
+                if (!SLANG_RUN_IR_PASS(
+                        irModule,
+                        unrollLoopsInModule,
+                        targetProgram,
+                        irModule,
+                        codeGenContext->getSink()))
                     return SLANG_FAIL;
             }
         }
@@ -1005,14 +1045,23 @@ Result linkAndOptimizeIR(
         // Specialize away these parameters
         // TODO: We should implement a proper defunctionalization pass
         if (requiredLoweringPassSet.higherOrderFunc)
-            changed |= specializeHigherOrderParameters(codeGenContext, irModule);
+            changed |= SLANG_RUN_IR_PASS(
+                irModule,
+                specializeHigherOrderParameters,
+                codeGenContext,
+                irModule);
 
         if (requiredLoweringPassSet.autodiff)
         {
             dumpIRIfEnabled(codeGenContext, irModule, "BEFORE-AUTODIFF");
             {
                 auto validationScope = enableIRValidationScope();
-                changed |= processAutodiffCalls(targetProgram, irModule, sink);
+                changed |= SLANG_RUN_IR_PASS(
+                    irModule,
+                    processAutodiffCalls,
+                    targetProgram,
+                    irModule,
+                    sink);
             }
             dumpIRIfEnabled(codeGenContext, irModule, "AFTER-AUTODIFF");
         }
@@ -1024,15 +1073,25 @@ Result linkAndOptimizeIR(
     // Report checkpointing information
     if (codeGenContext->shouldReportCheckpointIntermediates())
     {
-        simplifyIR(targetProgram, irModule, fastIRSimplificationOptions, sink);
+        SLANG_RUN_IR_PASS(
+            irModule,
+            simplifyIR,
+            targetProgram,
+            irModule,
+            fastIRSimplificationOptions,
+            sink);
         reportCheckpointIntermediates(codeGenContext, sink, irModule);
     }
 
     // Finalization is always run so AD-related instructions can be removed,
     // even if the AD pass itself is not run.
     //
-    finalizeAutoDiffPass(targetProgram, irModule);
-    eliminateDeadCode(irModule, deadCodeEliminationOptions);
+    SLANG_RUN_IR_PASS(irModule, finalizeAutoDiffPass, targetProgram, irModule);
+    SLANG_RUN_IR_PASS(irModule, eliminateDeadCode, irModule, deadCodeEliminationOptions);
+
+    // Specialization, loop unrolling and auto-diff discard a lot of instructions,
+    // so let the passes that follow reuse their memory.
+    irModule->reclaimDeallocatedInsts();
 
     // After auto-diff, we can perform more aggressive specialization with dynamic-dispatch
     // lowering.
@@ -1041,26 +1100,32 @@ Result linkAndOptimizeIR(
     {
         SpecializationOptions specOptions;
         specOptions.lowerWitnessLookups = true;
-        specializeModule(targetProgram, irModule, codeGenContext->getSink(), specOptions);
+        SLANG_RUN_IR_PASS(
+            irModule,
+            specializeModule,
+            targetProgram,
+            irModule,
+            codeGenContext->getSink(),
+            specOptions);
     }
 
-    finalizeSpecialization(irModule);
+    SLANG_RUN_IR_PASS(irModule, finalizeSpecialization, irModule);
 
     // Lower `Result<T,E>` types into ordinary struct types. This must happen
     // after specialization, since otherwise incompatible copies of the lowered
     // result structure are generated.
     if (requiredLoweringPassSet.resultType)
-        lowerResultType(irModule, sink);
+        SLANG_RUN_IR_PASS(irModule, lowerResultType, irModule, sink);
 
     if (requiredLoweringPassSet.optionalType)
-        lowerOptionalType(irModule, sink);
+        SLANG_RUN_IR_PASS(irModule, lowerOptionalType, irModule, sink);
 
     if (requiredLoweringPassSet.nonVectorCompositeSelect)
     {
         switch (target)
         {
         case CodeGenTarget::HLSL:
-            legalizeNonVectorCompositeSelect(irModule);
+            SLANG_RUN_IR_PASS(irModule, legalizeNonVectorCompositeSelect, irModule);
             break;
         default:
             break;
@@ -1072,29 +1137,39 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::CPPSource:
     case CodeGenTarget::HostCPPSource:
         {
-            lowerComInterfaces(irModule, artifactDesc.style, sink);
-            generateDllImportFuncs(codeGenContext->getTargetProgram(), irModule, sink);
-            generateDllExportFuncs(irModule, sink);
+            SLANG_RUN_IR_PASS(irModule, lowerComInterfaces, irModule, artifactDesc.style, sink);
+            SLANG_RUN_IR_PASS(
+                irModule,
+                generateDllImportFuncs,
+                codeGenContext->getTargetProgram(),
+                irModule,
+                sink);
+            SLANG_RUN_IR_PASS(irModule, generateDllExportFuncs, irModule, sink);
             break;
         }
     default:
         break;
     }
 
-    calcRequiredLoweringPassSet(requiredLoweringPassSet, codeGenContext, irModule->getModuleInst());
+    SLANG_RUN_IR_PASS(
+        irModule,
+        calcRequiredLoweringPassSet,
+        requiredLoweringPassSet,
+        codeGenContext,
+        irModule->getModuleInst());
 
     switch (target)
     {
     case CodeGenTarget::PyTorchCppBinding:
-        generateHostFunctionsForAutoBindCuda(irModule, sink);
-        lowerBuiltinTypesForKernelEntryPoints(irModule, sink);
-        generatePyTorchCppBinding(irModule, sink);
-        handleAutoBindNames(irModule);
+        SLANG_RUN_IR_PASS(irModule, generateHostFunctionsForAutoBindCuda, irModule, sink);
+        SLANG_RUN_IR_PASS(irModule, lowerBuiltinTypesForKernelEntryPoints, irModule, sink);
+        SLANG_RUN_IR_PASS(irModule, generatePyTorchCppBinding, irModule, sink);
+        SLANG_RUN_IR_PASS(irModule, handleAutoBindNames, irModule);
         break;
     case CodeGenTarget::CUDASource:
-        lowerBuiltinTypesForKernelEntryPoints(irModule, sink);
-        removeTorchKernels(irModule);
-        handleAutoBindNames(irModule);
+        SLANG_RUN_IR_PASS(irModule, lowerBuiltinTypesForKernelEntryPoints, irModule, sink);
+        SLANG_RUN_IR_PASS(irModule, removeTorchKernels, irModule);
+        SLANG_RUN_IR_PASS(irModule, handleAutoBindNames, irModule);
         break;
     default:
         break;
@@ -1102,21 +1177,31 @@ Result linkAndOptimizeIR(
 
     if (codeGenContext->removeAvailableInDownstreamIR)
     {
-        removeAvailableInDownstreamModuleDecorations(target, irModule);
+        SLANG_RUN_IR_PASS(irModule, removeAvailableInDownstreamModuleDecorations, target, irModule);
     }
 
     if (targetProgram->getOptionSet().shouldRunNonEssentialValidation())
     {
-        checkForRecursiveTypes(irModule, sink);
-        checkForRecursiveFunctions(codeGenContext->getTargetReq(), irModule, sink);
+        SLANG_RUN_IR_PASS(irModule, checkForRecursiveTypes, irModule, sink);
+        SLANG_RUN_IR_PASS(
+            irModule,
+            checkForRecursiveFunctions,
+            codeGenContext->getTargetReq(),
+            irModule,
+            sink);
 
         if (requiredLoweringPassSet.missingReturn)
-            checkForMissingReturns(irModule, sink, target, false);
+            SLANG_RUN_IR_PASS(irModule, checkForMissingReturns, irModule, sink, target, false);
 
         // For some targets, we are more restrictive about what types are allowed
         // to be used as shader parameters in ConstantBuffer/ParameterBlock.
         // We will check for these restrictions here.
-        checkForInvalidShaderParameterType(targetRequest, irModule, sink);
+        SLANG_RUN_IR_PASS(
+            irModule,
+            checkForInvalidShaderParameterType,
+            targetRequest,
+            irModule,
+            sink);
     }
 
     if (sink->getErrorCount() != 0)
@@ -1129,31 +1214,41 @@ Result linkAndOptimizeIR(
     {
         // We could fail because
         // 1) It's not inlinable for some reason (for example if it's recursive)
-        SLANG_RETURN_ON_FAIL(performTypeInlining(irModule, sink));
+        SLANG_RETURN_ON_FAIL(SLANG_RUN_IR_PASS(irModule, performTypeInlining, irModule, sink));
     }
 
     if (requiredLoweringPassSet.reinterpret)
-        lowerReinterpret(targetProgram, irModule, sink);
+        SLANG_RUN_IR_PASS(irModule, lowerReinterpret, targetProgram, irModule, sink);
 
     if (sink->getErrorCount() != 0)
         return SLANG_FAIL;
 
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
-    inferAnyValueSizeWhereNecessary(targetProgram, irModule);
+    SLANG_RUN_IR_PASS(irModule, inferAnyValueSizeWhereNecessary, targetProgram, irModule);
 
     // If we have any witness tables that are marked as `KeepAlive`,
     // but are not used for dynamic dispatch, unpin them so we don't
     // do unnecessary work to lower them.
-    unpinWitnessTables(irModule);
+    SLANG_RUN_IR_PASS(irModule, unpinWitnessTables, irModule);
 
     if (!fastIRSimplificationOptions.minimalOptimization)
     {
-        simplifyIR(targetProgram, irModule, fastIRSimplificationOptions, sink);
+        SLANG_RUN_IR_PASS(
+            irModule,
+            simplifyIR,
+            targetProgram,
+            irModule,
+            fastIRSimplificationOptions,
+            sink);
     }
     else if (requiredLoweringPassSet.generics)
     {
-        eliminateDeadCode(irModule, fastIRSimplificationOptions.deadCodeElimOptions);
+        SLANG_RUN_IR_PASS(
+            irModule,
+            eliminateDeadCode,
+            irModule,
+            fastIRSimplificationOptions.deadCodeElimOptions);
     }
 
     if (!ArtifactDescUtil::isCpuLikeTarget(artifactDesc) &&
@@ -1161,7 +1256,7 @@ Result linkAndOptimizeIR(
     {
         // We could fail because (perhaps, somehow) end up with getStringHash that the operand is
         // not a string literal
-        SLANG_RETURN_ON_FAIL(checkGetStringHashInsts(irModule, sink));
+        SLANG_RETURN_ON_FAIL(SLANG_RUN_IR_PASS(irModule, checkGetStringHashInsts, irModule, sink));
     }
 
     // For targets that supports dynamic dispatch, we need to lower the
@@ -1169,27 +1264,33 @@ Result linkAndOptimizeIR(
     // function pointers.
     dumpIRIfEnabled(codeGenContext, irModule, "BEFORE-LOWER-GENERICS");
     if (requiredLoweringPassSet.generics)
-        lowerGenerics(targetProgram, irModule, sink);
+        SLANG_RUN_IR_PASS(irModule, lowerGenerics, targetProgram, irModule, sink);
     else
-        cleanupGenerics(targetProgram, irModule, sink);
+        SLANG_RUN_IR_PASS(irModule, cleanupGenerics, targetProgram, irModule, sink);
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER-LOWER-GENERICS");
 
     if (requiredLoweringPassSet.enumType)
-        lowerEnumType(irModule, sink);
+        SLANG_RUN_IR_PASS(irModule, lowerEnumType, irModule, sink);
 
     // Don't need to run any further target-dependent passes if we are generating code
     // for host vm.
     if (target == CodeGenTarget::HostVM)
     {
-        performForceInlining(irModule);
-        simplifyIR(targetProgram, irModule, defaultIRSimplificationOptions, sink);
+        SLANG_RUN_IR_PASS(irModule, performForceInlining, irModule);
+        SLANG_RUN_IR_PASS(
+            irModule,
+            simplifyIR,
+            targetProgram,
+            irModule,
+            defaultIRSimplificationOptions,
+            sink);
         return SLANG_OK;
     }
 
     // After dynamic dispatch logic is resolved into ordinary function calls,
     // we can now run our stage specialization logic.
     if (requiredLoweringPassSet.specializeStageSwitch)
-        specializeStageSwitch(irModule);
+        SLANG_RUN_IR_PASS(irModule, specializeStageSwitch, irModule);
     if (sink->getErrorCount() != 0)
         return SLANG_FAIL;
 #if 0
@@ -1204,11 +1305,11 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::HLSL:
         break;
     default:
-        lowerCooperativeVectors(irModule, sink);
+        SLANG_RUN_IR_PASS(irModule, lowerCooperativeVectors, irModule, sink);
     }
 
     // Inline calls to any functions marked with [__unsafeInlineEarly] or [ForceInline].
-    performForceInlining(irModule);
+    SLANG_RUN_IR_PASS(irModule, performForceInlining, irModule);
 
     // Specialization can introduce dead code that could trip
     // up downstream passes like type legalization, so we
@@ -1216,11 +1317,17 @@ Result linkAndOptimizeIR(
     //
     if (fastIRSimplificationOptions.minimalOptimization)
     {
-        eliminateDeadCode(irModule, deadCodeEliminationOptions);
+        SLANG_RUN_IR_PASS(irModule, eliminateDeadCode, irModule, deadCodeEliminationOptions);
     }
     else
     {
-        simplifyIR(targetProgram, irModule, defaultIRSimplificationOptions, sink);
+        SLANG_RUN_IR_PASS(
+            irModule,
+            simplifyIR,
+            targetProgram,
+            irModule,
+            defaultIRSimplificationOptions,
+            sink);
     }
 
     validateIRModuleIfEnabled(codeGenContext, irModule);
@@ -1230,7 +1337,12 @@ Result linkAndOptimizeIR(
     // of `RWStructuredBuffer` typed fields now.
     if (target != CodeGenTarget::HLSL)
     {
-        lowerAppendConsumeStructuredBuffers(targetProgram, irModule, sink);
+        SLANG_RUN_IR_PASS(
+            irModule,
+            lowerAppendConsumeStructuredBuffers,
+            targetProgram,
+            irModule,
+            sink);
     }
 
     switch (target)
@@ -1245,22 +1357,27 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::MetalLibAssembly:
     case CodeGenTarget::WGSL:
         if (requiredLoweringPassSet.combinedTextureSamplers)
-            lowerCombinedTextureSamplers(codeGenContext, irModule, sink);
+            SLANG_RUN_IR_PASS(
+                irModule,
+                lowerCombinedTextureSamplers,
+                codeGenContext,
+                irModule,
+                sink);
         break;
     }
 
     if (codeGenContext->getTargetProgram()->getOptionSet().getBoolOption(
             CompilerOptionName::VulkanEmitReflection))
     {
-        addUserTypeHintDecorations(irModule);
+        SLANG_RUN_IR_PASS(irModule, addUserTypeHintDecorations, irModule);
     }
 
-    legalizeEmptyArray(irModule, sink);
+    SLANG_RUN_IR_PASS(irModule, legalizeEmptyArray, irModule, sink);
 
     // We don't need the legalize pass for C/C++ based types
     if (options.shouldLegalizeExistentialAndResourceTypes)
     {
-        inlineGlobalConstantsForLegalization(irModule);
+        SLANG_RUN_IR_PASS(irModule, inlineGlobalConstantsForLegalization, irModule);
 
         // The Slang language allows interfaces to be used like
         // ordinary types (including placing them in constant
@@ -1289,7 +1406,12 @@ Result linkAndOptimizeIR(
         //
         if (requiredLoweringPassSet.existentialTypeLayout)
         {
-            legalizeExistentialTypeLayout(targetProgram, irModule, sink);
+            SLANG_RUN_IR_PASS(
+                irModule,
+                legalizeExistentialTypeLayout,
+                targetProgram,
+                irModule,
+                sink);
         }
 
 #if 0
@@ -1308,7 +1430,7 @@ Result linkAndOptimizeIR(
         // What used to be individual variables/parameters/arguments/etc.
         // then become multiple variables/parameters/arguments/etc.
         //
-        legalizeResourceTypes(targetProgram, irModule, sink);
+        SLANG_RUN_IR_PASS(irModule, legalizeResourceTypes, targetProgram, irModule, sink);
 
         // We also need to legalize empty types for Metal targets.
         switch (target)
@@ -1316,7 +1438,7 @@ Result linkAndOptimizeIR(
         case CodeGenTarget::Metal:
         case CodeGenTarget::MetalLib:
         case CodeGenTarget::MetalLibAssembly:
-            legalizeEmptyTypes(targetProgram, irModule, sink);
+            SLANG_RUN_IR_PASS(irModule, legalizeEmptyTypes, targetProgram, irModule, sink);
             break;
         }
         //  Debugging output of legalization
@@ -1329,10 +1451,10 @@ Result linkAndOptimizeIR(
     {
         // On CPU/CUDA targets, we simply elminate any empty types if
         // they are not part of public interface.
-        legalizeEmptyTypes(targetProgram, irModule, sink);
+        SLANG_RUN_IR_PASS(irModule, legalizeEmptyTypes, targetProgram, irModule, sink);
     }
 
-    legalizeVectorTypes(irModule, sink);
+    SLANG_RUN_IR_PASS(irModule, legalizeVectorTypes, irModule, sink);
 
     // Once specialization and type legalization have been performed,
     // we should perform some of our basic optimization steps again,
@@ -1340,12 +1462,18 @@ Result linkAndOptimizeIR(
     // (e.g., things that used to be aggregated might now be split up,
     // so that we can work with the individual fields).
     if (fastIRSimplificationOptions.minimalOptimization)
-        eliminateDeadCode(irModule, deadCodeEliminationOptions);
+        SLANG_RUN_IR_PASS(irModule, eliminateDeadCode, irModule, deadCodeEliminationOptions);
     else
-        simplifyIR(targetProgram, irModule, fastIRSimplificationOptions, sink);
+        SLANG_RUN_IR_PASS(
+            irModule,
+            simplifyIR,
+            targetProgram,
+            irModule,
+            fastIRSimplificationOptions,
+            sink);
 
     if (requiredLoweringPassSet.dynamicResourceHeap)
-        lowerDynamicResourceHeap(targetProgram, irModule, sink);
+        SLANG_RUN_IR_PASS(irModule, lowerDynamicResourceHeap, targetProgram, irModule, sink);
 
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER SSA");
@@ -1361,13 +1489,13 @@ Result linkAndOptimizeIR(
     // resource types can be used, so that having them as
     // function parameters, reults, etc. is invalid.
     // We clean up the usages of resource values here.
-    specializeResourceUsage(codeGenContext, irModule);
-    specializeFuncsForBufferLoadArgs(codeGenContext, irModule);
+    SLANG_RUN_IR_PASS(irModule, specializeResourceUsage, codeGenContext, irModule);
+    SLANG_RUN_IR_PASS(irModule, specializeFuncsForBufferLoadArgs, codeGenContext, irModule);
 
     // Push `structuredBufferLoad` to the end of access chain to avoid loading unnecessary data.
     if (isKhronosTarget(targetRequest) || isMetalTarget(targetRequest) ||
         isWGPUTarget(targetRequest))
-        deferBufferLoad(irModule);
+        SLANG_RUN_IR_PASS(irModule, deferBufferLoad, irModule);
 
     // We also want to specialize calls to functions that
     // takes unsized array parameters if possible.
@@ -1375,7 +1503,7 @@ Result linkAndOptimizeIR(
     // that takes arrays/structs containing arrays as parameters with the actual
     // global array object to avoid loading big arrays into SSA registers, which seems
     // to cause performance issues.
-    specializeArrayParameters(codeGenContext, irModule);
+    SLANG_RUN_IR_PASS(irModule, specializeArrayParameters, codeGenContext, irModule);
 
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER RESOURCE SPECIALIZATION");
@@ -1385,7 +1513,7 @@ Result linkAndOptimizeIR(
 
     // Process `static_assert` after the specialization is done.
     // Some information for `static_assert` is available only after the specialization.
-    checkStaticAssert(irModule->getModuleInst(), sink);
+    SLANG_RUN_IR_PASS(irModule, checkStaticAssert, irModule->getModuleInst(), sink);
 
     // For HLSL (and fxc/dxc) only, we need to "wrap" any
     // structured buffers defined over matrix types so
@@ -1398,7 +1526,7 @@ Result linkAndOptimizeIR(
     {
     case CodeGenTarget::HLSL:
         {
-            wrapStructuredBuffersOfMatrices(irModule);
+            SLANG_RUN_IR_PASS(irModule, wrapStructuredBuffersOfMatrices, irModule);
 #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "STRUCTURED BUFFERS WRAPPED");
 #endif
@@ -1514,7 +1642,9 @@ Result linkAndOptimizeIR(
             break;
         }
 
-        legalizeByteAddressBufferOps(
+        SLANG_RUN_IR_PASS(
+            irModule,
+            legalizeByteAddressBufferOps,
             session,
             targetProgram,
             irModule,
@@ -1527,7 +1657,12 @@ Result linkAndOptimizeIR(
     if (target != CodeGenTarget::SPIRV && target != CodeGenTarget::SPIRVAssembly)
     {
         bool skipFuncParamValidation = true;
-        validateAtomicOperations(skipFuncParamValidation, sink, irModule->getModuleInst());
+        SLANG_RUN_IR_PASS(
+            irModule,
+            validateAtomicOperations,
+            skipFuncParamValidation,
+            sink,
+            irModule->getModuleInst());
     }
 
     // For CUDA targets only, we will need to turn operations
@@ -1539,7 +1674,7 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::CUDASource:
     case CodeGenTarget::PTX:
         {
-            synthesizeActiveMask(irModule, codeGenContext->getSink());
+            SLANG_RUN_IR_PASS(irModule, synthesizeActiveMask, irModule, codeGenContext->getSink());
 
 #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "AFTER synthesizeActiveMask");
@@ -1557,7 +1692,7 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::GLSL:
     case CodeGenTarget::SPIRV:
     case CodeGenTarget::WGSL:
-        resolveTextureFormat(irModule);
+        SLANG_RUN_IR_PASS(irModule, resolveTextureFormat, irModule);
         break;
     }
 
@@ -1584,7 +1719,9 @@ Result linkAndOptimizeIR(
             dumpIRIfEnabled(codeGenContext, irModule, "PRE GLSL LEGALIZED");
 #endif
 
-            legalizeEntryPointsForGLSL(
+            SLANG_RUN_IR_PASS(
+                irModule,
+                legalizeEntryPointsForGLSL,
                 session,
                 irModule,
                 irEntryPoints,
@@ -1601,19 +1738,27 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::MetalLib:
     case CodeGenTarget::MetalLibAssembly:
         {
-            legalizeIRForMetal(irModule, sink);
+            SLANG_RUN_IR_PASS(irModule, legalizeIRForMetal, irModule, sink);
         }
         break;
     case CodeGenTarget::CSource:
     case CodeGenTarget::CPPSource:
         {
-            legalizeEntryPointVaryingParamsForCPU(irModule, codeGenContext->getSink());
+            SLANG_RUN_IR_PASS(
+                irModule,
+                legalizeEntryPointVaryingParamsForCPU,
+                irModule,
+                codeGenContext->getSink());
         }
         break;
 
     case CodeGenTarget::CUDASource:
         {
-            legalizeEntryPointVaryingParamsForCUDA(irModule, codeGenContext->getSink());
+            SLANG_RUN_IR_PASS(
+                irModule,
+                legalizeEntryPointVaryingParamsForCUDA,
+                irModule,
+                codeGenContext->getSink());
         }
         break;
 
@@ -1621,7 +1766,7 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::WGSLSPIRV:
     case CodeGenTarget::WGSLSPIRVAssembly:
         {
-            legalizeIRForWGSL(irModule, sink);
+            SLANG_RUN_IR_PASS(irModule, legalizeIRForWGSL, irModule, sink);
         }
         break;
 
@@ -1631,20 +1776,24 @@ Result linkAndOptimizeIR(
 
     if (!isSPIRV(targetRequest->getTarget()))
     {
-        floatNonUniformResourceIndex(irModule, NonUniformResourceIndexFloatMode::Textual);
+        SLANG_RUN_IR_PASS(
+            irModule,
+            floatNonUniformResourceIndex,
+            irModule,
+            NonUniformResourceIndexFloatMode::Textual);
     }
 
     if (isD3DTarget(targetRequest) || isKhronosTarget(targetRequest) ||
         isWGPUTarget(targetRequest) || isMetalTarget(targetRequest))
-        legalizeLogicalAndOr(irModule->getModuleInst());
+        SLANG_RUN_IR_PASS(irModule, legalizeLogicalAndOr, irModule->getModuleInst());
 
     // Legalize non struct parameters that are expected to be structs for HLSL.
     if (isD3DTarget(targetRequest))
-        legalizeNonStructParameterToStructForHLSL(irModule);
+        SLANG_RUN_IR_PASS(irModule, legalizeNonStructParameterToStructForHLSL, irModule);
 
     // Create aliases for all dynamic resource parameters.
     if (requiredLoweringPassSet.dynamicResource && isKhronosTarget(targetRequest))
-        legalizeDynamicResourcesForGLSL(codeGenContext, irModule);
+        SLANG_RUN_IR_PASS(irModule, legalizeDynamicResourcesForGLSL, codeGenContext, irModule);
 
     // Legalize `ImageSubscript` loads.
     switch (target)
@@ -1656,7 +1805,7 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::SPIRV:
     case CodeGenTarget::SPIRVAssembly:
         {
-            legalizeImageSubscript(targetRequest, irModule, sink);
+            SLANG_RUN_IR_PASS(irModule, legalizeImageSubscript, targetRequest, irModule, sink);
         }
         break;
     default:
@@ -1670,8 +1819,8 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::SPIRV:
     case CodeGenTarget::SPIRVAssembly:
         {
-            legalizeConstantBufferLoadForGLSL(irModule);
-            legalizeDispatchMeshPayloadForGLSL(irModule);
+            SLANG_RUN_IR_PASS(irModule, legalizeConstantBufferLoadForGLSL, irModule);
+            SLANG_RUN_IR_PASS(irModule, legalizeDispatchMeshPayloadForGLSL, irModule);
         }
         break;
     default:
@@ -1685,15 +1834,23 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::HLSL:
     case CodeGenTarget::GLSL:
     case CodeGenTarget::WGSL:
-        moveGlobalVarInitializationToEntryPoints(irModule, targetProgram);
+        SLANG_RUN_IR_PASS(
+            irModule,
+            moveGlobalVarInitializationToEntryPoints,
+            irModule,
+            targetProgram);
         break;
     // For SPIR-V to SROA across 2 entry-points a value must not be a global
     case CodeGenTarget::SPIRV:
     case CodeGenTarget::SPIRVAssembly:
-        moveGlobalVarInitializationToEntryPoints(irModule, targetProgram);
+        SLANG_RUN_IR_PASS(
+            irModule,
+            moveGlobalVarInitializationToEntryPoints,
+            irModule,
+            targetProgram);
         if (targetProgram->getOptionSet().getBoolOption(
                 CompilerOptionName::EnableExperimentalPasses))
-            introduceExplicitGlobalContext(irModule, target);
+            SLANG_RUN_IR_PASS(irModule, introduceExplicitGlobalContext, irModule, target);
 #if 0
         dumpIRIfEnabled(codeGenContext, irModule, "EXPLICIT GLOBAL CONTEXT INTRODUCED");
 #endif
@@ -1703,16 +1860,20 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::CUDASource:
         // For CUDA/OptiX like targets, add our pass to replace inout parameter copies with direct
         // pointers
-        undoParameterCopy(irModule);
+        SLANG_RUN_IR_PASS(irModule, undoParameterCopy, irModule);
 #if 0
         dumpIRIfEnabled(codeGenContext, irModule, "PARAMETER COPIES REPLACED WITH DIRECT POINTERS");
 #endif
         validateIRModuleIfEnabled(codeGenContext, irModule);
-        moveGlobalVarInitializationToEntryPoints(irModule, targetProgram);
-        introduceExplicitGlobalContext(irModule, target);
+        SLANG_RUN_IR_PASS(
+            irModule,
+            moveGlobalVarInitializationToEntryPoints,
+            irModule,
+            targetProgram);
+        SLANG_RUN_IR_PASS(irModule, introduceExplicitGlobalContext, irModule, target);
         if (target == CodeGenTarget::CPPSource)
         {
-            convertEntryPointPtrParamsToRawPtrs(irModule);
+            SLANG_RUN_IR_PASS(irModule, convertEntryPointPtrParamsToRawPtrs, irModule);
         }
 #if 0
         dumpIRIfEnabled(codeGenContext, irModule, "EXPLICIT GLOBAL CONTEXT INTRODUCED");
@@ -1724,7 +1885,7 @@ Result linkAndOptimizeIR(
     // TODO: our current dynamic dispatch pass will remove all uses of witness tables.
     // If we are going to support function-pointer based, "real" modular dynamic dispatch,
     // we will need to disable this pass.
-    stripLegalizationOnlyInstructions(irModule);
+    SLANG_RUN_IR_PASS(irModule, stripLegalizationOnlyInstructions, irModule);
 
     switch (target)
     {
@@ -1733,7 +1894,7 @@ Result linkAndOptimizeIR(
     //
     case CodeGenTarget::SPIRV:
         if (targetProgram->shouldEmitSPIRVDirectly())
-            removeRawDefaultConstructors(irModule);
+            SLANG_RUN_IR_PASS(irModule, removeRawDefaultConstructors, irModule);
         break;
     default:
         break;
@@ -1745,7 +1906,7 @@ Result linkAndOptimizeIR(
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
     // Validate vectors and matrices according to what the target allows
-    validateVectorsAndMatrices(irModule, sink, targetRequest);
+    SLANG_RUN_IR_PASS(irModule, validateVectorsAndMatrices, irModule, sink, targetRequest);
 
     // The resource-based specialization pass above
     // may create specialized versions of functions, but
@@ -1755,16 +1916,20 @@ Result linkAndOptimizeIR(
     //
     // We run DCE pass again to clean things up.
     //
-    eliminateDeadCode(irModule, deadCodeEliminationOptions);
+    SLANG_RUN_IR_PASS(irModule, eliminateDeadCode, irModule, deadCodeEliminationOptions);
 
-    cleanUpVoidType(irModule);
+    SLANG_RUN_IR_PASS(irModule, cleanUpVoidType, irModule);
 
     if (isKhronosTarget(targetRequest))
     {
         // As a fallback, if the above specialization steps failed to remove resource type
         // parameters, we will inline the functions in question to make sure we can produce valid
         // GLSL.
-        performGLSLResourceReturnFunctionInlining(targetProgram, irModule);
+        SLANG_RUN_IR_PASS(
+            irModule,
+            performGLSLResourceReturnFunctionInlining,
+            targetProgram,
+            irModule);
     }
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER DCE");
@@ -1775,7 +1940,7 @@ Result linkAndOptimizeIR(
     // Lower the `getRegisterIndex` and `getRegisterSpace` intrinsics.
     //
     if (requiredLoweringPassSet.bindingQuery)
-        lowerBindingQueries(irModule, sink);
+        SLANG_RUN_IR_PASS(irModule, lowerBindingQueries, irModule, sink);
 
     // For some small improvement in type safety we represent these as opaque
     // structs instead of regular arrays.
@@ -1783,47 +1948,58 @@ Result linkAndOptimizeIR(
     // If any have survived this far, change them back to regular (decorated)
     // arrays that the emitters can deal with.
     if (requiredLoweringPassSet.meshOutput)
-        legalizeMeshOutputTypes(irModule);
+        SLANG_RUN_IR_PASS(irModule, legalizeMeshOutputTypes, irModule);
 
     BufferElementTypeLoweringOptions bufferElementTypeLoweringOptions;
     bufferElementTypeLoweringOptions.use16ByteArrayElementForConstantBuffer =
         isWGPUTarget(targetRequest);
-    lowerBufferElementTypeToStorageType(targetProgram, irModule, bufferElementTypeLoweringOptions);
-    performForceInlining(irModule);
+    SLANG_RUN_IR_PASS(
+        irModule,
+        lowerBufferElementTypeToStorageType,
+        targetProgram,
+        irModule,
+        bufferElementTypeLoweringOptions);
+    SLANG_RUN_IR_PASS(irModule, performForceInlining, irModule);
 
     // Rewrite functions that return arrays to return them via `out` parameter,
     // since our target languages doesn't allow returning arrays.
     if (!isMetalTarget(targetRequest) && !isSPIRV(target))
-        legalizeArrayReturnType(irModule);
+        SLANG_RUN_IR_PASS(irModule, legalizeArrayReturnType, irModule);
 
     if (isKhronosTarget(targetRequest) || target == CodeGenTarget::HLSL)
     {
-        legalizeUniformBufferLoad(irModule);
+        SLANG_RUN_IR_PASS(irModule, legalizeUniformBufferLoad, irModule);
         if (targetProgram->getOptionSet().getBoolOption(CompilerOptionName::VulkanInvertY))
-            invertYOfPositionOutput(irModule);
+            SLANG_RUN_IR_PASS(irModule, invertYOfPositionOutput, irModule);
         if (targetProgram->getOptionSet().getBoolOption(CompilerOptionName::VulkanUseDxPositionW))
-            rcpWOfPositionInput(irModule);
+            SLANG_RUN_IR_PASS(irModule, rcpWOfPositionInput, irModule);
     }
 
     // Lower all bit_cast operations on complex types into leaf-level
     // bit_cast on basic types.
     if (requiredLoweringPassSet.bitcast)
-        lowerBitCast(targetProgram, irModule, sink);
+        SLANG_RUN_IR_PASS(irModule, lowerBitCast, targetProgram, irModule, sink);
 
     bool emitSpirvDirectly = targetProgram->shouldEmitSPIRVDirectly();
 
     if (emitSpirvDirectly)
     {
-        performIntrinsicFunctionInlining(irModule);
+        SLANG_RUN_IR_PASS(irModule, performIntrinsicFunctionInlining, irModule);
     }
 
-    eliminateMultiLevelBreak(irModule);
+    SLANG_RUN_IR_PASS(irModule, eliminateMultiLevelBreak, irModule);
 
     if (!fastIRSimplificationOptions.minimalOptimization)
     {
         IRSimplificationOptions simplificationOptions = fastIRSimplificationOptions;
         simplificationOptions.cfgOptions.removeTrivialSingleIterationLoops = true;
-        simplifyIR(targetProgram, irModule, simplificationOptions, sink);
+        SLANG_RUN_IR_PASS(
+            irModule,
+            simplifyIR,
+            targetProgram,
+            irModule,
+            simplificationOptions,
+            sink);
     }
 
     // As a late step, we need to take the SSA-form IR and move things *out*
@@ -1848,7 +2024,11 @@ Result linkAndOptimizeIR(
         //
         if (isEnabled(livenessMode))
         {
-            LivenessUtil::addVariableRangeStarts(irModule, livenessMode);
+            SLANG_RUN_IR_PASS(
+                irModule,
+                LivenessUtil::addVariableRangeStarts,
+                irModule,
+                livenessMode);
         }
 
         // We only want to accumulate locations if liveness tracking is enabled.
@@ -1858,7 +2038,7 @@ Result linkAndOptimizeIR(
             phiEliminationOptions.eliminateCompositeTypedPhiOnly = false;
             phiEliminationOptions.useRegisterAllocation = true;
         }
-        eliminatePhis(livenessMode, irModule, phiEliminationOptions);
+        SLANG_RUN_IR_PASS(irModule, eliminatePhis, livenessMode, irModule, phiEliminationOptions);
 #if 0
         dumpIRIfEnabled(codeGenContext, irModule, "PHIS ELIMINATED");
 #endif
@@ -1867,7 +2047,7 @@ Result linkAndOptimizeIR(
 
         if (isEnabled(livenessMode))
         {
-            LivenessUtil::addRangeEnds(irModule, livenessMode);
+            SLANG_RUN_IR_PASS(irModule, LivenessUtil::addRangeEnds, irModule, livenessMode);
 
 #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "LIVENESS");
@@ -1897,19 +2077,29 @@ Result linkAndOptimizeIR(
     {
         if (isKhronosTarget(targetRequest))
         {
-            applyGLSLLiveness(irModule);
+            SLANG_RUN_IR_PASS(irModule, applyGLSLLiveness, irModule);
         }
     }
 
     if (isKhronosTarget(targetRequest) && emitSpirvDirectly)
     {
-        replaceLocationIntrinsicsWithRaytracingObject(targetProgram, irModule, sink);
+        SLANG_RUN_IR_PASS(
+            irModule,
+            replaceLocationIntrinsicsWithRaytracingObject,
+            targetProgram,
+            irModule,
+            sink);
     }
 
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
     // Run a final round of simplifications to clean up unused things after phi-elimination.
-    simplifyNonSSAIR(targetProgram, irModule, fastIRSimplificationOptions);
+    SLANG_RUN_IR_PASS(
+        irModule,
+        simplifyNonSSAIR,
+        targetProgram,
+        irModule,
+        fastIRSimplificationOptions);
 
     // We include one final step to (optionally) dump the IR and validate
     // it after all of the optimization passes are complete. This should
@@ -1928,7 +2118,7 @@ Result linkAndOptimizeIR(
         // This is a separate pass because it needs to run after
         // all the other optimization passes have been performed.
 
-        applyVariableScopeCorrection(irModule, targetRequest);
+        SLANG_RUN_IR_PASS(irModule, applyVariableScopeCorrection, irModule, targetRequest);
         validateIRModuleIfEnabled(codeGenContext, irModule);
     }
 
@@ -1937,15 +2127,26 @@ Result linkAndOptimizeIR(
 
     if (targetProgram->getOptionSet().getBoolOption(CompilerOptionName::EmbedDownstreamIR))
     {
-        unexportNonEmbeddableIR(target, irModule);
+        SLANG_RUN_IR_PASS(irModule, unexportNonEmbeddableIR, target, irModule);
     }
 
-    collectMetadata(irModule, *metadata);
+    SLANG_RUN_IR_PASS(irModule, collectMetadata, irModule, *metadata);
 
     outLinkedIR.metadata = metadata;
 
     if (!targetProgram->getOptionSet().shouldPerformMinimumOptimizations())
-        checkUnsupportedInst(codeGenContext->getTargetReq(), irModule, sink);
+        SLANG_RUN_IR_PASS(
+            irModule,
+            checkUnsupportedInst,
+            codeGenContext->getTargetReq(),
+            irModule,
+            sink);
+
+    const auto memoryStats = irModule->getInstMemoryStats();
+    session->addLinkedIRMemoryStats(
+        memoryStats.arenaBytes,
+        memoryStats.deadInstBytes,
+        memoryStats.reusedInstBytes);
 
     return sink->getErrorCount() == 0 ? SLANG_OK : SLANG_FAIL;
 }
@@ -2517,21 +2718,29 @@ static SlangResult createArtifactFromIR(
             // of spirv files.
             auto program = codeGenContext->getProgram();
 
-            program->enumerateIRModules(
-                [&](IRModule* irModule)
+            // Modules with unread serialized IR are only read if they could have
+            // embedded downstream IR.
+            auto visitModule = [&](IRModule* irModule)
+            {
+                for (auto globalInst : irModule->getModuleInst()->getChildren())
                 {
-                    for (auto globalInst : irModule->getModuleInst()->getChildren())
+                    if (auto inst = as<IREmbeddedDownstreamIR>(globalInst))
                     {
-                        if (auto inst = as<IREmbeddedDownstreamIR>(globalInst))
+                        if (inst->getTarget() == CodeGenTarget::SPIRV)
                         {
-                            if (inst->getTarget() == CodeGenTarget::SPIRV)
-                            {
-                                auto slice = inst->getBlob()->getStringSlice();
-                                spirvFiles.add((uint32_t*)slice.begin());
-                                spirvSizes.add(int(slice.getLength()) / 4);
-                            }
+                            auto slice = inst->getBlob()->getStringSlice();
+                            spirvFiles.add((uint32_t*)slice.begin());
+                            spirvSizes.add(int(slice.getLength()) / 4);
                         }
                     }
+                }
+            };
+            program->enumerateIRModules(
+                visitModule,
+                [&](Module* module)
+                {
+                    if (module->mayHaveUnconditionalIRInsts())
+                        visitModule(module->getIRModule(codeGenContext->getSink()));
                 });
 
             SLANG_ASSERT(int(spirv.getCount()) % 4 == 0);
@@ -484,6 +484,9 @@ public:
 
     operator UnownedTerminatedStringSlice() const { return get(); }
 
+    /// Get the string object, without reading it.
+    FossilizedStringObj const* getObj() const { return _obj.get(); }
+
 private:
     FossilizedPtr<FossilizedStringObj> _obj;
 };
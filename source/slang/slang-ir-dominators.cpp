@@ -190,6 +190,22 @@ bool IRDominatorTree::isUnreachable(IRBlock* block)
     return !reachableSet.contains(block);
 }
 
+bool IRDominatorTree::isEquivalentTo(IRDominatorTree* other)
+{
+    if (reachableSet.getCount() != other->reachableSet.getCount())
+        return false;
+
+    for (auto block : reachableSet)
+    {
+        if (other->isUnreachable(block) ||
+            getImmediateDominator(block) != other->getImmediateDominator(block))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 
 // IRDominatorTree::DominatedList
 
@@ -849,4 +865,11 @@ RefPtr<IRDominatorTree> computeDominatorTree(IRGlobalValueWithCode* code)
     return context.createDominatorTree(code);
 }
 
+RefPtr<IRDominatorTree> findOrComputeDominatorTree(IRGlobalValueWithCode* code)
+{
+    if (auto module = code->getModule())
+        return module->findOrCreateDominatorTree(code);
+    return computeDominatorTree(code);
+}
+
 } // namespace Slang
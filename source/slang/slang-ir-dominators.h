@@ -60,6 +60,9 @@ struct IRDominatorTree : public RefObject
     /// Is `block` unrechable in the control flow graph?
     bool isUnreachable(IRBlock* block);
 
+    /// Does `other` have the same reachable blocks, with the same immediate dominators?
+    bool isEquivalentTo(IRDominatorTree* other);
+
     struct DominatedList
     {
     public:
@@ -167,6 +170,10 @@ private:
 
 RefPtr<IRDominatorTree> computeDominatorTree(IRGlobalValueWithCode* code);
 
+/// Get the dominator tree for `code`, reusing the tree cached on the module that
+/// contains `code` while its control flow graph is unchanged.
+RefPtr<IRDominatorTree> findOrComputeDominatorTree(IRGlobalValueWithCode* code);
+
 void computePostorder(IRGlobalValueWithCode* code, List<IRBlock*>& outOrder);
 void computePostorder(
     IRGlobalValueWithCode* code,
@@ -84,6 +84,18 @@ struct IRSpecContextBase
 
     List<IRModule*> irModules;
 
+    // Modules loaded from serialized data whose IR hasn't been read. Only the
+    // global values that are looked up are read from them.
+    struct OnDemandModule
+    {
+        Module* module;
+        SerializedIRModule* serializedIRModule;
+    };
+    List<OnDemandModule> onDemandModules;
+
+    // Where failures to read the IR of a module are reported.
+    DiagnosticSink* sink = nullptr;
+
     HashSet<UnownedStringSlice> deferredWitnessTableEntryKeys;
     List<RefPtr<WitnessTableCloneInfo>> witnessTables;
 
@@ -98,6 +110,26 @@ struct IRSpecContextBase
             for (auto inst : m->findSymbolByMangledName(hashedName))
                 insertGlobalValueSymbol(shared, inst);
         }
+        // Read the global values with this name, and what they reference, from
+        // modules that haven't been read. Each module looks the name up in its
+        // sorted table of mangled names.
+        for (auto& onDemandModule : onDemandModules)
+        {
+            List<IRInst*> insts;
+            if (SLANG_FAILED(onDemandModule.serializedIRModule->readSymbol(mangledName, insts)))
+            {
+                if (sink)
+                {
+                    sink->diagnose(
+                        SourceLoc(),
+                        Diagnostics::unableToReadModuleIR,
+                        onDemandModule.module->getName());
+                }
+                continue;
+            }
+            for (auto inst : insts)
+                insertGlobalValueSymbol(shared, inst);
+        }
         if (shared->symbols.tryGetValue(hashedName, symbol))
             return symbol;
         shared->symbols[hashedName] = nullptr;
@@ -1986,6 +2018,90 @@ bool doesModuleUseAutodiff(IRInst* inst)
     }
 }
 
+static RefPtr<IRModuleLinkIndex> _buildIRModuleLinkIndex(IRModule* module, bool usesAutodiff)
+{
+    // The categories here must match the instructions `linkIR` needs from every
+    // module it links, regardless of which symbols are referenced.
+    //
+    RefPtr<IRModuleLinkIndex> index = new IRModuleLinkIndex();
+    index->usesAutodiff = usesAutodiff;
+
+    for (auto inst : module->getGlobalInsts())
+    {
+        uint8_t flags = 0;
+        switch (inst->getOp())
+        {
+        case kIROp_BindGlobalGenericParam:
+        case kIROp_DebugSource:
+        case kIROp_DebugBuildIdentifier:
+            index->unconditionalInsts.add(inst);
+            break;
+        case kIROp_GlobalHashedStringLiterals:
+            index->hashedStringLiterals.add(inst);
+            break;
+        case kIROp_EmbeddedDownstreamIR:
+            index->hasEmbeddedDownstreamIR = true;
+            break;
+        case kIROp_GlobalParam:
+            flags |= IRModuleLinkIndex::kFlag_GlobalParam;
+            break;
+        case kIROp_DifferentiableTypeAnnotation:
+            flags |= IRModuleLinkIndex::kFlag_AutoDiffAnnotation;
+            break;
+        default:
+            break;
+        }
+
+        if (_isHLSLExported(inst))
+            flags |= IRModuleLinkIndex::kFlag_HLSLExported;
+        if (inst->findDecorationImpl(kIROp_AutoDiffBuiltinDecoration))
+            flags |= IRModuleLinkIndex::kFlag_AutoDiffAnnotation;
+
+        if (flags)
+            index->conditionalInsts.add(IRModuleLinkIndex::Entry{inst, flags});
+    }
+    return index;
+}
+
+IRModuleLinkIndex* getIRModuleLinkIndex(IRModule* module)
+{
+    if (auto index = module->findLinkIndex())
+        return index;
+
+    auto index = _buildIRModuleLinkIndex(module, doesModuleUseAutodiff(module->getModuleInst()));
+    module->setLinkIndex(index);
+    return index;
+}
+
+void buildIRModuleLinkIndex(IRModule* module, bool usesAutodiff)
+{
+    module->setLinkIndex(_buildIRModuleLinkIndex(module, usesAutodiff));
+}
+
+IRModuleLinkRequirements getIRModuleLinkRequirements(IRModule* module)
+{
+    auto index = getIRModuleLinkIndex(module);
+
+    IRModuleLinkRequirements requirements;
+    requirements.hasUnconditionalInsts =
+        module->getModuleInst()->getFirstDecoration() != nullptr || index->usesAutodiff ||
+        index->unconditionalInsts.getCount() != 0 || index->hashedStringLiterals.getCount() != 0 ||
+        index->hasEmbeddedDownstreamIR;
+    requirements.hasGlobalParams = false;
+    requirements.hasAutoDiffAnnotations = false;
+
+    for (auto entry : index->conditionalInsts)
+    {
+        if (entry.flags & IRModuleLinkIndex::kFlag_HLSLExported)
+            requirements.hasUnconditionalInsts = true;
+        if (entry.flags & IRModuleLinkIndex::kFlag_GlobalParam)
+            requirements.hasGlobalParams = true;
+        if (entry.flags & IRModuleLinkIndex::kFlag_AutoDiffAnnotation)
+            requirements.hasAutoDiffAnnotations = true;
+    }
+    return requirements;
+}
+
 void cloneUsedWitnessTableEntries(IRSpecContext* context)
 {
     bool changed = true;
@@ -2049,10 +2165,20 @@ LinkedIR linkIR(CodeGenContext* codeGenContext)
     // accelerate lookup, we will create a symbol table for looking
     // up IR definitions by their mangled name.
     //
+    // Modules that were loaded from serialized data, and whose IR hasn't been
+    // read yet, are only read if the linker needs something from them.
+    //
     auto globalSession = static_cast<Session*>(linkage->getGlobalSession());
     List<IRModule*> builtinModules;
+    List<Module*> unreadBuiltinModules;
+    List<Module*> unreadUserModules;
     for (auto& m : globalSession->coreModules)
-        builtinModules.add(m->getIRModule());
+    {
+        if (m->getUnreadSerializedIRModule())
+            unreadBuiltinModules.add(m);
+        else
+            builtinModules.add(m->getIRModule());
+    }
 
     // Link modules in the program.
     program->enumerateIRModules(
@@ -2062,8 +2188,38 @@ LinkedIR linkIR(CodeGenContext* codeGenContext)
                 builtinModules.add(module);
             else
                 irModules.add(module);
+        },
+        [&](Module* module)
+        {
+            if (module->getNameObj() == globalSession->glslModuleName)
+                unreadBuiltinModules.add(module);
+            else
+                unreadUserModules.add(module);
         });
 
+    // Modules with instructions that are linked regardless of which symbols are
+    // referenced always need to be read.
+    //
+    auto sink = codeGenContext->getSink();
+    auto readModulesWithUnconditionalInsts =
+        [&](List<Module*>& modules, List<IRModule*>& outIRModules)
+    {
+        for (Index i = 0; i < modules.getCount();)
+        {
+            auto serializedIRModule = modules[i]->getUnreadSerializedIRModule();
+            if (serializedIRModule &&
+                !serializedIRModule->getLinkRequirements().hasUnconditionalInsts)
+            {
+                ++i;
+                continue;
+            }
+            outIRModules.add(modules[i]->getIRModule(sink));
+            modules.removeAt(i);
+        }
+    };
+    readModulesWithUnconditionalInsts(unreadUserModules, irModules);
+    readModulesWithUnconditionalInsts(unreadBuiltinModules, builtinModules);
+
     // We will also consider the IR global symbols from the IR module
     // attached to the `TargetProgram`, since this module is
     // responsible for associating layout information to those
@@ -2073,9 +2229,30 @@ LinkedIR linkIR(CodeGenContext* codeGenContext)
     if (irModuleForLayout)
         irModules.add(irModuleForLayout);
 
-    Index userModuleCount = irModules.getCount();
+    // Note that `irModules` can grow while linking, as unread modules are read.
+    List<IRModule*> userModules = irModules;
     irModules.addRange(builtinModules);
-    ArrayView<IRModule*> userModules = irModules.getArrayView(0, userModuleCount);
+
+    // Rather than visiting all the global insts of each module, we use the link
+    // index of the module to find the insts that are linked regardless of which
+    // symbols are referenced.
+    //
+    // The layout module is created per target program, and can still change, so
+    // it gets a link index of its own rather than caching one on the module.
+    //
+    RefPtr<IRModuleLinkIndex> layoutModuleLinkIndex;
+    auto getLinkIndex = [&](IRModule* irModule) -> IRModuleLinkIndex*
+    {
+        if (irModule != irModuleForLayout)
+            return getIRModuleLinkIndex(irModule);
+        if (!layoutModuleLinkIndex)
+        {
+            layoutModuleLinkIndex = _buildIRModuleLinkIndex(
+                irModule,
+                doesModuleUseAutodiff(irModule->getModuleInst()));
+        }
+        return layoutModuleLinkIndex;
+    };
 
     // Check if any user module uses auto-diff, if so we will need to link
     // additional witnesses and decorations.
@@ -2083,17 +2260,46 @@ LinkedIR linkIR(CodeGenContext* codeGenContext)
     {
         if (sharedContext->useAutodiff)
             break;
-        sharedContext->useAutodiff = doesModuleUseAutodiff(irModule->getModuleInst());
+        sharedContext->useAutodiff = getLinkIndex(irModule)->usesAutodiff;
     }
 
+    // The remaining unread modules may still have global parameters or auto-diff
+    // annotations that need to be linked, depending on the options.
+    //
+    bool shouldCopyGlobalParams =
+        linkage->m_optionSet.getBoolOption(CompilerOptionName::PreserveParameters);
+
     auto context = state->getContext();
+    for (auto unreadModules : {&unreadUserModules, &unreadBuiltinModules})
+    {
+        for (auto module : *unreadModules)
+        {
+            auto serializedIRModule = module->getUnreadSerializedIRModule();
+            if (!serializedIRModule ||
+                shouldCopyGlobalParams &&
+                    serializedIRModule->getLinkRequirements().hasGlobalParams ||
+                sharedContext->useAutodiff &&
+                    serializedIRModule->getLinkRequirements().hasAutoDiffAnnotations)
+            {
+                irModules.add(module->getIRModule(sink));
+            }
+            else
+            {
+                context->onDemandModules.add({module, serializedIRModule});
+            }
+        }
+    }
 
     // Combine all of the contents of IRGlobalHashedStringLiterals
     {
         StringSlicePool pool(StringSlicePool::Style::Empty);
         for (IRModule* irModule : userModules)
         {
-            findGlobalHashedStringLiterals(irModule, pool);
+            for (auto hashedStringLits : getLinkIndex(irModule)->hashedStringLiterals)
+            {
+                for (UInt i = 0; i < hashedStringLits->getOperandCount(); ++i)
+                    pool.add(as<IRStringLit>(hashedStringLits->getOperand(i))->getStringSlice());
+            }
         }
         addGlobalHashedStringLiterals(pool, state->irModule);
     }
@@ -2102,6 +2308,7 @@ LinkedIR linkIR(CodeGenContext* codeGenContext)
 
     context->shared = sharedContext;
     context->builder = &sharedContext->builderStorage;
+    context->sink = sink;
 
     context->builder->setInsertInto(context->getModule()->getModuleInst());
 
@@ -2151,58 +2358,50 @@ LinkedIR linkIR(CodeGenContext* codeGenContext)
     // even if they are not being directly referenced.
     for (IRModule* irModule : userModules)
     {
-        for (auto inst : irModule->getGlobalInsts())
+        // Bindings for global generic parameters are currently represented
+        // as stand-alone global-scope instructions in the IR module for
+        // `SpecializedComponentType`s. These instructions are required for
+        // correct codegen, and so we must make sure to copy them all over,
+        // even though they are not directly referenced.
+        //
+        // TODO: We should change these to decorations, akin to how
+        // `[bindExistentialSlots(...)]` works, so that they can be attached
+        // to the relevant parameters and cloned via `cloneExtraDecorations`.
+        //
+        // We also need to list all source files in the debug source file list,
+        // regardless if the source files participate in the line table or not,
+        // and keep the debug build identifier around if it is in the IR, even
+        // though it won't be referenced by anything.
+        //
+        RefPtr<IRModuleLinkIndex> linkIndex = getLinkIndex(irModule);
+        for (auto inst : linkIndex->unconditionalInsts)
         {
-            switch (inst->getOp())
-            {
-            default:
-                break;
-            case kIROp_BindGlobalGenericParam:
-                // Bindings for global generic parameters are currently represented
-                // as stand-alone global-scope instructions in the IR module for
-                // `SpecializedComponentType`s. These instructions are required for
-                // correct codegen, and so we must make sure to copy them all over,
-                // even though they are not directly referenced.
-                //
-                // TODO: We should change these to decorations, akin to how
-                // `[bindExistentialSlots(...)]` works, so that they can be attached
-                // to the relevant parameters and cloned via `cloneExtraDecorations`.
-                // In the long run we do not want to *ever* iterate over all the
-                // instructions in all the input modules.
-                [[fallthrough]];
-            case kIROp_DebugSource:
-                // Need to list all source files in the debug source file list,
-                // regardless if the source files participate in the line table or not.
-                cloneValue(context, inst);
-                break;
-            case kIROp_DebugBuildIdentifier:
-                // The debug build identifier won't be referenced by anything,
-                // but we still need to keep it around if it is in the IR.
-                cloneValue(context, inst);
-                break;
-            }
+            cloneValue(context, inst);
         }
     }
 
-    bool shouldCopyGlobalParams =
-        linkage->m_optionSet.getBoolOption(CompilerOptionName::PreserveParameters);
+    // We need to copy over exported symbols, any global parameters if
+    // preserve-params option is set, and auto-diff annotations if auto-diff is used.
+    //
+    uint8_t clonedFlags = IRModuleLinkIndex::kFlag_HLSLExported;
+    if (shouldCopyGlobalParams)
+        clonedFlags |= IRModuleLinkIndex::kFlag_GlobalParam;
+    if (sharedContext->useAutodiff)
+        clonedFlags |= IRModuleLinkIndex::kFlag_AutoDiffAnnotation;
 
-    for (IRModule* irModule : irModules)
+    // Cloning can read more modules into `irModules`, so we iterate by index.
+    for (Index moduleIndex = 0; moduleIndex < irModules.getCount(); ++moduleIndex)
     {
-        for (auto inst : irModule->getGlobalInsts())
+        RefPtr<IRModuleLinkIndex> linkIndex = getLinkIndex(irModules[moduleIndex]);
+        for (auto entry : linkIndex->conditionalInsts)
         {
-            // We need to copy over exported symbols,
-            // and any global parameters if preserve-params option is set.
-            if (_isHLSLExported(inst) || shouldCopyGlobalParams && as<IRGlobalParam>(inst) ||
-                sharedContext->useAutodiff &&
-                    (as<IRDifferentiableTypeAnnotation>(inst) ||
-                     inst->findDecorationImpl(kIROp_AutoDiffBuiltinDecoration) != nullptr))
+            if ((entry.flags & clonedFlags) == 0)
+                continue;
+
+            auto cloned = cloneValue(context, entry.inst);
+            if (!cloned->findDecorationImpl(kIROp_KeepAliveDecoration))
             {
-                auto cloned = cloneValue(context, inst);
-                if (!cloned->findDecorationImpl(kIROp_KeepAliveDecoration))
-                {
-                    context->builder->addKeepAliveDecoration(cloned);
-                }
+                context->builder->addKeepAliveDecoration(cloned);
             }
         }
     }
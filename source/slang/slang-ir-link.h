@@ -33,4 +33,22 @@ LinkedIR linkIR(CodeGenContext* codeGenContext);
 // treated as identical for the purposes of specialization.
 //
 void replaceGlobalConstants(IRModule* module);
+
+// Determine which parts of `module` `linkIR` needs regardless of which
+// symbols are referenced, so that it can be stored with a serialized
+// module that is read on demand.
+//
+IRModuleLinkRequirements getIRModuleLinkRequirements(IRModule* module);
+
+// Get the link index of `module`, building it if it hasn't been built yet.
+//
+// Building the index isn't thread-safe, so it should be built before a
+// module is linked on multiple threads.
+//
+IRModuleLinkIndex* getIRModuleLinkIndex(IRModule* module);
+
+// Build the link index of `module`, when it is already known whether the
+// module uses auto-diff (such as when it is read from serialized data).
+//
+void buildIRModuleLinkIndex(IRModule* module, bool usesAutodiff);
 } // namespace Slang
@@ -0,0 +1,38 @@
+// slang-ir-pass-profile.cpp
+#include "slang-ir-pass-profile.h"
+
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+IRPassProfileScope::IRPassProfileScope(const char* passName, IRModule* module)
+{
+    auto profiler = PerformanceProfiler::getProfiler();
+    if (!profiler->isPassProfilingEnabled())
+        return;
+
+    m_module = module;
+    m_instCountBefore = module->getInstCount();
+    m_allocatedInstBytesBefore = module->getAllocatedInstBytes();
+    m_context = profiler->enterPass(passName);
+}
+
+IRPassProfileScope::~IRPassProfileScope()
+{
+    if (!m_module)
+        return;
+
+    const Count instCountAfter = m_module->getInstCount();
+    const size_t allocatedInstBytes =
+        m_module->getAllocatedInstBytes() - m_allocatedInstBytesBefore;
+
+    PassInvocationInfo info;
+    info.sizeChange = instCountAfter - m_instCountBefore;
+    info.allocatedBytes = UInt64(allocatedInstBytes);
+    PerformanceProfiler::getProfiler()->exitPass(m_context, info);
+
+    SLANG_PROFILE_COUNTER(irInstBytesAllocated, allocatedInstBytes);
+}
+
+} // namespace Slang
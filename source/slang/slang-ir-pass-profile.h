@@ -0,0 +1,58 @@
+// slang-ir-pass-profile.h
+#pragma once
+
+#include "../core/slang-performance-profiler.h"
+
+namespace Slang
+{
+struct IRModule;
+
+/// Records statistics about a pass over an IR module with the performance profiler.
+///
+/// The statistics cover the time from construction to destruction: the wall time,
+/// the change in the number of instructions in the module (see `IRModule::getInstCount`),
+/// and the number of bytes allocated for instructions. `-report-perf-benchmark` reports
+/// their totals along with the smallest and largest values of a single invocation, and
+/// `ISlangProfiler` reports the invocation counts and times (as entries named
+/// `pass:<name>`). The pass is also a scope in the profiler's call tree and trace, so
+/// functions profiled while it runs are nested under it.
+///
+/// Nothing is recorded unless pass profiling is enabled (see
+/// `PerformanceProfiler::beginPassProfiling`) when the scope is constructed.
+///
+struct IRPassProfileScope
+{
+    /// The `passName` must outlive the profiler, so is typically a string literal.
+    IRPassProfileScope(const char* passName, IRModule* module);
+    ~IRPassProfileScope();
+
+private:
+    /// Null if pass profiling isn't enabled.
+    IRModule* m_module = nullptr;
+    Int64 m_instCountBefore = 0;
+    size_t m_allocatedInstBytesBefore = 0;
+    FuncProfileContext m_context;
+};
+
+/// Run the IR pass `runPass` (a callable taking no arguments) over `module`, recording
+/// statistics about it under `passName`, and return its result.
+///
+/// All the passes of `linkAndOptimizeIR` are run through this function, so it is the
+/// place to add anything that should happen around every pass.
+///
+template<typename RunPass>
+decltype(auto) runIRPass(const char* passName, IRModule* module, const RunPass& runPass)
+{
+    IRPassProfileScope scope(passName, module);
+    return runPass();
+}
+
+/// Run the IR pass implemented by the function `pass` with the arguments that follow,
+/// with `runIRPass`, under the name of the function.
+///
+/// Evaluates to the result of the pass, so it can be used in place of a call to it.
+///
+#define SLANG_RUN_IR_PASS(module, pass, ...) \
+    ::Slang::runIRPass(#pass, module, [&]() -> decltype(auto) { return pass(__VA_ARGS__); })
+
+} // namespace Slang
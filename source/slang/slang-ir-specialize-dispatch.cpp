@@ -177,94 +177,141 @@ IRFunc* specializeDispatchFunction(
     return newDispatchFunc;
 }
 
-// Ensures every witness table object has been assigned a sequential ID.
-// All witness tables will have a SequentialID decoration after this function is run.
-// The sequantial ID in the decoration will be the same as the one specified in the Linkage.
-// Otherwise, a new ID will be generated and assigned to the witness table object, and
-// the sequantial ID map in the Linkage will be updated to include the new ID, so they
-// can be looked up by the user via future Slang API calls.
-void ensureWitnessTableSequentialIDs(SharedGenericsLoweringContext* sharedContext)
+// Is `inst` a witness table for an interface that is only used for specialization?
+// It would be an error if dynamic dispatch is used through such an interface, so its
+// witness tables don't need IDs.
+static bool _isSpecializationOnlyWitnessTable(IRInst* inst)
 {
-    StringBuilder generatedMangledName;
+    auto witnessTableType = as<IRWitnessTableType>(inst->getDataType());
+    return witnessTableType &&
+           witnessTableType->getConformanceType()->findDecoration<IRSpecializeDecoration>();
+}
 
-    auto linkage = sharedContext->targetProgram->getTargetReq()->getLinkage();
-    for (auto inst : sharedContext->module->getGlobalInsts())
+// Allocate the next sequential ID of the interface of the witness table `inst` from
+// the linkage.
+//
+// The caller must hold `linkage->m_codeGenMutex`.
+static uint32_t _allocateSequentialID(Linkage* linkage, IRInst* inst)
+{
+    auto interfaceType = cast<IRWitnessTableType>(inst->getDataType())->getConformanceType();
+    if (!as<IRInterfaceType>(interfaceType))
+    {
+        // NoneWitness, has special ID of -1.
+        return uint32_t(-1);
+    }
+
+    auto interfaceLinkage = interfaceType->findDecoration<IRLinkageDecoration>();
+    SLANG_ASSERT(
+        interfaceLinkage && "An interface type does not have a linkage,"
+                            "but a witness table associated with it has one.");
+    auto interfaceName = interfaceLinkage->getMangledName();
+    auto idAllocator =
+        linkage->mapInterfaceMangledNameToSequentialIDCounters.tryGetValue(interfaceName);
+    if (!idAllocator)
+    {
+        linkage->mapInterfaceMangledNameToSequentialIDCounters[interfaceName] = 0;
+        idAllocator =
+            linkage->mapInterfaceMangledNameToSequentialIDCounters.tryGetValue(interfaceName);
+    }
+    uint32_t seqID = *idAllocator;
+    ++(*idAllocator);
+    return seqID;
+}
+
+// Get the sequential ID of the witness table `inst` named `mangledName` from the
+// linkage, allocating the next ID of its interface if it doesn't have one yet.
+//
+// The caller must hold `linkage->m_codeGenMutex`.
+static uint32_t _getOrAllocateSequentialID(
+    Linkage* linkage,
+    IRInst* inst,
+    UnownedStringSlice mangledName)
+{
+    uint32_t seqID = 0;
+    if (linkage->mapMangledNameToRTTIObjectIndex.tryGetValue(mangledName, seqID))
+        return seqID;
+
+    seqID = _allocateSequentialID(linkage, inst);
+    linkage->mapMangledNameToRTTIObjectIndex[mangledName] = seqID;
+    return seqID;
+}
+
+void assignWitnessTableSequentialIDs(Linkage* linkage, List<IRModule*> const& modules)
+{
+    std::lock_guard<std::mutex> lock(linkage->m_codeGenMutex);
+
+    // Witness tables that are given an ID explicitly (such as with a type conformance
+    // created with an ID override) keep it, and don't use up one of the allocated IDs.
+    HashSet<UnownedStringSlice> explicitlyNumberedTables;
+    for (auto module : modules)
     {
-        if (inst->getOp() == kIROp_WitnessTable)
+        for (auto inst : module->getGlobalInsts())
         {
-            UnownedStringSlice witnessTableMangledName;
+            if (inst->getOp() != kIROp_WitnessTable ||
+                !inst->findDecoration<IRSequentialIDDecoration>())
+                continue;
             if (auto instLinkage = inst->findDecoration<IRLinkageDecoration>())
-            {
-                witnessTableMangledName = instLinkage->getMangledName();
-            }
-            else
-            {
-                auto witnessTableType = as<IRWitnessTableType>(inst->getDataType());
-                if (witnessTableType && witnessTableType->getConformanceType()
-                                            ->findDecoration<IRSpecializeDecoration>())
-                {
-                    // The interface is for specialization only, it would be an error if dynamic
-                    // dispatch is used through the interface. Skip assigning ID for the witness
-                    // table.
-                    continue;
-                }
-
-                // generate a unique linkage for it.
-                static int32_t uniqueId = 0;
-                uniqueId++;
-                if (auto nameHint = inst->findDecoration<IRNameHintDecoration>())
-                {
-                    generatedMangledName << nameHint->getName();
-                }
-                generatedMangledName << "_generated_witness_uuid_" << uniqueId;
-                witnessTableMangledName = generatedMangledName.getUnownedSlice();
-            }
+                explicitlyNumberedTables.add(instLinkage->getMangledName());
+        }
+    }
 
-            // If the inst already has a SequentialIDDecoration, stop now.
-            if (inst->findDecoration<IRSequentialIDDecoration>())
+    for (auto module : modules)
+    {
+        for (auto inst : module->getGlobalInsts())
+        {
+            if (inst->getOp() != kIROp_WitnessTable)
+                continue;
+            auto instLinkage = inst->findDecoration<IRLinkageDecoration>();
+            if (!instLinkage || explicitlyNumberedTables.contains(instLinkage->getMangledName()))
                 continue;
+            _getOrAllocateSequentialID(linkage, inst, instLinkage->getMangledName());
+        }
+    }
+}
 
-            // Get a sequential ID for the witness table using the map from the Linkage.
-            uint32_t seqID = 0;
-            if (!linkage->mapMangledNameToRTTIObjectIndex.tryGetValue(
-                    witnessTableMangledName,
-                    seqID))
-            {
-                auto interfaceType =
-                    cast<IRWitnessTableType>(inst->getDataType())->getConformanceType();
-                if (as<IRInterfaceType>(interfaceType))
-                {
-                    auto interfaceLinkage = interfaceType->findDecoration<IRLinkageDecoration>();
-                    SLANG_ASSERT(
-                        interfaceLinkage && "An interface type does not have a linkage,"
-                                            "but a witness table associated with it has one.");
-                    auto interfaceName = interfaceLinkage->getMangledName();
-                    auto idAllocator =
-                        linkage->mapInterfaceMangledNameToSequentialIDCounters.tryGetValue(
-                            interfaceName);
-                    if (!idAllocator)
-                    {
-                        linkage->mapInterfaceMangledNameToSequentialIDCounters[interfaceName] = 0;
-                        idAllocator =
-                            linkage->mapInterfaceMangledNameToSequentialIDCounters.tryGetValue(
-                                interfaceName);
-                    }
-                    seqID = *idAllocator;
-                    ++(*idAllocator);
-                }
-                else
-                {
-                    // NoneWitness, has special ID of -1.
-                    seqID = uint32_t(-1);
-                }
-                linkage->mapMangledNameToRTTIObjectIndex[witnessTableMangledName] = seqID;
-            }
+// Ensures every witness table object has been assigned a sequential ID.
+// All witness tables will have a SequentialID decoration after this function is run.
+//
+// A witness table with a linkage gets the ID of its mangled name in the Linkage, which
+// is allocated if it doesn't have one yet, so it can be looked up by the user via
+// future Slang API calls. When entry points are generated in parallel, these are
+// allocated ahead of code generation by `assignWitnessTableSequentialIDs`.
+//
+// A witness table without a linkage (such as one created by specialization) can't be
+// looked up, but it still takes the next ID of its interface from the Linkage, so that
+// its ID can't be handed out again to a table that is linked into this module later.
+//
+void ensureWitnessTableSequentialIDs(SharedGenericsLoweringContext* sharedContext)
+{
+    auto linkage = sharedContext->targetProgram->getTargetReq()->getLinkage();
 
-            // Add a decoration to the inst.
-            IRBuilder builder(sharedContext->module);
-            builder.setInsertBefore(inst);
-            builder.addSequentialIDDecoration(inst, seqID);
+    // The ID maps are shared by all code generation tasks of the linkage, which
+    // may be running in parallel.
+    std::lock_guard<std::mutex> lock(linkage->m_codeGenMutex);
+
+    IRBuilder builder(sharedContext->module);
+    for (auto inst : sharedContext->module->getGlobalInsts())
+    {
+        if (inst->getOp() != kIROp_WitnessTable)
+            continue;
+
+        // If the inst already has a SequentialIDDecoration, stop now.
+        if (inst->findDecoration<IRSequentialIDDecoration>())
+            continue;
+
+        uint32_t seqID = 0;
+        if (auto instLinkage = inst->findDecoration<IRLinkageDecoration>())
+        {
+            seqID = _getOrAllocateSequentialID(linkage, inst, instLinkage->getMangledName());
+        }
+        else
+        {
+            if (_isSpecializationOnlyWitnessTable(inst))
+                continue;
+            seqID = _allocateSequentialID(linkage, inst);
         }
+        builder.setInsertBefore(inst);
+        builder.addSequentialIDDecoration(inst, seqID);
     }
 }
 
@@ -1,8 +1,12 @@
 // slang-ir-specialize-dispatch.h
 #pragma once
 
+#include "../core/slang-list.h"
+
 namespace Slang
 {
+class Linkage;
+struct IRModule;
 struct SharedGenericsLoweringContext;
 
 /// Modifies the body of interface dispatch functions to use branching instead
@@ -10,4 +14,13 @@ struct SharedGenericsLoweringContext;
 /// This is only used on GPU targets where function pointers are not supported
 /// or are not efficient.
 void specializeDispatchFunctions(SharedGenericsLoweringContext* sharedContext);
+
+/// Allocate the sequential IDs of the witness tables with a linkage in `modules`
+/// from `linkage`, in the order they appear in.
+///
+/// Code generation allocates the IDs of witness tables it finds without one, and
+/// when entry points are generated in parallel that happens in whatever order the
+/// tasks get to them. Allocating the IDs up front keeps them deterministic, so
+/// parallel code generation does this before starting its tasks.
+void assignWitnessTableSequentialIDs(Linkage* linkage, List<IRModule*> const& modules);
 } // namespace Slang
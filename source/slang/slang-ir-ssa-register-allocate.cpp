@@ -161,7 +161,7 @@ struct RegisterAllocateContext
         ReachabilityContext reachabilityContext(func);
         mapTypeToRegisterList.clear();
 
-        auto dom = computeDominatorTree(func);
+        auto dom = findOrComputeDominatorTree(func);
         inOutDom = dom;
 
         // Note that if inst A does not dominate inst B, then A can't be alive at B.
@@ -47,8 +47,53 @@ IRSimplificationOptions IRSimplificationOptions::getFast(TargetProgram* targetPr
     return result;
 }
 
+// Find the module level inst that `inst` is nested in.
+static IRInst* _getModuleLevelInst(IRInst* inst)
+{
+    while (inst)
+    {
+        auto parent = inst->getParent();
+        if (!parent || as<IRModuleInst>(parent))
+            return inst;
+        inst = parent;
+    }
+    return nullptr;
+}
+
+// Add the functions that use the module level inst `inst` to `ioFuncs`.
+//
+// Uses from other global insts (such as specializations or witness tables)
+// are followed, so that functions that only reference `inst` indirectly
+// are found too.
+static void _addDependentFuncs(
+    IRInst* inst,
+    HashSet<IRInst*>& ioVisited,
+    HashSet<IRInst*>& ioFuncs)
+{
+    if (!ioVisited.add(inst))
+        return;
+
+    for (auto use = inst->firstUse; use; use = use->nextUse)
+    {
+        auto user = _getModuleLevelInst(use->getUser());
+        if (!user)
+            continue;
+
+        if (as<IRGlobalValueWithCode>(user))
+            ioFuncs.add(user);
+        else
+            _addDependentFuncs(user, ioVisited, ioFuncs);
+    }
+}
+
 // Run a combination of SSA, SCCP, SimplifyCFG, and DeadCodeElimination pass
 // until no more changes are possible.
+//
+// Every function is simplified in the first iteration. After that only functions
+// that may be affected by a change are simplified again: those that use a function
+// that changed in the previous iteration, and those that didn't reach a fixed point
+// within `kMaxFuncIterations`. The module scope passes don't report what they changed,
+// so if any of them makes a change all functions are simplified again.
 void simplifyIR(
     TargetProgram* target,
     IRModule* module,
@@ -61,6 +106,13 @@ void simplifyIR(
     const int kMaxFuncIterations = 16;
     int iterationCounter = 0;
 
+    // The functions to simplify in the current iteration, and the next one.
+    // Only used if `simplifyAllFuncs` is false.
+    HashSet<IRInst*> dirtyFuncs;
+    HashSet<IRInst*> nextDirtyFuncs;
+    HashSet<IRInst*> visitedInsts;
+    bool simplifyAllFuncs = true;
+
     while (changed && iterationCounter < kMaxIterations)
     {
         if (sink && sink->getErrorCount())
@@ -75,12 +127,19 @@ void simplifyIR(
         changed |= peepholeOptimizeGlobalScope(target, module);
         changed |= trimOptimizableTypes(module);
 
+        if (changed)
+            simplifyAllFuncs = true;
+
         for (auto inst : module->getGlobalInsts())
         {
             auto func = as<IRGlobalValueWithCode>(inst);
             if (!func)
                 continue;
+            if (!simplifyAllFuncs && !dirtyFuncs.contains(func))
+                continue;
+
             bool funcChanged = true;
+            bool anyFuncChanges = false;
             int funcIterationCount = 0;
             while (funcChanged && funcIterationCount < kMaxFuncIterations)
             {
@@ -101,10 +160,26 @@ void simplifyIR(
                 eliminateDeadCode(func, options.deadCodeElimOptions);
                 if (funcIterationCount == 0)
                     funcChanged |= constructSSA(func);
-                changed |= funcChanged;
+                anyFuncChanges |= funcChanged;
                 funcIterationCount++;
             }
+
+            if (anyFuncChanges)
+            {
+                changed = true;
+
+                // A function that still changes after `kMaxFuncIterations` hasn't
+                // converged, so it needs to be simplified again.
+                if (funcChanged)
+                    nextDirtyFuncs.add(func);
+                _addDependentFuncs(func, visitedInsts, nextDirtyFuncs);
+                visitedInsts.clear();
+            }
         }
+
+        dirtyFuncs = _Move(nextDirtyFuncs);
+        nextDirtyFuncs.clear();
+        simplifyAllFuncs = false;
         iterationCounter++;
     }
     eliminateDeadCode(module, options.deadCodeElimOptions);
@@ -1735,13 +1735,13 @@ List<IRBlock*> collectBlocksInRegion(
     IRLoop* loopInst,
     bool* outHasMultiLevelBreaks)
 {
-    auto dom = computeDominatorTree(func);
+    auto dom = findOrComputeDominatorTree(func);
     return collectBlocksInRegion(dom, loopInst, outHasMultiLevelBreaks);
 }
 
 List<IRBlock*> collectBlocksInRegion(IRGlobalValueWithCode* func, IRLoop* loopInst)
 {
-    auto dom = computeDominatorTree(func);
+    auto dom = findOrComputeDominatorTree(func);
     bool hasMultiLevelBreaks = false;
     return collectBlocksInRegion(dom, loopInst, &hasMultiLevelBreaks);
 }
@@ -2127,7 +2127,7 @@ IRBlock* getLoopHeaderForConditionBlock(IRBlock* block)
 
 void legalizeDefUse(IRGlobalValueWithCode* func)
 {
-    auto dom = computeDominatorTree(func);
+    auto dom = findOrComputeDominatorTree(func);
 
     // Make a map of loop condition blocks to their loop header.
     // We need this because we'll be treating loop condition blocks as
@@ -359,6 +359,20 @@ void validateIRInst(IRValidateContext* context, IRInst* inst)
     {
         context->domTree = computeDominatorTree(code);
         validateCodeBody(context, code);
+
+        // A dominator tree cached on the module must have been dropped when the control
+        // flow graph of `code` changed.
+        if (context->module)
+        {
+            if (auto cachedDomTree = context->module->findDominatorTree(code))
+            {
+                validate(
+                    context,
+                    cachedDomTree->isEquivalentTo(context->domTree),
+                    code,
+                    "cached dominator tree must match the control flow graph");
+            }
+        }
     }
 
     // If `inst` is itself a parent instruction, then we need to recursively
@@ -63,7 +63,9 @@ void VariableScopeCorrectionContext::processModule()
 
 void VariableScopeCorrectionContext::_processFunction(IRFunc* funcInst)
 {
-    IRDominatorTree* dominatorTree = m_module->findOrCreateDominatorTree(funcInst);
+    // Processing the function can change its control flow graph, which releases the
+    // cached tree, so we hold on to it.
+    RefPtr<IRDominatorTree> dominatorTree = m_module->findOrCreateDominatorTree(funcInst);
     List<IRInst*> workList;
     Dictionary<IRBlock*, List<IRLoop*>> loopHeaderMap;
 
@@ -119,6 +119,46 @@ void IRUse::debugValidate()
 #endif
 }
 
+// The analyses cached on a module for a function (only its dominator tree, see
+// `IRAnalysis`) depend on the control flow graph of the function, which changes when
+// one of its blocks, or the terminator of one of its blocks, is added or removed, or
+// when the operands of a terminator change.
+//
+static void _invalidateAnalysisForCFGChange(IRInst* inst, IRInst* parent)
+{
+    IRInst* code = nullptr;
+    if (as<IRBlock>(inst))
+        code = parent;
+    else if (as<IRTerminatorInst>(inst) && as<IRBlock>(parent))
+        code = parent->getParent();
+
+    auto func = as<IRGlobalValueWithCode>(code);
+    if (!func)
+        return;
+    if (auto module = func->getModule())
+        module->invalidateAnalysisForInst(func);
+}
+
+// The link index of a module lists some of its global instructions by their
+// decorations, so it is out of date when a global instruction or one of their
+// decorations is added or removed.
+//
+// Only modules that have been linked from have an index, and most changes are
+// inside the bodies of functions, so the module is only marked when its index
+// would actually be affected.
+//
+static void _invalidateLinkIndexForChange(IRInst* inst, IRInst* parent)
+{
+    IRInst* moduleInst = parent;
+    if (as<IRDecoration>(inst))
+        moduleInst = parent->getParent();
+
+    auto module = as<IRModuleInst>(moduleInst);
+    if (!module || !module->module || !module->module->findLinkIndex())
+        return;
+    module->module->invalidateLinkIndex();
+}
+
 void IRUse::init(IRInst* u, IRInst* v)
 {
     clear();
@@ -135,6 +175,9 @@ void IRUse::init(IRInst* u, IRInst* v)
         }
 
         v->firstUse = this;
+
+        if (as<IRTerminatorInst>(u))
+            _invalidateAnalysisForCFGChange(u, u->getParent());
     }
 #ifdef SLANG_ENABLE_FULL_IR_VALIDATION
     debugValidate();
@@ -168,6 +211,9 @@ void IRUse::clear()
             nextUse->prevLink = prevLink;
         }
 
+        if (as<IRTerminatorInst>(user))
+            _invalidateAnalysisForCFGChange(user, user->getParent());
+
         user = nullptr;
         usedValue = nullptr;
         nextUse = nullptr;
@@ -1481,7 +1527,24 @@ IRInst* IRModule::_allocateInst(IROp op, Int operandCount, size_t minSizeInBytes
     size_t defaultSize = sizeof(IRInst) + (operandCount) * sizeof(IRUse);
     size_t totalSize = minSizeInBytes > defaultSize ? minSizeInBytes : defaultSize;
 
-    IRInst* inst = (IRInst*)m_memoryArena.allocateAndZero(totalSize);
+    // Reuse the memory of a deallocated instruction with the same operand count if
+    // possible. The free lists only hold instructions of their default size.
+    IRInst* inst = nullptr;
+    if (totalSize == defaultSize && operandCount < kFreeInstListCount &&
+        m_freeInstLists[operandCount])
+    {
+        void* freeInst = m_freeInstLists[operandCount];
+        m_freeInstLists[operandCount] = *(void**)freeInst;
+        m_deadInstBytes -= totalSize;
+        m_reusedInstBytes += totalSize;
+
+        inst = (IRInst*)freeInst;
+        memset(inst, 0, totalSize);
+    }
+    else
+    {
+        inst = (IRInst*)m_memoryArena.allocateAndZero(totalSize);
+    }
 
     // TODO: Is it actually important to run a constructor here?
     new (inst) IRInst();
@@ -1489,9 +1552,98 @@ IRInst* IRModule::_allocateInst(IROp op, Int operandCount, size_t minSizeInBytes
     inst->operandCount = uint32_t(operandCount);
     inst->m_op = op;
 
+    m_instCount++;
+    m_allocatedInstBytes += totalSize;
+
     return inst;
 }
 
+void IRModule::_deallocateInst(IRInst* inst)
+{
+    // An instruction that was reinserted after being deallocated can be deallocated again.
+    if (inst->m_isDeallocated)
+        return;
+    inst->m_isDeallocated = true;
+    m_instCount--;
+
+    // Deallocated instructions are only tracked if something reclaims them, since the
+    // module could otherwise accumulate them for as long as it lives.
+    if (!m_isInstReuseEnabled)
+        return;
+
+    m_deallocatedInsts.add(inst);
+    m_deadInstBytes += sizeof(IRInst) + inst->operandCount * sizeof(IRUse);
+}
+
+void IRModule::reclaimDeallocatedInsts()
+{
+    if (!m_isInstReuseEnabled || m_deallocatedInsts.getCount() == 0)
+        return;
+
+    // The deduplication maps can still refer to an instruction after it has been
+    // deallocated, such as when it is the replacement recorded for a duplicate that has
+    // been replaced. Reusing its memory would make later lookups find whatever
+    // instruction is allocated there next, so it is left alone until the maps drop it.
+    //
+    HashSet<IRInst*> dedupInsts;
+    for (const auto& [key, value] : m_deduplicationContext.getGlobalValueNumberingMap())
+        dedupInsts.add(value);
+    for (const auto& [key, value] : m_deduplicationContext.getConstantMap())
+        dedupInsts.add(value);
+    for (const auto& [key, value] : m_deduplicationContext.getInstReplacementMap())
+    {
+        dedupInsts.add(key);
+        dedupInsts.add(value);
+    }
+
+    List<IRInst*> dedupDeallocatedInsts;
+    for (auto inst : m_deallocatedInsts)
+    {
+        // An instruction can be deallocated while something still uses it, or be
+        // reinserted after being removed. Its memory is left alone in those cases, and
+        // it is counted as live again until it is next deallocated.
+        //
+        if (inst->hasUses() || inst->getParent())
+        {
+            inst->m_isDeallocated = false;
+            m_instCount++;
+            m_deadInstBytes -= sizeof(IRInst) + inst->operandCount * sizeof(IRUse);
+            continue;
+        }
+
+        // Check again at the next call.
+        if (dedupInsts.contains(inst))
+        {
+            dedupDeallocatedInsts.add(inst);
+            continue;
+        }
+
+        // The operand count can only have decreased since allocation, so the memory is
+        // at least as large as the size of the free list it is added to.
+        //
+        if (inst->operandCount >= kFreeInstListCount)
+            continue;
+
+        *(void**)inst = m_freeInstLists[inst->operandCount];
+        m_freeInstLists[inst->operandCount] = inst;
+    }
+    m_deallocatedInsts.clear();
+    for (auto inst : dedupDeallocatedInsts)
+        m_deallocatedInsts.add(inst);
+
+    // Analyses can refer to deallocated instructions, which are about to be reused.
+    invalidateAllAnalysis();
+}
+
+IRModule::InstMemoryStats IRModule::getInstMemoryStats() const
+{
+    InstMemoryStats stats;
+    stats.arenaBytes = m_memoryArena.calcTotalMemoryUsed();
+    stats.deadInstBytes = m_deadInstBytes;
+    stats.reusedInstBytes = m_reusedInstBytes;
+    return stats;
+}
+
 /// Return whichever of `left` or `right` represents the later point in a common parent
 static IRInst* pickLaterInstInSameParent(IRInst* left, IRInst* right)
 {
@@ -8266,6 +8418,10 @@ static void _replaceInstUsesWith(IRInst* thisInst, IRInst* other)
 
 void IRInst::replaceUsesWith(IRInst* other)
 {
+    // Replacing a block changes the terminators that branch to it.
+    if (as<IRBlock>(this))
+        _invalidateAnalysisForCFGChange(this, getParent());
+
     _replaceInstUsesWith(this, other);
 }
 
@@ -8325,6 +8481,9 @@ void IRInst::_insertAt(IRInst* inPrev, IRInst* inNext, IRInst* inParent)
     this->next = inNext;
     this->parent = inParent;
 
+    _invalidateAnalysisForCFGChange(this, inParent);
+    _invalidateLinkIndexForChange(this, inParent);
+
 #if _DEBUG
     validateIRInstOperands(this);
 #endif
@@ -8411,6 +8570,9 @@ void IRInst::removeFromParent()
     prev = nullptr;
     next = nullptr;
     parent = nullptr;
+
+    _invalidateAnalysisForCFGChange(this, oldParent);
+    _invalidateLinkIndexForChange(this, oldParent);
 }
 
 void IRInst::removeArguments()
@@ -8440,7 +8602,8 @@ void IRInst::removeAndDeallocate()
 {
     removeAndDeallocateAllDecorationsAndChildren();
 
-    if (auto module = getModule())
+    auto module = getModule();
+    if (module)
     {
         if (getIROpInfo(getOp()).isHoistable())
         {
@@ -8456,6 +8619,9 @@ void IRInst::removeAndDeallocate()
     }
     removeArguments();
     removeFromParent();
+
+    if (module)
+        module->_deallocateInst(this);
 }
 
 void IRInst::removeAndDeallocateAllDecorationsAndChildren()
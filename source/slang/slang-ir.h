@@ -555,6 +555,10 @@ struct IRInst
     // Source location information for this value, if any
     SourceLoc sourceLoc;
 
+    // Set once the instruction has been deallocated, so that it is only
+    // counted as deallocated once (see `IRModule::_deallocateInst`).
+    bool m_isDeallocated = false;
+
     // Each instruction can have zero or more "decorations"
     // attached to it. A decoration is a specialized kind
     // of instruction that either attaches metadata to,
@@ -2351,12 +2355,61 @@ private:
 
 struct IRDominatorTree;
 
+/// The analyses of a function that are cached on its module (see
+/// `IRModule::findOrCreateDominatorTree`), and dropped when its control flow graph changes.
+///
+/// Only the dominator tree is cached. Other analyses, such as post-dominator trees, loop
+/// structure, liveness and the call graph, are computed by the passes that use them, and
+/// nothing invalidates them, so they must not be kept across changes to the IR.
+///
 struct IRAnalysis
 {
     RefPtr<RefObject> domTree;
     IRDominatorTree* getDominatorTree();
 };
 
+/// The global instructions of a module that the linker may need to clone
+/// whether or not they are referenced.
+///
+/// This is gathered once per module (see `getIRModuleLinkIndex`), so that linking
+/// doesn't have to visit every global instruction of every module it links. The
+/// module drops its index when a global instruction, or a decoration of one, is
+/// added or removed (as `precompileForTarget` does), and it is built again on next
+/// use. Changes inside the bodies of global instructions don't drop the index,
+/// since modules aren't changed that way after they are lowered.
+///
+struct IRModuleLinkIndex : RefObject
+{
+    enum Flag : uint8_t
+    {
+        kFlag_HLSLExported = 0x1,       ///< The inst is exported to HLSL
+        kFlag_GlobalParam = 0x2,        ///< The inst is a global shader parameter
+        kFlag_AutoDiffAnnotation = 0x4, ///< The inst is an auto-diff annotation or builtin
+    };
+
+    struct Entry
+    {
+        IRInst* inst;
+        uint8_t flags;
+    };
+
+    /// Insts that are cloned depending on their flags and the link options, in module order.
+    List<Entry> conditionalInsts;
+
+    /// Insts that are always cloned from user modules (global generic parameter
+    /// bindings and debug information), in module order.
+    List<IRInst*> unconditionalInsts;
+
+    /// The `IRGlobalHashedStringLiterals` insts of the module.
+    List<IRInst*> hashedStringLiterals;
+
+    /// The module has embedded downstream IR.
+    bool hasEmbeddedDownstreamIR = false;
+
+    /// The module uses auto-diff (see `doesModuleUseAutodiff`).
+    bool usesAutodiff = false;
+};
+
 FIDDLE()
 struct IRModule : RefObject
 {
@@ -2400,13 +2453,26 @@ public:
             return analysis->getDominatorTree();
         return nullptr;
     }
+    /// Get the dominator tree of `func`, computing it if there isn't a valid one cached.
+    ///
+    /// The analyses of a function are invalidated automatically when its control flow
+    /// graph changes, which releases the tree. Code that keeps using a tree while
+    /// changing the control flow graph should hold on to it with a `RefPtr`.
+    ///
     IRDominatorTree* findOrCreateDominatorTree(IRGlobalValueWithCode* func);
     void invalidateAnalysisForInst(IRGlobalValueWithCode* func)
     {
-        m_mapInstToAnalysis.remove(func);
+        if (m_mapInstToAnalysis.getCount())
+            m_mapInstToAnalysis.remove(func);
     }
     void invalidateAllAnalysis() { m_mapInstToAnalysis.clear(); }
 
+    /// Get the link index of the module, or null if it hasn't been built.
+    /// Use `getIRModuleLinkIndex` to build it on demand.
+    IRModuleLinkIndex* findLinkIndex() const { return m_linkIndex; }
+    void setLinkIndex(IRModuleLinkIndex* linkIndex) { m_linkIndex = linkIndex; }
+    void invalidateLinkIndex() { m_linkIndex = nullptr; }
+
     IRInstListBase getGlobalInsts() const { return getModuleInst()->getChildren(); }
 
     Name* getName() const { return m_name; }
@@ -2441,6 +2507,58 @@ public:
         return (T*)_allocateInst(op, operandCount, sizeof(T));
     }
 
+    /// Record that `inst` has been removed from this module and deallocated.
+    ///
+    /// The memory of `inst` isn't reused straight away, since passes commonly
+    /// still look at instructions they have just removed. If reuse is enabled
+    /// (see `enableInstReuse`), it becomes available to `_allocateInst` after
+    /// the next call to `reclaimDeallocatedInsts`.
+    ///
+    void _deallocateInst(IRInst* inst);
+
+    /// Track deallocated instructions so that `reclaimDeallocatedInsts` can reuse
+    /// their memory.
+    ///
+    /// Only modules that call `reclaimDeallocatedInsts` regularly should enable this,
+    /// since the deallocated instructions are held until then.
+    ///
+    void enableInstReuse() { m_isInstReuseEnabled = true; }
+
+    /// Make the memory of instructions deallocated since the last call available
+    /// for reuse. Does nothing unless reuse is enabled.
+    ///
+    /// This must only be called between passes, when nothing holds on to
+    /// pointers to deallocated instructions. Instructions the deduplication maps
+    /// still refer to are kept until a later call.
+    ///
+    void reclaimDeallocatedInsts();
+
+    /// Statistics about the memory used for instructions in the module arena
+    struct InstMemoryStats
+    {
+        size_t arenaBytes = 0;      ///< Total bytes used in the memory arena
+        size_t deadInstBytes = 0;   ///< Bytes of deallocated instructions not reused (yet)
+        size_t reusedInstBytes = 0; ///< Bytes of deallocated instructions that have been reused
+
+        /// Bytes in the arena that are (approximately) still in use
+        size_t getLiveBytes() const
+        {
+            return arenaBytes > deadInstBytes ? arenaBytes - deadInstBytes : 0;
+        }
+    };
+
+    InstMemoryStats getInstMemoryStats() const;
+
+    /// Get the number of instructions allocated in the module that haven't been
+    /// deallocated.
+    ///
+    /// Instructions that are removed without being deallocated are still counted.
+    ///
+    Count getInstCount() const { return m_instCount; }
+
+    /// Get the total number of bytes allocated for instructions, including reused memory.
+    size_t getAllocatedInstBytes() const { return m_allocatedInstBytes; }
+
     ContainerPool& getContainerPool() { return m_containerPool; }
 
     //
@@ -2509,6 +2627,31 @@ private:
     Dictionary<IRInst*, IRAnalysis> m_mapInstToAnalysis;
 
     Dictionary<ImmutableHashedString, List<IRInst*>> m_mapMangledNameToGlobalInst;
+
+    RefPtr<IRModuleLinkIndex> m_linkIndex;
+
+    enum
+    {
+        /// Instructions with at least this many operands are not reused
+        kFreeInstListCount = 16,
+    };
+
+    /// Whether deallocated instructions are tracked for reuse, see `enableInstReuse`
+    bool m_isInstReuseEnabled = false;
+
+    /// Instructions deallocated since the last `reclaimDeallocatedInsts`
+    HashSet<IRInst*> m_deallocatedInsts;
+
+    /// Free lists of instruction memory, indexed by operand count. The memory
+    /// of each free instruction holds the link to the next one.
+    void* m_freeInstLists[kFreeInstListCount] = {};
+
+    size_t m_deadInstBytes = 0;
+    size_t m_reusedInstBytes = 0;
+
+    /// The number of instructions allocated and not deallocated
+    Count m_instCount = 0;
+    size_t m_allocatedInstBytes = 0;
 };
 
 
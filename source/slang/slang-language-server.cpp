@@ -186,6 +186,14 @@ SlangResult LanguageServer::parseNextMessage()
                 }
                 return SLANG_OK;
             }
+            else if (call.method == SetTraceParams::methodName)
+            {
+                SetTraceParams args;
+                SLANG_RETURN_ON_FAIL(
+                    m_connection->toNativeArgsOrSendError(call.params, &args, call.id));
+                updateTraceOptions(args.value);
+                return SLANG_OK;
+            }
             else if (call.method == "initialized")
             {
                 registerCapability("workspace/didChangeConfiguration");
@@ -2296,17 +2304,34 @@ void LanguageServer::updateTraceOptions(const JSONValue& value)
         JSONToNativeConverter converter(container, &m_typeMap, m_connection->getSink());
         String str;
         if (SLANG_SUCCEEDED(converter.convert(value, &str)))
-        {
-            if (str == "messages")
-                m_traceOptions = TraceOptions::Messages;
-            else if (str == "verbose")
-                m_traceOptions = TraceOptions::Verbose;
-            else
-                m_traceOptions = TraceOptions::Off;
-        }
+            updateTraceOptions(str);
     }
 }
 
+void LanguageServer::updateTraceOptions(const String& value)
+{
+    if (value == "messages")
+        m_traceOptions = TraceOptions::Messages;
+    else if (value == "verbose")
+        m_traceOptions = TraceOptions::Verbose;
+    else
+        m_traceOptions = TraceOptions::Off;
+}
+
+void LanguageServer::logEvictedModules()
+{
+    if (!m_core.m_workspace)
+        return;
+    auto names = m_core.m_workspace->takeEvictedModuleNames();
+    if (names.getCount() == 0 || m_traceOptions != TraceOptions::Verbose)
+        return;
+    StringBuilder msgBuilder;
+    msgBuilder << "Reloading " << names.getCount() << " changed imported module(s):";
+    for (auto& name : names)
+        msgBuilder << " " << name;
+    logMessage(3, msgBuilder.produceString());
+}
+
 void LanguageServer::sendConfigRequest()
 {
     ConfigurationParams args;
@@ -2726,6 +2751,7 @@ void LanguageServer::processCommands()
         else
         {
             runCommand(cmd);
+            logEvictedModules();
         }
     }
 }
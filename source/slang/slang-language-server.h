@@ -258,6 +258,10 @@ private:
         const JSONValue& allowLineBreakInRange);
     void updateInlayHintOptions(const JSONValue& deducedTypes, const JSONValue& parameterNames);
     void updateTraceOptions(const JSONValue& value);
+    void updateTraceOptions(const String& value);
+    /// Log the imported modules that the last command found to be out of date, if tracing
+    /// is verbose.
+    void logEvictedModules();
 
     void sendConfigRequest();
     void registerCapability(const char* methodName);
@@ -2,6 +2,7 @@
 #include "slang-lookup.h"
 
 #include "../compiler-core/slang-name.h"
+#include "../core/slang-performance-profiler.h"
 #include "slang-check-impl.h"
 
 // TODO(tfoley): The implementation of lookup still involves
@@ -832,11 +833,100 @@ static bool _isDeclOverloadable(Decl* decl)
     return false;
 }
 
+/// Is `scope` (along with its siblings) the scope of a module, file or namespace?
+static bool _isModuleLevelScope(Scope* scope)
+{
+    for (auto link = scope; link; link = link->nextSibling)
+    {
+        auto containerDecl = link->containerDecl;
+        if (containerDecl && !as<NamespaceDeclBase>(containerDecl) &&
+            !as<FileDecl>(containerDecl))
+            return false;
+    }
+    return true;
+}
+
 static void _lookUpInScopes(
     ASTBuilder* astBuilder,
     Name* name,
     LookupRequest const& request,
+    LookupResult& result,
+    bool useCache = true);
+
+/// Get the version of everything a lookup from a module level scope can find.
+///
+/// The modules that a lookup from the scope of a module being checked can reach
+/// are loaded into the same linkage, or into the builtin linkage, and each of
+/// those records any change to the members or sibling scopes of its modules
+/// (see `Linkage::getLookupVersion`). Both versions only ever grow, so their sum
+/// changes whenever anything the lookup can find changes.
+///
+static UInt _getModuleScopesLookupVersion(SharedSemanticsContext* shared)
+{
+    auto linkage = shared->getLinkage();
+    UInt version = linkage->getLookupVersion();
+    auto builtinLinkage = linkage->getSessionImpl()->getBuiltinLinkage();
+    if (builtinLinkage && builtinLinkage != linkage)
+        version += builtinLinkage->getLookupVersion();
+    return version;
+}
+
+/// Look up `name` starting from the module level `scope`, using the result cached
+/// for the semantic checking session if there is one.
+///
+/// The scopes of modules, files and namespaces (and their parents) only contain
+/// declarations that don't depend on where the lookup came from, and change
+/// rarely once they are checked, so the same names (like `float3` or `mul`) can
+/// be looked up through them once rather than each time they are referenced.
+///
+static void _lookUpInModuleScopes(
+    ASTBuilder* astBuilder,
+    Name* name,
+    LookupRequest const& request,
+    Scope* scope,
     LookupResult& result)
+{
+    auto shared = request.semantics->getShared();
+    auto& cache = shared->getLookupCache();
+    UInt version = _getModuleScopesLookupVersion(shared);
+
+    LookupCacheKey key = {astBuilder, scope, name, request.mask, request.options};
+    auto cachedResult = cache.results.tryGetValue(key);
+    if (cachedResult && cachedResult->version == version)
+    {
+        cache.hitCount++;
+        result = cachedResult->result;
+        return;
+    }
+    cache.missCount++;
+
+    LookupRequest moduleRequest = request;
+    moduleRequest.scope = scope;
+    _lookUpInScopes(astBuilder, name, moduleRequest, result, false);
+
+    // Looking up may have checked declarations that changed the scopes, in which
+    // case the result may already be out of date.
+    //
+    if (_getModuleScopesLookupVersion(shared) == version)
+        cache.results[key] = CachedLookupResult{result, version};
+}
+
+LookupCache::~LookupCache()
+{
+    // Report how well the cache worked in the compile time profile.
+    if (hitCount || missCount)
+    {
+        SLANG_PROFILE_COUNTER(lookupCacheHits, hitCount);
+        SLANG_PROFILE_COUNTER(lookupCacheMisses, missCount);
+    }
+}
+
+static void _lookUpInScopes(
+    ASTBuilder* astBuilder,
+    Name* name,
+    LookupRequest const& request,
+    LookupResult& result,
+    bool useCache)
 {
     auto thisParameterMode = LookupResultItem::Breadcrumb::ThisParameterMode::Default;
 
@@ -847,8 +937,20 @@ static void _lookUpInScopes(
     // The file decl that this scope is in.
     FileDecl* thisFileDecl = nullptr;
 
+    // Results are only cached for the common case of a lookup that runs to the
+    // outermost scope, with nothing found before reaching the module level scopes.
+    //
+    useCache = useCache && request.semantics && !endScope && !request.declToExclude &&
+               !request.isCompletionRequest();
+
     for (; scope != endScope; scope = scope->parent)
     {
+        if (useCache && !result.isValid() && _isModuleLevelScope(scope))
+        {
+            _lookUpInModuleScopes(astBuilder, name, request, scope, result);
+            return;
+        }
+
         // Note that we consider all "peer" scopes together,
         // so that a hit in one of them does not preclude
         // also finding a hit in another
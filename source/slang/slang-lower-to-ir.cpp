@@ -12337,6 +12337,8 @@ RefPtr<IRModule> generateIRForTranslationUnit(
 
     module->buildMangledNameToGlobalInstMap();
 
+    SLANG_PROFILE_COUNTER(irInstsLowered, module->getInstCount());
+
     return module;
 }
 
@@ -514,7 +514,15 @@ void initCommandOptions(CommandOptions& options)
         {OptionKind::ReportPerfBenchmark,
          "-report-perf-benchmark",
          nullptr,
-         "Reports compiler performance benchmark results."},
+         "Reports compiler performance benchmark results, including the time, instruction "
+         "counts and memory allocated for each IR pass."},
+        {OptionKind::ReportPerfTrace,
+         "-report-perf-trace",
+         "-report-perf-trace <path>",
+         "Writes a profile of the compilation to the specified path as JSON in the Chrome trace "
+         "event format, which can be viewed with chrome://tracing or Perfetto. The profile shows "
+         "the functions and IR passes run on each thread, nested as they ran, and compiler "
+         "counters over time."},
         {OptionKind::ReportCheckpointIntermediates,
          "-report-checkpoint-intermediates",
          nullptr,
@@ -566,7 +574,46 @@ void initCommandOptions(CommandOptions& options)
         {OptionKind::EmitReflectionJSON,
          "-reflection-json",
          "-reflection-json <path>",
-         "Emit reflection data in JSON format to a file."}};
+         "Emit reflection data in JSON format to a file."},
+        {OptionKind::CompilationCacheDirectory,
+         "-cache-dir",
+         "-cache-dir <path>",
+         "Use a persistent compilation cache in the specified directory. Entry point code is "
+         "looked up in the cache by a hash of the program, its dependencies and the compiler "
+         "options before generating code, and added to it afterwards."},
+        {OptionKind::CompilationCacheMaxEntryCount,
+         "-cache-max-entries",
+         "-cache-max-entries <count>",
+         "Limit the number of entries in the persistent compilation cache. The least recently "
+         "used entries are evicted first. Defaults to no limit."},
+        {OptionKind::CodeGenThreadCount,
+         "-codegen-threads",
+         "-codegen-threads <count>",
+         "Generate code for entry points and targets in parallel using the specified number of "
+         "threads. A count of 0 uses one thread per hardware thread. Diagnostics and outputs are "
+         "the same as for a serial compile. Defaults to 1."},
+        {OptionKind::ImportThreadCount,
+         "-import-threads",
+         "-import-threads <count>",
+         "Preprocess the modules imported by the code being compiled in the background, while "
+         "the modules importing them are parsed and checked, using the specified number of "
+         "threads (including the compiling thread). Only preprocessing is done in the "
+         "background. A count of 0 uses one thread per hardware thread. Diagnostics and outputs "
+         "are the same as for a serial compile. A custom file system must support being used "
+         "from several threads at once, so this is off by default. Defaults to 1."},
+        {OptionKind::MapBinaryModules,
+         "-map-binary-modules",
+         nullptr,
+         "Map precompiled modules (.slang-module) found in the file system into memory instead "
+         "of reading them, so their contents are shared with other processes and only the parts "
+         "that are used are loaded. A mapped module file must not be modified while the compiler "
+         "is running."},
+        {OptionKind::ReuseIRMemory,
+         "-reuse-ir-memory",
+         nullptr,
+         "Reuse the memory of IR instructions removed by the optimization passes run on the "
+         "linked IR for the instructions created by later passes, to reduce the memory used to "
+         "compile large programs. Off by default."}};
 
     _addOptions(makeConstArrayView(generalOpts), options);
 
@@ -2264,6 +2311,8 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
         case OptionKind::LoopInversion:
         case OptionKind::UnscopedEnum:
         case OptionKind::PreserveParameters:
+        case OptionKind::MapBinaryModules:
+        case OptionKind::ReuseIRMemory:
             linkage->m_optionSet.set(optionKind, true);
             break;
         case OptionKind::MatrixLayoutRow:
@@ -2827,6 +2876,47 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
                 linkage->m_optionSet.set(CompilerOptionName::EmitReflectionJSON, outputPath.value);
                 break;
             }
+        case OptionKind::ReportPerfTrace:
+            {
+                CommandLineArg tracePath;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(tracePath));
+
+                linkage->m_optionSet.set(CompilerOptionName::ReportPerfTrace, tracePath.value);
+                break;
+            }
+        case OptionKind::CompilationCacheDirectory:
+            {
+                CommandLineArg cacheDirectory;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(cacheDirectory));
+
+                linkage->m_optionSet.set(
+                    CompilerOptionName::CompilationCacheDirectory,
+                    cacheDirectory.value);
+                break;
+            }
+        case OptionKind::CompilationCacheMaxEntryCount:
+            {
+                Int count = 0;
+                SLANG_RETURN_ON_FAIL(_expectInt(arg, count));
+                linkage->m_optionSet.set(
+                    CompilerOptionName::CompilationCacheMaxEntryCount,
+                    (int)count);
+                break;
+            }
+        case OptionKind::CodeGenThreadCount:
+            {
+                Int count = 0;
+                SLANG_RETURN_ON_FAIL(_expectInt(arg, count));
+                linkage->m_optionSet.set(CompilerOptionName::CodeGenThreadCount, (int)count);
+                break;
+            }
+        case OptionKind::ImportThreadCount:
+            {
+                Int count = 0;
+                SLANG_RETURN_ON_FAIL(_expectInt(arg, count));
+                linkage->m_optionSet.set(CompilerOptionName::ImportThreadCount, (int)count);
+                break;
+            }
         case OptionKind::DepFile:
             {
                 CommandLineArg dependencyPath;
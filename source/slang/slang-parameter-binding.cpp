@@ -4160,8 +4160,15 @@ RefPtr<ProgramLayout> generateParameterBindings(TargetProgram* targetProgram, Di
 
     {
         auto& pool = programLayout->hashedStringLiteralPool;
-        program->enumerateIRModules([&](IRModule* module)
-                                    { findGlobalHashedStringLiterals(module, pool); });
+        // Modules with unread serialized IR are only read if they have hashed string literals.
+        auto visitModule = [&](IRModule* module) { findGlobalHashedStringLiterals(module, pool); };
+        program->enumerateIRModules(
+            visitModule,
+            [&](Module* module)
+            {
+                if (module->mayHaveUnconditionalIRInsts())
+                    visitModule(module->getIRModule(sink));
+            });
     }
 
     // Try to find rules based on the selected code-generation target
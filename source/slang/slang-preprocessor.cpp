@@ -38,6 +38,161 @@ void PreprocessorHandler::handleFileDependency(SourceFile* sourceFile)
     SLANG_UNUSED(sourceFile);
 }
 
+//
+// PreprocessorTokenCache
+//
+
+/// Find the macro guarding the whole of a file lexed into `tokens`, if there is one.
+///
+/// We recognize the classic form of include guard:
+///
+///     #ifndef X
+///     #define X
+///     ...
+///     #endif
+///
+/// where nothing but whitespace and comments comes before the `#ifndef` or after the
+/// `#endif`, and there is no `#else` or `#elif` for the `#ifndef`. When `X` is defined
+/// including such a file has no effect, and so it can be skipped.
+///
+static Name* _findIncludeGuard(List<Token> const& tokens)
+{
+    // New-line tokens only matter to us as the ends of directives, and we can
+    // tell where a directive starts from the `#` at the start of a line, so we
+    // skip over them. The `tokens` always end with an end-of-file token.
+    //
+    Index index = 0;
+    auto peekToken = [&]() -> const Token&
+    {
+        while (tokens[index].type == TokenType::NewLine)
+            index++;
+        return tokens[index];
+    };
+    auto readToken = [&]() -> const Token&
+    {
+        const Token& token = peekToken();
+        if (token.type != TokenType::EndOfFile)
+            index++;
+        return token;
+    };
+
+    // Read an identifier on the same line as the token before it
+    auto readDirectiveName = [&]() -> Name*
+    {
+        const Token& token = peekToken();
+        if (token.type != TokenType::Identifier || (token.flags & TokenFlag::AtStartOfLine))
+            return nullptr;
+        readToken();
+        return token.getName();
+    };
+
+    // Get the name of the directive started by `token`, if it starts one
+    auto getDirective = [&](const Token& token) -> UnownedStringSlice
+    {
+        if (token.type != TokenType::Pound || !(token.flags & TokenFlag::AtStartOfLine))
+            return UnownedStringSlice();
+        Name* name = readDirectiveName();
+        return name ? name->text.getUnownedSlice() : UnownedStringSlice();
+    };
+
+    if (getDirective(readToken()) != "ifndef")
+        return nullptr;
+    Name* guard = readDirectiveName();
+    if (!guard || getDirective(readToken()) != "define" || readDirectiveName() != guard)
+        return nullptr;
+
+    Index depth = 1;
+    for (;;)
+    {
+        const Token& token = readToken();
+        if (token.type == TokenType::EndOfFile)
+            return nullptr;
+
+        const UnownedStringSlice directive = getDirective(token);
+        if (directive == "if" || directive == "ifdef" || directive == "ifndef")
+        {
+            depth++;
+        }
+        else if (directive == "endif")
+        {
+            if (--depth == 0)
+                return readToken().type == TokenType::EndOfFile ? guard : nullptr;
+        }
+        else if (depth == 1 && (directive == "else" || directive == "elif"))
+        {
+            return nullptr;
+        }
+    }
+}
+
+PreprocessorTokenCache::Entry* PreprocessorTokenCache::findEntry(SourceFile* sourceFile)
+{
+    if (!sourceFile->hasContent())
+        return nullptr;
+    const SHA1::Digest digest = sourceFile->getDigest();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (auto entry = m_entries.tryGetValue(digest))
+        return *entry;
+    return nullptr;
+}
+
+PreprocessorTokenCache::Entry* PreprocessorTokenCache::getEntry(
+    SourceView* sourceView,
+    NamePool* namePool)
+{
+    SourceFile* sourceFile = sourceView->getSourceFile();
+    if (!sourceFile->hasContent())
+        return nullptr;
+    const SHA1::Digest digest = sourceFile->getDigest();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (auto entry = m_entries.tryGetValue(digest))
+            return *entry;
+    }
+
+    // Lex the whole file without holding the lock, into a sink of our own so we can
+    // tell whether there was anything to diagnose.
+    //
+    RefPtr<Entry> entry = new Entry();
+    entry->contentBlob = sourceFile->getContentBlob();
+    {
+        DiagnosticSink sink(sourceView->getSourceManager(), nullptr);
+
+        Lexer lexer;
+        lexer.initialize(sourceView, &sink, namePool, &entry->memoryArena);
+
+        const SourceLoc::RawValue startLoc = sourceView->getRange().begin.getRaw();
+        for (;;)
+        {
+            Token token = lexer.lexToken();
+            if (token.type == TokenType::WhiteSpace || token.type == TokenType::BlockComment ||
+                token.type == TokenType::LineComment)
+                continue;
+
+            token.loc = SourceLoc::fromRaw(token.loc.getRaw() - startLoc);
+            entry->tokens.add(token);
+            if (token.type == TokenType::EndOfFile)
+                break;
+        }
+
+        if (sink.getErrorCount() != 0 || sink.outputBuffer.getLength() != 0)
+            entry = nullptr;
+        else
+            entry->includeGuard = _findIncludeGuard(entry->tokens);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Another preprocessor may have added the same contents while we were lexing.
+    if (auto existingEntry = m_entries.tryGetValue(digest))
+        return *existingEntry;
+
+    m_entries.add(digest, entry);
+    return entry;
+}
+
 // In order to simplify the naming scheme, we will nest the implementaiton of the
 // preprocessor under an additional namesspace, so taht we can have, e.g.,
 // `MacroDefinition` instead of `PreprocessorMacroDefinition`.
@@ -518,7 +673,12 @@ struct LexerInputStream : InputStream
 {
     typedef InputStream Super;
 
-    LexerInputStream(Preprocessor* preprocessor, SourceView* sourceView);
+    /// If `cachedTokens` is set the tokens are read from it, and the lexer is only used
+    /// for locating the ends of lines.
+    LexerInputStream(
+        Preprocessor* preprocessor,
+        SourceView* sourceView,
+        PreprocessorTokenCache::Entry* cachedTokens);
 
     Lexer* getLexer() { return &m_lexer; }
 
@@ -544,6 +704,21 @@ private:
     /// Read a token from the lexer, bypassing lookahead
     Token _readTokenImpl()
     {
+        if (m_cachedTokens)
+        {
+            // The cached tokens are relative to the start of the file, and are moved
+            // into the range of our source view. Once the end-of-file token is reached
+            // it is returned from then on, as the lexer would.
+            //
+            const auto& tokens = m_cachedTokens->tokens;
+            Token token = tokens[m_cachedTokenIndex];
+            if (m_cachedTokenIndex < tokens.getCount() - 1)
+                m_cachedTokenIndex++;
+
+            token.loc = m_lexer.m_startLoc + Int(token.loc.getRaw());
+            return token;
+        }
+
         for (;;)
         {
             Token token = m_lexer.lexToken();
@@ -563,6 +738,12 @@ private:
     /// The lexer state that will provide input
     Lexer m_lexer;
 
+    /// If set, the tokens to read instead of lexing them again
+    PreprocessorTokenCache::Entry* m_cachedTokens = nullptr;
+
+    /// The index of the next token to read from `m_cachedTokens`
+    Index m_cachedTokenIndex = 0;
+
     /// One token of lookahead
     Token m_lookaheadToken;
 };
@@ -943,7 +1124,10 @@ private:
 ///
 struct InputFile
 {
-    InputFile(Preprocessor* preprocessor, SourceView* sourceView);
+    InputFile(
+        Preprocessor* preprocessor,
+        SourceView* sourceView,
+        PreprocessorTokenCache::Entry* cachedTokens = nullptr);
 
     ~InputFile();
 
@@ -1310,8 +1494,15 @@ struct Preprocessor
     /// Stores macro definition and invocation info for language server.
     PreprocessorContentAssistInfo* contentAssistInfo = nullptr;
 
+    /// Cache of the tokens of included files, shared with other preprocessors (optional)
+    PreprocessorTokenCache* tokenCache = nullptr;
+
+    /// Memory arena to hold the contents of lexed tokens
+    MemoryArena* memoryArena = nullptr;
+
     NamePool* getNamePool() { return namePool; }
     SourceManager* getSourceManager() { return sourceManager; }
+    MemoryArena* getMemoryArena() { return memoryArena; }
 
     SourceLoc::RawValue absoluteSourceLocCounter = 0;
 
@@ -1386,19 +1577,28 @@ DiagnosticSink* InputStream::getSink()
 // Basic Input Handling
 //
 
-LexerInputStream::LexerInputStream(Preprocessor* preprocessor, SourceView* sourceView)
-    : Super(preprocessor)
+LexerInputStream::LexerInputStream(
+    Preprocessor* preprocessor,
+    SourceView* sourceView,
+    PreprocessorTokenCache::Entry* cachedTokens)
+    : Super(preprocessor), m_cachedTokens(cachedTokens)
 {
-    MemoryArena* memoryArena = sourceView->getSourceManager()->getMemoryArena();
-    m_lexer.initialize(sourceView, GetSink(preprocessor), preprocessor->getNamePool(), memoryArena);
+    m_lexer.initialize(
+        sourceView,
+        GetSink(preprocessor),
+        preprocessor->getNamePool(),
+        preprocessor->getMemoryArena());
     m_lookaheadToken = _readTokenImpl();
 }
 
-InputFile::InputFile(Preprocessor* preprocessor, SourceView* sourceView)
+InputFile::InputFile(
+    Preprocessor* preprocessor,
+    SourceView* sourceView,
+    PreprocessorTokenCache::Entry* cachedTokens)
 {
     m_preprocessor = preprocessor;
 
-    m_lexerStream = new LexerInputStream(preprocessor, sourceView);
+    m_lexerStream = new LexerInputStream(preprocessor, sourceView, cachedTokens);
     m_expansionStream = new ExpansionInputStream(preprocessor, m_lexerStream);
 }
 
@@ -2162,7 +2362,7 @@ Token MacroInvocation::_readTokenImpl()
                     sourceView,
                     GetSink(m_preprocessor),
                     m_preprocessor->getNamePool(),
-                    sourceManager->getMemoryArena());
+                    m_preprocessor->getMemoryArena());
                 auto lexedTokens = lexer.lexAllSemanticTokens();
 
                 // The `lexedTokens` will always contain at least one token, representing an EOF for
@@ -2247,9 +2447,7 @@ void MacroInvocation::_pushSingleTokenStream(
     // manager, which will also lead to it being shared if used multiple times.
     //
     SourceManager* sourceManager = m_preprocessor->getSourceManager();
-    auto& pool = sourceManager->getStringSlicePool();
-    auto poolHandle = pool.add(content);
-    auto slice = pool.getSlice(poolHandle);
+    auto slice = sourceManager->getStringSlice(sourceManager->addStringSlice(content));
 
     Token token;
     token.type = tokenType;
@@ -3596,8 +3794,11 @@ static void HandleIncludeDirective(PreprocessorDirectiveContext* context)
             return;
         }
 
+        // Another preprocessor running in parallel may have loaded the same file meanwhile,
+        // in which case we use the one that was registered first.
         sourceFile = sourceManager->createSourceFileWithBlob(filePathInfo, foundSourceBlob);
-        sourceManager->addSourceFile(filePathInfo.uniqueIdentity, sourceFile);
+        sourceFile =
+            sourceManager->addSourceFileIfNotExist(filePathInfo.uniqueIdentity, sourceFile);
     }
 
     // If we are running the preprocessor as part of compiling a
@@ -3609,11 +3810,29 @@ static void HandleIncludeDirective(PreprocessorDirectiveContext* context)
         handler->handleFileDependency(sourceFile);
     }
 
+    // If the file has been lexed before (possibly by the preprocessor for another
+    // module), we can reuse its tokens. If it is wrapped in an include guard that
+    // is already defined, everything in it would be skipped, so we needn't enter it.
+    //
+    auto tokenCache = context->m_preprocessor->tokenCache;
+    PreprocessorTokenCache::Entry* cachedTokens =
+        tokenCache ? tokenCache->findEntry(sourceFile) : nullptr;
+    if (cachedTokens && cachedTokens->includeGuard &&
+        LookupMacro(context, cachedTokens->includeGuard))
+    {
+        return;
+    }
+
     // This is a new parse (even if it's a pre-existing source file), so create a new SourceView
     SourceView* sourceView =
         sourceManager->createSourceView(sourceFile, &filePathInfo, directiveLoc);
 
-    InputFile* inputFile = new InputFile(context->m_preprocessor, sourceView);
+    if (tokenCache && !cachedTokens)
+    {
+        cachedTokens = tokenCache->getEntry(sourceView, context->m_preprocessor->getNamePool());
+    }
+
+    InputFile* inputFile = new InputFile(context->m_preprocessor, sourceView, cachedTokens);
 
     context->m_preprocessor->pushInputFile(inputFile, directiveLoc);
 }
@@ -4741,7 +4960,7 @@ static void DefineMacro(Preprocessor* preprocessor, String const& key, String co
         valueView,
         GetSink(preprocessor),
         preprocessor->getNamePool(),
-        sourceManager->getMemoryArena());
+        preprocessor->getMemoryArena());
     macro->tokens = lexer.lexAllSemanticTokens();
 
     Dictionary<Name*, Index> mapParamNameToIndex;
@@ -4859,28 +5078,29 @@ TokenList preprocessSource(
     Linkage* linkage,
     SourceLanguage& outDetectedLanguage,
     SlangLanguageVersion& outLanguageVersion,
-    PreprocessorHandler* handler)
+    PreprocessorHandler* handler,
+    MemoryArena* memoryArena)
 {
     PreprocessorDesc desc;
 
     desc.sink = sink;
     desc.includeSystem = includeSystem;
     desc.handler = handler;
+    desc.memoryArena = memoryArena;
 
     desc.defines = &defines;
 
     desc.fileSystem = linkage->getFileSystemExt();
     desc.namePool = linkage->getNamePool();
     desc.sourceManager = linkage->getSourceManager();
+    desc.tokenCache = &linkage->preprocessorTokenCache;
 
     if (linkage->isInLanguageServer())
     {
         desc.contentAssistInfo = &linkage->contentAssistInfo.preprocessorInfo;
     }
 
-    preprocessor::WarningStateTracker* wst =
-        new preprocessor::WarningStateTracker(desc.sourceManager);
-    desc.sink->setSourceWarningStateTracker(wst);
+    desc.trackWarningState = true;
 
     return preprocessSource(file, desc, outDetectedLanguage, outLanguageVersion);
 }
@@ -4903,7 +5123,15 @@ TokenList preprocessSource(
     preprocessor.endOfFileToken.type = TokenType::EndOfFile;
     preprocessor.endOfFileToken.flags = TokenFlag::AtStartOfLine;
     preprocessor.contentAssistInfo = desc.contentAssistInfo;
+    preprocessor.tokenCache = desc.tokenCache;
+    preprocessor.memoryArena =
+        desc.memoryArena ? desc.memoryArena : desc.sourceManager->getMemoryArena();
 
+    if (desc.trackWarningState)
+    {
+        desc.sink->setSourceWarningStateTracker(
+            new preprocessor::WarningStateTracker(desc.sourceManager));
+    }
     preprocessor.warningStateTracker =
         dynamicCast<preprocessor::WarningStateTracker>(desc.sink->getSourceWarningStateTracker());
 
@@ -5,6 +5,9 @@
 #include "../compiler-core/slang-include-system.h"
 #include "../compiler-core/slang-lexer.h"
 #include "../core/slang-basic.h"
+#include "../core/slang-memory-arena.h"
+
+#include <mutex>
 
 namespace Slang
 {
@@ -33,6 +36,61 @@ struct PreprocessorHandler
     virtual void handleFileDependency(SourceFile* sourceFile);
 };
 
+/// A cache of the tokens lexed from files included by the preprocessor.
+///
+/// How a file is lexed doesn't depend on the macros defined where it is included,
+/// so the tokens of a file can be reused whenever a file with the same contents is
+/// included again, by any preprocessor sharing the cache. Files are identified by
+/// the digest of their contents.
+///
+/// The cache can be used by preprocessors running on different threads.
+///
+class PreprocessorTokenCache
+{
+public:
+    /// The tokens lexed from the contents of a file.
+    struct Entry : RefObject
+    {
+        Entry()
+            : memoryArena(kMemoryArenaBlockSize)
+        {
+        }
+
+        /// The tokens, not including whitespace or comments, and ending with an
+        /// end-of-file token. Their locations are offsets from the start of the file.
+        List<Token> tokens;
+
+        /// If the whole file is inside an `#ifndef X`/`#define X`/`#endif` include
+        /// guard, the name `X`, otherwise nullptr.
+        Name* includeGuard = nullptr;
+
+        /// Holds the file contents the tokens refer to
+        ComPtr<ISlangBlob> contentBlob;
+
+        /// Holds the contents of tokens that needed scrubbing
+        MemoryArena memoryArena;
+
+        static const size_t kMemoryArenaBlockSize = 4096;
+    };
+
+    /// Find the entry for the contents of `sourceFile`, if they have been lexed before.
+    Entry* findEntry(SourceFile* sourceFile);
+
+    /// Get the entry for the contents of the file viewed by `sourceView`, lexing them
+    /// with names from `namePool` if they haven't been lexed before.
+    ///
+    /// Returns nullptr if lexing the contents produces any diagnostics. Whether those
+    /// are reported depends on where the file is included, so such files are always
+    /// lexed again.
+    Entry* getEntry(SourceView* sourceView, NamePool* namePool);
+
+private:
+    std::mutex m_mutex;
+
+    /// Maps the digest of file contents to their entry, or nullptr if they can't be cached
+    Dictionary<SHA1::Digest, RefPtr<Entry>> m_entries;
+};
+
 /// Description of a preprocessor options/dependencies
 struct PreprocessorDesc
 {
@@ -59,6 +117,19 @@ struct PreprocessorDesc
 
     /// Optional: additional information for code assist.
     PreprocessorContentAssistInfo* contentAssistInfo = nullptr;
+
+    /// Optional: cache of the tokens of included files, to share with other preprocessors.
+    /// The names in the cached tokens come from `namePool`, so preprocessors sharing a
+    /// cache must use the same root name pool.
+    PreprocessorTokenCache* tokenCache = nullptr;
+
+    /// Optional: memory arena to hold the contents of lexed tokens. If not set, the memory arena
+    /// of `sourceManager` is used.
+    MemoryArena* memoryArena = nullptr;
+
+    /// If set, the warnings enabled and disabled by `#pragma warning` are tracked, and applied
+    /// by `sink` to the diagnostics reported for the source.
+    bool trackWarningState = false;
 };
 
 /// Take a source `file` and preprocess it into a list of tokens.
@@ -77,7 +148,8 @@ TokenList preprocessSource(
     Linkage* linkage,
     SourceLanguage& outDetectedLanguage,
     SlangLanguageVersion& outLanguageVersion,
-    PreprocessorHandler* handler = nullptr);
+    PreprocessorHandler* handler = nullptr,
+    MemoryArena* memoryArena = nullptr);
 
 // The following functions are intended to be used inside of implementations
 // of the `PreprocessorHandler` interface, in order to query the current
@@ -0,0 +1,1477 @@
+// slang-reflection-binary.cpp
+
+//
+// This file implements a compact binary form of program layout reflection.
+//
+// The reflection data is written with the fossil serializer (see `slang-fossil.h`),
+// so that an application can store it next to its compiled kernels, map the file
+// into memory, and query it directly without a live session or compiled program,
+// and without deserializing anything.
+//
+// The handles returned by the `spBinaryReflection*` functions are pointers to
+// the fossilized records inside of the data, so they stay valid for as long as
+// the data does.
+//
+
+#include "../core/slang-blob-builder.h"
+#include "../core/slang-riff.h"
+#include "slang-serialize-fossil.h"
+#include "slang-serialize.h"
+#include "slang.h"
+
+namespace Slang
+{
+
+struct BinaryReflectionTypeLayout;
+struct BinaryReflectionVarLayout;
+
+/// Size of a type layout for one parameter category.
+struct BinaryReflectionSizeInfo
+{
+    Int32 category = 0;
+    UInt64 size = 0;
+    UInt64 stride = 0;
+};
+
+/// Offset of a variable layout for one parameter category.
+struct BinaryReflectionOffsetInfo
+{
+    Int32 category = 0;
+    UInt64 offset = 0;
+    UInt64 space = 0;
+};
+
+struct BinaryReflectionBindingRange
+{
+    Int32 bindingType = 0;
+    Int64 bindingCount = 0;
+    BinaryReflectionTypeLayout* leafTypeLayout = nullptr;
+    Int64 descriptorSetIndex = 0;
+    Int64 firstDescriptorRangeIndex = 0;
+    Int64 descriptorRangeCount = 0;
+};
+
+struct BinaryReflectionDescriptorRange
+{
+    Int64 indexOffset = 0;
+    Int64 descriptorCount = 0;
+    Int32 bindingType = 0;
+    Int32 category = 0;
+};
+
+struct BinaryReflectionDescriptorSet
+{
+    Int64 spaceOffset = 0;
+    List<BinaryReflectionDescriptorRange> descriptorRanges;
+};
+
+struct BinaryReflectionSubObjectRange
+{
+    Int64 bindingRangeIndex = 0;
+    Int64 spaceOffset = 0;
+};
+
+struct BinaryReflectionTypeLayout : RefObject
+{
+    Int32 kind = 0;
+    String name;
+    Int32 parameterCategory = 0;
+    Int32 uniformAlignment = 0;
+    List<BinaryReflectionSizeInfo> sizes;
+
+    List<BinaryReflectionVarLayout*> fields;
+    BinaryReflectionTypeLayout* elementTypeLayout = nullptr;
+    BinaryReflectionVarLayout* elementVarLayout = nullptr;
+    BinaryReflectionVarLayout* containerVarLayout = nullptr;
+    UInt64 elementCount = 0;
+
+    Int32 scalarType = 0;
+    UInt32 rowCount = 0;
+    UInt32 columnCount = 0;
+    UInt32 resourceShape = 0;
+    UInt32 resourceAccess = 0;
+
+    List<BinaryReflectionBindingRange> bindingRanges;
+    List<Int64> fieldBindingRangeOffsets;
+    List<BinaryReflectionDescriptorSet> descriptorSets;
+    List<BinaryReflectionSubObjectRange> subObjectRanges;
+};
+
+struct BinaryReflectionVarLayout : RefObject
+{
+    String name;
+    BinaryReflectionTypeLayout* typeLayout = nullptr;
+    List<BinaryReflectionOffsetInfo> offsets;
+    String semanticName;
+    UInt64 semanticIndex = 0;
+    Int32 stage = 0;
+};
+
+struct BinaryReflectionEntryPoint : RefObject
+{
+    String name;
+    String nameOverride;
+    Int32 stage = 0;
+    List<BinaryReflectionVarLayout*> parameters;
+    BinaryReflectionVarLayout* varLayout = nullptr;
+    BinaryReflectionVarLayout* resultVarLayout = nullptr;
+    List<UInt64> threadGroupSize;
+};
+
+/// Root of the binary reflection data.
+struct BinaryReflectionProgramLayout
+{
+    /// Identifies the data as binary reflection, rather than some other fossilized value.
+    static const UInt32 kMagic = SLANG_FOUR_CC('S', 'R', 'F', 'L');
+
+    /// Incremented whenever the representation changes.
+    static const UInt32 kVersion = 1;
+
+    UInt32 magic = kMagic;
+    UInt32 version = kVersion;
+    List<BinaryReflectionVarLayout*> parameters;
+    List<BinaryReflectionEntryPoint*> entryPoints;
+    BinaryReflectionVarLayout* globalParamsVarLayout = nullptr;
+    UInt64 globalConstantBufferBinding = 0;
+    UInt64 globalConstantBufferSize = 0;
+};
+
+//
+// Fossilized representations, which are what the handles point to.
+//
+
+#define SLANG_BINARY_REFLECTION_TYPES(X) \
+    X(BinaryReflectionSizeInfo)          \
+    X(BinaryReflectionOffsetInfo)        \
+    X(BinaryReflectionBindingRange)      \
+    X(BinaryReflectionDescriptorRange)   \
+    X(BinaryReflectionDescriptorSet)     \
+    X(BinaryReflectionSubObjectRange)    \
+    X(BinaryReflectionTypeLayout)        \
+    X(BinaryReflectionVarLayout)         \
+    X(BinaryReflectionEntryPoint)        \
+    X(BinaryReflectionProgramLayout)
+
+#define SLANG_DECLARE_BINARY_REFLECTION_FOSSILIZED_TYPE(T) \
+    struct Fossilized_##T;                                 \
+    SLANG_DECLARE_FOSSILIZED_TYPE(T, Fossilized_##T);
+
+SLANG_BINARY_REFLECTION_TYPES(SLANG_DECLARE_BINARY_REFLECTION_FOSSILIZED_TYPE)
+
+#undef SLANG_DECLARE_BINARY_REFLECTION_FOSSILIZED_TYPE
+
+struct Fossilized_BinaryReflectionSizeInfo : public FossilizedRecordVal
+{
+    Fossilized<decltype(BinaryReflectionSizeInfo::category)> category;
+    Fossilized<decltype(BinaryReflectionSizeInfo::size)> size;
+    Fossilized<decltype(BinaryReflectionSizeInfo::stride)> stride;
+};
+
+struct Fossilized_BinaryReflectionOffsetInfo : public FossilizedRecordVal
+{
+    Fossilized<decltype(BinaryReflectionOffsetInfo::category)> category;
+    Fossilized<decltype(BinaryReflectionOffsetInfo::offset)> offset;
+    Fossilized<decltype(BinaryReflectionOffsetInfo::space)> space;
+};
+
+struct Fossilized_BinaryReflectionBindingRange : public FossilizedRecordVal
+{
+    Fossilized<decltype(BinaryReflectionBindingRange::bindingType)> bindingType;
+    Fossilized<decltype(BinaryReflectionBindingRange::bindingCount)> bindingCount;
+    Fossilized<decltype(BinaryReflectionBindingRange::leafTypeLayout)> leafTypeLayout;
+    Fossilized<decltype(BinaryReflectionBindingRange::descriptorSetIndex)> descriptorSetIndex;
+    Fossilized<decltype(BinaryReflectionBindingRange::firstDescriptorRangeIndex)>
+        firstDescriptorRangeIndex;
+    Fossilized<decltype(BinaryReflectionBindingRange::descriptorRangeCount)> descriptorRangeCount;
+};
+
+struct Fossilized_BinaryReflectionDescriptorRange : public FossilizedRecordVal
+{
+    Fossilized<decltype(BinaryReflectionDescriptorRange::indexOffset)> indexOffset;
+    Fossilized<decltype(BinaryReflectionDescriptorRange::descriptorCount)> descriptorCount;
+    Fossilized<decltype(BinaryReflectionDescriptorRange::bindingType)> bindingType;
+    Fossilized<decltype(BinaryReflectionDescriptorRange::category)> category;
+};
+
+struct Fossilized_BinaryReflectionDescriptorSet : public FossilizedRecordVal
+{
+    Fossilized<decltype(BinaryReflectionDescriptorSet::spaceOffset)> spaceOffset;
+    Fossilized<decltype(BinaryReflectionDescriptorSet::descriptorRanges)> descriptorRanges;
+};
+
+struct Fossilized_BinaryReflectionSubObjectRange : public FossilizedRecordVal
+{
+    Fossilized<decltype(BinaryReflectionSubObjectRange::bindingRangeIndex)> bindingRangeIndex;
+    Fossilized<decltype(BinaryReflectionSubObjectRange::spaceOffset)> spaceOffset;
+};
+
+struct Fossilized_BinaryReflectionTypeLayout : public FossilizedRecordVal
+{
+    Fossilized<decltype(BinaryReflectionTypeLayout::kind)> kind;
+    Fossilized<decltype(BinaryReflectionTypeLayout::name)> name;
+    Fossilized<decltype(BinaryReflectionTypeLayout::parameterCategory)> parameterCategory;
+    Fossilized<decltype(BinaryReflectionTypeLayout::uniformAlignment)> uniformAlignment;
+    Fossilized<decltype(BinaryReflectionTypeLayout::sizes)> sizes;
+    Fossilized<decltype(BinaryReflectionTypeLayout::fields)> fields;
+    Fossilized<decltype(BinaryReflectionTypeLayout::elementTypeLayout)> elementTypeLayout;
+    Fossilized<decltype(BinaryReflectionTypeLayout::elementVarLayout)> elementVarLayout;
+    Fossilized<decltype(BinaryReflectionTypeLayout::containerVarLayout)> containerVarLayout;
+    Fossilized<decltype(BinaryReflectionTypeLayout::elementCount)> elementCount;
+    Fossilized<decltype(BinaryReflectionTypeLayout::scalarType)> scalarType;
+    Fossilized<decltype(BinaryReflectionTypeLayout::rowCount)> rowCount;
+    Fossilized<decltype(BinaryReflectionTypeLayout::columnCount)> columnCount;
+    Fossilized<decltype(BinaryReflectionTypeLayout::resourceShape)> resourceShape;
+    Fossilized<decltype(BinaryReflectionTypeLayout::resourceAccess)> resourceAccess;
+    Fossilized<decltype(BinaryReflectionTypeLayout::bindingRanges)> bindingRanges;
+    Fossilized<decltype(BinaryReflectionTypeLayout::fieldBindingRangeOffsets)>
+        fieldBindingRangeOffsets;
+    Fossilized<decltype(BinaryReflectionTypeLayout::descriptorSets)> descriptorSets;
+    Fossilized<decltype(BinaryReflectionTypeLayout::subObjectRanges)> subObjectRanges;
+};
+
+struct Fossilized_BinaryReflectionVarLayout : public FossilizedRecordVal
+{
+    Fossilized<decltype(BinaryReflectionVarLayout::name)> name;
+    Fossilized<decltype(BinaryReflectionVarLayout::typeLayout)> typeLayout;
+    Fossilized<decltype(BinaryReflectionVarLayout::offsets)> offsets;
+    Fossilized<decltype(BinaryReflectionVarLayout::semanticName)> semanticName;
+    Fossilized<decltype(BinaryReflectionVarLayout::semanticIndex)> semanticIndex;
+    Fossilized<decltype(BinaryReflectionVarLayout::stage)> stage;
+};
+
+struct Fossilized_BinaryReflectionEntryPoint : public FossilizedRecordVal
+{
+    Fossilized<decltype(BinaryReflectionEntryPoint::name)> name;
+    Fossilized<decltype(BinaryReflectionEntryPoint::nameOverride)> nameOverride;
+    Fossilized<decltype(BinaryReflectionEntryPoint::stage)> stage;
+    Fossilized<decltype(BinaryReflectionEntryPoint::parameters)> parameters;
+    Fossilized<decltype(BinaryReflectionEntryPoint::varLayout)> varLayout;
+    Fossilized<decltype(BinaryReflectionEntryPoint::resultVarLayout)> resultVarLayout;
+    Fossilized<decltype(BinaryReflectionEntryPoint::threadGroupSize)> threadGroupSize;
+};
+
+struct Fossilized_BinaryReflectionProgramLayout : public FossilizedRecordVal
+{
+    Fossilized<decltype(BinaryReflectionProgramLayout::magic)> magic;
+    Fossilized<decltype(BinaryReflectionProgramLayout::version)> version;
+    Fossilized<decltype(BinaryReflectionProgramLayout::parameters)> parameters;
+    Fossilized<decltype(BinaryReflectionProgramLayout::entryPoints)> entryPoints;
+    Fossilized<decltype(BinaryReflectionProgramLayout::globalParamsVarLayout)>
+        globalParamsVarLayout;
+    Fossilized<decltype(BinaryReflectionProgramLayout::globalConstantBufferBinding)>
+        globalConstantBufferBinding;
+    Fossilized<decltype(BinaryReflectionProgramLayout::globalConstantBufferSize)>
+        globalConstantBufferSize;
+};
+
+static const FossilUInt kBinaryReflectionProgramLayoutFieldCount = 7;
+
+//
+// Serialization of the live representation. Only writing is supported, since
+// the data is only ever read through its fossilized representation.
+//
+
+void serialize(Serializer const& serializer, BinaryReflectionSizeInfo& value)
+{
+    SLANG_SCOPED_SERIALIZER_STRUCT(serializer);
+    serialize(serializer, value.category);
+    serialize(serializer, value.size);
+    serialize(serializer, value.stride);
+}
+
+void serialize(Serializer const& serializer, BinaryReflectionOffsetInfo& value)
+{
+    SLANG_SCOPED_SERIALIZER_STRUCT(serializer);
+    serialize(serializer, value.category);
+    serialize(serializer, value.offset);
+    serialize(serializer, value.space);
+}
+
+void serialize(Serializer const& serializer, BinaryReflectionBindingRange& value)
+{
+    SLANG_SCOPED_SERIALIZER_STRUCT(serializer);
+    serialize(serializer, value.bindingType);
+    serialize(serializer, value.bindingCount);
+    serialize(serializer, value.leafTypeLayout);
+    serialize(serializer, value.descriptorSetIndex);
+    serialize(serializer, value.firstDescriptorRangeIndex);
+    serialize(serializer, value.descriptorRangeCount);
+}
+
+void serialize(Serializer const& serializer, BinaryReflectionDescriptorRange& value)
+{
+    SLANG_SCOPED_SERIALIZER_STRUCT(serializer);
+    serialize(serializer, value.indexOffset);
+    serialize(serializer, value.descriptorCount);
+    serialize(serializer, value.bindingType);
+    serialize(serializer, value.category);
+}
+
+void serialize(Serializer const& serializer, BinaryReflectionDescriptorSet& value)
+{
+    SLANG_SCOPED_SERIALIZER_STRUCT(serializer);
+    serialize(serializer, value.spaceOffset);
+    serialize(serializer, value.descriptorRanges);
+}
+
+void serialize(Serializer const& serializer, BinaryReflectionSubObjectRange& value)
+{
+    SLANG_SCOPED_SERIALIZER_STRUCT(serializer);
+    serialize(serializer, value.bindingRangeIndex);
+    serialize(serializer, value.spaceOffset);
+}
+
+void serialize(Serializer const& serializer, BinaryReflectionTypeLayout& value)
+{
+    SLANG_SCOPED_SERIALIZER_STRUCT(serializer);
+    serialize(serializer, value.kind);
+    serialize(serializer, value.name);
+    serialize(serializer, value.parameterCategory);
+    serialize(serializer, value.uniformAlignment);
+    serialize(serializer, value.sizes);
+    serialize(serializer, value.fields);
+    serialize(serializer, value.elementTypeLayout);
+    serialize(serializer, value.elementVarLayout);
+    serialize(serializer, value.containerVarLayout);
+    serialize(serializer, value.elementCount);
+    serialize(serializer, value.scalarType);
+    serialize(serializer, value.rowCount);
+    serialize(serializer, value.columnCount);
+    serialize(serializer, value.resourceShape);
+    serialize(serializer, value.resourceAccess);
+    serialize(serializer, value.bindingRanges);
+    serialize(serializer, value.fieldBindingRangeOffsets);
+    serialize(serializer, value.descriptorSets);
+    serialize(serializer, value.subObjectRanges);
+}
+
+void serialize(Serializer const& serializer, BinaryReflectionVarLayout& value)
+{
+    SLANG_SCOPED_SERIALIZER_STRUCT(serializer);
+    serialize(serializer, value.name);
+    serialize(serializer, value.typeLayout);
+    serialize(serializer, value.offsets);
+    serialize(serializer, value.semanticName);
+    serialize(serializer, value.semanticIndex);
+    serialize(serializer, value.stage);
+}
+
+void serialize(Serializer const& serializer, BinaryReflectionEntryPoint& value)
+{
+    SLANG_SCOPED_SERIALIZER_STRUCT(serializer);
+    serialize(serializer, value.name);
+    serialize(serializer, value.nameOverride);
+    serialize(serializer, value.stage);
+    serialize(serializer, value.parameters);
+    serialize(serializer, value.varLayout);
+    serialize(serializer, value.resultVarLayout);
+    serialize(serializer, value.threadGroupSize);
+}
+
+void serialize(Serializer const& serializer, BinaryReflectionProgramLayout& value)
+{
+    SLANG_SCOPED_SERIALIZER_STRUCT(serializer);
+    serialize(serializer, value.magic);
+    serialize(serializer, value.version);
+    serialize(serializer, value.parameters);
+    serialize(serializer, value.entryPoints);
+    serialize(serializer, value.globalParamsVarLayout);
+    serialize(serializer, value.globalConstantBufferBinding);
+    serialize(serializer, value.globalConstantBufferSize);
+}
+
+//
+// Collection of the live representation from the reflection of a program layout.
+//
+
+struct BinaryReflectionCollector
+{
+public:
+    BinaryReflectionCollector(slang::ShaderReflection* program)
+        : m_program(program)
+    {
+    }
+
+    BinaryReflectionTypeLayout* getTypeLayout(slang::TypeLayoutReflection* typeLayout);
+    BinaryReflectionVarLayout* getVarLayout(slang::VariableLayoutReflection* varLayout);
+    BinaryReflectionEntryPoint* getEntryPoint(slang::EntryPointReflection* entryPoint);
+
+    void collect(BinaryReflectionProgramLayout& outProgramLayout);
+
+private:
+    void _fillTypeLayout(
+        slang::TypeLayoutReflection* typeLayout,
+        BinaryReflectionTypeLayout* binaryTypeLayout);
+
+    slang::ShaderReflection* m_program;
+
+    // The same layout is usually referenced from several places (for example
+    // by every binding range of a resource), and is only stored once.
+    Dictionary<slang::TypeLayoutReflection*, BinaryReflectionTypeLayout*> m_typeLayouts;
+    Dictionary<slang::VariableLayoutReflection*, BinaryReflectionVarLayout*> m_varLayouts;
+
+    List<RefPtr<RefObject>> m_objects;
+};
+
+BinaryReflectionTypeLayout* BinaryReflectionCollector::getTypeLayout(
+    slang::TypeLayoutReflection* typeLayout)
+{
+    if (!typeLayout)
+        return nullptr;
+    if (auto found = m_typeLayouts.tryGetValue(typeLayout))
+        return *found;
+
+    // The layout is registered before it is filled in, as a type layout can
+    // be reached again from its own binding ranges.
+    RefPtr<BinaryReflectionTypeLayout> binaryTypeLayout = new BinaryReflectionTypeLayout();
+    m_objects.add(binaryTypeLayout);
+    m_typeLayouts.add(typeLayout, binaryTypeLayout);
+    _fillTypeLayout(typeLayout, binaryTypeLayout);
+    return binaryTypeLayout;
+}
+
+void BinaryReflectionCollector::_fillTypeLayout(
+    slang::TypeLayoutReflection* typeLayout,
+    BinaryReflectionTypeLayout* binaryTypeLayout)
+{
+    binaryTypeLayout->kind = Int32(typeLayout->getKind());
+    binaryTypeLayout->parameterCategory = Int32(typeLayout->getParameterCategory());
+    binaryTypeLayout->uniformAlignment = typeLayout->getAlignment(SLANG_PARAMETER_CATEGORY_UNIFORM);
+
+    for (unsigned i = 0; i < typeLayout->getCategoryCount(); ++i)
+    {
+        auto category = SlangParameterCategory(typeLayout->getCategoryByIndex(i));
+        BinaryReflectionSizeInfo sizeInfo;
+        sizeInfo.category = Int32(category);
+        sizeInfo.size = typeLayout->getSize(category);
+        sizeInfo.stride = typeLayout->getStride(category);
+        binaryTypeLayout->sizes.add(sizeInfo);
+    }
+
+    if (auto type = typeLayout->getType())
+    {
+        if (auto name = type->getName())
+            binaryTypeLayout->name = name;
+        binaryTypeLayout->elementCount = type->getElementCount((SlangReflection*)m_program);
+        binaryTypeLayout->scalarType = Int32(type->getScalarType());
+        binaryTypeLayout->rowCount = type->getRowCount();
+        binaryTypeLayout->columnCount = type->getColumnCount();
+        binaryTypeLayout->resourceShape = UInt32(type->getResourceShape());
+        binaryTypeLayout->resourceAccess = UInt32(type->getResourceAccess());
+    }
+
+    for (unsigned i = 0; i < typeLayout->getFieldCount(); ++i)
+    {
+        binaryTypeLayout->fields.add(getVarLayout(typeLayout->getFieldByIndex(i)));
+        binaryTypeLayout->fieldBindingRangeOffsets.add(typeLayout->getFieldBindingRangeOffset(i));
+    }
+    binaryTypeLayout->elementTypeLayout = getTypeLayout(typeLayout->getElementTypeLayout());
+    binaryTypeLayout->elementVarLayout = getVarLayout(typeLayout->getElementVarLayout());
+    binaryTypeLayout->containerVarLayout = getVarLayout(typeLayout->getContainerVarLayout());
+
+    for (SlangInt i = 0; i < typeLayout->getBindingRangeCount(); ++i)
+    {
+        BinaryReflectionBindingRange bindingRange;
+        bindingRange.bindingType = Int32(typeLayout->getBindingRangeType(i));
+        bindingRange.bindingCount = typeLayout->getBindingRangeBindingCount(i);
+        bindingRange.leafTypeLayout = getTypeLayout(typeLayout->getBindingRangeLeafTypeLayout(i));
+        bindingRange.descriptorSetIndex = typeLayout->getBindingRangeDescriptorSetIndex(i);
+        bindingRange.firstDescriptorRangeIndex =
+            typeLayout->getBindingRangeFirstDescriptorRangeIndex(i);
+        bindingRange.descriptorRangeCount = typeLayout->getBindingRangeDescriptorRangeCount(i);
+        binaryTypeLayout->bindingRanges.add(bindingRange);
+    }
+
+    for (SlangInt i = 0; i < typeLayout->getDescriptorSetCount(); ++i)
+    {
+        BinaryReflectionDescriptorSet descriptorSet;
+        descriptorSet.spaceOffset = typeLayout->getDescriptorSetSpaceOffset(i);
+        for (SlangInt j = 0; j < typeLayout->getDescriptorSetDescriptorRangeCount(i); ++j)
+        {
+            BinaryReflectionDescriptorRange descriptorRange;
+            descriptorRange.indexOffset =
+                typeLayout->getDescriptorSetDescriptorRangeIndexOffset(i, j);
+            descriptorRange.descriptorCount =
+                typeLayout->getDescriptorSetDescriptorRangeDescriptorCount(i, j);
+            descriptorRange.bindingType =
+                Int32(typeLayout->getDescriptorSetDescriptorRangeType(i, j));
+            descriptorRange.category =
+                Int32(typeLayout->getDescriptorSetDescriptorRangeCategory(i, j));
+            descriptorSet.descriptorRanges.add(descriptorRange);
+        }
+        binaryTypeLayout->descriptorSets.add(descriptorSet);
+    }
+
+    for (SlangInt i = 0; i < typeLayout->getSubObjectRangeCount(); ++i)
+    {
+        BinaryReflectionSubObjectRange subObjectRange;
+        subObjectRange.bindingRangeIndex = typeLayout->getSubObjectRangeBindingRangeIndex(i);
+        subObjectRange.spaceOffset = typeLayout->getSubObjectRangeSpaceOffset(i);
+        binaryTypeLayout->subObjectRanges.add(subObjectRange);
+    }
+}
+
+BinaryReflectionVarLayout* BinaryReflectionCollector::getVarLayout(
+    slang::VariableLayoutReflection* varLayout)
+{
+    if (!varLayout)
+        return nullptr;
+    if (auto found = m_varLayouts.tryGetValue(varLayout))
+        return *found;
+
+    RefPtr<BinaryReflectionVarLayout> binaryVarLayout = new BinaryReflectionVarLayout();
+    m_objects.add(binaryVarLayout);
+    m_varLayouts.add(varLayout, binaryVarLayout);
+
+    if (varLayout->getVariable())
+    {
+        if (auto name = varLayout->getName())
+            binaryVarLayout->name = name;
+    }
+    binaryVarLayout->typeLayout = getTypeLayout(varLayout->getTypeLayout());
+
+    // Offsets are looked up with the same fallbacks between related categories as
+    // the live reflection, so every category is recorded that has a non-zero result.
+    for (Int32 category = 0; category < Int32(SLANG_PARAMETER_CATEGORY_COUNT); ++category)
+    {
+        BinaryReflectionOffsetInfo offsetInfo;
+        offsetInfo.category = category;
+        offsetInfo.offset = varLayout->getOffset(SlangParameterCategory(category));
+        offsetInfo.space = varLayout->getBindingSpace(SlangParameterCategory(category));
+        if (offsetInfo.offset || offsetInfo.space)
+            binaryVarLayout->offsets.add(offsetInfo);
+    }
+
+    if (auto semanticName = varLayout->getSemanticName())
+        binaryVarLayout->semanticName = semanticName;
+    binaryVarLayout->semanticIndex = varLayout->getSemanticIndex();
+    binaryVarLayout->stage = Int32(varLayout->getStage());
+    return binaryVarLayout;
+}
+
+BinaryReflectionEntryPoint* BinaryReflectionCollector::getEntryPoint(
+    slang::EntryPointReflection* entryPoint)
+{
+    RefPtr<BinaryReflectionEntryPoint> binaryEntryPoint = new BinaryReflectionEntryPoint();
+    m_objects.add(binaryEntryPoint);
+
+    if (auto name = entryPoint->getName())
+        binaryEntryPoint->name = name;
+    if (auto nameOverride = entryPoint->getNameOverride())
+        binaryEntryPoint->nameOverride = nameOverride;
+    binaryEntryPoint->stage = Int32(entryPoint->getStage());
+    for (unsigned i = 0; i < entryPoint->getParameterCount(); ++i)
+        binaryEntryPoint->parameters.add(getVarLayout(entryPoint->getParameterByIndex(i)));
+    binaryEntryPoint->varLayout = getVarLayout(entryPoint->getVarLayout());
+    binaryEntryPoint->resultVarLayout = getVarLayout(entryPoint->getResultVarLayout());
+
+    SlangUInt threadGroupSize[3] = {};
+    entryPoint->getComputeThreadGroupSize(3, threadGroupSize);
+    for (auto size : threadGroupSize)
+        binaryEntryPoint->threadGroupSize.add(size);
+    return binaryEntryPoint;
+}
+
+void BinaryReflectionCollector::collect(BinaryReflectionProgramLayout& outProgramLayout)
+{
+    for (unsigned i = 0; i < m_program->getParameterCount(); ++i)
+        outProgramLayout.parameters.add(getVarLayout(m_program->getParameterByIndex(i)));
+    for (SlangUInt i = 0; i < m_program->getEntryPointCount(); ++i)
+        outProgramLayout.entryPoints.add(getEntryPoint(m_program->getEntryPointByIndex(i)));
+    outProgramLayout.globalParamsVarLayout = getVarLayout(m_program->getGlobalParamsVarLayout());
+    outProgramLayout.globalConstantBufferBinding = m_program->getGlobalConstantBufferBinding();
+    outProgramLayout.globalConstantBufferSize = m_program->getGlobalConstantBufferSize();
+}
+
+//
+// Access to the fossilized representation through the handles of the C API.
+//
+
+typedef Fossilized<BinaryReflectionProgramLayout> FossilizedBinaryProgramLayout;
+typedef Fossilized<BinaryReflectionTypeLayout> FossilizedBinaryTypeLayout;
+typedef Fossilized<BinaryReflectionVarLayout> FossilizedBinaryVarLayout;
+typedef Fossilized<BinaryReflectionEntryPoint> FossilizedBinaryEntryPoint;
+
+static FossilizedBinaryProgramLayout const* convert(SlangBinaryReflection* reflection)
+{
+    return (FossilizedBinaryProgramLayout const*)reflection;
+}
+
+static FossilizedBinaryTypeLayout const* convert(SlangBinaryReflectionTypeLayout* typeLayout)
+{
+    return (FossilizedBinaryTypeLayout const*)typeLayout;
+}
+
+static FossilizedBinaryVarLayout const* convert(SlangBinaryReflectionVariableLayout* varLayout)
+{
+    return (FossilizedBinaryVarLayout const*)varLayout;
+}
+
+static FossilizedBinaryEntryPoint const* convert(SlangBinaryReflectionEntryPoint* entryPoint)
+{
+    return (FossilizedBinaryEntryPoint const*)entryPoint;
+}
+
+static SlangBinaryReflectionTypeLayout* convert(FossilizedBinaryTypeLayout const* typeLayout)
+{
+    return (SlangBinaryReflectionTypeLayout*)typeLayout;
+}
+
+static SlangBinaryReflectionVariableLayout* convert(FossilizedBinaryVarLayout const* varLayout)
+{
+    return (SlangBinaryReflectionVariableLayout*)varLayout;
+}
+
+static SlangBinaryReflectionEntryPoint* convert(FossilizedBinaryEntryPoint const* entryPoint)
+{
+    return (SlangBinaryReflectionEntryPoint*)entryPoint;
+}
+
+/// Get the element at `index` of `array`, or null if the index is out of range.
+template<typename T>
+static T const* _getElement(FossilizedArray<T> const& array, SlangInt index)
+{
+    if (index < 0 || index >= array.getElementCount())
+        return nullptr;
+    return &array[index];
+}
+
+/// Get the string held by `string`, or null if it is empty.
+static char const* _getString(FossilizedString const& string)
+{
+    return string.getSize() ? string.get().begin() : nullptr;
+}
+
+// The data is read in place, and has 64 bit values in it.
+static const size_t kFossilDataAlignment = 8;
+
+// Get the size of the fossil data in `data`. The writer leaves the total size in the header
+// as 0, in which case the data is taken to be all of `size`.
+static size_t _getFossilDataSize(void const* data, size_t size)
+{
+    auto header = (Fossil::Header const*)data;
+    return header->totalSizeIncludingHeader ? size_t(header->totalSizeIncludingHeader) : size;
+}
+
+// Check that `data` is fossil data, and that what `spBinaryReflection_Load` reads before it
+// can check the layout of the root value is inside it: the root value with the pointer to its
+// layout before it, and the start of that layout.
+static bool _isFossilData(void const* data, size_t size)
+{
+    if (!data || size < sizeof(Fossil::Header) || (uintptr_t(data) % kFossilDataAlignment) != 0)
+        return false;
+    auto header = (Fossil::Header const*)data;
+    if (memcmp(header->magic, Fossil::Header::kMagic, sizeof(header->magic)) != 0 ||
+        header->totalSizeIncludingHeader > size)
+        return false;
+
+    // Addresses are compared as integers, as pointers that are out of range can't be.
+    const uintptr_t begin = uintptr_t(data);
+    const uintptr_t end = begin + _getFossilDataSize(data, size);
+    auto isInData = [&](uintptr_t address, size_t byteCount)
+    { return address >= begin && address <= end && byteCount <= end - address; };
+
+    // The root value is a variant, with the pointer to its layout just before it.
+    auto root = header->rootValue.get();
+    if (!root)
+        return false;
+    const size_t layoutPtrSize = sizeof(FossilizedPtr<FossilizedValLayout>);
+    const uintptr_t rootStart = uintptr_t(root) - layoutPtrSize;
+    if (!isInData(rootStart, layoutPtrSize + sizeof(FossilizedBinaryProgramLayout)))
+        return false;
+    auto layout = root->getContentLayout();
+    return layout && isInData(uintptr_t(layout), sizeof(FossilizedRecordLayout));
+}
+
+static Fossilized<BinaryReflectionSizeInfo> const* _findSizeInfo(
+    FossilizedBinaryTypeLayout const* typeLayout,
+    SlangParameterCategory category)
+{
+    if (!typeLayout)
+        return nullptr;
+    for (auto& sizeInfo : typeLayout->sizes)
+    {
+        if (sizeInfo.category == Int32(category))
+            return &sizeInfo;
+    }
+    return nullptr;
+}
+
+static Fossilized<BinaryReflectionOffsetInfo> const* _findOffsetInfo(
+    FossilizedBinaryVarLayout const* varLayout,
+    SlangParameterCategory category)
+{
+    if (!varLayout)
+        return nullptr;
+    for (auto& offsetInfo : varLayout->offsets)
+    {
+        if (offsetInfo.category == Int32(category))
+            return &offsetInfo;
+    }
+    return nullptr;
+}
+
+static Fossilized<BinaryReflectionDescriptorRange> const* _getDescriptorRange(
+    FossilizedBinaryTypeLayout const* typeLayout,
+    SlangInt setIndex,
+    SlangInt rangeIndex)
+{
+    if (!typeLayout)
+        return nullptr;
+    auto descriptorSet = _getElement(typeLayout->descriptorSets, setIndex);
+    if (!descriptorSet)
+        return nullptr;
+    return _getElement(descriptorSet->descriptorRanges, rangeIndex);
+}
+
+/// Checks that everything the accessors can reach from the root of binary reflection data lies
+/// inside the data, so that they can follow the relative pointers in it without checks.
+///
+/// Records that can be reached in more than one way are only checked once. They are checked
+/// from a worklist rather than recursively, so that corrupt data can't exhaust the stack.
+class BinaryReflectionValidator
+{
+public:
+    BinaryReflectionValidator(void const* data, size_t size)
+        : m_begin(uintptr_t(data)), m_end(uintptr_t(data) + size)
+    {
+    }
+
+    bool validate(FossilizedBinaryProgramLayout const* programLayout)
+    {
+        if (!_checkRecord(*programLayout))
+            return false;
+        while (m_workList.getCount())
+        {
+            auto item = m_workList.getLast();
+            m_workList.removeLast();
+            if (!(this->*item.check)(item.record))
+                return false;
+        }
+        return true;
+    }
+
+private:
+    typedef bool (BinaryReflectionValidator::*CheckFunc)(void const* record);
+
+    struct WorkItem
+    {
+        void const* record;
+        CheckFunc check;
+    };
+
+    // Addresses are compared as integers, as pointers that are out of range can't be.
+    bool _isInData(uintptr_t address, size_t byteCount, size_t alignment) const
+    {
+        return address >= m_begin && address <= m_end && byteCount <= m_end - address &&
+               (address % alignment) == 0;
+    }
+
+    template<typename T>
+    bool _checkRecordAt(void const* record)
+    {
+        return _checkRecord(*(T const*)record);
+    }
+
+    template<typename T>
+    bool _check(FossilizedPtr<T> const& ptr)
+    {
+        auto target = ptr.get();
+        if (!target)
+            return true;
+        if (!_isInData(uintptr_t(target), sizeof(T), alignof(T)))
+            return false;
+        if (m_visited.add(target))
+            m_workList.add(WorkItem{target, &BinaryReflectionValidator::_checkRecordAt<T>});
+        return true;
+    }
+
+    bool _check(FossilizedString const& string)
+    {
+        auto obj = string.getObj();
+        if (!obj)
+            return true;
+        // The size is before the characters, which are followed by a 0.
+        const uintptr_t address = uintptr_t(obj);
+        if (!_isInData(address - sizeof(FossilUInt), sizeof(FossilUInt), alignof(FossilUInt)))
+            return false;
+        const size_t size = obj->getSize();
+        return _isInData(address, size, 1) && size < m_end - address &&
+               *((char const*)obj + size) == 0;
+    }
+
+    template<typename T>
+    bool _check(FossilizedArray<T> const& array)
+    {
+        auto elements = array.getBuffer();
+        if (!elements)
+            return true;
+        // The element count is before the elements.
+        const uintptr_t address = uintptr_t(elements);
+        if (!_isInData(address - sizeof(FossilUInt), sizeof(FossilUInt), alignof(FossilUInt)) ||
+            !_isInData(address, 0, alignof(T)))
+            return false;
+        const size_t count = size_t(array.getElementCount());
+        if (count > (m_end - address) / sizeof(T))
+            return false;
+        for (auto& element : array)
+        {
+            if (!_check(element))
+                return false;
+        }
+        return true;
+    }
+
+    // Values that hold no pointers.
+    template<typename T, FossilizedValKind Kind>
+    bool _check(FossilizedSimpleVal<T, Kind> const&)
+    {
+        return true;
+    }
+    bool _check(Fossilized<BinaryReflectionSizeInfo> const&) { return true; }
+    bool _check(Fossilized<BinaryReflectionOffsetInfo> const&) { return true; }
+    bool _check(Fossilized<BinaryReflectionDescriptorRange> const&) { return true; }
+    bool _check(Fossilized<BinaryReflectionSubObjectRange> const&) { return true; }
+
+    bool _check(Fossilized<BinaryReflectionBindingRange> const& bindingRange)
+    {
+        return _check(bindingRange.leafTypeLayout);
+    }
+
+    bool _check(Fossilized<BinaryReflectionDescriptorSet> const& descriptorSet)
+    {
+        return _check(descriptorSet.descriptorRanges);
+    }
+
+    bool _checkRecord(FossilizedBinaryTypeLayout const& typeLayout)
+    {
+        return _check(typeLayout.name) && _check(typeLayout.sizes) &&
+               _check(typeLayout.fields) && _check(typeLayout.elementTypeLayout) &&
+               _check(typeLayout.elementVarLayout) && _check(typeLayout.containerVarLayout) &&
+               _check(typeLayout.bindingRanges) && _check(typeLayout.fieldBindingRangeOffsets) &&
+               _check(typeLayout.descriptorSets) && _check(typeLayout.subObjectRanges);
+    }
+
+    bool _checkRecord(FossilizedBinaryVarLayout const& varLayout)
+    {
+        return _check(varLayout.name) && _check(varLayout.typeLayout) &&
+               _check(varLayout.offsets) && _check(varLayout.semanticName);
+    }
+
+    bool _checkRecord(FossilizedBinaryEntryPoint const& entryPoint)
+    {
+        return _check(entryPoint.name) && _check(entryPoint.nameOverride) &&
+               _check(entryPoint.parameters) && _check(entryPoint.varLayout) &&
+               _check(entryPoint.resultVarLayout) && _check(entryPoint.threadGroupSize);
+    }
+
+    bool _checkRecord(FossilizedBinaryProgramLayout const& programLayout)
+    {
+        return _check(programLayout.parameters) && _check(programLayout.entryPoints) &&
+               _check(programLayout.globalParamsVarLayout);
+    }
+
+    uintptr_t m_begin;
+    uintptr_t m_end;
+    HashSet<void const*> m_visited;
+    List<WorkItem> m_workList;
+};
+
+} // namespace Slang
+
+extern "C"
+{
+    using namespace Slang;
+
+    SLANG_API SlangResult spReflection_ToBinary(SlangReflection* reflection, ISlangBlob** outBlob)
+    {
+        if (!reflection || !outBlob)
+            return SLANG_E_INVALID_ARG;
+
+        BinaryReflectionCollector collector((slang::ShaderReflection*)reflection);
+        BinaryReflectionProgramLayout programLayout;
+        collector.collect(programLayout);
+
+        BlobBuilder blobBuilder;
+        {
+            Fossil::SerialWriter writer(blobBuilder);
+            Serializer serializer(&writer);
+            serialize(serializer, programLayout);
+        }
+        blobBuilder.writeToBlob(outBlob);
+        return SLANG_OK;
+    }
+
+    SLANG_API SlangBinaryReflection* spBinaryReflection_Load(void const* data, size_t size)
+    {
+        if (!_isFossilData(data, size))
+            return nullptr;
+
+        auto rootValPtr = Fossil::getRootValue(data, size);
+        auto programLayoutPtr = Fossil::as<FossilizedBinaryProgramLayout>(rootValPtr);
+        if (!programLayoutPtr ||
+            programLayoutPtr->getLayout()->fieldCount != kBinaryReflectionProgramLayoutFieldCount)
+            return nullptr;
+
+        FossilizedBinaryProgramLayout const* programLayout = programLayoutPtr;
+        if (programLayout->magic != BinaryReflectionProgramLayout::kMagic ||
+            programLayout->version != BinaryReflectionProgramLayout::kVersion)
+            return nullptr;
+
+        BinaryReflectionValidator validator(data, _getFossilDataSize(data, size));
+        if (!validator.validate(programLayout))
+            return nullptr;
+        return (SlangBinaryReflection*)programLayout;
+    }
+
+    // Program
+
+    SLANG_API unsigned spBinaryReflection_GetParameterCount(SlangBinaryReflection* reflection)
+    {
+        auto programLayout = convert(reflection);
+        return programLayout ? unsigned(programLayout->parameters.getElementCount()) : 0;
+    }
+
+    SLANG_API SlangBinaryReflectionVariableLayout* spBinaryReflection_GetParameterByIndex(
+        SlangBinaryReflection* reflection,
+        unsigned index)
+    {
+        auto programLayout = convert(reflection);
+        if (!programLayout)
+            return nullptr;
+        auto parameter = _getElement(programLayout->parameters, index);
+        return parameter ? convert(parameter->get()) : nullptr;
+    }
+
+    SLANG_API SlangUInt spBinaryReflection_getEntryPointCount(SlangBinaryReflection* reflection)
+    {
+        auto programLayout = convert(reflection);
+        return programLayout ? SlangUInt(programLayout->entryPoints.getElementCount()) : 0;
+    }
+
+    SLANG_API SlangBinaryReflectionEntryPoint* spBinaryReflection_getEntryPointByIndex(
+        SlangBinaryReflection* reflection,
+        SlangUInt index)
+    {
+        auto programLayout = convert(reflection);
+        if (!programLayout)
+            return nullptr;
+        auto entryPoint = _getElement(programLayout->entryPoints, SlangInt(index));
+        return entryPoint ? convert(entryPoint->get()) : nullptr;
+    }
+
+    SLANG_API SlangBinaryReflectionEntryPoint* spBinaryReflection_findEntryPointByName(
+        SlangBinaryReflection* reflection,
+        char const* name)
+    {
+        auto programLayout = convert(reflection);
+        if (!programLayout || !name)
+            return nullptr;
+        for (auto& entryPoint : programLayout->entryPoints)
+        {
+            if (entryPoint->name == UnownedStringSlice(name))
+                return convert(entryPoint.get());
+        }
+        return nullptr;
+    }
+
+    SLANG_API SlangUInt
+    spBinaryReflection_getGlobalConstantBufferBinding(SlangBinaryReflection* reflection)
+    {
+        auto programLayout = convert(reflection);
+        return programLayout ? SlangUInt(programLayout->globalConstantBufferBinding.get()) : 0;
+    }
+
+    SLANG_API size_t
+    spBinaryReflection_getGlobalConstantBufferSize(SlangBinaryReflection* reflection)
+    {
+        auto programLayout = convert(reflection);
+        return programLayout ? size_t(programLayout->globalConstantBufferSize.get()) : 0;
+    }
+
+    SLANG_API SlangBinaryReflectionVariableLayout* spBinaryReflection_getGlobalParamsVarLayout(
+        SlangBinaryReflection* reflection)
+    {
+        auto programLayout = convert(reflection);
+        return programLayout ? convert(programLayout->globalParamsVarLayout.get()) : nullptr;
+    }
+
+    // Type Layout
+
+    SLANG_API SlangTypeKind spBinaryReflectionTypeLayout_getKind(
+        SlangBinaryReflectionTypeLayout* inTypeLayout)
+    {
+        auto typeLayout = convert(inTypeLayout);
+        return typeLayout ? SlangTypeKind(typeLayout->kind.get()) : SLANG_TYPE_KIND_NONE;
+    }
+
+    SLANG_API char const* spBinaryReflectionTypeLayout_GetName(
+        SlangBinaryReflectionTypeLayout* inTypeLayout)
+    {
+        auto typeLayout = convert(inTypeLayout);
+        return typeLayout ? _getString(typeLayout->name) : nullptr;
+    }
+
+    SLANG_API size_t spBinaryReflectionTypeLayout_GetSize(
+        SlangBinaryReflectionTypeLayout* inTypeLayout,
+        SlangParameterCategory category)
+    {
+        auto sizeInfo = _findSizeInfo(convert(inTypeLayout), category);
+        return sizeInfo ? size_t(sizeInfo->size.get()) : 0;
+    }
+
+    SLANG_API size_t spBinaryReflectionTypeLayout_GetStride(
+        SlangBinaryReflectionTypeLayout* inTypeLayout,
+        SlangParameterCategory category)
+    {
+        auto sizeInfo = _findSizeInfo(convert(inTypeLayout), category);
+        return sizeInfo ? size_t(sizeInfo->stride.get()) : 0;
+    }
+
+    SLANG_API int32_t spBinaryReflectionTypeLayout_getAlignment(
+        SlangBinaryReflectionTypeLayout* inTypeLayout,
+        SlangParameterCategory category)
+    {
+        auto typeLayout = convert(inTypeLayout);
+        if (!typeLayout)
+            return 0;
+        return category == SLANG_PARAMETER_CATEGORY_UNIFORM ? typeLayout->uniformAlignment.get()
+                                                            : 1;
+    }
+
+    SLANG_API SlangParameterCategory spBinaryReflectionTypeLayout_GetParameterCategory(
+        SlangBinaryReflectionTypeLayout* inTypeLayout)
+    {
+        auto typeLayout = convert(inTypeLayout);
+        return typeLayout ? SlangParameterCategory(typeLayout->parameterCategory.get())
+                          : SLANG_PARAMETER_CATEGORY_NONE;
+    }
+
+    SLANG_API unsigned spBinaryReflectionTypeLayout_GetCategoryCount(
+        SlangBinaryReflectionTypeLayout* inTypeLayout)
+    {
+        auto typeLayout = convert(inTypeLayout);
+        return typeLayout ? unsigned(typeLayout->sizes.getElementCount()) : 0;
+    }
+
+    SLANG_API SlangParameterCategory spBinaryReflectionTypeLayout_GetCategoryByIndex(
+        SlangBinaryReflectionTypeLayout* inTypeLayout,
+        unsigned index)
+    {
+        auto typeLayout = convert(inTypeLayout);
+        if (!typeLayout)
+            return SLANG_PARAMETER_CATEGORY_NONE;
+        auto sizeInfo = _getElement(typeLayout->sizes, index);
+        return sizeInfo ? SlangParameterCategory(sizeInfo->category.get())
+                        : SLANG_PARAMETER_CATEGORY_NONE;
+    }
+
+    SLANG_API unsigned spBinaryReflectionTypeLayout_GetFieldCount(
+        SlangBinaryReflectionTypeLayout* inTypeLayout)
+    {
+        auto typeLayout = convert(inTypeLayout);
+        return typeLayout ? unsigned(typeLayout->fields.getElementCount()) : 0;
+    }
+
+    SLANG_API SlangBinaryReflectionVariableLayout* spBinaryReflectionTypeLayout_GetFieldByIndex(
+        SlangBinaryReflectionTypeLayout* inTypeLayout,
+        unsigned index)
+    {
+        auto typeLayout = convert(inTypeLayout);
+        if (!typeLayout)
+            return nullptr;
+        auto field = _getElement(typeLayout->fields, index);
+        return field ? convert(field->get()) : nullptr;
+    }
+
+    SLANG_API SlangInt spBinaryReflectionTypeLayout_findFieldIndexByName(
+        SlangBinaryReflectionTypeLayout* inTypeLayout,
+        char const* nameBegin,
+        char const* nameEnd)
+    {
+        auto typeLayout = convert(inTypeLayout);
+        if (!typeLayout || !nameBegin)
+            return -1;
+        UnownedStringSlice name = nameEnd ? UnownedStringSlice(nameBegin, nameEnd)
+                                          : UnownedStringSlice(nameBegin);
+        for (Index i = 0; i < typeLayout->fields.getElementCount(); ++i)
+        {
+            auto field = typeLayout->fields[i].get();
+            if (field && field->name == name)
+                return SlangInt(i);
+        }
+        return -1;
+    }
+
+    SLANG_API size_t spBinaryReflectionTypeLayout_GetElementCount(
+        SlangBinaryReflectionTypeLayout* inTypeLayout)
+    {
+        auto typeLayout = convert(inTypeLayout);
+        return typeLayout ? size_t(typeLayout->elementCount.get()) : 0;
+    }
+
+    SLANG_API SlangBinaryReflectionTypeLayout* spBinaryReflectionTypeLayout_GetElementTypeLayout(
+        SlangBinaryReflectionTypeLayout* inTypeLayout)
+    {
+        auto typeLayout = convert(inTypeLayout);
+        return typeLayout ? convert(typeLayout->elementTypeLayout.get()) : nullptr;
+    }
+
+    SLANG_API SlangBinaryReflectionVariableLayout*
+    spBinaryReflectionTypeLayout_GetElementVarLayout(SlangBinaryReflectionTypeLayout* inTypeLayout)
+    {
+        auto typeLayout = convert(inTypeLayout);
+        return typeLayout ? convert(typeLayout->elementVarLayout.get()) : nullptr;
+    }
+
+    SLANG_API SlangBinaryReflectionVariableLayout*
+    spBinaryReflectionTypeLayout_getContainerVarLayout(
+        SlangBinaryReflectionTypeLayout* inTypeLayout)
+    {
+        auto typeLayout = convert(inTypeLayout);
+        return typeLayout ? convert(typeLayout->containerVarLayout.get()) : nullptr;
+    }
+
+    SLANG_API SlangScalarType spBinaryReflectionTypeLayout_GetScalarType(
+        SlangBinaryReflectionTypeLayout* inTypeLayout)
+    {
+        auto typeLayout = convert(inTypeLayout);
+        return typeLayout ? SlangScalarType(typeLayout->scalarType.get()) : SLANG_SCALAR_TYPE_NONE;
+    }
+
+    SLANG_API unsigned spBinaryReflectionTypeLayout_GetRowCount(
+        SlangBinaryReflectionTypeLayout* inTypeLayout)
+    {
+        auto typeLayout = convert(inTypeLayout);
+        return typeLayout ? unsigned(typeLayout->rowCount.get()) : 0;
+    }
+
+    SLANG_API unsigned spBinaryReflectionTypeLayout_GetColumnCount(
+        SlangBinaryReflectionTypeLayout* inTypeLayout)
+    {
+        auto typeLayout = convert(inTypeLayout);
+        return typeLayout ? unsigned(typeLayout->columnCount.get()) : 0;
+    }
+
+    SLANG_API SlangResourceShape spBinaryReflectionTypeLayout_GetResourceShape(
+        SlangBinaryReflectionTypeLayout* inTypeLayout)
+    {
+        auto typeLayout = convert(inTypeLayout);
+        return typeLayout ? SlangResourceShape(typeLayout->resourceShape.get())
+                          : SLANG_RESOURCE_NONE;
+    }
+
+    SLANG_API SlangResourceAccess spBinaryReflectionTypeLayout_GetResourceAccess(
+        SlangBinaryReflectionTypeLayout* inTypeLayout)
+    {
+        auto typeLayout = convert(inTypeLayout);
+        return typeLayout ? SlangResourceAccess(typeLayout->resourceAccess.get())
+                          : SLANG_RESOURCE_ACCESS_NONE;
+    }
+
+    SLANG_API SlangInt spBinaryReflectionTypeLayout_getBindingRangeCount(
+        SlangBinaryReflectionTypeLayout* inTypeLayout)
+    {
+        auto typeLayout = convert(inTypeLayout);
+        return typeLayout ? SlangInt(typeLayout->bindingRanges.getElementCount()) : 0;
+    }
+
+    SLANG_API SlangBindingType spBinaryReflectionTypeLayout_getBindingRangeType(
+        SlangBinaryReflectionTypeLayout* inTypeLayout,
+        SlangInt index)
+    {
+        auto typeLayout = convert(inTypeLayout);
+        if (!typeLayout)
+            return SLANG_BINDING_TYPE_UNKNOWN;
+        auto bindingRange = _getElement(typeLayout->bindingRanges, index);
+        return bindingRange ? SlangBindingType(bindingRange->bindingType.get())
+                            : SLANG_BINDING_TYPE_UNKNOWN;
+    }
+
+    SLANG_API SlangInt spBinaryReflectionTypeLayout_getBindingRangeBindingCount(
+        SlangBinaryReflectionTypeLayout* inTypeLayout,
+        SlangInt index)
+    {
+        auto typeLayout = convert(inTypeLayout);
+        if (!typeLayout)
+            return 0;
+        auto bindingRange = _getElement(typeLayout->bindingRanges, index);
+        return bindingRange ? SlangInt(bindingRange->bindingCount.get()) : 0;
+    }
+
+    SLANG_API SlangBinaryReflectionTypeLayout*
+    spBinaryReflectionTypeLayout_getBindingRangeLeafTypeLayout(
+        SlangBinaryReflectionTypeLayout* inTypeLayout,
+        SlangInt index)
+    {
+        auto typeLayout = convert(inTypeLayout);
+        if (!typeLayout)
+            return nullptr;
+        auto bindingRange = _getElement(typeLayout->bindingRanges, index);
+        return bindingRange ? convert(bindingRange->leafTypeLayout.get()) : nullptr;
+    }
+
+    SLANG_API SlangInt spBinaryReflectionTypeLayout_getBindingRangeDescriptorSetIndex(
+        SlangBinaryReflectionTypeLayout* inTypeLayout,
+        SlangInt index)
+    {
+        auto typeLayout = convert(inTypeLayout);
+        if (!typeLayout)
+            return 0;
+        auto bindingRange = _getElement(typeLayout->bindingRanges, index);
+        return bindingRange ? SlangInt(bindingRange->descriptorSetIndex.get()) : 0;
+    }
+
+    SLANG_API SlangInt spBinaryReflectionTypeLayout_getBindingRangeFirstDescriptorRangeIndex(
+        SlangBinaryReflectionTypeLayout* inTypeLayout,
+        SlangInt index)
+    {
+        auto typeLayout = convert(inTypeLayout);
+        if (!typeLayout)
+            return 0;
+        auto bindingRange = _getElement(typeLayout->bindingRanges, index);
+        return bindingRange ? SlangInt(bindingRange->firstDescriptorRangeIndex.get()) : 0;
+    }
+
+    SLANG_API SlangInt spBinaryReflectionTypeLayout_getBindingRangeDescriptorRangeCount(
+        SlangBinaryReflectionTypeLayout* inTypeLayout,
+        SlangInt index)
+    {
+        auto typeLayout = convert(inTypeLayout);
+        if (!typeLayout)
+            return 0;
+        auto bindingRange = _getElement(typeLayout->bindingRanges, index);
+        return bindingRange ? SlangInt(bindingRange->descriptorRangeCount.get()) : 0;
+    }
+
+    SLANG_API SlangInt spBinaryReflectionTypeLayout_getFieldBindingRangeOffset(
+        SlangBinaryReflectionTypeLayout* inTypeLayout,
+        SlangInt fieldIndex)
+    {
+        auto typeLayout = convert(inTypeLayout);
+        if (!typeLayout)
+            return 0;
+        auto offset = _getElement(typeLayout->fieldBindingRangeOffsets, fieldIndex);
+        return offset ? SlangInt(offset->get()) : 0;
+    }
+
+    SLANG_API SlangInt spBinaryReflectionTypeLayout_getDescriptorSetCount(
+        SlangBinaryReflectionTypeLayout* inTypeLayout)
+    {
+        auto typeLayout = convert(inTypeLayout);
+        return typeLayout ? SlangInt(typeLayout->descriptorSets.getElementCount()) : 0;
+    }
+
+    SLANG_API SlangInt spBinaryReflectionTypeLayout_getDescriptorSetSpaceOffset(
+        SlangBinaryReflectionTypeLayout* inTypeLayout,
+        SlangInt setIndex)
+    {
+        auto typeLayout = convert(inTypeLayout);
+        if (!typeLayout)
+            return 0;
+        auto descriptorSet = _getElement(typeLayout->descriptorSets, setIndex);
+        return descriptorSet ? SlangInt(descriptorSet->spaceOffset.get()) : 0;
+    }
+
+    SLANG_API SlangInt spBinaryReflectionTypeLayout_getDescriptorSetDescriptorRangeCount(
+        SlangBinaryReflectionTypeLayout* inTypeLayout,
+        SlangInt setIndex)
+    {
+        auto typeLayout = convert(inTypeLayout);
+        if (!typeLayout)
+            return 0;
+        auto descriptorSet = _getElement(typeLayout->descriptorSets, setIndex);
+        return descriptorSet ? SlangInt(descriptorSet->descriptorRanges.getElementCount()) : 0;
+    }
+
+    SLANG_API SlangInt spBinaryReflectionTypeLayout_getDescriptorSetDescriptorRangeIndexOffset(
+        SlangBinaryReflectionTypeLayout* inTypeLayout,
+        SlangInt setIndex,
+        SlangInt rangeIndex)
+    {
+        auto descriptorRange = _getDescriptorRange(convert(inTypeLayout), setIndex, rangeIndex);
+        return descriptorRange ? SlangInt(descriptorRange->indexOffset.get()) : 0;
+    }
+
+    SLANG_API SlangInt spBinaryReflectionTypeLayout_getDescriptorSetDescriptorRangeDescriptorCount(
+        SlangBinaryReflectionTypeLayout* inTypeLayout,
+        SlangInt setIndex,
+        SlangInt rangeIndex)
+    {
+        auto descriptorRange = _getDescriptorRange(convert(inTypeLayout), setIndex, rangeIndex);
+        return descriptorRange ? SlangInt(descriptorRange->descriptorCount.get()) : 0;
+    }
+
+    SLANG_API SlangBindingType spBinaryReflectionTypeLayout_getDescriptorSetDescriptorRangeType(
+        SlangBinaryReflectionTypeLayout* inTypeLayout,
+        SlangInt setIndex,
+        SlangInt rangeIndex)
+    {
+        auto descriptorRange = _getDescriptorRange(convert(inTypeLayout), setIndex, rangeIndex);
+        return descriptorRange ? SlangBindingType(descriptorRange->bindingType.get())
+                               : SLANG_BINDING_TYPE_UNKNOWN;
+    }
+
+    SLANG_API SlangParameterCategory
+    spBinaryReflectionTypeLayout_getDescriptorSetDescriptorRangeCategory(
+        SlangBinaryReflectionTypeLayout* inTypeLayout,
+        SlangInt setIndex,
+        SlangInt rangeIndex)
+    {
+        auto descriptorRange = _getDescriptorRange(convert(inTypeLayout), setIndex, rangeIndex);
+        return descriptorRange ? SlangParameterCategory(descriptorRange->category.get())
+                               : SLANG_PARAMETER_CATEGORY_NONE;
+    }
+
+    SLANG_API SlangInt spBinaryReflectionTypeLayout_getSubObjectRangeCount(
+        SlangBinaryReflectionTypeLayout* inTypeLayout)
+    {
+        auto typeLayout = convert(inTypeLayout);
+        return typeLayout ? SlangInt(typeLayout->subObjectRanges.getElementCount()) : 0;
+    }
+
+    SLANG_API SlangInt spBinaryReflectionTypeLayout_getSubObjectRangeBindingRangeIndex(
+        SlangBinaryReflectionTypeLayout* inTypeLayout,
+        SlangInt subObjectRangeIndex)
+    {
+        auto typeLayout = convert(inTypeLayout);
+        if (!typeLayout)
+            return 0;
+        auto subObjectRange = _getElement(typeLayout->subObjectRanges, subObjectRangeIndex);
+        return subObjectRange ? SlangInt(subObjectRange->bindingRangeIndex.get()) : 0;
+    }
+
+    SLANG_API SlangInt spBinaryReflectionTypeLayout_getSubObjectRangeSpaceOffset(
+        SlangBinaryReflectionTypeLayout* inTypeLayout,
+        SlangInt subObjectRangeIndex)
+    {
+        auto typeLayout = convert(inTypeLayout);
+        if (!typeLayout)
+            return 0;
+        auto subObjectRange = _getElement(typeLayout->subObjectRanges, subObjectRangeIndex);
+        return subObjectRange ? SlangInt(subObjectRange->spaceOffset.get()) : 0;
+    }
+
+    // Variable Layout
+
+    SLANG_API char const* spBinaryReflectionVariableLayout_GetName(
+        SlangBinaryReflectionVariableLayout* inVarLayout)
+    {
+        auto varLayout = convert(inVarLayout);
+        return varLayout ? _getString(varLayout->name) : nullptr;
+    }
+
+    SLANG_API SlangBinaryReflectionTypeLayout* spBinaryReflectionVariableLayout_GetTypeLayout(
+        SlangBinaryReflectionVariableLayout* inVarLayout)
+    {
+        auto varLayout = convert(inVarLayout);
+        return varLayout ? convert(varLayout->typeLayout.get()) : nullptr;
+    }
+
+    SLANG_API size_t spBinaryReflectionVariableLayout_GetOffset(
+        SlangBinaryReflectionVariableLayout* inVarLayout,
+        SlangParameterCategory category)
+    {
+        auto offsetInfo = _findOffsetInfo(convert(inVarLayout), category);
+        return offsetInfo ? size_t(offsetInfo->offset.get()) : 0;
+    }
+
+    SLANG_API size_t spBinaryReflectionVariableLayout_GetSpace(
+        SlangBinaryReflectionVariableLayout* inVarLayout,
+        SlangParameterCategory category)
+    {
+        auto offsetInfo = _findOffsetInfo(convert(inVarLayout), category);
+        return offsetInfo ? size_t(offsetInfo->space.get()) : 0;
+    }
+
+    SLANG_API char const* spBinaryReflectionVariableLayout_GetSemanticName(
+        SlangBinaryReflectionVariableLayout* inVarLayout)
+    {
+        auto varLayout = convert(inVarLayout);
+        return varLayout ? _getString(varLayout->semanticName) : nullptr;
+    }
+
+    SLANG_API size_t spBinaryReflectionVariableLayout_GetSemanticIndex(
+        SlangBinaryReflectionVariableLayout* inVarLayout)
+    {
+        auto varLayout = convert(inVarLayout);
+        return varLayout ? size_t(varLayout->semanticIndex.get()) : 0;
+    }
+
+    SLANG_API SlangStage spBinaryReflectionVariableLayout_getStage(
+        SlangBinaryReflectionVariableLayout* inVarLayout)
+    {
+        auto varLayout = convert(inVarLayout);
+        return varLayout ? SlangStage(varLayout->stage.get()) : SLANG_STAGE_NONE;
+    }
+
+    // Entry Point
+
+    SLANG_API char const* spBinaryReflectionEntryPoint_getName(
+        SlangBinaryReflectionEntryPoint* inEntryPoint)
+    {
+        auto entryPoint = convert(inEntryPoint);
+        return entryPoint ? _getString(entryPoint->name) : nullptr;
+    }
+
+    SLANG_API char const* spBinaryReflectionEntryPoint_getNameOverride(
+        SlangBinaryReflectionEntryPoint* inEntryPoint)
+    {
+        auto entryPoint = convert(inEntryPoint);
+        return entryPoint ? _getString(entryPoint->nameOverride) : nullptr;
+    }
+
+    SLANG_API SlangStage spBinaryReflectionEntryPoint_getStage(
+        SlangBinaryReflectionEntryPoint* inEntryPoint)
+    {
+        auto entryPoint = convert(inEntryPoint);
+        return entryPoint ? SlangStage(entryPoint->stage.get()) : SLANG_STAGE_NONE;
+    }
+
+    SLANG_API unsigned spBinaryReflectionEntryPoint_getParameterCount(
+        SlangBinaryReflectionEntryPoint* inEntryPoint)
+    {
+        auto entryPoint = convert(inEntryPoint);
+        return entryPoint ? unsigned(entryPoint->parameters.getElementCount()) : 0;
+    }
+
+    SLANG_API SlangBinaryReflectionVariableLayout* spBinaryReflectionEntryPoint_getParameterByIndex(
+        SlangBinaryReflectionEntryPoint* inEntryPoint,
+        unsigned index)
+    {
+        auto entryPoint = convert(inEntryPoint);
+        if (!entryPoint)
+            return nullptr;
+        auto parameter = _getElement(entryPoint->parameters, index);
+        return parameter ? convert(parameter->get()) : nullptr;
+    }
+
+    SLANG_API SlangBinaryReflectionVariableLayout* spBinaryReflectionEntryPoint_getVarLayout(
+        SlangBinaryReflectionEntryPoint* inEntryPoint)
+    {
+        auto entryPoint = convert(inEntryPoint);
+        return entryPoint ? convert(entryPoint->varLayout.get()) : nullptr;
+    }
+
+    SLANG_API SlangBinaryReflectionVariableLayout* spBinaryReflectionEntryPoint_getResultVarLayout(
+        SlangBinaryReflectionEntryPoint* inEntryPoint)
+    {
+        auto entryPoint = convert(inEntryPoint);
+        return entryPoint ? convert(entryPoint->resultVarLayout.get()) : nullptr;
+    }
+
+    SLANG_API void spBinaryReflectionEntryPoint_getComputeThreadGroupSize(
+        SlangBinaryReflectionEntryPoint* inEntryPoint,
+        SlangUInt axisCount,
+        SlangUInt* outSizeAlongAxis)
+    {
+        auto entryPoint = convert(inEntryPoint);
+        if (!entryPoint || !outSizeAlongAxis)
+            return;
+        for (SlangUInt i = 0; i < axisCount; ++i)
+        {
+            auto size = _getElement(entryPoint->threadGroupSize, SlangInt(i));
+            outSizeAlongAxis[i] = size ? SlangUInt(size->get()) : 0;
+        }
+    }
+}
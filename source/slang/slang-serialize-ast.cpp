@@ -1115,20 +1115,33 @@ void serialize(Serializer const& serializer, CapabilityTargetSet& value)
 
 void serialize(Serializer const& serializer, CapabilitySet& value)
 {
-    serialize(serializer, value.getCapabilityTargetSets());
+    // The target sets of a `CapabilitySet` are interned and
+    // can't be modified in place, so when reading we read
+    // them into a new dictionary and then intern that. Writing
+    // doesn't modify the target sets.
+    //
+    if (!isReading(serializer))
+    {
+        serialize(
+            serializer,
+            const_cast<CapabilityTargetSets&>(value.getCapabilityTargetSets()));
+        return;
+    }
+
+    CapabilityTargetSets targetSets;
+    serialize(serializer, targetSets);
 
-    // The value for each entry in `getCapabilityTargetSets()` have
+    // The value for each entry in the target sets have
     // a `target` field that is redundant with the key for
     // that entry. Rather than serialize the key as part
     // of the `CapabilityTargetSet` type, we instead copy
     // it over from the key to the value in the case where
     // we are reading.
     //
-    if (isReading(serializer))
-    {
-        for (auto& p : value.getCapabilityTargetSets())
-            p.second.target = p.first;
-    }
+    for (auto& p : targetSets)
+        p.second.target = p.first;
+
+    value = CapabilitySet(std::move(targetSets));
 }
 
 //
@@ -2,8 +2,10 @@
 #include "slang-serialize-container.h"
 
 #include "../core/slang-byte-encode-util.h"
+#include "../core/slang-io.h"
 #include "../core/slang-math.h"
 #include "../core/slang-stream.h"
+#include "../core/slang-string-util.h"
 #include "../core/slang-text-io.h"
 #include "slang-check-impl.h"
 #include "slang-compiler.h"
@@ -210,6 +212,7 @@ public:
             // files that the compiled result depended on.
             //
             encodeModuleDependencyPaths(module);
+            encodeModuleDependencyStats(module);
         }
 
         // If there is IR available for this module, then we we encode it.
@@ -349,6 +352,33 @@ public:
         return SLANG_OK;
     }
 
+    SlangResult encodeModuleDependencyStats(Module* module)
+    {
+        // There is one stat for each of the paths written by `encodeModuleDependencyPaths`,
+        // in the same order, so a reader can tell if a dependency has changed without
+        // reading and hashing it.
+        //
+        // The stat is the one taken when the file was read, so that it matches the digest
+        // of the contents the module was compiled from. A file changed since then has a
+        // different stat, and is hashed by the reader.
+        List<SerialFileDependencyStat> stats;
+        for (auto file : module->getFileDependencies())
+        {
+            SerialFileDependencyStat stat;
+            auto& fileStat = file->getFileStat();
+            stat.size = fileStat.size;
+            stat.modificationTime = fileStat.modificationTime;
+            stat.digest = file->getDigest();
+            stats.add(stat);
+        }
+
+        _cursor.addDataChunk(
+            PropertyKeys<Module>::FileDependencyStats,
+            stats.getBuffer(),
+            stats.getCount() * sizeof(SerialFileDependencyStat));
+        return SLANG_OK;
+    }
+
     SlangResult encodeFinalPieces()
     {
         // We can now output the debug information. This is for all IR and AST
@@ -413,6 +443,24 @@ public:
     return SLANG_OK;
 }
 
+/* static */ SlangResult SerialContainerUtil::getFileDependencyStat(
+    ISlangFileSystemExt* fileSystem,
+    const String& path,
+    SerialFileDependencyStat& outStat)
+{
+    // Only files of the operating system have a modification time.
+    if (!fileSystem || fileSystem->getOSPathKind() == OSPathKind::None)
+        return SLANG_E_NOT_AVAILABLE;
+
+    ComPtr<ISlangBlob> osPathBlob;
+    SLANG_RETURN_ON_FAIL(
+        fileSystem->getPath(PathKind::OperatingSystem, path.getBuffer(), osPathBlob.writeRef()));
+    return File::getSizeAndModificationTime(
+        StringUtil::getString(osPathBlob),
+        outStat.size,
+        outStat.modificationTime);
+}
+
 String StringChunk::getValue() const
 {
     return String(UnownedStringSlice((char const*)getPayload(), getPayloadSize()));
@@ -426,6 +474,19 @@ RIFF::ChunkList<StringChunk> ModuleChunk::getFileDependencies() const
     return found->getChildren().cast<StringChunk>();
 }
 
+List<SerialFileDependencyStat> ModuleChunk::getFileDependencyStats() const
+{
+    List<SerialFileDependencyStat> stats;
+    auto found = findDataChunk(PropertyKeys<Module>::FileDependencyStats);
+    if (!found)
+        return stats;
+
+    // The payload may not be aligned, so it is copied out.
+    stats.setCount(found->getPayloadSize() / sizeof(SerialFileDependencyStat));
+    found->writePayloadInto(stats.getBuffer(), stats.getCount() * sizeof(SerialFileDependencyStat));
+    return stats;
+}
+
 ModuleChunk const* ModuleChunk::find(RIFF::ListChunk const* baseChunk)
 {
     auto found = baseChunk->findListChunkRec(SerialBinary::kModuleFourCC);
@@ -60,6 +60,14 @@ struct SerialContainerUtil
         const WriteOptions& options,
         Stream* stream);
     static SlangResult write(Module* module, const WriteOptions& options, Stream* stream);
+
+    /// Get the size and modification time of the file at `path` in `fileSystem`, leaving
+    /// the digest of `outStat` as it is. Fails if the file system isn't backed by files
+    /// of the operating system.
+    static SlangResult getFileDependencyStat(
+        ISlangFileSystemExt* fileSystem,
+        const String& path,
+        SerialFileDependencyStat& outStat);
 };
 
 struct StringChunk : RIFF::DataChunk
@@ -89,6 +97,10 @@ public:
     SHA1::Digest getDigest() const;
 
     RIFF::ChunkList<StringChunk> getFileDependencies() const;
+
+    /// Get the stats of the file dependencies, in the same order as `getFileDependencies`.
+    /// Empty if the module was written without them.
+    List<SerialFileDependencyStat> getFileDependencyStats() const;
 };
 
 struct EntryPointChunk : RIFF::ListChunk
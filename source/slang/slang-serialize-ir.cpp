@@ -4,6 +4,7 @@
 #include "core/slang-blob-builder.h"
 #include "slang-ir-insts-stable-names.h"
 #include "slang-ir-insts.h"
+#include "slang-ir-link.h"
 #include "slang-ir-validate.h"
 #include "slang-serialize-fossil.h"
 #include "slang-serialize-source-loc.h"
@@ -34,9 +35,26 @@ struct IRModuleInfo
     // things and maintain backwards compat we can increment this value, for
     // example if we introduce more instructions with weird payloads like
     // IRModuleInst or IRConstants.
-    const static UInt kSupportedSerializationVersion = 0;
+    const static UInt kSupportedSerializationVersion = 3;
     FIDDLE() UInt serializationVersion = kSupportedSerializationVersion;
     FIDDLE() RefPtr<IRModule> module;
+
+    // The global values with linkage in the module, by mangled name. The keys
+    // are sorted so that they can be searched without reading the module.
+    FIDDLE() OrderedDictionary<String, List<IRInst*>> mapMangledNameToGlobalInsts;
+
+    // Whether the global values in `mapMangledNameToGlobalInsts` can be read
+    // without reading the whole module, see `SerializedIRModule`.
+    FIDDLE() bool canReadSymbolsOnDemand = false;
+
+    // See `IRModuleLinkRequirements`
+    FIDDLE() bool hasUnconditionalInsts = true;
+    FIDDLE() bool hasGlobalParams = true;
+    FIDDLE() bool hasAutoDiffAnnotations = true;
+
+    // Whether the module uses auto-diff, so that the link index of the module
+    // can be built without visiting all of its instructions after reading it.
+    FIDDLE() bool usesAutodiff = true;
 };
 
 //
@@ -84,10 +102,21 @@ struct IRSerialReadContext : IRSerialContext, RefObject
 
     // The module in which we will allocate our instructions
     RefPtr<IRModule> _module;
+
+    // The state shared by all the readers that read into `_module`, which
+    // maps each serialized instruction to the instruction it was read as.
+    Fossil::ReadContext _readContext;
+
+    // The instructions allocated by reads since this was last cleared.
+    List<IRInst*> _readInsts;
 };
 
 SLANG_DECLARE_FOSSILIZED_AS(Name, String);
 
+// Instructions are serialized as variants (see `serializeObject` below), so a
+// pointer to a fossilized instruction can be read on its own.
+SLANG_DECLARE_FOSSILIZED_TYPE(IRInst, FossilizedVariantObj);
+
 /// Fossilized representation of a `IRModule`
 struct Fossilized_IRModule;
 
@@ -309,7 +338,14 @@ void serializeObject(IRSerializer const& serializer, T*& inst, IRInst*)
                              offsetof(IRConstant::StringValue, chars) + stringLitString.getLength();
             break;
         }
-        inst = cast<T>(readContext->_module->_allocateInst(op, operandCount, minSizeInBytes));
+        // A module that instructions have already been read into on demand
+        // has its module instruction, which is reused when the rest of the
+        // module is read.
+        if (op == kIROp_ModuleInst && readContext->_module->getModuleInst())
+            inst = cast<T>(readContext->_module->getModuleInst());
+        else
+            inst = cast<T>(readContext->_module->_allocateInst(op, operandCount, minSizeInBytes));
+        readContext->_readInsts.add(inst);
         if (op == kIROp_StringLit || op == kIROp_BlobLit)
         {
             const auto c = cast<IRConstant>(inst);
@@ -403,9 +439,9 @@ void IRSerialWriteContext::handleIRModule(IRSerializer const& serializer, IRModu
 void IRSerialReadContext::handleIRModule(IRSerializer const& serializer, IRModule*& value)
 {
     SLANG_SCOPED_SERIALIZER_STRUCT(serializer);
-    value = new IRModule{_session};
-    SLANG_ASSERT(!_module);
-    _module = value;
+    if (!_module)
+        _module = new IRModule{_session};
+    value = _module;
     serialize(serializer, value->m_moduleInst);
     serialize(serializer, value->m_name);
     serialize(serializer, value->m_version);
@@ -437,6 +473,89 @@ void IRSerialReadContext::handleName(IRSerializer const& serializer, Name*& valu
 // {write,read}SerializedModuleIR()
 //
 
+// Get the global instruction that `inst` is nested in, or `inst` itself if it is
+// a global instruction.
+static IRInst* _getGlobalAncestor(IRInst* inst)
+{
+    while (inst->getParent() && inst->getParent()->getOp() != kIROp_ModuleInst)
+        inst = inst->getParent();
+    return inst;
+}
+
+// Determine whether each global value can be read without reading the rest of
+// the module. Reading a global instruction reads the instructions nested in it,
+// and the instructions its operands refer to, but not the parents of those.
+// This is only enough if every instruction nested in a global instruction is
+// referenced from within that global instruction only.
+static bool _canReadSymbolsOnDemand(IRModule* irModule)
+{
+    auto moduleInst = irModule->getModuleInst();
+    auto isReferenceValid = [&](IRInst* user, IRInst* used)
+    {
+        if (!used || used->getParent() == moduleInst)
+            return true;
+        if (used == moduleInst)
+            return false;
+        return _getGlobalAncestor(used) == _getGlobalAncestor(user);
+    };
+
+    bool canRead = true;
+    auto visit = [&](auto&& visit, IRInst* inst) -> void
+    {
+        if (!canRead)
+            return;
+        if (!isReferenceValid(inst, inst->getFullType()))
+            canRead = false;
+        for (UInt i = 0; i < inst->getOperandCount(); ++i)
+        {
+            if (!isReferenceValid(inst, inst->getOperand(i)))
+                canRead = false;
+        }
+        for (auto child : inst->getDecorationsAndChildren())
+            visit(visit, child);
+    };
+    for (auto inst : irModule->getModuleInst()->getDecorationsAndChildren())
+        visit(visit, inst);
+    return canRead;
+}
+
+// Collect the information that allows a module to be read on demand,
+// see `SerializedIRModule`.
+static void _collectOnDemandInfo(IRModule* irModule, IRModuleInfo& moduleInfo)
+{
+    Dictionary<String, List<IRInst*>> mapMangledNameToGlobalInsts;
+    List<String> mangledNames;
+    for (auto inst : irModule->getGlobalInsts())
+    {
+        if (auto linkage = inst->findDecoration<IRLinkageDecoration>())
+        {
+            String mangledName = linkage->getMangledName();
+            auto& insts = mapMangledNameToGlobalInsts[mangledName];
+            if (insts.getCount() == 0)
+                mangledNames.add(mangledName);
+            insts.add(inst);
+        }
+    }
+
+    // The entries are written in sorted order, so that they can be searched
+    // with a binary search when reading, in the same way as the exported
+    // declarations of an AST module.
+    mangledNames.sort();
+    for (auto& mangledName : mangledNames)
+    {
+        moduleInfo.mapMangledNameToGlobalInsts.add(
+            mangledName,
+            mapMangledNameToGlobalInsts[mangledName]);
+    }
+    moduleInfo.canReadSymbolsOnDemand = _canReadSymbolsOnDemand(irModule);
+
+    const auto linkRequirements = getIRModuleLinkRequirements(irModule);
+    moduleInfo.hasUnconditionalInsts = linkRequirements.hasUnconditionalInsts;
+    moduleInfo.hasGlobalParams = linkRequirements.hasGlobalParams;
+    moduleInfo.hasAutoDiffAnnotations = linkRequirements.hasAutoDiffAnnotations;
+    moduleInfo.usesAutodiff = getIRModuleLinkIndex(irModule)->usesAutodiff;
+}
+
 void writeSerializedModuleIR(
     RIFF::BuildCursor& cursor,
     IRModule* irModule,
@@ -448,6 +567,7 @@ void writeSerializedModuleIR(
     IRModuleInfo moduleInfo;
     moduleInfo.fullVersion = SLANG_TAG_VERSION;
     moduleInfo.module = irModule;
+    _collectOnDemandInfo(irModule, moduleInfo);
 
     BlobBuilder blobBuilder;
     {
@@ -492,48 +612,25 @@ Result readSerializedModuleInfo(
     return SLANG_OK;
 }
 
-//
-// Read a module, this currently does not do any on-demand loading
-//
-Result readSerializedModuleIR(
-    RIFF::Chunk const* chunk,
-    Session* session,
-    SerialSourceLocReader* sourceLocReader,
+// Read the whole module from the root value of the serialized data, into the
+// module of `context` if it has one.
+static Result _readSerializedModuleIR(
+    Fossil::AnyValPtr rootValPtr,
+    IRSerialReadContext* context,
     RefPtr<IRModule>& outIRModule)
 {
-    auto dataChunk = as<RIFF::DataChunk>(chunk);
-    if (!dataChunk)
-    {
-        SLANG_UNEXPECTED("invalid format for serialized module IR");
-    }
-
-    Fossil::AnyValPtr rootValPtr =
-        Fossil::getRootValue(dataChunk->getPayload(), dataChunk->getPayloadSize());
-    if (!rootValPtr)
-    {
-        SLANG_UNEXPECTED("invalid format for serialized module IR");
-    }
-
-    Fossilized<IRModuleInfo>* fossilizedModuleInfo = cast<Fossilized<IRModuleInfo>>(rootValPtr);
-
-    // Only one version supported so far, if we had multiple versions to
-    // support this is where we might branch
-    if (fossilizedModuleInfo->serializationVersion != IRModuleInfo::kSupportedSerializationVersion)
-        return SLANG_FAIL;
-
     IRModuleInfo info;
     {
-        auto sharedDecodingContext = RefPtr(new IRSerialReadContext(session, sourceLocReader));
-        Fossil::ReadContext readContext;
         Fossil::SerialReader reader(
-            readContext,
+            context->_readContext,
             rootValPtr,
             Fossil::SerialReader::InitialStateType::Root);
 
-        IRSerializer serializer(&reader, sharedDecodingContext);
+        IRSerializer serializer(&reader, context);
         serialize(serializer, info);
     }
     SLANG_ASSERT(info.module);
+    context->_readInsts.clear();
 
     //
     // Now that everything is loaded, we can traverse the module and fix up the
@@ -541,13 +638,17 @@ Result readSerializedModuleIR(
     // deserialization we didn't necessarily have this information handy at the
     // time.
     //
+    // Instructions that were read on demand before already have the right
+    // parent, and may be in use on other threads, so we leave those alone.
+    //
     bool hasUnrecognizedInsts = false;
     auto go = [&](auto&& go, IRInst* parent, IRInst* inst) -> void
     {
         if (inst->getOp() == kIROp_Unrecognized)
             hasUnrecognizedInsts = true;
 
-        inst->parent = parent;
+        if (inst->parent != parent)
+            inst->parent = parent;
         for (const auto child : inst->getDecorationsAndChildren())
             go(go, inst, child);
     };
@@ -561,8 +662,245 @@ Result readSerializedModuleIR(
     // ready to be used
     //
     info.module->buildMangledNameToGlobalInstMap();
+    buildIRModuleLinkIndex(info.module, info.usesAutodiff);
     outIRModule = info.module;
     return SLANG_OK;
 }
 
+static Fossilized<IRModuleInfo>* _getFossilizedModuleInfo(RIFF::Chunk const* chunk)
+{
+    auto dataChunk = as<RIFF::DataChunk>(chunk);
+    if (!dataChunk)
+    {
+        SLANG_UNEXPECTED("invalid format for serialized module IR");
+    }
+
+    Fossil::AnyValPtr rootValPtr =
+        Fossil::getRootValue(dataChunk->getPayload(), dataChunk->getPayloadSize());
+    if (!rootValPtr)
+    {
+        SLANG_UNEXPECTED("invalid format for serialized module IR");
+    }
+
+    return cast<Fossilized<IRModuleInfo>>(rootValPtr);
+}
+
+//
+// Read a whole module
+//
+Result readSerializedModuleIR(
+    RIFF::Chunk const* chunk,
+    Session* session,
+    SerialSourceLocReader* sourceLocReader,
+    RefPtr<IRModule>& outIRModule)
+{
+    Fossilized<IRModuleInfo>* fossilizedModuleInfo = _getFossilizedModuleInfo(chunk);
+
+    // Only one version supported so far, if we had multiple versions to
+    // support this is where we might branch
+    if (fossilizedModuleInfo->serializationVersion != IRModuleInfo::kSupportedSerializationVersion)
+        return SLANG_FAIL;
+
+    auto dataChunk = as<RIFF::DataChunk>(chunk);
+    auto context = RefPtr(new IRSerialReadContext(session, sourceLocReader));
+    return _readSerializedModuleIR(
+        Fossil::getRootValue(dataChunk->getPayload(), dataChunk->getPayloadSize()),
+        context,
+        outIRModule);
+}
+
+//
+// Read a module on demand.
+//
+// Everything needed to decide whether the module needs to be read is stored in
+// the `IRModuleInfo` next to the module, and can be accessed in place, in the same
+// way as the AST looks up exported declarations (see slang-serialize-ast.cpp).
+//
+Result readSerializedModuleIROnDemand(
+    RIFF::Chunk const* chunk,
+    ISlangBlob* blobHoldingSerializedData,
+    Session* session,
+    SerialSourceLocReader* sourceLocReader,
+    RefPtr<SerializedIRModule>& outSerializedIRModule)
+{
+    Fossilized<IRModuleInfo>* fossilizedModuleInfo = _getFossilizedModuleInfo(chunk);
+
+    if (fossilizedModuleInfo->serializationVersion != IRModuleInfo::kSupportedSerializationVersion)
+        return SLANG_FAIL;
+
+    // A module written by a different compiler version could contain instructions we don't
+    // recognize, which is only detected when reading it, at which point it is too late to fail.
+    if (fossilizedModuleInfo->fullVersion.get() != UnownedStringSlice(SLANG_TAG_VERSION))
+        return SLANG_E_NOT_AVAILABLE;
+
+    // Without a blob to retain, the serialized data can't be assumed to outlive this call.
+    if (!blobHoldingSerializedData)
+        return SLANG_E_NOT_AVAILABLE;
+
+    outSerializedIRModule = new SerializedIRModule(
+        chunk,
+        blobHoldingSerializedData,
+        session,
+        sourceLocReader,
+        fossilizedModuleInfo);
+    return SLANG_OK;
+}
+
+SerializedIRModule::SerializedIRModule(
+    RIFF::Chunk const* chunk,
+    ISlangBlob* blobHoldingSerializedData,
+    Session* session,
+    SerialSourceLocReader* sourceLocReader,
+    void const* fossilizedModuleInfo)
+    : m_chunk(chunk)
+    , m_blobHoldingSerializedData(blobHoldingSerializedData)
+    , m_sourceLocReader(sourceLocReader)
+    , m_fossilizedModuleInfo(fossilizedModuleInfo)
+{
+    auto info = (Fossilized<IRModuleInfo> const*)m_fossilizedModuleInfo;
+    m_linkRequirements.hasUnconditionalInsts = info->hasUnconditionalInsts.get();
+    m_linkRequirements.hasGlobalParams = info->hasGlobalParams.get();
+    m_linkRequirements.hasAutoDiffAnnotations = info->hasAutoDiffAnnotations.get();
+    m_canReadSymbolsOnDemand = info->canReadSymbolsOnDemand.get();
+
+    // Instructions that are read on demand are allocated in the module that
+    // `readModule` completes later.
+    m_readContext = new IRSerialReadContext(session, sourceLocReader);
+    m_readContext->_module = IRModule::create(session);
+    m_readContext->_module->setName(
+        session->getNamePool()->getName(info->module->m_name.get()));
+}
+
+SerializedIRModule::~SerializedIRModule() {}
+
+// The mangled names in a serialized module were sorted when it was written,
+// so we can look them up with a binary search.
+static Fossilized<List<IRInst*>> const* _findGlobalInstsInSerializedModule(
+    Fossilized<IRModuleInfo> const* info,
+    UnownedStringSlice const& mangledName)
+{
+    auto entries = info->mapMangledNameToGlobalInsts.getBuffer();
+
+    Index lo = 0;
+    Index hi = info->mapMangledNameToGlobalInsts.getElementCount() - 1;
+    while (lo <= hi)
+    {
+        Index mid = lo + ((hi - lo) >> 1);
+
+        int cmp = compare(entries[mid].key, mangledName);
+        if (cmp == 0)
+            return &entries[mid].value;
+
+        if (cmp < 0)
+            lo = mid + 1;
+        else
+            hi = mid - 1;
+    }
+    return nullptr;
+}
+
+bool SerializedIRModule::hasSymbol(UnownedStringSlice const& mangledName) const
+{
+    auto info = (Fossilized<IRModuleInfo> const*)m_fossilizedModuleInfo;
+    return _findGlobalInstsInSerializedModule(info, mangledName) != nullptr;
+}
+
+Result SerializedIRModule::readSymbol(
+    UnownedStringSlice const& mangledName,
+    List<IRInst*>& outInsts)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_canReadSymbolsOnDemand && !m_isModuleRead)
+        return _readSymbol(mangledName, outInsts);
+
+    SLANG_RETURN_ON_FAIL(_readModule());
+    auto irModule = m_readContext->_module;
+    for (auto inst : irModule->findSymbolByMangledName(ImmutableHashedString(mangledName)))
+        outInsts.add(inst);
+    return SLANG_OK;
+}
+
+Result SerializedIRModule::_readSymbol(
+    UnownedStringSlice const& mangledName,
+    List<IRInst*>& outInsts)
+{
+    auto info = (Fossilized<IRModuleInfo> const*)m_fossilizedModuleInfo;
+    auto fossilizedInsts = _findGlobalInstsInSerializedModule(info, mangledName);
+    if (!fossilizedInsts)
+        return SLANG_OK;
+
+    // Each instruction is read in the same way as `ASTSerialReadContext::readFossilizedDecl`
+    // reads a declaration. The shared read context maps instructions that have been read
+    // before, whether they were read for this symbol or referenced by another one, to
+    // the same `IRInst`.
+    //
+    for (auto fossilizedInst : *fossilizedInsts)
+    {
+        Fossil::SerialReader reader(
+            m_readContext->_readContext,
+            getVariantContentPtr(fossilizedInst.get()),
+            Fossil::SerialReader::InitialStateType::PseudoPtr);
+        IRSerializer serializer(&reader, m_readContext.Ptr());
+
+        IRInst* inst = nullptr;
+        serialize(serializer, inst);
+        outInsts.add(inst);
+    }
+
+    // The parents of the instructions that were read are fixed up as in
+    // `_readSerializedModuleIR`. Instructions nested in another instruction were
+    // read along with it, so any instruction without a parent now is a global
+    // instruction (see `_canReadSymbolsOnDemand`), which is added to the module.
+    // Reading the whole module later rebuilds the list of global instructions in
+    // its serialized order.
+    //
+    auto& readInsts = m_readContext->_readInsts;
+    bool hasUnrecognizedInsts = false;
+    for (auto inst : readInsts)
+    {
+        if (inst->getOp() == kIROp_Unrecognized)
+            hasUnrecognizedInsts = true;
+        for (auto child : inst->getDecorationsAndChildren())
+            child->parent = inst;
+    }
+    auto moduleInst = m_readContext->_module->getModuleInst();
+    for (auto inst : readInsts)
+    {
+        if (inst->parent)
+            continue;
+        if (as<IRDecoration>(inst))
+            inst->insertAtStart(moduleInst);
+        else
+            inst->insertAtEnd(moduleInst);
+    }
+    readInsts.clear();
+
+    return hasUnrecognizedInsts ? SLANG_FAIL : SLANG_OK;
+}
+
+Result SerializedIRModule::readModule(RefPtr<IRModule>& outIRModule)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    SLANG_RETURN_ON_FAIL(_readModule());
+    outIRModule = m_readContext->_module;
+    return SLANG_OK;
+}
+
+Result SerializedIRModule::_readModule()
+{
+    if (m_isModuleRead)
+        return m_readModuleResult;
+    m_isModuleRead = true;
+
+    // Reading the module reuses the instructions that have been read on demand,
+    // and adds all the global instructions to the module instruction.
+    auto dataChunk = as<RIFF::DataChunk>(m_chunk);
+    RefPtr<IRModule> irModule;
+    m_readModuleResult = _readSerializedModuleIR(
+        Fossil::getRootValue(dataChunk->getPayload(), dataChunk->getPayloadSize()),
+        m_readContext,
+        irModule);
+    return m_readModuleResult;
+}
+
 } // namespace Slang
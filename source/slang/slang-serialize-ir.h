@@ -2,14 +2,116 @@
 
 #include "core/slang-riff.h"
 
+#include <mutex>
+
 namespace Slang
 {
 
+struct IRInst;
 struct IRModule;
+struct IRSerialReadContext;
 class Session;
 class SerialSourceLocReader;
 class SerialSourceLocWriter;
 
+/// Information about the parts of an IR module that are needed when linking,
+/// other than the global values that are looked up by mangled name.
+///
+/// This is stored alongside a serialized IR module, so that the linker can
+/// tell whether a module needs to be read without reading it.
+///
+struct IRModuleLinkRequirements
+{
+    /// The module has instructions (or module decorations) that are used
+    /// whether or not any of its symbols are referenced, such as exported
+    /// symbols, debug sources, hashed string literals or embedded downstream IR.
+    bool hasUnconditionalInsts = true;
+
+    /// The module has global shader parameters, which are linked when
+    /// parameters are preserved.
+    bool hasGlobalParams = true;
+
+    /// The module has auto-diff annotations, which are linked when any
+    /// linked module uses auto-diff.
+    bool hasAutoDiffAnnotations = true;
+};
+
+/// A serialized IR module that is read on demand.
+///
+/// The symbol table and link requirements of the module can be queried
+/// directly from the serialized data. The global instructions with a given
+/// mangled name can be read on their own with `readSymbol`, along with the
+/// instructions they reference, and the module as a whole is only
+/// deserialized when `readModule` is called.
+///
+/// Instructions read by `readSymbol` belong to the same `IRModule` that
+/// `readModule` completes, so an instruction is never read twice. Reads are
+/// serialized by a mutex, and can add uses to instructions read earlier, so
+/// code that works with instructions of the module while other threads read
+/// from it must not walk their uses.
+///
+class SerializedIRModule : public RefObject
+{
+public:
+    /// Returns true if the module has a global value with the given mangled name.
+    bool hasSymbol(UnownedStringSlice const& mangledName) const;
+
+    /// Get the link requirements of the module.
+    IRModuleLinkRequirements const& getLinkRequirements() const { return m_linkRequirements; }
+
+    /// Read the global values with the given mangled name, if the module has any.
+    ///
+    /// The instructions they reference are read as well. Global instructions read
+    /// this way are added to the module instruction, and are reused when
+    /// `readModule` reads the rest of the module.
+    ///
+    [[nodiscard]] Result readSymbol(
+        UnownedStringSlice const& mangledName,
+        List<IRInst*>& outInsts);
+
+    /// Deserialize the whole module.
+    ///
+    /// Calling this more than once returns the same module.
+    ///
+    [[nodiscard]] Result readModule(RefPtr<IRModule>& outIRModule);
+
+    SerializedIRModule(
+        RIFF::Chunk const* chunk,
+        ISlangBlob* blobHoldingSerializedData,
+        Session* session,
+        SerialSourceLocReader* sourceLocReader,
+        void const* fossilizedModuleInfo);
+    ~SerializedIRModule();
+
+private:
+    Result _readSymbol(UnownedStringSlice const& mangledName, List<IRInst*>& outInsts);
+    Result _readModule();
+
+    RIFF::Chunk const* m_chunk;
+    ComPtr<ISlangBlob> m_blobHoldingSerializedData;
+    RefPtr<SerialSourceLocReader> m_sourceLocReader;
+
+    /// Points into `m_blobHoldingSerializedData`
+    void const* m_fossilizedModuleInfo;
+
+    IRModuleLinkRequirements m_linkRequirements;
+
+    /// Whether the global values of the module can be read on their own. This is
+    /// false if an instruction references an instruction nested in a different
+    /// global instruction, in which case `readSymbol` reads the whole module.
+    bool m_canReadSymbolsOnDemand = false;
+
+    /// The shared state of all reads from the module, including the module
+    /// that the instructions are read into.
+    RefPtr<IRSerialReadContext> m_readContext;
+
+    /// The result of reading the whole module, once `m_isModuleRead` is set.
+    Result m_readModuleResult = SLANG_OK;
+    bool m_isModuleRead = false;
+
+    std::mutex m_mutex;
+};
+
 void writeSerializedModuleIR(
     RIFF::BuildCursor& cursor,
     IRModule* moduleDecl,
@@ -21,6 +123,22 @@ void writeSerializedModuleIR(
     SerialSourceLocReader* sourceLocReader,
     RefPtr<IRModule>& outIRModule);
 
+/// Prepare to read a serialized module on demand.
+///
+/// The `chunk` must be within `blobHoldingSerializedData`, which is retained
+/// by the `SerializedIRModule`.
+///
+/// Returns `SLANG_E_NOT_AVAILABLE` if the module can't be read on demand,
+/// for example because it was written by a different compiler version, in
+/// which case `readSerializedModuleIR` should be used instead.
+///
+[[nodiscard]] Result readSerializedModuleIROnDemand(
+    RIFF::Chunk const* chunk,
+    ISlangBlob* blobHoldingSerializedData,
+    Session* session,
+    SerialSourceLocReader* sourceLocReader,
+    RefPtr<SerializedIRModule>& outSerializedIRModule);
+
 [[nodiscard]] Result readSerializedModuleInfo(
     RIFF::Chunk const* chunk,
     String& compilerVersion,
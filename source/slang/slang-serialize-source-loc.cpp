@@ -184,19 +184,21 @@ int SerialSourceLocReader::calcFixSourceLoc(
     SerialSourceLocData::SourceLoc loc,
     SerialSourceLocData::SourceRange& outRange)
 {
-    if (m_lastViewIndex < 0 || !m_views[m_lastViewIndex].m_range.contains(loc))
+    Index viewIndex = m_lastViewIndex.load(std::memory_order_relaxed);
+    if (viewIndex < 0 || !m_views[viewIndex].m_range.contains(loc))
     {
-        m_lastViewIndex = findViewIndex(loc);
+        viewIndex = findViewIndex(loc);
+        m_lastViewIndex.store(viewIndex, std::memory_order_relaxed);
     }
 
-    if (m_lastViewIndex < 0)
+    if (viewIndex < 0)
     {
         // Set an invalid range, as couldn't find
         outRange = SerialSourceLocData::SourceRange::getInvalid();
         return 0;
     }
 
-    const auto& view = m_views[m_lastViewIndex];
+    const auto& view = m_views[viewIndex];
 
     SLANG_ASSERT(view.m_range.contains(loc));
 
@@ -208,19 +210,21 @@ SourceLoc SerialSourceLocReader::getSourceLoc(SerialSourceLocData::SourceLoc loc
 {
     if (loc != 0)
     {
-        if (m_lastViewIndex >= 0)
+        Index viewIndex = m_lastViewIndex.load(std::memory_order_relaxed);
+        if (viewIndex >= 0)
         {
-            const auto& view = m_views[m_lastViewIndex];
+            const auto& view = m_views[viewIndex];
             if (view.m_range.contains(loc))
             {
                 return view.m_range.getSourceLoc(loc, view.m_sourceView);
             }
         }
 
-        m_lastViewIndex = findViewIndex(loc);
-        if (m_lastViewIndex >= 0)
+        viewIndex = findViewIndex(loc);
+        m_lastViewIndex.store(viewIndex, std::memory_order_relaxed);
+        if (viewIndex >= 0)
         {
-            const auto& view = m_views[m_lastViewIndex];
+            const auto& view = m_views[viewIndex];
             return view.m_range.getSourceLoc(loc, view.m_sourceView);
         }
     }
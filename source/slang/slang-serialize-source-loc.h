@@ -10,6 +10,8 @@
 #include "slang-serialize-types.h"
 #include "slang-serialize.h"
 
+#include <atomic>
+
 namespace Slang
 {
 
@@ -177,8 +179,11 @@ protected:
         SourceView* m_sourceView;
     };
 
-    List<View> m_views;         ///< All the views
-    Index m_lastViewIndex = -1; ///< Caches last lookup
+    List<View> m_views; ///< All the views, which don't change once they have been read
+
+    /// Caches last lookup. Locations of a module can be read by code generation tasks
+    /// running in parallel, so the cache is shared by them.
+    std::atomic<Index> m_lastViewIndex{-1};
 };
 
 /// Used to write serialized SourceLoc information
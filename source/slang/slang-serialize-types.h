@@ -3,6 +3,7 @@
 #define SLANG_SERIALIZE_TYPES_H
 
 #include "../core/slang-array-view.h"
+#include "../core/slang-crypto.h"
 #include "../core/slang-riff.h"
 #include "../core/slang-string-slice-pool.h"
 #include "slang-ir.h"
@@ -108,6 +109,21 @@ struct PropertyKeys<Module>
     static const FourCC::RawValue Digest = SLANG_FOUR_CC('S', 'H', 'A', '1');
     static const FourCC::RawValue ASTModule = SLANG_FOUR_CC('a', 's', 't', ' ');
     static const FourCC::RawValue FileDependencies = SLANG_FOUR_CC('f', 'd', 'e', 'p');
+    static const FourCC::RawValue FileDependencyStats = SLANG_FOUR_CC('f', 's', 't', 'a');
+};
+
+/// The size, modification time and contents digest of a file a module depends on, as they
+/// were when the file was read to compile the module. Lets a reader check that a dependency
+/// is unchanged without reading it.
+struct SerialFileDependencyStat
+{
+    uint64_t size = 0;
+    /// As in `SourceFile::FileStat`, or 0 if it can't be used to tell that the file is
+    /// unchanged (for example if it isn't a file of the operating system).
+    uint64_t modificationTime = 0;
+    SHA1::Digest digest;
+    /// Keeps the size of the struct the same on all platforms.
+    uint32_t pad = 0;
 };
 
 template<>
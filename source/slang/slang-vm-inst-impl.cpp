@@ -2,6 +2,8 @@
 
 #include "slang-vm.h"
 
+#include <type_traits>
+
 using namespace slang;
 
 namespace Slang
@@ -969,6 +971,87 @@ void printHandler(IByteCodeRunner* inCtx, VMExecInstHeader* inst, void* userData
 }
 
 
+static bool isWorkingSetOperand(VMOperand const& operand)
+{
+    return operand.sectionId == kSlangByteCodeSectionWorkingSet;
+}
+
+static bool isScalar32BitArithmetic(VMInstHeader* inst)
+{
+    ArithmeticExtCode arithExtCode;
+    memcpy(&arithExtCode, &inst->opcodeExtension, sizeof(arithExtCode));
+    return arithExtCode.vectorSize <= 1 && arithExtCode.scalarBitWidth == 2;
+}
+
+// Scalar arithmetic with all operands in the working set is the most common kind of
+// instruction, so it gets handlers that compute the operand addresses from the working set
+// directly, rather than going through the section pointer of each operand.
+//
+template<typename ScalarFunc, typename TR, typename T1, typename T2>
+struct WorkingSetScalarFunc
+{
+    static void run(IByteCodeRunner* inCtx, VMExecInstHeader* inst, void*)
+    {
+        auto workingSet = (uint8_t*)convert(inCtx)->m_currentWorkingSet;
+        ScalarFunc::template run<TR, T1, T2>(
+            (TR*)(workingSet + inst->getOperand(0).offset),
+            (T1*)(workingSet + inst->getOperand(1).offset),
+            (T2*)(workingSet + inst->getOperand(2).offset));
+    }
+};
+
+template<typename ScalarFunc, typename TR, typename T1, typename T2>
+VMExtFunction getWorkingSetScalarHandler(VMInstHeader* inst)
+{
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        if (!isWorkingSetOperand(inst->getOperand(i)))
+            return nullptr;
+    }
+    return WorkingSetScalarFunc<ScalarFunc, TR, T1, T2>::run;
+}
+
+/// Get a handler for scalar 32-bit arithmetic on working set operands, or null
+/// if `inst` isn't such an instruction.
+template<typename ScalarFunc, bool isCompare>
+VMExtFunction getWorkingSetScalarArithmeticHandler(VMInstHeader* inst)
+{
+    if (inst->operandCount != 3 || !isScalar32BitArithmetic(inst))
+        return nullptr;
+
+    ArithmeticExtCode arithExtCode;
+    memcpy(&arithExtCode, &inst->opcodeExtension, sizeof(arithExtCode));
+    switch (arithExtCode.scalarType)
+    {
+    case kSlangByteCodeScalarTypeSignedInt:
+        return getWorkingSetScalarHandler<
+            ScalarFunc,
+            std::conditional_t<isCompare, uint32_t, int32_t>,
+            int32_t,
+            int32_t>(inst);
+    case kSlangByteCodeScalarTypeUnsignedInt:
+        return getWorkingSetScalarHandler<ScalarFunc, uint32_t, uint32_t, uint32_t>(inst);
+    case kSlangByteCodeScalarTypeFloat:
+        return getWorkingSetScalarHandler<
+            ScalarFunc,
+            std::conditional_t<isCompare, uint32_t, float>,
+            float,
+            float>(inst);
+    }
+    return nullptr;
+}
+
+template<typename ScalarFunc, bool isCompare>
+VMExtFunction binaryInstHandler(VMInstHeader* inst)
+{
+    if (auto handler = getWorkingSetScalarArithmeticHandler<ScalarFunc, isCompare>(inst))
+        return handler;
+    if constexpr (isCompare)
+        return binaryArithmeticCompareInstHandler<ScalarFunc>(inst->opcodeExtension);
+    else
+        return binaryArithmeticInstHandler<ScalarFunc>(inst->opcodeExtension);
+}
+
 VMExtFunction mapInstToFunction(
     VMInstHeader* instHeader,
     VMModuleView* module,
@@ -979,11 +1062,11 @@ VMExtFunction mapInstToFunction(
     case VMOp::Nop:
         return nopHandler;
     case VMOp::Add:
-        return binaryArithmeticInstHandler<AddScalarFunc>(instHeader->opcodeExtension);
+        return binaryInstHandler<AddScalarFunc, false>(instHeader);
     case VMOp::Sub:
-        return binaryArithmeticInstHandler<SubScalarFunc>(instHeader->opcodeExtension);
+        return binaryInstHandler<SubScalarFunc, false>(instHeader);
     case VMOp::Mul:
-        return binaryArithmeticInstHandler<MulScalarFunc>(instHeader->opcodeExtension);
+        return binaryInstHandler<MulScalarFunc, false>(instHeader);
     case VMOp::Div:
         return binaryArithmeticInstHandler<DivScalarFunc>(instHeader->opcodeExtension);
     case VMOp::Rem:
@@ -1003,17 +1086,17 @@ VMExtFunction mapInstToFunction(
     case VMOp::Shr:
         return binaryArithmeticIntInstHandler<ShrScalarFunc>(instHeader->opcodeExtension);
     case VMOp::Less:
-        return binaryArithmeticCompareInstHandler<LessScalarFunc>(instHeader->opcodeExtension);
+        return binaryInstHandler<LessScalarFunc, true>(instHeader);
     case VMOp::Leq:
-        return binaryArithmeticCompareInstHandler<LeqScalarFunc>(instHeader->opcodeExtension);
+        return binaryInstHandler<LeqScalarFunc, true>(instHeader);
     case VMOp::Greater:
-        return binaryArithmeticCompareInstHandler<GreaterScalarFunc>(instHeader->opcodeExtension);
+        return binaryInstHandler<GreaterScalarFunc, true>(instHeader);
     case VMOp::Geq:
-        return binaryArithmeticCompareInstHandler<GeqScalarFunc>(instHeader->opcodeExtension);
+        return binaryInstHandler<GeqScalarFunc, true>(instHeader);
     case VMOp::Equal:
-        return binaryArithmeticCompareInstHandler<EqualScalarFunc>(instHeader->opcodeExtension);
+        return binaryInstHandler<EqualScalarFunc, true>(instHeader);
     case VMOp::Neq:
-        return binaryArithmeticCompareInstHandler<NeqScalarFunc>(instHeader->opcodeExtension);
+        return binaryInstHandler<NeqScalarFunc, true>(instHeader);
     case VMOp::Neg:
         return negInstHandler<NegScalarFunc>(instHeader->opcodeExtension);
     case VMOp::Not:
@@ -1063,4 +1146,173 @@ VMExtFunction mapInstToFunction(
     return VMExtFunction();
 }
 
+//
+// Superinstructions
+//
+// A superinstruction executes a common sequence of instructions with a single handler,
+// which saves the dispatch of all but the first instruction, and lets the compiler
+// optimize across them.
+//
+// The handler of the first instruction of the sequence is replaced, but the instructions
+// themselves are left unchanged, so that jumps into the middle of the sequence still work.
+// A superinstruction has the exact same effect as running the instructions one by one,
+// including writing any intermediate results to the working set.
+//
+
+// Compare, followed by a conditional jump (typically on the result of the compare).
+template<typename ScalarFunc, typename T>
+struct CompareJumpIfSuperInst
+{
+    static void run(IByteCodeRunner* inCtx, VMExecInstHeader* inst, void*)
+    {
+        auto ctx = convert(inCtx);
+        ScalarFunc::template run<uint32_t, T, T>(
+            (uint32_t*)inst->getOperand(0).getPtr(),
+            (T*)inst->getOperand(1).getPtr(),
+            (T*)inst->getOperand(2).getPtr());
+
+        auto jumpIfInst = inst->getNextInst();
+        auto cond = *(uint32_t*)jumpIfInst->getOperand(0).getPtr();
+        ctx->m_currentInst = (VMExecInstHeader*)jumpIfInst->getOperand(cond ? 1 : 2).getPtr();
+    }
+};
+
+// Load, arithmetic, and store (typically of the result of the arithmetic, to the same address).
+template<typename ScalarFunc, typename T>
+struct LoadOpStoreSuperInst
+{
+    static void run(IByteCodeRunner* inCtx, VMExecInstHeader* inst, void*)
+    {
+        auto ctx = convert(inCtx);
+        *(T*)inst->getOperand(0).getPtr() = **(T**)inst->getOperand(1).getPtr();
+
+        auto opInst = inst->getNextInst();
+        auto result = (T*)opInst->getOperand(0).getPtr();
+        ScalarFunc::template run<T, T, T>(
+            result,
+            (T*)opInst->getOperand(1).getPtr(),
+            (T*)opInst->getOperand(2).getPtr());
+
+        auto storeInst = opInst->getNextInst();
+        **(T**)storeInst->getOperand(0).getPtr() = *(T*)storeInst->getOperand(1).getPtr();
+        ctx->m_currentInst = storeInst->getNextInst();
+    }
+};
+
+// Copy followed by a jump, which is how branches pass arguments to the parameters of
+// their target block.
+template<typename T>
+struct CopyJumpSuperInst
+{
+    static void run(IByteCodeRunner* inCtx, VMExecInstHeader* inst, void*)
+    {
+        auto ctx = convert(inCtx);
+        *(T*)inst->getOperand(0).getPtr() = *(T*)inst->getOperand(1).getPtr();
+
+        auto jumpInst = inst->getNextInst();
+        ctx->m_currentInst = (VMExecInstHeader*)jumpInst->getOperand(0).getPtr();
+    }
+};
+
+template<template<typename, typename> class SuperInst, typename ScalarFunc>
+VMExtFunction getScalar32BitSuperInstHandler(VMInstHeader* inst)
+{
+    if (inst->operandCount != 3 || !isScalar32BitArithmetic(inst))
+        return nullptr;
+
+    ArithmeticExtCode arithExtCode;
+    memcpy(&arithExtCode, &inst->opcodeExtension, sizeof(arithExtCode));
+    switch (arithExtCode.scalarType)
+    {
+    case kSlangByteCodeScalarTypeSignedInt:
+        return SuperInst<ScalarFunc, int32_t>::run;
+    case kSlangByteCodeScalarTypeUnsignedInt:
+        return SuperInst<ScalarFunc, uint32_t>::run;
+    case kSlangByteCodeScalarTypeFloat:
+        return SuperInst<ScalarFunc, float>::run;
+    }
+    return nullptr;
+}
+
+static VMExtFunction getCompareJumpIfSuperInstHandler(VMInstHeader* compareInst)
+{
+    switch (compareInst->opcode)
+    {
+    case VMOp::Less:
+        return getScalar32BitSuperInstHandler<CompareJumpIfSuperInst, LessScalarFunc>(compareInst);
+    case VMOp::Leq:
+        return getScalar32BitSuperInstHandler<CompareJumpIfSuperInst, LeqScalarFunc>(compareInst);
+    case VMOp::Greater:
+        return getScalar32BitSuperInstHandler<CompareJumpIfSuperInst, GreaterScalarFunc>(
+            compareInst);
+    case VMOp::Geq:
+        return getScalar32BitSuperInstHandler<CompareJumpIfSuperInst, GeqScalarFunc>(compareInst);
+    case VMOp::Equal:
+        return getScalar32BitSuperInstHandler<CompareJumpIfSuperInst, EqualScalarFunc>(
+            compareInst);
+    case VMOp::Neq:
+        return getScalar32BitSuperInstHandler<CompareJumpIfSuperInst, NeqScalarFunc>(compareInst);
+    default:
+        return nullptr;
+    }
+}
+
+static VMExtFunction getLoadOpStoreSuperInstHandler(VMInstHeader* opInst)
+{
+    switch (opInst->opcode)
+    {
+    case VMOp::Add:
+        return getScalar32BitSuperInstHandler<LoadOpStoreSuperInst, AddScalarFunc>(opInst);
+    case VMOp::Sub:
+        return getScalar32BitSuperInstHandler<LoadOpStoreSuperInst, SubScalarFunc>(opInst);
+    case VMOp::Mul:
+        return getScalar32BitSuperInstHandler<LoadOpStoreSuperInst, MulScalarFunc>(opInst);
+    default:
+        return nullptr;
+    }
+}
+
+VMExtFunction mapInstSequenceToSuperInstFunction(ArrayView<VMInstHeader*> insts)
+{
+    if (insts.getCount() < 2)
+        return nullptr;
+
+    auto first = insts[0];
+    auto second = insts[1];
+    switch (first->opcode)
+    {
+    case VMOp::Less:
+    case VMOp::Leq:
+    case VMOp::Greater:
+    case VMOp::Geq:
+    case VMOp::Equal:
+    case VMOp::Neq:
+        if (second->opcode == VMOp::JumpIf)
+            return getCompareJumpIfSuperInstHandler(first);
+        break;
+    case VMOp::Copy:
+        if (second->opcode == VMOp::Jump)
+        {
+            switch (first->opcodeExtension)
+            {
+            case 4:
+                return CopyJumpSuperInst<uint32_t>::run;
+            case 8:
+                return CopyJumpSuperInst<uint64_t>::run;
+            }
+        }
+        break;
+    case VMOp::Load:
+        // The operation must have the same size as the load and store, which is 4 bytes
+        // for all of the scalar 32-bit arithmetic we have superinstructions for.
+        if (insts.getCount() >= 3 && first->opcodeExtension == 4 &&
+            insts[2]->opcode == VMOp::Store && insts[2]->opcodeExtension == 4)
+            return getLoadOpStoreSuperInstHandler(second);
+        break;
+    default:
+        break;
+    }
+    return nullptr;
+}
+
 } // namespace Slang
@@ -11,6 +11,16 @@ slang::VMExtFunction mapInstToFunction(
     VMModuleView* module,
     Dictionary<String, slang::VMExtFunction>& extInstHandlers);
 
+/// The maximum number of instructions executed by a single superinstruction.
+static const Index kMaxSuperInstLength = 3;
+
+/// Get a handler that executes the sequence of instructions starting at `insts[0]` as a
+/// single "superinstruction", or null if there isn't one for the sequence.
+///
+/// The handler replaces the handler of `insts[0]`, and moves execution past the
+/// instructions it executes.
+slang::VMExtFunction mapInstSequenceToSuperInstFunction(ArrayView<VMInstHeader*> insts);
+
 } // namespace Slang
 
 #endif
@@ -15,8 +15,9 @@ static_assert(sizeof(VMInstHeader) == sizeof(VMExecInstHeader));
 
 ISlangUnknown* ByteCodeInterpreter::getInterface(const Guid& guid)
 {
-    if (guid == ISlangUnknown::getTypeGuid() || guid == IByteCodeRunner::getTypeGuid())
-        return static_cast<IByteCodeRunner*>(this);
+    if (guid == ISlangUnknown::getTypeGuid() || guid == IByteCodeRunner::getTypeGuid() ||
+        guid == IByteCodeBatchRunner::getTypeGuid())
+        return static_cast<IByteCodeBatchRunner*>(this);
 
     return nullptr;
 }
@@ -86,6 +87,28 @@ SlangResult ByteCodeInterpreter::prepareModuleForExecution()
                 }
             }
         }
+
+        if (m_enableSuperInstructions)
+        {
+            // The executable instructions no longer have their opcodes, so we match
+            // sequences against the original instructions, which are at the same offsets
+            // in the module code.
+            List<VMInstHeader*> insts;
+            List<VMExecInstHeader*> execInsts;
+            for (auto inst : func)
+                insts.add(inst);
+            for (auto execInst : exeFunc)
+                execInsts.add(execInst);
+            SLANG_ASSERT(insts.getCount() == execInsts.getCount());
+
+            for (Index j = 0; j < insts.getCount(); j++)
+            {
+                auto sequence =
+                    insts.getArrayView(j, Math::Min(insts.getCount() - j, kMaxSuperInstLength));
+                if (auto handler = mapInstSequenceToSuperInstFunction(sequence))
+                    execInsts[j]->functionPtr = handler;
+            }
+        }
     }
 
     return SLANG_OK;
@@ -98,6 +121,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ByteCodeInterpreter::loadModule(IBlob* mo
     m_currentWorkingSet = m_workingSetBuffer.getBuffer();
 
     m_errorBuilder.clear();
+    m_batchWorkers.clear();
     m_code.addRange((uint8_t*)(moduleBlob->getBufferPointer()), moduleBlob->getBufferSize());
     SLANG_RETURN_ON_FAIL(
         initVMModule(m_code.getBuffer(), (uint32_t)moduleBlob->getBufferSize(), &m_moduleView));
@@ -149,6 +173,7 @@ ByteCodeInterpreter::selectFunctionByIndex(uint32_t functionIndex)
         return SLANG_FAIL;
     }
     auto func = m_moduleView.getFunction(functionIndex);
+    m_currentFunctionIndex = (int)functionIndex;
     m_currentFuncCode = m_functions[functionIndex].m_codeBuffer.getBuffer();
     m_currentInst = reinterpret_cast<VMExecInstHeader*>(m_currentFuncCode);
     m_workingSetBuffer.setCount(func.header->workingSetSizeInBytes / sizeof(uint64_t));
@@ -202,9 +227,121 @@ ByteCodeInterpreter::setPrintCallback(slang::VMPrintFunc callback, void* userDat
 {
     m_printCallback = callback;
     m_printCallbackUserData = userData;
+    m_batchWorkers.clear();
+    return SLANG_OK;
+}
+
+SlangResult ByteCodeInterpreter::_createBatchWorkers(Count workerCount)
+{
+    while (m_batchWorkers.getCount() < workerCount)
+    {
+        RefPtr<ByteCodeInterpreter> worker = new ByteCodeInterpreter();
+        worker->m_enableSuperInstructions = m_enableSuperInstructions;
+        worker->m_extInstHandlers = m_extInstHandlers;
+        worker->m_extInstHandlerUserData = m_extInstHandlerUserData;
+        worker->m_printCallback = m_printCallback;
+        worker->m_printCallbackUserData = m_printCallbackUserData;
+
+        auto codeBlob = UnownedRawBlob::create(m_code.getBuffer(), m_code.getCount());
+        SLANG_RETURN_ON_FAIL(worker->loadModule(codeBlob));
+        m_batchWorkers.add(worker);
+    }
     return SLANG_OK;
 }
 
+SlangResult ByteCodeInterpreter::_executeInvocations(
+    const ByteCodeBatchDesc& desc,
+    uint32_t beginInvocation,
+    uint32_t endInvocation)
+{
+    SLANG_RETURN_ON_FAIL(selectFunctionByIndex((uint32_t)m_currentFunctionIndex));
+    for (uint32_t i = beginInvocation; i < endInvocation; i++)
+    {
+        // Restart the function, as `selectFunctionByIndex` would, without resizing the
+        // working set again.
+        m_currentInst = reinterpret_cast<VMExecInstHeader*>(m_currentFuncCode);
+        m_currentWorkingSet = m_workingSetBuffer.getBuffer();
+        auto arguments = (uint8_t*)desc.argumentData + i * desc.argumentStride;
+        SLANG_RETURN_ON_FAIL(execute(arguments, desc.argumentSize));
+        if (desc.returnValueData)
+        {
+            memcpy(
+                (uint8_t*)desc.returnValueData + i * desc.returnValueStride,
+                m_returnRegister.getBuffer(),
+                m_returnValSize);
+        }
+    }
+    return SLANG_OK;
+}
+
+SLANG_NO_THROW SlangResult SLANG_MCALL
+ByteCodeInterpreter::executeBatch(const ByteCodeBatchDesc* inDesc)
+{
+    ByteCodeBatchDesc desc;
+    memcpy(&desc, inDesc, Math::Min(sizeof(desc), inDesc->structSize));
+    desc.structSize = sizeof(desc);
+
+    if (m_currentFunctionIndex < 0)
+    {
+        reportError("No function selected for execution");
+        return SLANG_FAIL;
+    }
+    if (desc.invocationCount == 0)
+        return SLANG_OK;
+
+    auto funcHeader = m_functions[m_currentFunctionIndex].m_header;
+    if (desc.returnValueData && desc.returnValueStride < funcHeader->returnValueSizeInBytes)
+    {
+        reportError("Return value stride is smaller than the return value size.");
+        return SLANG_FAIL;
+    }
+
+    Count threadCount =
+        desc.threadCount ? Count(desc.threadCount) : ThreadPool::getHardwareThreadCount();
+    threadCount = Math::Min(threadCount, Count(desc.invocationCount));
+    if (threadCount <= 1)
+        return _executeInvocations(desc, 0, desc.invocationCount);
+
+    SLANG_RETURN_ON_FAIL(_createBatchWorkers(threadCount - 1));
+    if (!m_batchThreadPool || m_batchThreadPool->getThreadCount() != threadCount)
+        m_batchThreadPool = new ThreadPool(threadCount);
+
+    // Each task runs a contiguous range of invocations on its own interpreter, with the
+    // first task using this interpreter.
+    List<SlangResult> results;
+    results.setCount(threadCount);
+    const uint32_t invocationsPerTask = uint32_t(
+        (desc.invocationCount + uint32_t(threadCount) - 1) / uint32_t(threadCount));
+    m_batchThreadPool->forEach(
+        threadCount,
+        [&](Index taskIndex)
+        {
+            ByteCodeInterpreter* interpreter =
+                taskIndex == 0 ? this : m_batchWorkers[taskIndex - 1].Ptr();
+            if (taskIndex != 0)
+                interpreter->m_currentFunctionIndex = m_currentFunctionIndex;
+
+            const uint32_t begin =
+                Math::Min(uint32_t(taskIndex) * invocationsPerTask, desc.invocationCount);
+            const uint32_t end = Math::Min(begin + invocationsPerTask, desc.invocationCount);
+            results[taskIndex] = interpreter->_executeInvocations(desc, begin, end);
+        });
+
+    SlangResult result = SLANG_OK;
+    for (Index i = 1; i < threadCount; i++)
+    {
+        auto& workerErrors = m_batchWorkers[i - 1]->m_errorBuilder;
+        m_errorBuilder.append(workerErrors);
+        workerErrors.clear();
+    }
+    for (auto taskResult : results)
+    {
+        if (SLANG_FAILED(taskResult))
+            result = taskResult;
+    }
+    return result;
+}
+
 void ByteCodeInterpreter::defaultPrintCallback(const char* str, void* userData)
 {
     SLANG_UNUSED(userData);
@@ -233,8 +370,10 @@ SLANG_EXTERN_C SLANG_API SlangResult slang_createByteCodeRunner(
     const slang::ByteCodeRunnerDesc* desc,
     slang::IByteCodeRunner** outByteCodeRunner)
 {
-    SLANG_UNUSED(desc);
     Slang::RefPtr<Slang::ByteCodeInterpreter> runner = new Slang::ByteCodeInterpreter();
+    if (desc && desc->structSize >= offsetof(slang::ByteCodeRunnerDesc, enableSuperInstructions) +
+                                        sizeof(desc->enableSuperInstructions))
+        runner->m_enableSuperInstructions = desc->enableSuperInstructions;
     *outByteCodeRunner = static_cast<slang::IByteCodeRunner*>(runner.detach());
     return SLANG_OK;
 }
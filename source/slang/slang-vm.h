@@ -2,6 +2,7 @@
 #define SLANG_VM_H
 
 #include "core/slang-string-util.h"
+#include "core/slang-thread-pool.h"
 #include "slang-vm-bytecode.h"
 
 using namespace slang;
@@ -39,7 +40,7 @@ struct StackFrame
     size_t m_workingSetOffset = 0;
 };
 
-class ByteCodeInterpreter : public RefObject, public IByteCodeRunner
+class ByteCodeInterpreter : public RefObject, public IByteCodeBatchRunner
 {
 public:
     SLANG_REF_OBJECT_IUNKNOWN_ALL
@@ -61,6 +62,26 @@ public:
 
     size_t m_returnValSize = 0;
 
+    /// Whether common instruction sequences are executed by superinstructions.
+    bool m_enableSuperInstructions = true;
+
+    /// The index of the selected function, or -1 if none is selected.
+    int m_currentFunctionIndex = -1;
+
+    /// Interpreters for running parts of a batch on other threads.
+    ///
+    /// The executable code refers to the state of the interpreter that prepared it, so
+    /// each thread needs its own interpreter. They are created on demand and kept until
+    /// the module or anything that affects execution changes.
+    List<RefPtr<ByteCodeInterpreter>> m_batchWorkers;
+    RefPtr<ThreadPool> m_batchThreadPool;
+
+    SlangResult _createBatchWorkers(Count workerCount);
+    SlangResult _executeInvocations(
+        const ByteCodeBatchDesc& desc,
+        uint32_t beginInvocation,
+        uint32_t endInvocation);
+
     void pushFrame(uint32_t size)
     {
         StackFrame frame;
@@ -123,16 +144,21 @@ public:
     virtual SLANG_NO_THROW void SLANG_MCALL setExtInstHandlerUserData(void* userData) override
     {
         m_extInstHandlerUserData = userData;
+        m_batchWorkers.clear();
     }
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL
     registerExtCall(const char* name, VMExtFunction functionPtr) override
     {
         m_extInstHandlers[name] = functionPtr;
+        m_batchWorkers.clear();
         return SLANG_OK;
     }
 
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL
     setPrintCallback(VMPrintFunc callback, void* userData) override;
+
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+    executeBatch(const ByteCodeBatchDesc* desc) override;
 };
 
 } // namespace Slang
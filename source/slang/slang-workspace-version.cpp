@@ -1,5 +1,6 @@
 #include "slang-workspace-version.h"
 
+#include "../compiler-core/slang-include-system.h"
 #include "../compiler-core/slang-lexer.h"
 #include "../core/slang-file-system.h"
 #include "../core/slang-io.h"
@@ -35,7 +36,9 @@ DocumentVersion* Workspace::openDoc(String path, String text)
     doc->setText(text.getUnownedSlice());
     doc->setPath(path);
     openedDocuments[path] = doc;
-    workspaceSearchPaths.add(Path::getParentDirectory(path));
+    // Opening a document can add a search path, which can change how imports resolve.
+    if (workspaceSearchPaths.add(Path::getParentDirectory(path)) || !searchInWorkspace)
+        resetSharedLinkages();
     invalidate();
     return doc.Ptr();
 }
@@ -73,6 +76,8 @@ void Workspace::changeDoc(DocumentVersion* doc, const String& newText)
 void Workspace::closeDoc(const String& path)
 {
     openedDocuments.remove(path);
+    if (!searchInWorkspace)
+        resetSharedLinkages();
     invalidate();
 }
 
@@ -113,6 +118,7 @@ bool Workspace::updatePredefinedMacros(List<String> macros)
     if (changed)
     {
         predefinedMacros = _Move(newDefs);
+        resetSharedLinkages();
         invalidate();
     }
     return changed;
@@ -137,6 +143,7 @@ bool Workspace::updateSearchPaths(List<String> paths)
     if (changed)
     {
         additionalSearchPaths = _Move(paths);
+        resetSharedLinkages();
         invalidate();
     }
     return changed;
@@ -148,6 +155,7 @@ bool Workspace::updateSearchInWorkspace(bool value)
     searchInWorkspace = value;
     if (changed)
     {
+        resetSharedLinkages();
         invalidate();
     }
     return changed;
@@ -192,6 +200,7 @@ void Workspace::init(List<URI> rootDirURI, slang::IGlobalSession* globalSession)
         workspaceSearchPaths = _Move(context.paths);
     }
     slangGlobalSession = globalSession;
+    resetSharedLinkages();
 }
 
 void Workspace::invalidate()
@@ -199,6 +208,12 @@ void Workspace::invalidate()
     currentVersion = nullptr;
 }
 
+void Workspace::resetSharedLinkages()
+{
+    sharedLinkage.reset();
+    sharedCompletionLinkage.reset();
+}
+
 void WorkspaceVersion::parseDiagnostics(String compilerOutput)
 {
     List<UnownedStringSlice> lines;
@@ -306,10 +321,8 @@ void WorkspaceVersion::parseDiagnostics(String compilerOutput)
     }
 }
 
-RefPtr<WorkspaceVersion> Workspace::createWorkspaceVersion()
+RefPtr<Linkage> Workspace::createLinkage()
 {
-    RefPtr<WorkspaceVersion> version = new WorkspaceVersion();
-    version->workspace = this;
     slang::SessionDesc desc = {};
     desc.fileSystem = this;
     desc.targetCount = 1;
@@ -350,11 +363,242 @@ RefPtr<WorkspaceVersion> Workspace::createWorkspaceVersion()
 
     ComPtr<slang::ISession> session;
     slangGlobalSession->createSession(desc, session.writeRef());
-    version->linkage = static_cast<Linkage*>(session.get());
-    version->linkage->contentAssistInfo.checkingMode = ContentAssistCheckingMode::General;
+    return RefPtr<Linkage>(static_cast<Linkage*>(session.get()));
+}
+
+// The number of versions after which a shared linkage is replaced by a new one. Every
+// version loads at least its primary modules again, and the memory of the old modules is
+// only released with the linkage.
+static const Index kMaxSharedLinkageVersionCount = 64;
+
+static bool _hasFailedImports(Linkage* linkage)
+{
+    for (const auto& [name, module] : linkage->mapNameToLoadedModules)
+    {
+        if (!module)
+            return true;
+    }
+    return false;
+}
+
+RefPtr<WorkspaceVersion> Workspace::createWorkspaceVersion(
+    SharedWorkspaceLinkage& shared,
+    ContentAssistCheckingMode checkingMode)
+{
+    // A failed import isn't tracked as a dependency of the module that tried it, so we
+    // can't tell when it would succeed, and start over with a new linkage instead.
+    if (!shared.linkage || shared.versionCount >= kMaxSharedLinkageVersionCount ||
+        _hasFailedImports(shared.linkage))
+    {
+        shared.reset();
+        shared.linkage = createLinkage();
+    }
+    else
+    {
+        evictOutOfDateModules(shared);
+    }
+    shared.versionCount++;
+
+    RefPtr<WorkspaceVersion> version = new WorkspaceVersion();
+    version->workspace = this;
+    version->linkage = shared.linkage;
+    version->sharedLinkage = &shared;
+    if (version->linkage->m_optionSet.getBoolOption(CompilerOptionName::EnableEffectAnnotations))
+        version->flavor = WorkspaceFlavor::VFX;
+
+    auto& contentAssistInfo = version->linkage->contentAssistInfo;
+    contentAssistInfo.checkingMode = checkingMode;
+    contentAssistInfo.completionSuggestions.clear();
     return version;
 }
 
+bool Workspace::isSourceFileUpToDate(SourceFile* sourceFile)
+{
+    // Only files that were loaded from a path can change.
+    auto& pathInfo = sourceFile->getPathInfo();
+    if (pathInfo.type != PathInfo::Type::Normal && pathInfo.type != PathInfo::Type::FoundPath)
+        return true;
+
+    String canonicalPath;
+    if (SLANG_FAILED(Path::getCanonical(pathInfo.foundPath, canonicalPath)))
+        return false;
+
+    // The contents are compared by digest. The digests of source files and documents are
+    // computed once, rather than every time a version is created.
+    RefPtr<DocumentVersion> doc;
+    if (openedDocuments.tryGetValue(canonicalPath, doc))
+        return doc->getDigest() == sourceFile->getDigest();
+
+    // A file that has the same stat as when it was last read for this check has the same
+    // contents, so only files that have been modified since are read again.
+    auto fileStat = IncludeSystem::getOSFileStat(canonicalPath);
+    if (auto checkedStat = checkedFileStats.tryGetValue(canonicalPath))
+    {
+        if (fileStat.modificationTime != 0 &&
+            fileStat.modificationTime == checkedStat->stat.modificationTime &&
+            fileStat.size == checkedStat->stat.size)
+            return checkedStat->digest == sourceFile->getDigest();
+    }
+
+    ComPtr<ISlangBlob> blob;
+    if (SLANG_FAILED(OSFileSystem::getExtSingleton()->loadFile(
+            canonicalPath.getBuffer(),
+            blob.writeRef())))
+        return false;
+    DigestBuilder<SHA1> builder;
+    builder.append(
+        UnownedStringSlice((const char*)blob->getBufferPointer(), blob->getBufferSize()));
+    CheckedFileStat checkedStat;
+    checkedStat.stat = fileStat;
+    checkedStat.digest = builder.finalize();
+    checkedFileStats[canonicalPath] = checkedStat;
+    return checkedStat.digest == sourceFile->getDigest();
+}
+
+template<typename T, typename IsEvictedLoc>
+static void _removeEvictedInfos(List<T>& infos, const IsEvictedLoc& isEvictedLoc)
+{
+    Index count = 0;
+    for (Index i = 0; i < infos.getCount(); i++)
+    {
+        if (isEvictedLoc(infos[i].loc))
+            continue;
+        if (count != i)
+            infos[count] = _Move(infos[i]);
+        count++;
+    }
+    infos.setCount(count);
+}
+
+void Workspace::evictOutOfDateModules(SharedWorkspaceLinkage& shared)
+{
+    auto linkage = shared.linkage.Ptr();
+    evictedModuleNames.clear();
+
+    // Primary modules are always evicted, and so is any module that depends on a
+    // file that has changed, or on another evicted module.
+    HashSet<Module*> evictedModules;
+    for (auto& module : shared.primaryModules)
+        evictedModules.add(module.Ptr());
+
+    Dictionary<SourceFile*, bool> upToDateFiles;
+    HashSet<SourceFile*> outOfDateFiles;
+    for (auto& module : linkage->loadedModulesList)
+    {
+        for (auto sourceFile : module->getFileDependencies())
+        {
+            bool upToDate;
+            if (!upToDateFiles.tryGetValue(sourceFile, upToDate))
+            {
+                upToDate = isSourceFileUpToDate(sourceFile);
+                upToDateFiles[sourceFile] = upToDate;
+                if (!upToDate)
+                    outOfDateFiles.add(sourceFile);
+            }
+            if (!upToDate)
+                evictedModules.add(module.Ptr());
+        }
+    }
+    for (bool changed = true; changed;)
+    {
+        changed = false;
+        for (auto& module : linkage->loadedModulesList)
+        {
+            if (evictedModules.contains(module.Ptr()))
+                continue;
+            for (auto dependency : module->getModuleDependencies())
+            {
+                if (evictedModules.contains(dependency))
+                {
+                    evictedModules.add(module.Ptr());
+                    changed = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    // A changed file can also be cached by the source manager without being a dependency
+    // of any loaded module, for example if the module loading it failed.
+    auto sourceManager = linkage->getSourceManager();
+    for (auto sourceFile : sourceManager->getSourceFiles())
+    {
+        if (!upToDateFiles.containsKey(sourceFile) && !isSourceFileUpToDate(sourceFile))
+            outOfDateFiles.add(sourceFile);
+    }
+
+    // Make sure that changed files are read again, rather than found in a cache.
+    if (outOfDateFiles.getCount() != 0)
+    {
+        for (auto sourceFile : outOfDateFiles)
+            sourceManager->removeSourceFile(sourceFile);
+        linkage->getFileSystemExt()->clearCache();
+    }
+
+    if (evictedModules.getCount() == 0)
+        return;
+
+    // Remove the evicted modules from the linkage, so that they are loaded again when
+    // they are next imported.
+    List<RefPtr<LoadedModule>> remainingModules;
+    HashSet<SourceFile*> remainingFiles;
+    HashSet<SourceFile*> evictedFiles;
+    for (auto& module : linkage->loadedModulesList)
+    {
+        const bool isEvicted = evictedModules.contains(module.Ptr());
+        auto& files = isEvicted ? evictedFiles : remainingFiles;
+        for (auto sourceFile : module->getFileDependencies())
+            files.add(sourceFile);
+        if (!isEvicted)
+            remainingModules.add(module);
+        else if (!shared.primaryModules.contains(module))
+            evictedModuleNames.add(module->getName());
+    }
+    for (auto& module : shared.primaryModules)
+    {
+        for (auto sourceFile : module->getFileDependencies())
+            evictedFiles.add(sourceFile);
+    }
+    linkage->loadedModulesList = _Move(remainingModules);
+
+    List<String> evictedPaths;
+    for (const auto& [path, module] : linkage->mapPathToLoadedModule)
+    {
+        if (evictedModules.contains(module.Ptr()))
+            evictedPaths.add(path);
+    }
+    for (const auto& path : evictedPaths)
+        linkage->mapPathToLoadedModule.remove(path);
+
+    List<Name*> evictedNames;
+    for (const auto& [name, module] : linkage->mapNameToLoadedModules)
+    {
+        if (evictedModules.contains(module.Ptr()))
+            evictedNames.add(name);
+    }
+    for (auto name : evictedNames)
+        linkage->mapNameToLoadedModules.remove(name);
+
+    for (auto module : evictedModules)
+        shared.evictedModules.add(module);
+    shared.primaryModules.clear();
+
+    // Drop the preprocessor information of files that are no longer part of any loaded
+    // module. It is recorded again when the files are preprocessed again.
+    auto isEvictedLoc = [&](SourceLoc loc)
+    {
+        auto sourceView = sourceManager->findSourceViewRecursively(loc);
+        if (!sourceView)
+            return false;
+        auto sourceFile = sourceView->getSourceFile();
+        return evictedFiles.contains(sourceFile) && !remainingFiles.contains(sourceFile);
+    };
+    auto& preprocessorInfo = linkage->contentAssistInfo.preprocessorInfo;
+    _removeEvictedInfos(preprocessorInfo.macroDefinitions, isEvictedLoc);
+    _removeEvictedInfos(preprocessorInfo.macroInvocations, isEvictedLoc);
+    _removeEvictedInfos(preprocessorInfo.fileIncludes, isEvictedLoc);
+}
+
 SlangResult Workspace::loadFile(const char* path, ISlangBlob** outBlob)
 {
     String canonnicalPath;
@@ -370,14 +614,13 @@ SlangResult Workspace::loadFile(const char* path, ISlangBlob** outBlob)
 WorkspaceVersion* Workspace::getCurrentVersion()
 {
     if (!currentVersion)
-        currentVersion = createWorkspaceVersion();
+        currentVersion = createWorkspaceVersion(sharedLinkage, ContentAssistCheckingMode::General);
     return currentVersion.Ptr();
 }
 WorkspaceVersion* Workspace::createVersionForCompletion()
 {
-    currentCompletionVersion = createWorkspaceVersion();
-    currentCompletionVersion->linkage->contentAssistInfo.checkingMode =
-        ContentAssistCheckingMode::Completion;
+    currentCompletionVersion =
+        createWorkspaceVersion(sharedCompletionLinkage, ContentAssistCheckingMode::Completion);
     return currentCompletionVersion.Ptr();
 }
 
@@ -409,11 +652,23 @@ void* Workspace::castAs(const Guid& guid)
 void DocumentVersion::setText(const String& newText)
 {
     text = newText;
+    digest = SHA1::Digest();
     StringUtil::calcLines(text.getUnownedSlice(), lines);
     mapUTF16CharIndexToCodePointIndex.clear();
     mapCodePointIndexToUTF8ByteOffset.clear();
 }
 
+SHA1::Digest DocumentVersion::getDigest()
+{
+    if (digest == SHA1::Digest())
+    {
+        DigestBuilder<SHA1> builder;
+        builder.append(text.getUnownedSlice());
+        digest = builder.finalize();
+    }
+    return digest;
+}
+
 void DocumentVersion::ensureUTFBoundsAvailable()
 {
     for (auto slice : lines)
@@ -601,6 +856,39 @@ void WorkspaceVersion::ensureWorkspaceFlavor(UnownedStringSlice path)
     }
 }
 
+// Remove `module` from the lookups of `linkage`. Modules that imported it can still refer to
+// it, so it is kept alive by `shared`, or by the list of loaded modules of a linkage that is
+// no longer shared.
+static void _removeLoadedModule(
+    Linkage* linkage,
+    LoadedModule* module,
+    SharedWorkspaceLinkage* shared)
+{
+    if (shared && shared->linkage == linkage)
+    {
+        shared->evictedModules.add(module);
+        linkage->loadedModulesList.remove(module);
+    }
+
+    List<String> paths;
+    for (const auto& [path, loadedModule] : linkage->mapPathToLoadedModule)
+    {
+        if (loadedModule == module)
+            paths.add(path);
+    }
+    for (const auto& path : paths)
+        linkage->mapPathToLoadedModule.remove(path);
+
+    List<Name*> names;
+    for (const auto& [name, loadedModule] : linkage->mapNameToLoadedModules)
+    {
+        if (loadedModule == module)
+            names.add(name);
+    }
+    for (auto name : names)
+        linkage->mapNameToLoadedModules.remove(name);
+}
+
 Module* WorkspaceVersion::getOrLoadModule(String path)
 {
     Module* module;
@@ -628,6 +916,13 @@ Module* WorkspaceVersion::getOrLoadModule(String path)
     // trying to reuse the existing one through `findOrImportModule`, this will result in
     // redundant parsing and storage, but it saves us from the hassle of handling
     // incremental/lazy checking on a previously loaded module.
+    // Modules imported by the primary module are reused across versions as long as they
+    // are up to date, see `Workspace::evictOutOfDateModules`. Since the module at `path`
+    // may have been imported by an earlier version, we remove it from the linkage so that
+    // the fresh module can be registered, and so that it isn't found by a later import.
+    RefPtr<LoadedModule> staleModule;
+    if (linkage->mapPathToLoadedModule.tryGetValue(path, staleModule))
+        _removeLoadedModule(linkage, staleModule, sharedLinkage);
     auto parsedModule = linkage->loadModuleFromSource(
         moduleName.getBuffer(),
         path.getBuffer(),
@@ -636,6 +931,8 @@ Module* WorkspaceVersion::getOrLoadModule(String path)
     if (parsedModule)
     {
         modules[path] = static_cast<Module*>(parsedModule);
+        if (sharedLinkage && sharedLinkage->linkage == linkage)
+            sharedLinkage->primaryModules.add(static_cast<Module*>(parsedModule));
     }
     if (diagnosticBlob)
     {
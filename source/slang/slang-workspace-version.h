@@ -19,6 +19,7 @@ private:
     URI uri;
     String path;
     String text;
+    SHA1::Digest digest;
     List<UnownedStringSlice> lines;
     List<List<Index>> mapUTF16CharIndexToCodePointIndex;
     List<List<Index>> mapCodePointIndexToUTF8ByteOffset;
@@ -34,6 +35,9 @@ public:
     const String& getText() { return text; }
     void setText(const String& newText);
 
+    /// Get the digest of the text, which is computed on demand.
+    SHA1::Digest getDigest();
+
     void ensureUTFBoundsAvailable();
     ArrayView<Index> getUTF16Boundaries(Index line);
     ArrayView<Index> getUTF8Boundaries(Index line);
@@ -135,6 +139,29 @@ enum class WorkspaceFlavor
     VFX,
 };
 
+/// A linkage that is shared by successive workspace versions.
+///
+/// Modules imported by one version stay loaded in the linkage, and are reused by later
+/// versions as long as none of the files they depend on have changed, so that an edit
+/// doesn't require parsing and checking every imported module again.
+struct SharedWorkspaceLinkage
+{
+    RefPtr<Linkage> linkage;
+
+    /// The number of versions that have used `linkage`.
+    Index versionCount = 0;
+
+    /// Modules loaded as the primary module of a version. These are checked differently
+    /// from imported modules, so they are always loaded again by the next version.
+    List<RefPtr<Module>> primaryModules;
+
+    /// Modules that have been removed from `linkage` because they are out of date.
+    /// They are kept alive because other versions can still refer to them.
+    List<RefPtr<Module>> evictedModules;
+
+    void reset() { *this = SharedWorkspaceLinkage(); }
+};
+
 class WorkspaceVersion : public RefObject
 {
 private:
@@ -147,6 +174,7 @@ public:
     Workspace* workspace;
     WorkspaceFlavor flavor = WorkspaceFlavor::Standard;
     RefPtr<Linkage> linkage;
+    SharedWorkspaceLinkage* sharedLinkage = nullptr;
     Dictionary<String, DocumentDiagnostics> diagnostics;
     ASTMarkup* getOrCreateMarkupAST(ModuleDecl* module);
     Module* getOrLoadModule(String path);
@@ -164,7 +192,29 @@ class Workspace : public ComObject, public ISlangFileSystem
 private:
     RefPtr<WorkspaceVersion> currentVersion;
     RefPtr<WorkspaceVersion> currentCompletionVersion;
-    RefPtr<WorkspaceVersion> createWorkspaceVersion();
+    SharedWorkspaceLinkage sharedLinkage;
+    SharedWorkspaceLinkage sharedCompletionLinkage;
+
+    RefPtr<Linkage> createLinkage();
+    RefPtr<WorkspaceVersion> createWorkspaceVersion(
+        SharedWorkspaceLinkage& shared,
+        ContentAssistCheckingMode checkingMode);
+    bool isSourceFileUpToDate(SourceFile* sourceFile);
+    void evictOutOfDateModules(SharedWorkspaceLinkage& shared);
+
+    /// The stat and the digest of the contents of a file of the operating system, taken
+    /// when it was last read to check whether a source file is up to date.
+    struct CheckedFileStat
+    {
+        SourceFile::FileStat stat;
+        SHA1::Digest digest;
+    };
+    /// Keyed by canonical path. A file is only read again if its stat changes.
+    Dictionary<String, CheckedFileStat> checkedFileStats;
+
+    /// See `takeEvictedModuleNames`.
+    List<String> evictedModuleNames;
+    void resetSharedLinkages();
 
 public:
     List<String> rootDirectories;
@@ -193,6 +243,12 @@ public:
     WorkspaceVersion* getCurrentCompletionVersion() { return currentCompletionVersion.Ptr(); }
     WorkspaceVersion* createVersionForCompletion();
 
+    /// Get the names of the imported modules that were removed from a shared linkage when the
+    /// latest version was created, because they depend on a file or a module that has
+    /// changed, unless they have already been taken. They are loaded again when they are
+    /// next imported.
+    List<String> takeEvictedModuleNames() { return _Move(evictedModuleNames); }
+
 public:
     // Inherited via ISlangFileSystem
     SLANG_COM_OBJECT_IUNKNOWN_ALL
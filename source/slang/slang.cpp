@@ -404,9 +404,94 @@ const char* getBuiltinModuleNameStr(slang::BuiltinModuleName name)
     return result;
 }
 
-TypeCheckingCache* Session::getTypeCheckingCache()
+void Session::initTypeCheckingCache(TypeCheckingCache* cache)
 {
-    return static_cast<TypeCheckingCache*>(m_typeCheckingCache.get());
+    std::lock_guard<std::mutex> lock(m_typeCheckingCacheMutex);
+    cache->parent = static_cast<TypeCheckingCache*>(m_typeCheckingCache.get());
+    cache->version = ++m_typeCheckingCacheVersion;
+}
+
+bool Session::tryGetFileDependencyStat(
+    String const& uniqueIdentity,
+    SerialFileDependencyStat& outStat)
+{
+    std::lock_guard<std::mutex> lock(m_fileDependencyStatsMutex);
+    return m_fileDependencyStats.tryGetValue(uniqueIdentity, outStat);
+}
+
+void Session::setFileDependencyStat(
+    String const& uniqueIdentity,
+    SerialFileDependencyStat const& stat)
+{
+    // The key is a copy, as String reference counts are not atomic, and the dictionary is
+    // shared by linkages on different threads.
+    std::lock_guard<std::mutex> lock(m_fileDependencyStatsMutex);
+    m_fileDependencyStats[String(uniqueIdentity.getUnownedSlice())] = stat;
+}
+
+// The number of levels a frozen type checking cache can have before they are merged into one,
+// which bounds the number of dictionaries a lookup has to search.
+static const Index kMaxTypeCheckingCacheDepth = 8;
+
+void Session::publishTypeCheckingCache(TypeCheckingCache* cache)
+{
+    std::lock_guard<std::mutex> lock(m_typeCheckingCacheMutex);
+    auto sharedCache = static_cast<TypeCheckingCache*>(m_typeCheckingCache.get());
+
+    // Results the linkage found in the shared cache, but had to resolve again because they
+    // refer to another linkage, are not published.
+    //
+    // Only the decls of the overloads are published, as the candidates refer to the linkage,
+    // so that the shared cache holds no references to anything.
+    RefPtr<TypeCheckingCache> frozenCache = new TypeCheckingCache();
+    auto overloads = &TypeCheckingCache::resolvedOperatorOverloadCache;
+    const ResolvedOperatorOverload* overload = nullptr;
+    for (const auto& [key, value] : cache->resolvedOperatorOverloadCache)
+    {
+        if (!sharedCache || !sharedCache->findLevel(overloads, key, overload))
+        {
+            ResolvedOperatorOverload frozenOverload;
+            frozenOverload.decl = value.decl;
+            frozenCache->resolvedOperatorOverloadCache.add(key, frozenOverload);
+        }
+    }
+    auto conversionCosts = &TypeCheckingCache::conversionCostCache;
+    const ConversionCost* cost = nullptr;
+    for (const auto& [key, value] : cache->conversionCostCache)
+    {
+        if (!sharedCache || !sharedCache->findLevel(conversionCosts, key, cost))
+            frozenCache->conversionCostCache.add(key, value);
+    }
+
+    // The linkage is done with its cache, and the reference to the parent has to be released
+    // while holding the lock.
+    cache->parent = nullptr;
+
+    if (frozenCache->resolvedOperatorOverloadCache.getCount() == 0 &&
+        frozenCache->conversionCostCache.getCount() == 0)
+    {
+        return;
+    }
+
+    if (sharedCache && sharedCache->depth + 1 >= kMaxTypeCheckingCacheDepth)
+    {
+        // Merge all the levels into the new one. Nearer levels are added first, so their
+        // results take precedence.
+        for (const TypeCheckingCache* level = sharedCache; level; level = level->parent)
+        {
+            for (const auto& entry : level->resolvedOperatorOverloadCache)
+                frozenCache->resolvedOperatorOverloadCache.addIfNotExists(entry);
+            for (const auto& entry : level->conversionCostCache)
+                frozenCache->conversionCostCache.addIfNotExists(entry);
+        }
+    }
+    else if (sharedCache)
+    {
+        frozenCache->parent = sharedCache;
+        frozenCache->depth = sharedCache->depth + 1;
+    }
+
+    m_typeCheckingCache = frozenCache;
 }
 
 Session::BuiltinModuleInfo Session::getBuiltinModuleInfo(slang::BuiltinModuleName name)
@@ -532,6 +617,26 @@ SlangResult Session::loadBuiltinModule(
     slang::BuiltinModuleName moduleName,
     const void* moduleData,
     size_t sizeInBytes)
+{
+    // Make a file system to read it from
+    ComPtr<ISlangFileSystemExt> fileSystem;
+    SLANG_RETURN_ON_FAIL(loadArchiveFileSystem(moduleData, sizeInBytes, fileSystem));
+    return _loadBuiltinModule(moduleName, fileSystem);
+}
+
+SlangResult Session::loadBuiltinModuleBlob(
+    slang::BuiltinModuleName moduleName,
+    ISlangBlob* moduleBlob)
+{
+    // The file system references the contents of the blob, rather than a copy
+    ComPtr<ISlangFileSystemExt> fileSystem;
+    SLANG_RETURN_ON_FAIL(loadArchiveFileSystem(moduleBlob, fileSystem));
+    return _loadBuiltinModule(moduleName, fileSystem);
+}
+
+SlangResult Session::_loadBuiltinModule(
+    slang::BuiltinModuleName moduleName,
+    ISlangFileSystemExt* fileSystem)
 {
     SLANG_PROFILE;
 
@@ -546,10 +651,6 @@ SlangResult Session::loadBuiltinModule(
         return SLANG_FAIL;
     }
 
-    // Make a file system to read it from
-    ComPtr<ISlangFileSystemExt> fileSystem;
-    SLANG_RETURN_ON_FAIL(loadArchiveFileSystem(moduleData, sizeInBytes, fileSystem));
-
     // Let's try loading serialized modules and adding them
     Module* module = nullptr;
     SLANG_RETURN_ON_FAIL(_readBuiltinModule(
@@ -762,11 +863,32 @@ SlangResult Session::_readBuiltinModule(
     // After the AST module has been read in, we next look
     // to deserialize the IR module.
     //
-    RefPtr<IRModule> irModule;
-    SLANG_RETURN_ON_FAIL(readSerializedModuleIR(irChunk, this, sourceLocReader, irModule));
+    // The IR is only read once it is needed, which for most of the builtin
+    // modules is never, or only when linking a symbol they define.
+    //
+    RefPtr<SerializedIRModule> serializedIRModule;
+    SlangResult irResult = readSerializedModuleIROnDemand(
+        irChunk,
+        fileContents,
+        this,
+        sourceLocReader,
+        serializedIRModule);
+    if (SLANG_SUCCEEDED(irResult))
+    {
+        module->setSerializedIRModule(serializedIRModule);
+    }
+    else if (irResult == SLANG_E_NOT_AVAILABLE)
+    {
+        RefPtr<IRModule> irModule;
+        SLANG_RETURN_ON_FAIL(readSerializedModuleIR(irChunk, this, sourceLocReader, irModule));
 
-    irModule->setName(module->getNameObj());
-    module->setIRModule(irModule);
+        irModule->setName(module->getNameObj());
+        module->setIRModule(irModule);
+    }
+    else
+    {
+        return irResult;
+    }
 
     // Put in the loaded module map
     linkage->mapNameToLoadedModules.add(sessionNamePool->getName(moduleName), module);
@@ -786,6 +908,7 @@ SlangResult Session::_readBuiltinModule(
         subScope->nextSibling = scope->nextSibling;
         scope->nextSibling = subScope;
     }
+    linkage->invalidateCachedLookups();
 
     outModule = module.get();
 
@@ -874,13 +997,6 @@ Session::createSession(slang::SessionDesc const& inDesc, slang::ISession** outSe
         linkage->m_optionSet.set(CompilerOptionName::SkipSPIRVValidation, true);
     }
 
-    {
-        std::lock_guard<std::mutex> lock(m_typeCheckingCacheMutex);
-        if (m_typeCheckingCache)
-            linkage->m_typeCheckingCache =
-                new TypeCheckingCache(*static_cast<TypeCheckingCache*>(m_typeCheckingCache.get()));
-    }
-
     Int searchPathCount = desc.searchPathCount;
     for (Int ii = 0; ii < searchPathCount; ++ii)
     {
@@ -1401,18 +1517,20 @@ ISlangUnknown* Linkage::getInterface(const Guid& guid)
 
 Linkage::~Linkage()
 {
+    // Wait for any imports being preprocessed, as they use the linkage.
+    m_importThreadPool = nullptr;
+
     // Upstream type checking cache.
     if (m_typeCheckingCache)
     {
-        auto globalSession = getSessionImpl();
-        std::lock_guard<std::mutex> lock(globalSession->m_typeCheckingCacheMutex);
-        if (!globalSession->m_typeCheckingCache ||
-            globalSession->getTypeCheckingCache()->resolvedOperatorOverloadCache.getCount() <
-                getTypeCheckingCache()->resolvedOperatorOverloadCache.getCount())
+        auto cache = getTypeCheckingCache();
+        if (cache->hitCount || cache->parentHitCount || cache->missCount)
         {
-            globalSession->m_typeCheckingCache = m_typeCheckingCache;
-            getTypeCheckingCache()->version++;
+            SLANG_PROFILE_COUNTER(typeCheckingCacheHits, cache->hitCount);
+            SLANG_PROFILE_COUNTER(typeCheckingCacheParentHits, cache->parentHitCount);
+            SLANG_PROFILE_COUNTER(typeCheckingCacheMisses, cache->missCount);
         }
+        getSessionImpl()->publishTypeCheckingCache(cache);
         destroyTypeCheckingCache();
     }
 }
@@ -1433,7 +1551,11 @@ TypeCheckingCache* Linkage::getTypeCheckingCache()
 {
     if (!m_typeCheckingCache)
     {
-        m_typeCheckingCache = new TypeCheckingCache();
+        // The results of linkages that have been destroyed are looked up in the session's
+        // shared cache, rather than being copied into this one.
+        RefPtr<TypeCheckingCache> cache = new TypeCheckingCache();
+        getSessionImpl()->initTypeCheckingCache(cache);
+        m_typeCheckingCache = cache;
     }
     return static_cast<TypeCheckingCache*>(m_typeCheckingCache.get());
 }
@@ -1443,6 +1565,76 @@ void Linkage::destroyTypeCheckingCache()
     m_typeCheckingCache = nullptr;
 }
 
+PersistentCache* Linkage::getPersistentCache()
+{
+    // The cache is created lazily, because options can still be
+    // changed after the linkage has been created (e.g. when parsing
+    // command line options for an end-to-end compile request).
+    //
+    // Code generation tasks running in parallel can get here at the same time.
+    std::call_once(
+        m_persistentCacheInitialized,
+        [this]()
+        {
+            String cacheDirectory =
+                m_optionSet.getStringOption(CompilerOptionName::CompilationCacheDirectory);
+            if (cacheDirectory.getLength())
+            {
+                PersistentCache::Desc desc;
+                desc.directory = cacheDirectory.getBuffer();
+                desc.maxEntryCount =
+                    m_optionSet.getIntOption(CompilerOptionName::CompilationCacheMaxEntryCount);
+                m_persistentCache = new PersistentCache(desc);
+            }
+        });
+    return m_persistentCache;
+}
+
+ThreadPool* Linkage::getCodeGenThreadPool()
+{
+    if (!m_optionSet.hasOption(CompilerOptionName::CodeGenThreadCount))
+        return nullptr;
+
+    Count threadCount = m_optionSet.getIntOption(CompilerOptionName::CodeGenThreadCount);
+    if (threadCount <= 0)
+        threadCount = ThreadPool::getHardwareThreadCount();
+    if (threadCount <= 1)
+        return nullptr;
+
+    // Like the persistent cache, the pool is created lazily so that it picks up
+    // options set after the linkage was created.
+    if (!m_codeGenThreadPool || m_codeGenThreadPool->getThreadCount() != threadCount)
+    {
+        m_codeGenThreadPool = new ThreadPool(threadCount);
+    }
+    return m_codeGenThreadPool;
+}
+
+ThreadPool* Linkage::getImportThreadPool()
+{
+    // The language server gathers content assist information as modules are preprocessed,
+    // so it preprocesses each module as it is imported.
+    if (isInLanguageServer() || !m_optionSet.hasOption(CompilerOptionName::ImportThreadCount))
+        return nullptr;
+
+    Count threadCount = m_optionSet.getIntOption(CompilerOptionName::ImportThreadCount);
+    if (threadCount <= 0)
+        threadCount = ThreadPool::getHardwareThreadCount();
+    if (threadCount <= 1)
+        return nullptr;
+
+    if (!m_importThreadPool || m_importThreadPool->getThreadCount() != threadCount)
+    {
+        m_importThreadPool = new ThreadPool(threadCount);
+
+        // The tasks of the previous pool that hadn't started were dropped with it.
+        std::lock_guard<std::mutex> lock(m_preprocessedImportsMutex);
+        for (Index i = 0; i < m_queuedImports.getCount(); ++i)
+            m_importThreadPool->runAsync([this]() { _preprocessQueuedImport(); });
+    }
+    return m_importThreadPool;
+}
+
 SLANG_NO_THROW slang::IGlobalSession* SLANG_MCALL Linkage::getGlobalSession()
 {
     return asExternal(getSessionImpl());
@@ -2066,6 +2258,8 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::getTypeConformanceWitnessSequent
     auto name = getMangledNameForConformanceWitness(m_astBuilder, subType, supType);
     auto interfaceName = getMangledTypeName(m_astBuilder, supType);
     uint32_t resultIndex = 0;
+
+    std::lock_guard<std::mutex> lock(m_codeGenMutex);
     if (mapMangledNameToRTTIObjectIndex.tryGetValue(name, resultIndex))
     {
         if (outId)
@@ -2530,12 +2724,17 @@ Scope* TranslationUnitRequest::getLanguageScope()
     return languageScope;
 }
 
-Dictionary<String, String> TranslationUnitRequest::getCombinedPreprocessorDefinitions()
+// Combine the `preprocessorDefinitions` of a translation unit in `sourceLanguage` with the
+// definitions in `optionSet` and the standard macros.
+static Dictionary<String, String> _getCombinedPreprocessorDefinitions(
+    Dictionary<String, String> const& preprocessorDefinitions,
+    CompilerOptionSet& optionSet,
+    SourceLanguage sourceLanguage)
 {
     Dictionary<String, String> combinedPreprocessorDefinitions;
     for (const auto& def : preprocessorDefinitions)
         combinedPreprocessorDefinitions.addIfNotExists(def);
-    for (const auto& def : compileRequest->optionSet.getArray(CompilerOptionName::MacroDefine))
+    for (const auto& def : optionSet.getArray(CompilerOptionName::MacroDefine))
         combinedPreprocessorDefinitions.addIfNotExists(def.stringValue, def.stringValue2);
 
     // Define standard macros, if not already defined. This style assumes using `#if __SOME_VAR`
@@ -2580,6 +2779,14 @@ Dictionary<String, String> TranslationUnitRequest::getCombinedPreprocessorDefini
     return combinedPreprocessorDefinitions;
 }
 
+Dictionary<String, String> TranslationUnitRequest::getCombinedPreprocessorDefinitions()
+{
+    return _getCombinedPreprocessorDefinitions(
+        preprocessorDefinitions,
+        compileRequest->optionSet,
+        sourceLanguage);
+}
+
 void TranslationUnitRequest::addSourceArtifact(IArtifact* sourceArtifact)
 {
     SLANG_ASSERT(sourceArtifact);
@@ -3516,15 +3723,36 @@ void FrontEndCompileRequest::parseTranslationUnit(TranslationUnitRequest* transl
         SourceLanguage sourceLanguage = translationUnit->sourceLanguage;
         SlangLanguageVersion languageVersion =
             translationUnit->compileRequest->optionSet.getLanguageVersion();
-        auto tokens = preprocessSource(
-            sourceFile,
-            getSink(),
-            &includeSystem,
-            combinedPreprocessorDefinitions,
-            getLinkage(),
-            sourceLanguage,
-            languageVersion,
-            &preprocessorHandler);
+        TokenList tokens;
+        if (auto preprocessedImport = linkage->takePreprocessedImport(
+                sourceFile,
+                combinedPreprocessorDefinitions,
+                sourceLanguage,
+                languageVersion))
+        {
+            // The source was preprocessed ahead of the module being imported, so we use
+            // the result, and pass on what the preprocessor reported along the way.
+            tokens = _Move(preprocessedImport->tokens);
+            sourceLanguage = preprocessedImport->detectedLanguage;
+            languageVersion = preprocessedImport->detectedLanguageVersion;
+
+            PreprocessorHandler* handler = &preprocessorHandler;
+            for (auto dependency : preprocessedImport->fileDependencies)
+                handler->handleFileDependency(dependency);
+            getSink()->setSourceWarningStateTracker(preprocessedImport->warningStateTracker);
+        }
+        else
+        {
+            tokens = preprocessSource(
+                sourceFile,
+                getSink(),
+                &includeSystem,
+                combinedPreprocessorDefinitions,
+                getLinkage(),
+                sourceLanguage,
+                languageVersion,
+                &preprocessorHandler);
+        }
 
         translationUnitSyntax->languageVersion = languageVersion;
 
@@ -3566,6 +3794,9 @@ void FrontEndCompileRequest::parseTranslationUnit(TranslationUnitRequest* transl
             return;
         }
 
+        // Get the modules this one imports ready while it is parsed and checked.
+        linkage->preprocessImportsInParallel(tokens, getSink());
+
         parseSourceFile(
             astBuilder,
             translationUnit,
@@ -3725,6 +3956,7 @@ SlangResult FrontEndCompileRequest::executeActionsInner()
 {
     SLANG_PROFILE_SECTION(frontEndExecute);
     SLANG_AST_BUILDER_RAII(getLinkage()->getASTBuilder());
+    Linkage::PreprocessedImportScopeRAII preprocessedImportScope(getLinkage());
 
     for (TranslationUnitRequest* translationUnit : translationUnits)
     {
@@ -3841,6 +4073,8 @@ EndToEndCompileRequest::queryInterface(SlangUUID const& uuid, void** outObject)
 
 void EndToEndCompileRequest::init()
 {
+    m_profileSnapshot = PerformanceProfiler::getProfiler()->takeSnapshot();
+
     m_sink.setSourceManager(m_linkage->getSourceManager());
 
     m_writers = new StdWriters;
@@ -4401,6 +4635,10 @@ RefPtr<Module> Linkage::loadBinaryModuleImpl(
         requestingLoc,
         sink);
 
+    if (module)
+    {
+        SLANG_PROFILE_COUNTER(modulesLoaded, 1);
+    }
     return module;
 }
 
@@ -4454,6 +4692,7 @@ RefPtr<Module> Linkage::loadSourceModuleImpl(
     const LoadedModuleDictionary* additionalLoadedModules)
 {
     RefPtr<FrontEndCompileRequest> frontEndReq = new FrontEndCompileRequest(this, nullptr, sink);
+    PreprocessedImportScopeRAII preprocessedImportScope(this);
 
     frontEndReq->additionalLoadedModules = additionalLoadedModules;
 
@@ -4544,6 +4783,8 @@ RefPtr<Module> Linkage::loadSourceModuleImpl(
     if (!module)
         return nullptr;
 
+    SLANG_PROFILE_COUNTER(modulesLoaded, 1);
+
     module->setPathInfo(filePathInfo);
     return module;
 }
@@ -4791,7 +5032,14 @@ RefPtr<Module> Linkage::findOrImportModule(
             // and *read* it, then we continue the search
             // using whatever other candidate file names are left.
             //
+            // A precompiled module that is a file of the operating system can be mapped into
+            // memory instead, so that its pages are shared with other processes importing the
+            // same module and only the parts that are used are read.
+            //
             ComPtr<ISlangBlob> fileContents;
+            includeSystem.setMapOSFiles(
+                type == ModuleBlobType::IR &&
+                m_optionSet.getBoolOption(CompilerOptionName::MapBinaryModules));
             if (SLANG_FAILED(includeSystem.loadFile(filePathInfo, fileContents)))
             {
                 continue;
@@ -4847,6 +5095,353 @@ RefPtr<Module> Linkage::findOrImportModule(
     return nullptr;
 }
 
+// Find the names of the modules imported by `import` declarations in the preprocessed
+// `tokens` of a module, reading each name as the parser does.
+//
+// As the tokens aren't parsed, this may find an `import` the parser would reject. That
+// is harmless, as the modules found are only preprocessed ahead of being imported.
+//
+static void _findImportedModuleNames(
+    NamePool* namePool,
+    TokenList const& tokens,
+    List<NameLoc>& outModuleNames)
+{
+    const List<Token>& tokenList = tokens.m_tokens;
+    const Index tokenCount = tokenList.getCount();
+    for (Index i = 0; i + 2 < tokenCount; ++i)
+    {
+        const Token& token = tokenList[i];
+        if (token.type != TokenType::Identifier || token.getContent() != "import")
+            continue;
+
+        Index cursor = i + 1;
+        const Token& nameToken = tokenList[cursor++];
+        String moduleName;
+        if (nameToken.type == TokenType::StringLiteral)
+        {
+            moduleName = getStringLiteralTokenValue(nameToken);
+        }
+        else if (nameToken.type == TokenType::Identifier)
+        {
+            // We allow a dotted format for the name, as sugar
+            StringBuilder sb;
+            sb << nameToken.getContent();
+            while (cursor + 1 < tokenCount && tokenList[cursor].type == TokenType::Dot &&
+                   tokenList[cursor + 1].type == TokenType::Identifier)
+            {
+                sb << "/" << tokenList[cursor + 1].getContent();
+                cursor += 2;
+            }
+            moduleName = sb.produceString();
+        }
+        else
+        {
+            continue;
+        }
+
+        if (cursor < tokenCount && tokenList[cursor].type == TokenType::Semicolon)
+            outModuleNames.add(NameLoc(namePool->getName(moduleName), nameToken.loc));
+    }
+}
+
+void Linkage::_findImportsToPreprocess(
+    TokenList const& tokens,
+    IncludeSystem& includeSystem,
+    List<RefPtr<PreprocessedImport>>& ioImports)
+{
+    List<NameLoc> moduleNames;
+    _findImportedModuleNames(getNamePool(), tokens, moduleNames);
+
+    for (const auto& moduleName : moduleNames)
+    {
+        // Modules that have been loaded already, or are built in, needn't be preprocessed.
+        if (mapNameToLoadedModules.containsKey(moduleName.name) ||
+            moduleName.name == getSessionImpl()->glslModuleName)
+        {
+            continue;
+        }
+
+        // Search for the file as `findOrImportModule` does, with binary modules preferred.
+        // If a binary module is found, it will most likely be used, so there is nothing
+        // to preprocess.
+        const String defaultSourceFileName = getFileNameFromModuleName(moduleName.name, false);
+        const String alternativeSourceFileName = getFileNameFromModuleName(moduleName.name, true);
+        const String fileNamesToTry[] = {
+            Path::replaceExt(defaultSourceFileName, "slang-module"),
+            Path::replaceExt(alternativeSourceFileName, "slang-module"),
+            defaultSourceFileName,
+            alternativeSourceFileName};
+        const Index firstSourceFileNameIndex = 2;
+
+        PathInfo requestingPathInfo =
+            getSourceManager()->getPathInfo(moduleName.loc, SourceLocType::Actual);
+
+        PathInfo filePathInfo;
+        Index foundIndex = -1;
+        for (Index i = 0; i < SLANG_COUNT_OF(fileNamesToTry); ++i)
+        {
+            if (SLANG_SUCCEEDED(includeSystem.findFile(
+                    fileNamesToTry[i],
+                    requestingPathInfo.foundPath,
+                    filePathInfo)))
+            {
+                foundIndex = i;
+                break;
+            }
+        }
+        if (foundIndex < firstSourceFileNameIndex ||
+            mapPathToLoadedModule.containsKey(filePathInfo.getMostUniqueIdentity()))
+        {
+            continue;
+        }
+
+        // Loading the file registers it with the source manager, so the same source file
+        // is used when the module is imported.
+        ComPtr<ISlangBlob> fileContents;
+        SourceFile* sourceFile = nullptr;
+        if (SLANG_FAILED(includeSystem.loadFile(filePathInfo, fileContents, sourceFile)) ||
+            !sourceFile || m_preprocessedImports.containsKey(sourceFile))
+        {
+            continue;
+        }
+
+        // Work out the inputs to the preprocessor as `loadSourceModuleImpl` would.
+        RefPtr<PreprocessedImport> preprocessedImport = new PreprocessedImport();
+        preprocessedImport->sourceFile = sourceFile;
+        preprocessedImport->language = SourceLanguage::Slang;
+        Stage impliedStage;
+        if ((SourceLanguage)findSourceLanguageFromPath(filePathInfo.getName(), impliedStage) ==
+            SourceLanguage::GLSL)
+        {
+            preprocessedImport->language = SourceLanguage::GLSL;
+        }
+        preprocessedImport->defines = _getCombinedPreprocessorDefinitions(
+            Dictionary<String, String>(),
+            m_optionSet,
+            preprocessedImport->language);
+        preprocessedImport->languageVersion = m_optionSet.getLanguageVersion();
+
+        m_preprocessedImports.add(sourceFile, preprocessedImport);
+        ioImports.add(preprocessedImport);
+    }
+}
+
+/// Records what the preprocessor reports while preprocessing a module ahead of
+/// it being imported.
+struct ImportPreprocessorHandler : PreprocessorHandler
+{
+    ImportPreprocessorHandler(Linkage::PreprocessedImport* preprocessedImport)
+        : m_import(preprocessedImport)
+    {
+    }
+
+protected:
+    Linkage::PreprocessedImport* m_import;
+
+    void handleFileDependency(SourceFile* sourceFile) SLANG_OVERRIDE
+    {
+        m_import->fileDependencies.add(sourceFile);
+    }
+
+    void handleEndOfTranslationUnit(Preprocessor* preprocessor) SLANG_OVERRIDE
+    {
+        // The NVAPI macros are recorded on the declaration of the module being compiled,
+        // so a module that sets them is preprocessed again when it is imported.
+        String nvapiRegister;
+        SourceLoc nvapiRegisterLoc;
+        if (SLANG_SUCCEEDED(findMacroValue(
+                preprocessor,
+                "NV_SHADER_EXTN_SLOT",
+                nvapiRegister,
+                nvapiRegisterLoc)))
+        {
+            m_import->isUsable = false;
+        }
+    }
+};
+
+void Linkage::preprocessImportsInParallel(TokenList const& tokens, DiagnosticSink* sink)
+{
+    // The language server records what the preprocessor finds for content assist, which
+    // only happens on the thread loading modules.
+    ThreadPool* threadPool = getImportThreadPool();
+    if (!threadPool || isInLanguageServer())
+        return;
+
+    SLANG_PROFILE;
+
+    // The imports are found and their files loaded on this thread, as that uses the state
+    // of the linkage, and then they are queued to be preprocessed on the pool.
+    SearchDirectoryList* searchDirectories = &getSearchDirectories();
+    IncludeSystem includeSystem(searchDirectories, getFileSystemExt(), getSourceManager());
+
+    List<RefPtr<PreprocessedImport>> imports;
+    _findImportsToPreprocess(tokens, includeSystem, imports);
+    for (auto preprocessedImport : imports)
+    {
+        // String reference counts are not atomic, so the worker is given strings of its own.
+        for (const auto& searchDirectory : searchDirectories->searchDirectories)
+        {
+            preprocessedImport->searchDirectories.searchDirectories.add(
+                SearchDirectory(String(searchDirectory.path.getUnownedSlice())));
+        }
+        Dictionary<String, String> defines;
+        for (const auto& [name, value] : preprocessedImport->defines)
+            defines.add(String(name.getUnownedSlice()), String(value.getUnownedSlice()));
+        preprocessedImport->defines = _Move(defines);
+
+        // The preprocessor gives the sink a warning state tracker of its own.
+        preprocessedImport->sink.initFrom(*sink);
+        preprocessedImport->sink.setSourceWarningStateTracker(nullptr);
+
+        preprocessedImport->fileSystemExt = getFileSystemExt();
+        preprocessedImport->sourceManager = getSourceManager();
+        preprocessedImport->namePool.setRootNamePool(&preprocessedImport->rootNamePool);
+        {
+            std::lock_guard<std::mutex> lock(m_preprocessedImportsMutex);
+            m_queuedImports.add(preprocessedImport);
+        }
+        threadPool->runAsync([this]() { _preprocessQueuedImport(); });
+    }
+}
+
+void Linkage::_preprocessQueuedImport()
+{
+    // There is a task for each import queued, but an import may have been taken off the
+    // queue by the thread loading modules.
+    PreprocessedImport* preprocessedImport = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_preprocessedImportsMutex);
+        if (m_queuedImports.getCount() == 0)
+            return;
+        preprocessedImport = m_queuedImports[0];
+        m_queuedImports.removeAt(0);
+        preprocessedImport->state = PreprocessedImport::State::Running;
+    }
+
+    SLANG_PROFILE;
+
+    // Each import reports to its own sink, as a `DiagnosticSink` can't be shared between
+    // threads. If there is anything to report, the module is preprocessed again when it is
+    // imported, so that diagnostics are reported in order.
+    //
+    // Only the state of the import is used, and not that of the linkage. The tokens of
+    // included files aren't taken from the linkage's token cache, as they hold the names
+    // of the linkage.
+    DiagnosticSink& importSink = preprocessedImport->sink;
+    IncludeSystem importIncludeSystem(
+        &preprocessedImport->searchDirectories,
+        preprocessedImport->fileSystemExt,
+        preprocessedImport->sourceManager);
+    ImportPreprocessorHandler handler(preprocessedImport);
+
+    PreprocessorDesc desc;
+    desc.sink = &importSink;
+    desc.namePool = &preprocessedImport->namePool;
+    desc.fileSystem = preprocessedImport->fileSystemExt;
+    desc.sourceManager = preprocessedImport->sourceManager;
+    desc.includeSystem = &importIncludeSystem;
+    desc.defines = &preprocessedImport->defines;
+    desc.handler = &handler;
+    desc.memoryArena = &preprocessedImport->memoryArena;
+    desc.trackWarningState = true;
+
+    preprocessedImport->detectedLanguage = preprocessedImport->language;
+    preprocessedImport->detectedLanguageVersion = preprocessedImport->languageVersion;
+    try
+    {
+        preprocessedImport->tokens = preprocessSource(
+            preprocessedImport->sourceFile,
+            desc,
+            preprocessedImport->detectedLanguage,
+            preprocessedImport->detectedLanguageVersion);
+    }
+    catch (...)
+    {
+        preprocessedImport->isUsable = false;
+    }
+    if (importSink.getErrorCount() || importSink.outputBuffer.getLength())
+        preprocessedImport->isUsable = false;
+    preprocessedImport->warningStateTracker = importSink.getSourceWarningStateTracker();
+
+    // The import may be freed as soon as it is seen to be done, so the lock is held until
+    // the waiting threads have been signaled.
+    std::lock_guard<std::mutex> lock(m_preprocessedImportsMutex);
+    preprocessedImport->state = PreprocessedImport::State::Done;
+    m_preprocessedImportDone.notify_all();
+}
+
+void Linkage::_waitForImport(PreprocessedImport* preprocessedImport, bool cancel)
+{
+    std::unique_lock<std::mutex> lock(m_preprocessedImportsMutex);
+    if (cancel && preprocessedImport->state == PreprocessedImport::State::Queued)
+    {
+        m_queuedImports.remove(preprocessedImport);
+        preprocessedImport->state = PreprocessedImport::State::Done;
+        return;
+    }
+    m_preprocessedImportDone.wait(
+        lock,
+        [&]() { return preprocessedImport->state == PreprocessedImport::State::Done; });
+}
+
+void Linkage::_dropPreprocessedImports()
+{
+    for (auto& [sourceFile, preprocessedImport] : m_preprocessedImports)
+        _waitForImport(preprocessedImport, true);
+    m_preprocessedImports.clear();
+}
+
+static bool _areDefinesEqual(
+    Dictionary<String, String> const& defines,
+    Dictionary<String, String> const& otherDefines)
+{
+    if (defines.getCount() != otherDefines.getCount())
+        return false;
+    for (const auto& [name, value] : defines)
+    {
+        const String* otherValue = otherDefines.tryGetValue(name);
+        if (!otherValue || *otherValue != value)
+            return false;
+    }
+    return true;
+}
+
+Linkage::PreprocessedImport* Linkage::takePreprocessedImport(
+    SourceFile* sourceFile,
+    Dictionary<String, String> const& defines,
+    SourceLanguage language,
+    SlangLanguageVersion languageVersion)
+{
+    RefPtr<PreprocessedImport> preprocessedImport;
+    if (!m_preprocessedImports.tryGetValue(sourceFile, preprocessedImport))
+        return nullptr;
+    m_preprocessedImports.remove(sourceFile);
+
+    // An import still queued is behind others the workers are busy with. It is waited for
+    // rather than preprocessed here, so whether the result is used doesn't depend on timing.
+    _waitForImport(preprocessedImport, false);
+
+    if (!preprocessedImport->isUsable || preprocessedImport->language != language ||
+        preprocessedImport->languageVersion != languageVersion ||
+        !_areDefinesEqual(preprocessedImport->defines, defines))
+    {
+        return nullptr;
+    }
+
+    SLANG_PROFILE_SECTION(usePreprocessedImport);
+
+    // The worker is done with the names of the import, so they can be replaced.
+    for (auto& token : preprocessedImport->tokens.m_tokens)
+    {
+        if (auto name = token.getNameOrNull())
+            token.setName(namePool.getName(name->text.getUnownedSlice()));
+    }
+
+    m_usedPreprocessedImports.add(preprocessedImport);
+    return preprocessedImport;
+}
+
 SourceFile* Linkage::loadSourceFile(String pathFrom, String path)
 {
     IncludeSystem includeSystem(&getSearchDirectories(), getFileSystemExt(), getSourceManager());
@@ -4892,24 +5487,96 @@ bool Linkage::isBinaryModuleUpToDate(String fromPath, RIFF::ListChunk const* bas
         }
     }
 
+    // Modules written by older versions have no stats, and every dependency is hashed.
+    auto dependencyStats = moduleChunk->getFileDependencyStats();
+    Index dependencyIndex = 0;
     for (auto dependencyChunk : dependencyChunks)
     {
         auto file = dependencyChunk->getValue();
-        auto sourceFile = loadSourceFile(fromPath, file);
-        if (!sourceFile)
-        {
-            // If we cannot find the source file from `fromPath`,
-            // try again from the module's source file path.
-            if (dependencyChunks.getFirst())
-                sourceFile = loadSourceFile(moduleSrcPath, file);
-        }
-        if (!sourceFile)
+        auto recordedStat = dependencyIndex < dependencyStats.getCount()
+                                ? &dependencyStats[dependencyIndex]
+                                : nullptr;
+        dependencyIndex++;
+
+        SHA1::Digest digest;
+        if (!getFileDependencyDigest(fromPath, moduleSrcPath, file, recordedStat, digest))
             return false;
-        digestBuilder.append(sourceFile->getDigest());
+        digestBuilder.append(digest);
     }
     return digestBuilder.finalize() == existingDigest;
 }
 
+static bool _isSameFileStat(SerialFileDependencyStat const& a, SerialFileDependencyStat const& b)
+{
+    return a.modificationTime != 0 && a.modificationTime == b.modificationTime &&
+           a.size == b.size;
+}
+
+bool Linkage::getFileDependencyDigest(
+    String const& fromPath,
+    String const& moduleSrcPath,
+    String const& file,
+    SerialFileDependencyStat const* recordedStat,
+    SHA1::Digest& outDigest)
+{
+    // If the file is unchanged since it was read, either to compile the module or by this
+    // session, its digest is known without reading it. As with make, a change that keeps
+    // both the size and the modification time is not noticed, but the stats are only
+    // recorded for files that weren't modified within the resolution of modification times
+    // before they were read (see `SourceFile::FileStat`).
+    IncludeSystem includeSystem(&getSearchDirectories(), getFileSystemExt(), getSourceManager());
+    PathInfo pathInfo;
+    SerialFileDependencyStat stat;
+    if ((SLANG_SUCCEEDED(includeSystem.findFile(file, fromPath, pathInfo)) ||
+         SLANG_SUCCEEDED(includeSystem.findFile(file, moduleSrcPath, pathInfo))) &&
+        SLANG_SUCCEEDED(SerialContainerUtil::getFileDependencyStat(
+            getFileSystemExt(),
+            pathInfo.foundPath,
+            stat)))
+    {
+        if (recordedStat && _isSameFileStat(*recordedStat, stat))
+        {
+            outDigest = recordedStat->digest;
+            return true;
+        }
+        SerialFileDependencyStat seenStat;
+        auto session = getSessionImpl();
+        if (session->tryGetFileDependencyStat(pathInfo.getMostUniqueIdentity(), seenStat) &&
+            _isSameFileStat(seenStat, stat))
+        {
+            outDigest = seenStat.digest;
+            return true;
+        }
+    }
+
+    auto sourceFile = loadSourceFile(fromPath, file);
+    if (!sourceFile)
+    {
+        // If we cannot find the source file from `fromPath`,
+        // try again from the module's source file path.
+        sourceFile = loadSourceFile(moduleSrcPath, file);
+    }
+    if (!sourceFile)
+        return false;
+    outDigest = sourceFile->getDigest();
+
+    // Remember the digest with the stat taken when the source file was read, which is the
+    // one that goes with its contents. The source file may have been read by this linkage
+    // long before the stat above was taken.
+    auto& fileStat = sourceFile->getFileStat();
+    if (fileStat.modificationTime != 0)
+    {
+        SerialFileDependencyStat readStat;
+        readStat.size = fileStat.size;
+        readStat.modificationTime = fileStat.modificationTime;
+        readStat.digest = outDigest;
+        getSessionImpl()->setFileDependencyStat(
+            sourceFile->getPathInfo().getMostUniqueIdentity(),
+            readStat);
+    }
+    return true;
+}
+
 SLANG_NO_THROW bool SLANG_MCALL
 Linkage::isBinaryModuleUpToDate(const char* modulePath, slang::IBlob* binaryModuleBlob)
 {
@@ -5196,6 +5863,36 @@ void Module::setName(String name)
     m_name = getLinkage()->getNamePool()->getName(name);
 }
 
+void Module::_readSerializedIRModule()
+{
+    // The IR may be needed from multiple threads when generating code in
+    // parallel, so only the first of them reads it.
+    std::lock_guard<std::mutex> lock(m_serializedIRModuleMutex);
+    if (!m_hasUnreadSerializedIRModule)
+        return;
+
+    // A module that can't be read gets an empty IR module, so that callers that
+    // don't check for the failure keep working, and the failure is reported by
+    // the callers that pass a sink to `getIRModule`.
+    RefPtr<IRModule> irModule;
+    m_serializedIRModuleReadResult = m_serializedIRModule->readModule(irModule);
+    if (SLANG_FAILED(m_serializedIRModuleReadResult))
+        irModule = IRModule::create(getLinkage()->getSessionImpl());
+    if (!irModule->getName())
+        irModule->setName(m_name);
+
+    m_irModule = irModule;
+    m_hasUnreadSerializedIRModule = false;
+}
+
+IRModule* Module::getIRModule(DiagnosticSink* sink)
+{
+    auto irModule = getIRModule();
+    if (sink && SLANG_FAILED(m_serializedIRModuleReadResult))
+        sink->diagnose(SourceLoc(), Diagnostics::unableToReadModuleIR, getName());
+    return irModule;
+}
+
 
 RefPtr<EntryPoint> Module::findEntryPointByName(UnownedStringSlice const& name)
 {
@@ -5494,7 +6191,10 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getResultAsFileSystem(
     if (!_findObfuscatedSourceMap(artifact))
     {
         List<IRModule*> irModules;
-        enumerateIRModules([&](IRModule* irModule) -> void { irModules.add(irModule); });
+        // Source maps aren't serialized, so modules with unread serialized IR can be skipped.
+        enumerateIRModules(
+            [&](IRModule* irModule) -> void { irModules.add(irModule); },
+            [&](Module*) -> void {});
 
         for (auto irModule : irModules)
         {
@@ -5883,12 +6583,16 @@ void ComponentType::enumerateModules(EnumerateModulesCallback callback, void* us
 /// Visitor used by `ComponentType::enumerateIRModules`
 struct EnumerateIRModulesVisitor : ComponentTypeVisitor
 {
-    EnumerateIRModulesVisitor(ComponentType::EnumerateIRModulesCallback callback, void* userData)
-        : m_callback(callback), m_userData(userData)
+    EnumerateIRModulesVisitor(
+        ComponentType::EnumerateIRModulesCallback callback,
+        ComponentType::EnumerateUnreadIRModulesCallback unreadCallback,
+        void* userData)
+        : m_callback(callback), m_unreadCallback(unreadCallback), m_userData(userData)
     {
     }
 
     ComponentType::EnumerateIRModulesCallback m_callback;
+    ComponentType::EnumerateUnreadIRModulesCallback m_unreadCallback;
     void* m_userData;
 
     void visitEntryPoint(EntryPoint*, EntryPoint::EntryPointSpecializationInfo*) SLANG_OVERRIDE {}
@@ -5902,7 +6606,10 @@ struct EnumerateIRModulesVisitor : ComponentTypeVisitor
 
     void visitModule(Module* module, Module::ModuleSpecializationInfo*) SLANG_OVERRIDE
     {
-        m_callback(module->getIRModule(), m_userData);
+        if (m_unreadCallback && module->getUnreadSerializedIRModule())
+            m_unreadCallback(module, m_userData);
+        else
+            m_callback(module->getIRModule(), m_userData);
     }
 
     void visitComposite(
@@ -5927,7 +6634,16 @@ struct EnumerateIRModulesVisitor : ComponentTypeVisitor
 
 void ComponentType::enumerateIRModules(EnumerateIRModulesCallback callback, void* userData)
 {
-    EnumerateIRModulesVisitor visitor(callback, userData);
+    EnumerateIRModulesVisitor visitor(callback, nullptr, userData);
+    acceptVisitor(&visitor, nullptr);
+}
+
+void ComponentType::enumerateIRModules(
+    EnumerateIRModulesCallback callback,
+    EnumerateUnreadIRModulesCallback unreadCallback,
+    void* userData)
+{
+    EnumerateIRModulesVisitor visitor(callback, unreadCallback, userData);
     acceptVisitor(&visitor, nullptr);
 }
 
@@ -6842,9 +7558,27 @@ SlangResult Linkage::loadSerializedModuleContents(
         return SLANG_FAIL;
     module->setModuleDecl(moduleDecl);
 
-    RefPtr<IRModule> irModule;
-    SLANG_RETURN_ON_FAIL(readSerializedModuleIR(irChunk, session, sourceLocReader, irModule));
-    module->setIRModule(irModule);
+    RefPtr<SerializedIRModule> serializedIRModule;
+    SlangResult irResult = readSerializedModuleIROnDemand(
+        irChunk,
+        blobHoldingSerializedData,
+        session,
+        sourceLocReader,
+        serializedIRModule);
+    if (SLANG_SUCCEEDED(irResult))
+    {
+        module->setSerializedIRModule(serializedIRModule);
+    }
+    else if (irResult == SLANG_E_NOT_AVAILABLE)
+    {
+        RefPtr<IRModule> irModule;
+        SLANG_RETURN_ON_FAIL(readSerializedModuleIR(irChunk, session, sourceLocReader, irModule));
+        module->setIRModule(irModule);
+    }
+    else
+    {
+        return irResult;
+    }
 
     // The handling of file dependencies is complicated, because of
     // the way that the encoding logic tried to make all of the
@@ -6984,6 +7718,7 @@ void Session::addBuiltinSource(
         subScope->nextSibling = scope->nextSibling;
         scope->nextSibling = subScope;
     }
+    module->getLinkage()->invalidateCachedLookups();
 
     outModule = module;
 }
@@ -7663,11 +8398,33 @@ SlangResult EndToEndCompileRequest::compile()
     double downstreamStartTime = 0.0;
     double totalStartTime = 0.0;
 
+    // The profiler is shared with any other compiles that run at the same time, so rather
+    // than clearing it, what is recorded during this compile is reported relative to a
+    // snapshot.
+    RefPtr<ProfileSnapshot> profileStart;
     if (getOptionSet().getBoolOption(CompilerOptionName::ReportDownstreamTime))
     {
         getSession()->getCompilerElapsedTime(&totalStartTime, &downstreamStartTime);
-        PerformanceProfiler::getProfiler()->clear();
+        profileStart = PerformanceProfiler::getProfiler()->takeSnapshot();
     }
+
+    // Trace events are only recorded when asked for, since they accumulate for every
+    // profiled scope that is run.
+    auto perfTracePath = getOptionSet().getStringOption(CompilerOptionName::ReportPerfTrace);
+    if (perfTracePath.getLength())
+    {
+        if (!profileStart)
+            profileStart = PerformanceProfiler::getProfiler()->takeSnapshot();
+        PerformanceProfiler::getProfiler()->beginTracing();
+    }
+
+    // Gathering the statistics of IR passes costs more than timing them, so it is only
+    // done when they are reported.
+    const bool shouldProfilePasses =
+        getOptionSet().getBoolOption(CompilerOptionName::ReportPerfBenchmark) ||
+        perfTracePath.getLength();
+    if (shouldProfilePasses)
+        PerformanceProfiler::getProfiler()->beginPassProfiling();
 #if !defined(SLANG_DEBUG_INTERNAL_ERROR)
     // By default we'd like to catch as many internal errors as possible,
     // and report them to the user nicely (rather than just crash their
@@ -7730,6 +8487,9 @@ SlangResult EndToEndCompileRequest::compile()
     }
 #endif
 
+    if (shouldProfilePasses)
+        PerformanceProfiler::getProfiler()->endPassProfiling();
+
     if (getOptionSet().getBoolOption(CompilerOptionName::ReportDownstreamTime))
     {
         double downstreamEndTime = 0;
@@ -7742,13 +8502,31 @@ SlangResult EndToEndCompileRequest::compile()
     if (getOptionSet().getBoolOption(CompilerOptionName::ReportPerfBenchmark))
     {
         StringBuilder perfResult;
-        PerformanceProfiler::getProfiler()->getResult(perfResult);
+        PerformanceProfiler::getProfiler()->getResult(perfResult, profileStart);
         perfResult << "\nType Dictionary Size: " << getSession()->m_typeDictionarySize << "\n";
+
+        auto session = getSession();
+        const size_t arenaBytes = session->m_linkedIRArenaBytes;
+        const size_t deadInstBytes = session->m_linkedIRDeadInstBytes;
+        perfResult << "Linked IR Memory: " << UInt64(arenaBytes - deadInstBytes) << " bytes live, "
+                   << UInt64(deadInstBytes) << " bytes dead, "
+                   << UInt64(session->m_linkedIRReusedInstBytes) << " bytes reused\n";
         getSink()->diagnose(
             SourceLoc(),
             Diagnostics::performanceBenchmarkResult,
             perfResult.produceString());
     }
+    if (perfTracePath.getLength())
+    {
+        PerformanceProfiler::getProfiler()->endTracing();
+
+        StringBuilder trace;
+        PerformanceProfiler::getProfiler()->getTraceResult(trace, profileStart);
+        if (SLANG_FAILED(File::writeAllText(perfTracePath, trace)))
+        {
+            getSink()->diagnose(SourceLoc(), Diagnostics::unableToWriteFile, perfTracePath);
+        }
+    }
 
     // Repro dump handling
     {
@@ -7880,11 +8658,14 @@ SlangResult EndToEndCompileRequest::getCompileTimeProfile(
         return SLANG_E_INVALID_ARG;
     }
 
-    SlangProfiler* profiler = new SlangProfiler(PerformanceProfiler::getProfiler());
+    // The profiler is shared by all the requests, so the profile of this request is what
+    // was recorded since its snapshot, and clearing it only takes a new snapshot.
+    auto performanceProfiler = PerformanceProfiler::getProfiler();
+    SlangProfiler* profiler = new SlangProfiler(performanceProfiler, m_profileSnapshot);
 
     if (shouldClear)
     {
-        PerformanceProfiler::getProfiler()->clear();
+        m_profileSnapshot = performanceProfiler->takeSnapshot();
     }
 
     ComPtr<ISlangProfiler> result(profiler);
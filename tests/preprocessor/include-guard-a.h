@@ -0,0 +1,20 @@
+// include-guard-a.h
+
+// Used by the `include-guard.slang` test
+
+#ifndef INCLUDE_GUARD_A_H
+#define INCLUDE_GUARD_A_H
+
+#ifdef INCLUDE_GUARD_A_EXTRA
+float extra(float x)
+{
+    return x;
+}
+#endif
+
+float foo(float x)
+{
+    return x;
+}
+
+#endif // INCLUDE_GUARD_A_H
@@ -0,0 +1,12 @@
+// include-guard-b.h
+
+// Used by the `include-guard.slang` test
+
+#ifndef INCLUDE_GUARD_B_H
+#define INCLUDE_GUARD_B_H
+#else
+float bar(float x)
+{
+    return x;
+}
+#endif
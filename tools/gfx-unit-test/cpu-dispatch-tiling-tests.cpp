@@ -0,0 +1,163 @@
+// Tests that the CPU device runs every invocation of a dispatch exactly once when it splits the
+// grid into tiles for its worker threads, including when the grid doesn't divide evenly into
+// the tiles.
+
+#include "core/slang-basic.h"
+#include "slang-gfx.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace gfx;
+using Slang::ComPtr;
+using Slang::List;
+
+namespace gfx_test
+{
+
+static const char kCountInvocationsShader[] = R"(
+    [shader("compute")]
+    [numthreads(2, 2, 1)]
+    void computeMain(
+        uint3 sv_dispatchThreadID : SV_DispatchThreadID,
+        uniform RWStructuredBuffer<uint> counts,
+        uniform uint3 threadCounts)
+    {
+        uint index = (sv_dispatchThreadID.z * threadCounts.y + sv_dispatchThreadID.y) *
+            threadCounts.x + sv_dispatchThreadID.x;
+        InterlockedAdd(counts[index], 1);
+    }
+    )";
+
+static const int kGroupSize[3] = {2, 2, 1};
+
+static ShaderOffset _getFieldOffset(IShaderObject* object, const char* name)
+{
+    auto typeLayout = object->getElementTypeLayout();
+    auto fieldIndex = typeLayout->findFieldIndexByName(name);
+    ShaderOffset offset;
+    offset.uniformOffset = typeLayout->getFieldByIndex(unsigned(fieldIndex))->getOffset();
+    offset.bindingRangeIndex = GfxIndex(typeLayout->getFieldBindingRangeOffset(fieldIndex));
+    return offset;
+}
+
+// Dispatch `groupCounts` groups, and check that every invocation ran exactly once.
+static void _checkDispatch(IDevice* device, IPipelineState* pipeline, const int groupCounts[3])
+{
+    uint32_t threadCounts[3];
+    size_t invocationCount = 1;
+    for (int axis = 0; axis < 3; axis++)
+    {
+        threadCounts[axis] = uint32_t(groupCounts[axis] * kGroupSize[axis]);
+        invocationCount *= threadCounts[axis];
+    }
+
+    List<uint32_t> initialData;
+    initialData.setCount(Slang::Index(invocationCount));
+    for (auto& count : initialData)
+        count = 0;
+
+    IBufferResource::Desc bufferDesc = {};
+    bufferDesc.sizeInBytes = invocationCount * sizeof(uint32_t);
+    bufferDesc.format = Format::Unknown;
+    bufferDesc.elementSize = sizeof(uint32_t);
+    bufferDesc.allowedStates = ResourceStateSet(
+        ResourceState::ShaderResource,
+        ResourceState::UnorderedAccess,
+        ResourceState::CopyDestination,
+        ResourceState::CopySource);
+    bufferDesc.defaultState = ResourceState::UnorderedAccess;
+    bufferDesc.memoryType = MemoryType::DeviceLocal;
+    ComPtr<IBufferResource> buffer;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        device->createBufferResource(bufferDesc, initialData.getBuffer(), buffer.writeRef())));
+
+    IResourceView::Desc viewDesc = {};
+    viewDesc.type = IResourceView::Type::UnorderedAccess;
+    viewDesc.format = Format::Unknown;
+    ComPtr<IResourceView> bufferView;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        device->createBufferView(buffer, nullptr, viewDesc, bufferView.writeRef())));
+
+    ITransientResourceHeap::Desc transientHeapDesc = {};
+    transientHeapDesc.constantBufferSize = 4096;
+    ComPtr<ITransientResourceHeap> transientHeap;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        device->createTransientResourceHeap(transientHeapDesc, transientHeap.writeRef())));
+
+    ICommandQueue::Desc queueDesc = {ICommandQueue::QueueType::Graphics};
+    auto queue = device->createCommandQueue(queueDesc);
+    auto commandBuffer = transientHeap->createCommandBuffer();
+    auto encoder = commandBuffer->encodeComputeCommands();
+    auto rootObject = encoder->bindPipeline(pipeline);
+    ComPtr<IShaderObject> entryPointObject;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(rootObject->getEntryPoint(0, entryPointObject.writeRef())));
+    entryPointObject->setResource(_getFieldOffset(entryPointObject, "counts"), bufferView);
+    entryPointObject->setData(
+        _getFieldOffset(entryPointObject, "threadCounts"),
+        threadCounts,
+        sizeof(threadCounts));
+    SLANG_CHECK(SLANG_SUCCEEDED(
+        encoder->dispatchCompute(groupCounts[0], groupCounts[1], groupCounts[2])));
+    encoder->endEncoding();
+    commandBuffer->close();
+    queue->executeCommandBuffer(commandBuffer);
+    queue->waitOnHost();
+
+    ComPtr<ISlangBlob> resultBlob;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(device->readBufferResource(
+        buffer,
+        0,
+        invocationCount * sizeof(uint32_t),
+        resultBlob.writeRef())));
+    auto counts = (const uint32_t*)resultBlob->getBufferPointer();
+    bool allRanOnce = true;
+    for (size_t i = 0; i < invocationCount; i++)
+        allRanOnce = allRanOnce && counts[i] == 1;
+    SLANG_CHECK(allRanOnce);
+}
+
+SLANG_UNIT_TEST(cpuDispatchTiling)
+{
+    // Three threads split a grid into twelve tiles, which doesn't divide any of the grids
+    // below evenly.
+    CPUDeviceExtendedDesc cpuDesc;
+    cpuDesc.workerThreadCount = 3;
+    void* extendedDescs[] = {&cpuDesc};
+
+    IDevice::Desc deviceDesc = {};
+    deviceDesc.deviceType = DeviceType::CPU;
+    deviceDesc.slang.slangGlobalSession = unitTestContext->slangGlobalSession;
+    deviceDesc.extendedDescCount = 1;
+    deviceDesc.extendedDescs = extendedDescs;
+    ComPtr<IDevice> device;
+    if (SLANG_FAILED(gfxCreateDevice(&deviceDesc, device.writeRef())))
+    {
+        SLANG_IGNORE_TEST
+    }
+
+    IShaderProgram::CreateDesc2 programDesc = {};
+    programDesc.sourceType = ShaderModuleSourceType::SlangSource;
+    programDesc.sourceData = (void*)kCountInvocationsShader;
+    programDesc.sourceDataSize = sizeof(kCountInvocationsShader) - 1;
+    ComPtr<IShaderProgram> program;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(device->createProgram2(programDesc, program.writeRef())));
+
+    ComputePipelineStateDesc pipelineDesc = {};
+    pipelineDesc.program = program;
+    ComPtr<IPipelineState> pipeline;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(device->createComputePipelineState(pipelineDesc, pipeline.writeRef())));
+
+    // Split along z and y, into uneven ranges.
+    const int boxGrid[3] = {13, 7, 5};
+    _checkDispatch(device, pipeline, boxGrid);
+
+    // Split along x only, into uneven ranges.
+    const int rowGrid[3] = {37, 1, 1};
+    _checkDispatch(device, pipeline, rowGrid);
+
+    // Fewer groups than tiles.
+    const int smallGrid[3] = {2, 1, 3};
+    _checkDispatch(device, pipeline, smallGrid);
+}
+
+} // namespace gfx_test
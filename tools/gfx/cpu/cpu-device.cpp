@@ -35,6 +35,28 @@ SLANG_NO_THROW Result SLANG_MCALL DeviceImpl::initialize(const Desc& desc)
 
     SLANG_RETURN_ON_FAIL(RendererBase::initialize(desc));
 
+    // Find extended desc.
+    for (GfxIndex i = 0; i < desc.extendedDescCount; i++)
+    {
+        StructType stype;
+        memcpy(&stype, desc.extendedDescs[i], sizeof(stype));
+        switch (stype)
+        {
+        case StructType::CPUDeviceExtendedDesc:
+            memcpy(&m_extendedDesc, desc.extendedDescs[i], sizeof(m_extendedDesc));
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (m_extendedDesc.workerThreadCount != 1)
+    {
+        m_threadPool = new ThreadPool(Count(m_extendedDesc.workerThreadCount));
+        if (m_threadPool->getThreadCount() <= 1)
+            m_threadPool = nullptr;
+    }
+
     // Initialize DeviceInfo
     {
         m_info.deviceType = DeviceType::CPU;
@@ -161,8 +183,9 @@ SLANG_NO_THROW Result SLANG_MCALL DeviceImpl::createProgram(
     IShaderProgram** outProgram,
     ISlangBlob** outDiagnosticBlob)
 {
+    auto slangSessionLock = lockSlangSession();
     RefPtr<ShaderProgramImpl> cpuProgram = new ShaderProgramImpl();
-    cpuProgram->init(desc);
+    cpuProgram->init(this, desc);
     auto slangGlobalScope = cpuProgram->linkedProgram;
     if (slangGlobalScope)
     {
@@ -260,36 +283,92 @@ void DeviceImpl::dispatchCompute(int x, int y, int z)
 
     auto entryPointObject = m_currentRootObject->getEntryPoint(entryPointIndex);
 
-    ComPtr<ISlangSharedLibrary> sharedLibrary;
-    ComPtr<ISlangBlob> diagnostics;
-    auto compileResult = program->slangGlobalScope->getEntryPointHostCallable(
-        entryPointIndex,
-        targetIndex,
-        sharedLibrary.writeRef(),
-        diagnostics.writeRef());
-    if (diagnostics)
+    if (!program->sharedLibrary)
     {
-        getDebugCallback()->handleMessage(
-            compileResult == SLANG_OK ? DebugMessageType::Warning : DebugMessageType::Error,
-            DebugMessageSource::Slang,
-            (char*)diagnostics->getBufferPointer());
+        auto slangSessionLock = lockSlangSession();
+        ComPtr<ISlangBlob> diagnostics;
+        auto compileResult = program->slangGlobalScope->getEntryPointHostCallable(
+            entryPointIndex,
+            targetIndex,
+            program->sharedLibrary.writeRef(),
+            diagnostics.writeRef());
+        if (diagnostics)
+        {
+            getDebugCallback()->handleMessage(
+                compileResult == SLANG_OK ? DebugMessageType::Warning : DebugMessageType::Error,
+                DebugMessageSource::Slang,
+                (char*)diagnostics->getBufferPointer());
+        }
+        if (SLANG_FAILED(compileResult))
+            return;
     }
-    if (SLANG_FAILED(compileResult))
-        return;
 
-    auto func = (slang_prelude::ComputeFunc)sharedLibrary->findSymbolAddressByName(entryPointName);
-
-    slang_prelude::ComputeVaryingInput varyingInput;
-    varyingInput.startGroupID.x = 0;
-    varyingInput.startGroupID.y = 0;
-    varyingInput.startGroupID.z = 0;
-    varyingInput.endGroupID.x = x;
-    varyingInput.endGroupID.y = y;
-    varyingInput.endGroupID.z = z;
+    auto func = (slang_prelude::ComputeFunc)program->sharedLibrary->findSymbolAddressByName(
+        entryPointName);
 
     auto globalParamsData = m_currentRootObject->getDataBuffer();
     auto entryPointParamsData = entryPointObject->getDataBuffer();
-    func(&varyingInput, entryPointParamsData, globalParamsData);
+
+    if (!m_threadPool)
+    {
+        slang_prelude::ComputeVaryingInput varyingInput;
+        varyingInput.startGroupID.x = 0;
+        varyingInput.startGroupID.y = 0;
+        varyingInput.startGroupID.z = 0;
+        varyingInput.endGroupID.x = x;
+        varyingInput.endGroupID.y = y;
+        varyingInput.endGroupID.z = z;
+
+        func(&varyingInput, entryPointParamsData, globalParamsData);
+        return;
+    }
+
+    // The kernel runs all the groups in the range of its varying input, so we split
+    // the grid into boxes of groups that are run as separate tasks. Having a few
+    // tasks per thread balances the load when groups take different amounts of time.
+    //
+    // Tiles are split off along z first, then y and then x, so that the groups of a
+    // tile are close together in memory for typical row-major data.
+    //
+    const int groupCounts[3] = {x, y, z};
+    int tileCounts[3] = {1, 1, 1};
+    int remainingTileCount = int(m_threadPool->getThreadCount() * 4);
+    for (int axis = 2; axis >= 0; --axis)
+    {
+        tileCounts[axis] = Math::Max(1, Math::Min(groupCounts[axis], remainingTileCount));
+        remainingTileCount = (remainingTileCount + tileCounts[axis] - 1) / tileCounts[axis];
+    }
+
+    auto getTileRange = [&](int axis, int tileIndex, uint32_t& outStart, uint32_t& outEnd)
+    {
+        outStart = uint32_t((int64_t(groupCounts[axis]) * tileIndex) / tileCounts[axis]);
+        outEnd = uint32_t((int64_t(groupCounts[axis]) * (tileIndex + 1)) / tileCounts[axis]);
+    };
+
+    const Index tileCount = Index(tileCounts[0]) * tileCounts[1] * tileCounts[2];
+    m_threadPool->forEach(
+        tileCount,
+        [&](Index tileIndex)
+        {
+            slang_prelude::ComputeVaryingInput varyingInput;
+            getTileRange(
+                0,
+                int(tileIndex % tileCounts[0]),
+                varyingInput.startGroupID.x,
+                varyingInput.endGroupID.x);
+            getTileRange(
+                1,
+                int((tileIndex / tileCounts[0]) % tileCounts[1]),
+                varyingInput.startGroupID.y,
+                varyingInput.endGroupID.y);
+            getTileRange(
+                2,
+                int(tileIndex / (Index(tileCounts[0]) * tileCounts[1])),
+                varyingInput.startGroupID.z,
+                varyingInput.endGroupID.z);
+
+            func(&varyingInput, entryPointParamsData, globalParamsData);
+        });
 }
 
 void DeviceImpl::copyBuffer(
@@ -2,6 +2,7 @@
 #pragma once
 #include "cpu-base.h"
 #include "cpu-pipeline-state.h"
+#include "core/slang-thread-pool.h"
 #include "cpu-shader-object.h"
 
 namespace gfx
@@ -82,6 +83,10 @@ private:
     RefPtr<PipelineStateImpl> m_currentPipeline = nullptr;
     RefPtr<RootShaderObjectImpl> m_currentRootObject = nullptr;
     DeviceInfo m_info;
+    CPUDeviceExtendedDesc m_extendedDesc;
+
+    /// Runs the thread groups of a dispatch, or null if they run on the calling thread
+    RefPtr<ThreadPool> m_threadPool;
 
     virtual void setPipelineState(IPipelineState* state) override;
 
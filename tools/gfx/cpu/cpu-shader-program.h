@@ -15,6 +15,9 @@ class ShaderProgramImpl : public ShaderProgramBase
 public:
     RefPtr<RootShaderObjectLayoutImpl> layout;
 
+    // The compiled entry points, once they have been asked for.
+    ComPtr<ISlangSharedLibrary> sharedLibrary;
+
     ~ShaderProgramImpl() {}
 };
 
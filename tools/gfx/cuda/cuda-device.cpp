@@ -984,11 +984,12 @@ SLANG_NO_THROW Result SLANG_MCALL DeviceImpl::createProgram(
     IShaderProgram** outProgram,
     ISlangBlob** outDiagnosticBlob)
 {
+    auto slangSessionLock = lockSlangSession();
     // If this is a specializable program, we just keep a reference to the slang program and
     // don't actually create any kernels. This program will be specialized later when we know
     // the shader object bindings.
     RefPtr<ShaderProgramImpl> cudaProgram = new ShaderProgramImpl();
-    cudaProgram->init(desc);
+    cudaProgram->init(this, desc);
     cudaProgram->cudaContext = m_context;
     if (desc.slangGlobalScope->getSpecializationParamCount() != 0)
     {
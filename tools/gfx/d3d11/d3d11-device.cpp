@@ -1438,13 +1438,14 @@ Result DeviceImpl::createProgram(
     IShaderProgram** outProgram,
     ISlangBlob** outDiagnosticBlob)
 {
+    auto slangSessionLock = lockSlangSession();
     SLANG_ASSERT(desc.slangGlobalScope);
 
     if (desc.slangGlobalScope->getSpecializationParamCount() != 0)
     {
         // For a specializable program, we don't invoke any actual slang compilation yet.
         RefPtr<ShaderProgramImpl> shaderProgram = new ShaderProgramImpl();
-        shaderProgram->init(desc);
+        shaderProgram->init(this, desc);
         returnComPtr(outProgram, shaderProgram);
         return SLANG_OK;
     }
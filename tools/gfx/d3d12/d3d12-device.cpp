@@ -1980,8 +1980,9 @@ Result DeviceImpl::createProgram(
     IShaderProgram** outProgram,
     ISlangBlob** outDiagnosticBlob)
 {
+    auto slangSessionLock = lockSlangSession();
     RefPtr<ShaderProgramImpl> shaderProgram = new ShaderProgramImpl();
-    shaderProgram->init(desc);
+    shaderProgram->init(this, desc);
     ComPtr<ID3DBlob> d3dDiagnosticBlob;
     auto rootShaderLayoutResult = RootShaderObjectLayoutImpl::create(
         this,
@@ -748,8 +748,10 @@ Result DeviceImpl::createProgram(
 {
     AUTORELEASEPOOL
 
+    auto slangSessionLock = lockSlangSession();
+
     RefPtr<ShaderProgramImpl> shaderProgram = new ShaderProgramImpl(this);
-    shaderProgram->init(desc);
+    shaderProgram->init(this, desc);
 
     RootShaderObjectLayoutImpl::create(
         this,
@@ -2928,11 +2928,12 @@ Result GLDevice::createProgram(
     IShaderProgram** outProgram,
     ISlangBlob** outDiagnosticBlob)
 {
+    auto slangSessionLock = lockSlangSession();
     if (desc.slangGlobalScope->getSpecializationParamCount() != 0)
     {
         // For a specializable program, we don't invoke any actual slang compilation yet.
         RefPtr<ShaderProgramImpl> shaderProgram = new ShaderProgramImpl(m_weakRenderer, 0);
-        shaderProgram->init(desc);
+        shaderProgram->init(this, desc);
         returnComPtr(outProgram, shaderProgram);
         return SLANG_OK;
     }
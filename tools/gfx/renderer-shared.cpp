@@ -350,6 +350,18 @@ void PipelineStateBase::initializeBase(const PipelineStateDesc& inDesc)
             break;
         }
     }
+    // Generic parameters cannot be specialized to `__Dynamic`, only interface-typed ones.
+    canSpecializeToDynamic = false;
+    if (isSpecializable && program->linkedProgram &&
+        program->linkedProgram->getLayout()->getTypeParameterCount() == 0)
+    {
+        canSpecializeToDynamic = true;
+        for (auto& entryPoint : program->slangEntryPoints)
+        {
+            if (entryPoint->getSpecializationParamCount() != 0)
+                canSpecializeToDynamic = false;
+        }
+    }
     // Hold a strong reference to inputLayout and framebufferLayout objects to prevent it from
     // destruction.
     if (inDesc.type == PipelineType::Graphics)
@@ -366,6 +378,8 @@ Result RendererBase::getEntryPointCodeFromShaderCache(
     slang::IBlob** outCode,
     slang::IBlob** outDiagnostics)
 {
+    auto slangSessionLock = lockSlangSession();
+
     // Immediately call getEntryPointCode if no shader cache has been initialized
     if (!persistentShaderCache)
     {
@@ -447,6 +461,22 @@ SLANG_NO_THROW Result SLANG_MCALL RendererBase::initialize(const Desc& desc)
                 (void**)m_pipelineCreationAPIDispatcher.writeRef());
         }
     }
+
+    for (GfxIndex i = 0; i < desc.extendedDescCount; i++)
+    {
+        StructType stype;
+        memcpy(&stype, desc.extendedDescs[i], sizeof(stype));
+        if (stype == StructType::PipelineSpecializationDesc)
+        {
+            PipelineSpecializationDesc specializationDesc;
+            memcpy(&specializationDesc, desc.extendedDescs[i], sizeof(specializationDesc));
+            if (specializationDesc.asynchronous && !m_pipelineSpecializer)
+            {
+                m_slangSessionMutex = new SlangSessionMutex();
+                m_pipelineSpecializer = new PipelineSpecializer(this, specializationDesc);
+            }
+        }
+    }
     return SLANG_OK;
 }
 
@@ -600,6 +630,7 @@ Result RendererBase::createProgram2(
     IShaderProgram** outProgram,
     ISlangBlob** outDiagnostic)
 {
+    auto slangSessionLock = lockSlangSession();
     auto slangSession = slangContext.session.get();
     slang::IModule* module = nullptr;
     ComPtr<slang::IBlob> diagnosticsBlob;
@@ -789,6 +820,7 @@ Result RendererBase::getShaderObjectLayout(
     ShaderObjectContainerType container,
     ShaderObjectLayoutBase** outLayout)
 {
+    auto slangSessionLock = lockSlangSession();
     switch (container)
     {
     case ShaderObjectContainerType::StructuredBuffer:
@@ -815,6 +847,7 @@ Result RendererBase::getShaderObjectLayout(
     RefPtr<ShaderObjectLayoutBase> shaderObjectLayout;
     if (!m_shaderObjectLayoutCache.tryGetValue(typeLayout, shaderObjectLayout))
     {
+        auto slangSessionLock = lockSlangSession();
         SLANG_RETURN_ON_FAIL(
             createShaderObjectLayout(session, typeLayout, shaderObjectLayout.writeRef()));
         m_shaderObjectLayoutCache.add(typeLayout, shaderObjectLayout);
@@ -921,6 +954,156 @@ void ShaderCache::addSpecializedPipeline(
     specializedPipelines[key] = specializedPipeline;
 }
 
+PipelineSpecializer::PipelineSpecializer(
+    RendererBase* device,
+    const PipelineSpecializationDesc& desc)
+    : m_device(device), m_desc(desc)
+{
+    // The pool counts the thread that submits the tasks, which does not run the async ones.
+    Count workerThreadCount = desc.workerThreadCount ? Count(desc.workerThreadCount)
+                                                     : ThreadPool::getHardwareThreadCount();
+    m_threadPool = new ThreadPool(workerThreadCount + 1);
+}
+
+PipelineSpecializer::~PipelineSpecializer()
+{
+    // Waits for the running jobs, queued jobs are dropped.
+    m_threadPool = nullptr;
+}
+
+Result PipelineSpecializer::request(
+    const PipelineKey& key,
+    PipelineStateBase* pipeline,
+    const ExtendedShaderObjectTypeList& specializationArgs)
+{
+    Job* jobPtr = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_failedKeys.contains(key))
+            return SLANG_FAIL;
+        if (m_jobs.containsKey(key))
+            return SLANG_OK;
+
+        RefPtr<Job> job = new Job();
+        job->key = key;
+        job->pipeline = pipeline;
+        job->specializationArgs = specializationArgs;
+        m_jobs.add(key, job);
+        jobPtr = job;
+    }
+    // The task only holds a plain pointer, as reference counts are not atomic. The job stays
+    // alive in `m_jobs` until it is taken after its completion.
+    m_threadPool->runAsync([this, jobPtr]() { _run(jobPtr); });
+    return SLANG_OK;
+}
+
+void PipelineSpecializer::wait(const PipelineKey& key)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_jobCompleted.wait(
+        lock,
+        [&]()
+        {
+            auto job = m_jobs.tryGetValue(key);
+            return !job || (*job)->isCompleted;
+        });
+}
+
+void PipelineSpecializer::addFailedKey(const PipelineKey& key)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_failedKeys.add(key);
+}
+
+void PipelineSpecializer::takeCompletedJobs(List<RefPtr<Job>>& outJobs)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_hasCompletedJobs.store(false, std::memory_order_relaxed);
+    for (auto& job : m_completedJobs)
+    {
+        if (SLANG_FAILED(job->result))
+            m_failedKeys.add(job->key);
+        m_jobs.remove(job->key);
+        outJobs.add(job);
+    }
+    m_completedJobs.clear();
+}
+
+void PipelineSpecializer::_run(Job* job)
+{
+    _specialize(job);
+    _onCompleted(job);
+}
+
+void PipelineSpecializer::_specialize(Job* job)
+{
+    job->result = m_device->specializePipelineProgram(
+        job->pipeline,
+        job->specializationArgs,
+        job->specializedComponentType.writeRef(),
+        job->diagnostics.writeRef());
+    if (SLANG_FAILED(job->result))
+        return;
+
+    // Generate the code of the specialized program, which Slang keeps with it, so that
+    // creating the pipeline does not have to. Programs linked per entry point are compiled when
+    // their pipeline is created. Errors are reported when the code is generated again then.
+    // The session is locked for each entry point, so that other threads can use it in between.
+    auto program = job->pipeline->desc.getProgram();
+    if (program->desc.linkingStyle != IShaderProgram::LinkingStyle::SingleProgram)
+        return;
+    auto specializedProgram = job->specializedComponentType.get();
+    SlangInt entryPointCount = 0;
+    {
+        auto slangSessionLock = m_device->lockSlangSession();
+        entryPointCount = (SlangInt)specializedProgram->getLayout()->getEntryPointCount();
+    }
+    for (SlangInt i = 0; i < entryPointCount; i++)
+    {
+        auto slangSessionLock = m_device->lockSlangSession();
+        ComPtr<slang::IBlob> diagnostics;
+        if (m_device->slangContext.compileTarget == SLANG_SHADER_HOST_CALLABLE)
+        {
+            ComPtr<ISlangSharedLibrary> sharedLibrary;
+            specializedProgram->getEntryPointHostCallable(
+                i,
+                0,
+                sharedLibrary.writeRef(),
+                diagnostics.writeRef());
+        }
+        else
+        {
+            ComPtr<slang::IBlob> code;
+            m_device->getEntryPointCodeFromShaderCache(
+                specializedProgram,
+                i,
+                0,
+                code.writeRef(),
+                diagnostics.writeRef());
+        }
+    }
+}
+
+void PipelineSpecializer::_onCompleted(Job* job)
+{
+    // The job is handed over to the threads calling into the device, which may release it as
+    // soon as `m_mutex` is unlocked, so what the callback needs is read before.
+    IPipelineState* pipeline = nullptr;
+    Result result = SLANG_OK;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        job->isCompleted = true;
+        pipeline = job->pipeline;
+        result = job->result;
+        m_completedJobs.add(m_jobs[job->key]);
+        m_hasCompletedJobs.store(true, std::memory_order_release);
+    }
+    m_jobCompleted.notify_all();
+
+    if (m_desc.onSpecializationCompleted)
+        m_desc.onSpecializationCompleted(m_desc.userData, pipeline, result);
+}
+
 void ShaderObjectLayoutBase::initBase(
     RendererBase* renderer,
     slang::ISession* session,
@@ -953,6 +1136,7 @@ Result ShaderObjectBase::_getSpecializedShaderObjectType(ExtendedShaderObjectTyp
     }
     else
     {
+        auto slangSessionLock = getRenderer()->lockSlangSession();
         shaderObjectType.slangType = getRenderer()->slangContext.session->specializeType(
             _getElementTypeLayout()->getType(),
             specializationArgs.components.getArrayView().getBuffer(),
@@ -989,11 +1173,23 @@ Result ShaderObjectBase::setExistentialHeader(
     // this sub-object range, then this is the point where we will detect that
     // fact and error out.
     //
-    uint32_t conformanceID = 0xFFFFFFFF;
-    SLANG_RETURN_ON_FAIL(getLayoutBase()->m_slangSession->getTypeConformanceWitnessSequentialID(
+    // The IDs are remembered by the layout, so that binding objects of the same
+    // types again does not need the Slang session.
+    //
+    auto layout = getLayoutBase();
+    KeyValuePair<slang::TypeReflection*, slang::TypeReflection*> conformance(
         concreteType,
-        existentialType,
-        &conformanceID));
+        existentialType);
+    uint32_t conformanceID = 0xFFFFFFFF;
+    if (!layout->m_conformanceIDs.tryGetValue(conformance, conformanceID))
+    {
+        auto slangSessionLock = getRenderer()->lockSlangSession();
+        SLANG_RETURN_ON_FAIL(layout->m_slangSession->getTypeConformanceWitnessSequentialID(
+            concreteType,
+            existentialType,
+            &conformanceID));
+        layout->m_conformanceIDs.add(conformance, conformanceID);
+    }
     //
     // Once we have the conformance ID, then we can write it into the object
     // at the required offset.
@@ -1058,9 +1254,23 @@ ResourceViewBase* SimpleShaderObjectData::getResourceView(
     }
 }
 
-void ShaderProgramBase::init(const IShaderProgram::Desc& inDesc)
+ShaderProgramBase::~ShaderProgramBase()
+{
+    // Release the Slang objects while the background specialization thread cannot use the
+    // session.
+    std::unique_lock<std::recursive_mutex> slangSessionLock;
+    if (slangSessionMutex)
+        slangSessionLock = std::unique_lock<std::recursive_mutex>(slangSessionMutex->mutex);
+    linkedEntryPoints = decltype(linkedEntryPoints)();
+    linkedProgram = nullptr;
+    slangEntryPoints = decltype(slangEntryPoints)();
+    slangGlobalScope = nullptr;
+}
+
+void ShaderProgramBase::init(RendererBase* device, const IShaderProgram::Desc& inDesc)
 {
     desc = inDesc;
+    slangSessionMutex = device->m_slangSessionMutex;
 
     slangGlobalScope = desc.slangGlobalScope;
     for (GfxIndex i = 0; i < desc.entryPointCount; i++)
@@ -1116,6 +1326,7 @@ void ShaderProgramBase::init(const IShaderProgram::Desc& inDesc)
 
 Result ShaderProgramBase::compileShaders(RendererBase* device)
 {
+    auto slangSessionLock = device->lockSlangSession();
     auto compileTarget = device->slangContext.compileTarget;
     // For a fully specialized program, read and store its kernel code in `shaderProgram`.
     auto compileShader = [&](slang::EntryPointReflection* entryPointInfo,
@@ -1278,6 +1489,206 @@ bool ShaderProgramBase::isMeshShaderProgram() const
     return false;
 }
 
+std::unique_lock<std::recursive_mutex> RendererBase::lockSlangSession()
+{
+    if (!m_slangSessionMutex)
+        return std::unique_lock<std::recursive_mutex>();
+    return std::unique_lock<std::recursive_mutex>(m_slangSessionMutex->mutex);
+}
+
+Result RendererBase::specializePipelineProgram(
+    PipelineStateBase* pipeline,
+    const ExtendedShaderObjectTypeList& args,
+    slang::IComponentType** outSpecializedComponentType,
+    slang::IBlob** outDiagnostics)
+{
+    auto slangSessionLock = lockSlangSession();
+    auto unspecializedProgram = static_cast<ShaderProgramBase*>(
+        pipeline->desc.type == PipelineType::Compute ? pipeline->desc.compute.program
+                                                     : pipeline->desc.graphics.program);
+    return unspecializedProgram->linkedProgram->specialize(
+        args.components.getArrayView().getBuffer(),
+        args.getCount(),
+        outSpecializedComponentType,
+        outDiagnostics);
+}
+
+Result RendererBase::_createSpecializedPipeline(
+    PipelineStateBase* pipeline,
+    slang::IComponentType* specializedComponentType,
+    RefPtr<PipelineStateBase>& outPipeline)
+{
+    auto pipelineType = pipeline->desc.type;
+    auto unspecializedProgram = static_cast<ShaderProgramBase*>(
+        pipelineType == PipelineType::Compute ? pipeline->desc.compute.program
+                                              : pipeline->desc.graphics.program);
+
+    // Now create the specialized shader program using compiled binaries.
+    ComPtr<IShaderProgram> specializedProgram;
+    IShaderProgram::Desc specializedProgramDesc = unspecializedProgram->desc;
+    specializedProgramDesc.slangGlobalScope = specializedComponentType;
+
+    if (specializedProgramDesc.linkingStyle == IShaderProgram::LinkingStyle::SingleProgram)
+    {
+        // When linking style is GraphicsCompute, the specialized global scope already
+        // contains entry-points, so we do not need to supply them again when creating the
+        // specialized pipeline.
+        specializedProgramDesc.entryPointCount = 0;
+    }
+    SLANG_RETURN_ON_FAIL(createProgram(specializedProgramDesc, specializedProgram.writeRef()));
+
+    // Create specialized pipeline state.
+    ComPtr<IPipelineState> specializedPipelineComPtr;
+    switch (pipelineType)
+    {
+    case PipelineType::Compute:
+        {
+            auto pipelineDesc = pipeline->desc.compute;
+            pipelineDesc.program = specializedProgram;
+            SLANG_RETURN_ON_FAIL(
+                createComputePipelineState(pipelineDesc, specializedPipelineComPtr.writeRef()));
+            break;
+        }
+    case PipelineType::Graphics:
+        {
+            auto pipelineDesc = pipeline->desc.graphics;
+            pipelineDesc.program = static_cast<ShaderProgramBase*>(specializedProgram.get());
+            SLANG_RETURN_ON_FAIL(
+                createGraphicsPipelineState(pipelineDesc, specializedPipelineComPtr.writeRef()));
+            break;
+        }
+    case PipelineType::RayTracing:
+        {
+            auto pipelineDesc = pipeline->desc.rayTracing;
+            pipelineDesc.program = static_cast<ShaderProgramBase*>(specializedProgram.get());
+            SLANG_RETURN_ON_FAIL(createRayTracingPipelineState(
+                pipelineDesc.get(),
+                specializedPipelineComPtr.writeRef()));
+            break;
+        }
+    default:
+        break;
+    }
+    outPipeline = static_cast<PipelineStateBase*>(specializedPipelineComPtr.get());
+    outPipeline->unspecializedPipelineState = pipeline;
+    return SLANG_OK;
+}
+
+Result RendererBase::_specializePipeline(
+    PipelineStateBase* pipeline,
+    const ExtendedShaderObjectTypeList& args,
+    RefPtr<PipelineStateBase>& outPipeline)
+{
+    ComPtr<slang::IComponentType> specializedComponentType;
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto compileRs = specializePipelineProgram(
+        pipeline,
+        args,
+        specializedComponentType.writeRef(),
+        diagnosticBlob.writeRef());
+    if (diagnosticBlob)
+    {
+        getDebugCallback()->handleMessage(
+            compileRs == SLANG_OK ? DebugMessageType::Warning : DebugMessageType::Error,
+            DebugMessageSource::Slang,
+            (char*)diagnosticBlob->getBufferPointer());
+    }
+    SLANG_RETURN_ON_FAIL(compileRs);
+    return _createSpecializedPipeline(pipeline, specializedComponentType, outPipeline);
+}
+
+Result RendererBase::_addCompletedSpecializations()
+{
+    // Creating the pipelines needs the Slang session. The background threads only hold it for
+    // one call into Slang at a time, so this does not wait for a whole job.
+    auto slangSessionLock = lockSlangSession();
+
+    List<RefPtr<PipelineSpecializer::Job>> jobs;
+    m_pipelineSpecializer->takeCompletedJobs(jobs);
+    for (auto& job : jobs)
+    {
+        if (job->diagnostics)
+        {
+            getDebugCallback()->handleMessage(
+                job->result == SLANG_OK ? DebugMessageType::Warning : DebugMessageType::Error,
+                DebugMessageSource::Slang,
+                (char*)job->diagnostics->getBufferPointer());
+        }
+        if (SLANG_FAILED(job->result))
+            continue;
+
+        // The code of the specialized program has been generated in the background, so
+        // creating the pipeline from it is cheap.
+        RefPtr<PipelineStateBase> specializedPipelineState;
+        auto createRs = _createSpecializedPipeline(
+            job->pipeline,
+            job->specializedComponentType,
+            specializedPipelineState);
+        if (SLANG_SUCCEEDED(createRs))
+            createRs = specializedPipelineState->ensureAPIPipelineStateCreated();
+        if (SLANG_FAILED(createRs))
+        {
+            m_pipelineSpecializer->addFailedKey(job->key);
+            continue;
+        }
+        shaderCache.addSpecializedPipeline(job->key, specializedPipelineState);
+    }
+    return SLANG_OK;
+}
+
+Result RendererBase::_getPipelineWhileSpecializing(
+    PipelineStateBase* pipeline,
+    const PipelineKey& key,
+    RefPtr<PipelineStateBase>& outPipeline)
+{
+    // Until the specialized pipeline is ready, run the pipeline specialized to `__Dynamic`,
+    // which only has to be created once for all the types that may be bound to it. It is
+    // created before the specialization is queued so that it does not wait for it.
+    RefPtr<PipelineStateBase> dynamicPipeline;
+    if (pipeline->canSpecializeToDynamic)
+    {
+        if (!m_dynamicType)
+        {
+            auto slangSessionLock = lockSlangSession();
+            m_dynamicType = slangContext.session->getDynamicType();
+        }
+        ExtendedShaderObjectType dynamicArg;
+        dynamicArg.slangType = m_dynamicType;
+        dynamicArg.componentID = shaderCache.getComponentId(m_dynamicType);
+
+        ExtendedShaderObjectTypeList dynamicArgs;
+        for (Index i = 0; i < specializationArgs.getCount(); i++)
+            dynamicArgs.add(dynamicArg);
+
+        PipelineKey dynamicKey;
+        dynamicKey.pipeline = pipeline;
+        dynamicKey.specializationArgs.addRange(dynamicArgs.componentIDs);
+        dynamicKey.updateHash();
+
+        dynamicPipeline = shaderCache.getSpecializedPipelineState(dynamicKey);
+        if (!dynamicPipeline)
+        {
+            if (SLANG_SUCCEEDED(_specializePipeline(pipeline, dynamicArgs, dynamicPipeline)))
+                shaderCache.addSpecializedPipeline(dynamicKey, dynamicPipeline);
+            else
+                pipeline->canSpecializeToDynamic = false;
+        }
+    }
+
+    SLANG_RETURN_ON_FAIL(m_pipelineSpecializer->request(key, pipeline, specializationArgs));
+    if (dynamicPipeline)
+    {
+        outPipeline = dynamicPipeline;
+        return SLANG_OK;
+    }
+
+    // Otherwise there is nothing to run in the meantime.
+    m_pipelineSpecializer->wait(key);
+    SLANG_RETURN_ON_FAIL(_addCompletedSpecializations());
+    outPipeline = shaderCache.getSpecializedPipelineState(key);
+    return outPipeline ? SLANG_OK : SLANG_FAIL;
+}
+
 Result RendererBase::maybeSpecializePipeline(
     PipelineStateBase* currentPipeline,
     ShaderObjectBase* rootObject,
@@ -1285,7 +1696,6 @@ Result RendererBase::maybeSpecializePipeline(
 {
     outNewPipeline = static_cast<PipelineStateBase*>(currentPipeline);
 
-    auto pipelineType = currentPipeline->desc.type;
     if (currentPipeline->unspecializedPipelineState)
         currentPipeline = currentPipeline->unspecializedPipelineState;
     // If the currently bound pipeline is specializable, we need to specialize it based on bound
@@ -1301,91 +1711,33 @@ Result RendererBase::maybeSpecializePipeline(
         pipelineKey.specializationArgs.addRange(specializationArgs.componentIDs);
         pipelineKey.updateHash();
 
+        // Add the pipelines whose specialization has completed in the background, which
+        // is flagged by the completion of their jobs.
+        if (m_pipelineSpecializer && m_pipelineSpecializer->hasCompletedJobs())
+            SLANG_RETURN_ON_FAIL(_addCompletedSpecializations());
+
         RefPtr<PipelineStateBase> specializedPipelineState =
             shaderCache.getSpecializedPipelineState(pipelineKey);
         // Try to find specialized pipeline from shader cache.
         if (!specializedPipelineState)
         {
-            auto unspecializedProgram = static_cast<ShaderProgramBase*>(
-                pipelineType == PipelineType::Compute ? currentPipeline->desc.compute.program
-                                                      : currentPipeline->desc.graphics.program);
-            auto unspecializedProgramLayout = unspecializedProgram->linkedProgram->getLayout();
-
-            ComPtr<slang::IComponentType> specializedComponentType;
-            ComPtr<slang::IBlob> diagnosticBlob;
-            auto compileRs = unspecializedProgram->linkedProgram->specialize(
-                specializationArgs.components.getArrayView().getBuffer(),
-                specializationArgs.getCount(),
-                specializedComponentType.writeRef(),
-                diagnosticBlob.writeRef());
-            if (diagnosticBlob)
-            {
-                getDebugCallback()->handleMessage(
-                    compileRs == SLANG_OK ? DebugMessageType::Warning : DebugMessageType::Error,
-                    DebugMessageSource::Slang,
-                    (char*)diagnosticBlob->getBufferPointer());
-            }
-            SLANG_RETURN_ON_FAIL(compileRs);
-
-            // Now create the specialized shader program using compiled binaries.
-            ComPtr<IShaderProgram> specializedProgram;
-            IShaderProgram::Desc specializedProgramDesc = unspecializedProgram->desc;
-            specializedProgramDesc.slangGlobalScope = specializedComponentType;
-
-            if (specializedProgramDesc.linkingStyle == IShaderProgram::LinkingStyle::SingleProgram)
+            if (m_pipelineSpecializer)
             {
-                // When linking style is GraphicsCompute, the specialized global scope already
-                // contains entry-points, so we do not need to supply them again when creating the
-                // specialized pipeline.
-                specializedProgramDesc.entryPointCount = 0;
+                SLANG_RETURN_ON_FAIL(_getPipelineWhileSpecializing(
+                    currentPipeline,
+                    pipelineKey,
+                    specializedPipelineState));
             }
-            SLANG_RETURN_ON_FAIL(
-                createProgram(specializedProgramDesc, specializedProgram.writeRef()));
-
-            // Create specialized pipeline state.
-            ComPtr<IPipelineState> specializedPipelineComPtr;
-            switch (pipelineType)
+            else
             {
-            case PipelineType::Compute:
-                {
-                    auto pipelineDesc = currentPipeline->desc.compute;
-                    pipelineDesc.program = specializedProgram;
-                    SLANG_RETURN_ON_FAIL(createComputePipelineState(
-                        pipelineDesc,
-                        specializedPipelineComPtr.writeRef()));
-                    break;
-                }
-            case PipelineType::Graphics:
-                {
-                    auto pipelineDesc = currentPipeline->desc.graphics;
-                    pipelineDesc.program =
-                        static_cast<ShaderProgramBase*>(specializedProgram.get());
-                    SLANG_RETURN_ON_FAIL(createGraphicsPipelineState(
-                        pipelineDesc,
-                        specializedPipelineComPtr.writeRef()));
-                    break;
-                }
-            case PipelineType::RayTracing:
-                {
-                    auto pipelineDesc = currentPipeline->desc.rayTracing;
-                    pipelineDesc.program =
-                        static_cast<ShaderProgramBase*>(specializedProgram.get());
-                    SLANG_RETURN_ON_FAIL(createRayTracingPipelineState(
-                        pipelineDesc.get(),
-                        specializedPipelineComPtr.writeRef()));
-                    break;
-                }
-            default:
-                break;
+                SLANG_RETURN_ON_FAIL(_specializePipeline(
+                    currentPipeline,
+                    specializationArgs,
+                    specializedPipelineState));
+                shaderCache.addSpecializedPipeline(pipelineKey, specializedPipelineState);
             }
-            specializedPipelineState =
-                static_cast<PipelineStateBase*>(specializedPipelineComPtr.get());
-            specializedPipelineState->unspecializedPipelineState = currentPipeline;
-            shaderCache.addSpecializedPipeline(pipelineKey, specializedPipelineState);
         }
-        auto specializedPipelineStateBase =
-            static_cast<PipelineStateBase*>(specializedPipelineState.Ptr());
-        outNewPipeline = specializedPipelineStateBase;
+        outNewPipeline = specializedPipelineState;
     }
     return SLANG_OK;
 }
@@ -3,10 +3,15 @@
 #include "core/slang-basic.h"
 #include "core/slang-com-object.h"
 #include "core/slang-persistent-cache.h"
+#include "core/slang-thread-pool.h"
 #include "resource-desc-utils.h"
 #include "slang-context.h"
 #include "slang-gfx.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
 namespace gfx
 {
 
@@ -405,6 +410,13 @@ protected:
 public:
     ComPtr<slang::ISession> m_slangSession;
 
+    // The witness IDs of the conformances looked up for the existential fields of objects of
+    // this layout, keyed by concrete type and interface type.
+    Slang::Dictionary<
+        Slang::KeyValuePair<slang::TypeReflection*, slang::TypeReflection*>,
+        uint32_t>
+        m_conformanceIDs;
+
     ShaderObjectContainerType getContainerType() { return m_containerType; }
 
     static slang::TypeLayoutReflection* _unwrapParameterGroups(
@@ -838,14 +850,28 @@ public:
     virtual Result collectSpecializationArgs(ExtendedShaderObjectTypeList& args) override;
 };
 
+// Serializes the use of the Slang session of a device between the threads calling into the device
+// and the thread specializing pipelines in the background.
+class SlangSessionMutex : public Slang::RefObject
+{
+public:
+    std::recursive_mutex mutex;
+};
+
 class ShaderProgramBase : public IShaderProgram, public Slang::ComObject
 {
 public:
     SLANG_COM_OBJECT_IUNKNOWN_ALL
     IShaderProgram* getInterface(const Slang::Guid& guid);
 
+    ~ShaderProgramBase();
+
     Desc desc;
 
+    // Held while the Slang objects of the program are released, if the device specializes
+    // pipelines in the background.
+    Slang::RefPtr<SlangSessionMutex> slangSessionMutex;
+
     Slang::ComPtr<slang::IComponentType> slangGlobalScope;
     Slang::List<ComPtr<slang::IComponentType>> slangEntryPoints;
 
@@ -856,7 +882,7 @@ public:
     // Linked program for each entry point when linkingStyle is RayTracing.
     Slang::List<Slang::ComPtr<slang::IComponentType>> linkedEntryPoints;
 
-    void init(const IShaderProgram::Desc& desc);
+    void init(RendererBase* device, const IShaderProgram::Desc& desc);
 
     bool isSpecializable()
     {
@@ -1033,6 +1059,11 @@ public:
     // Indicates whether this is a specializable pipeline. A specializable
     // pipeline cannot be used directly and must be specialized first.
     bool isSpecializable = false;
+
+    // Indicates whether all specialization parameters of the program are interface types, so
+    // that the pipeline can run specialized to `__Dynamic` while it is specialized to the bound
+    // types in the background.
+    bool canSpecializeToDynamic = false;
     Slang::RefPtr<ShaderProgramBase> m_program;
     template<typename TProgram>
     TProgram* getProgram()
@@ -1139,6 +1170,72 @@ protected:
     Slang::OrderedDictionary<PipelineKey, Slang::RefPtr<PipelineStateBase>> specializedPipelines;
 };
 
+// Specializes the programs of pipelines on a pool of background threads.
+//
+// A job only uses the Slang session of the device, which it locks around each call into Slang.
+// The specialized pipeline itself is created on the thread calling into the device once the job
+// has completed, as device objects are not thread-safe.
+class PipelineSpecializer : public Slang::RefObject
+{
+public:
+    struct Job : public Slang::RefObject
+    {
+        PipelineKey key;
+        Slang::RefPtr<PipelineStateBase> pipeline;
+        ExtendedShaderObjectTypeList specializationArgs;
+
+        bool isCompleted = false;
+        Result result = SLANG_OK;
+        Slang::ComPtr<slang::IComponentType> specializedComponentType;
+        Slang::ComPtr<slang::IBlob> diagnostics;
+    };
+
+    PipelineSpecializer(RendererBase* device, const PipelineSpecializationDesc& desc);
+    ~PipelineSpecializer();
+
+    // Queues the specialization of `pipeline` with `specializationArgs` unless it is already
+    // queued or has completed. Fails if an earlier specialization of `key` failed.
+    Result request(
+        const PipelineKey& key,
+        PipelineStateBase* pipeline,
+        const ExtendedShaderObjectTypeList& specializationArgs);
+
+    // Waits for the specialization of `key` to complete.
+    void wait(const PipelineKey& key);
+
+    // Fails later requests for `key`, whose pipeline could not be created.
+    void addFailedKey(const PipelineKey& key);
+
+    // Whether jobs have completed since the last call to `takeCompletedJobs`. This is set by the
+    // completion of a job, so that the threads calling into the device do not have to check for
+    // completed jobs at every draw or dispatch.
+    bool hasCompletedJobs() const { return m_hasCompletedJobs.load(std::memory_order_acquire); }
+
+    // Moves the jobs that have completed since the last call to `outJobs`.
+    void takeCompletedJobs(Slang::List<Slang::RefPtr<Job>>& outJobs);
+
+private:
+    void _run(Job* job);
+    void _specialize(Job* job);
+    void _onCompleted(Job* job);
+
+    RendererBase* m_device;
+    PipelineSpecializationDesc m_desc;
+
+    std::mutex m_mutex;
+    std::condition_variable m_jobCompleted;
+
+    // All jobs that are queued, running or not taken yet.
+    Slang::Dictionary<PipelineKey, Slang::RefPtr<Job>> m_jobs;
+    // Jobs that have completed and have not been taken yet.
+    Slang::List<Slang::RefPtr<Job>> m_completedJobs;
+    Slang::HashSet<PipelineKey> m_failedKeys;
+    std::atomic<bool> m_hasCompletedJobs = false;
+
+    // Declared last so that the threads stop before anything they use is destroyed.
+    Slang::RefPtr<Slang::ThreadPool> m_threadPool;
+};
+
 class TransientResourceHeapBase : public ITransientResourceHeap, public Slang::ComObject
 {
 public:
@@ -1371,6 +1468,33 @@ public:
         ShaderObjectBase* rootObject,
         Slang::RefPtr<PipelineStateBase>& outNewPipeline);
 
+    // Locks the Slang session of the device against the background pipeline specialization
+    // threads. The lock does nothing if pipelines are specialized synchronously.
+    std::unique_lock<std::recursive_mutex> lockSlangSession();
+
+    // Specializes the program of `pipeline` with `args`. Only uses the Slang session.
+    Result specializePipelineProgram(
+        PipelineStateBase* pipeline,
+        const ExtendedShaderObjectTypeList& args,
+        slang::IComponentType** outSpecializedComponentType,
+        slang::IBlob** outDiagnostics);
+
+protected:
+    Result _createSpecializedPipeline(
+        PipelineStateBase* pipeline,
+        slang::IComponentType* specializedComponentType,
+        Slang::RefPtr<PipelineStateBase>& outPipeline);
+    Result _specializePipeline(
+        PipelineStateBase* pipeline,
+        const ExtendedShaderObjectTypeList& args,
+        Slang::RefPtr<PipelineStateBase>& outPipeline);
+    Result _addCompletedSpecializations();
+    Result _getPipelineWhileSpecializing(
+        PipelineStateBase* pipeline,
+        const PipelineKey& key,
+        Slang::RefPtr<PipelineStateBase>& outPipeline);
+
+public:
 
     virtual Result createShaderObjectLayout(
         slang::ISession* session,
@@ -1408,6 +1532,12 @@ public:
     Slang::Dictionary<slang::TypeLayoutReflection*, Slang::RefPtr<ShaderObjectLayoutBase>>
         m_shaderObjectLayoutCache;
     Slang::ComPtr<IPipelineCreationAPIDispatcher> m_pipelineCreationAPIDispatcher;
+
+    // Set if pipelines are specialized in the background, see `PipelineSpecializationDesc`.
+    Slang::RefPtr<SlangSessionMutex> m_slangSessionMutex;
+    slang::TypeReflection* m_dynamicType = nullptr;
+    // Declared last so that the background threads stop before anything they use is destroyed.
+    Slang::RefPtr<PipelineSpecializer> m_pipelineSpecializer;
 };
 
 bool isDepthFormat(Format format);
@@ -53,6 +53,7 @@ DeviceImpl::~DeviceImpl()
         waitForGpu();
     }
 
+    m_pipelineSpecializer = nullptr;
     m_shaderObjectLayoutCache = decltype(m_shaderObjectLayoutCache)();
     shaderCache.free();
     m_deviceObjectsWithPotentialBackReferences.clearAndDeallocate();
@@ -2525,8 +2526,9 @@ Result DeviceImpl::createProgram(
     IShaderProgram** outProgram,
     ISlangBlob** outDiagnosticBlob)
 {
+    auto slangSessionLock = lockSlangSession();
     RefPtr<ShaderProgramImpl> shaderProgram = new ShaderProgramImpl(this);
-    shaderProgram->init(desc);
+    shaderProgram->init(this, desc);
 
     m_deviceObjectsWithPotentialBackReferences.add(shaderProgram);
 
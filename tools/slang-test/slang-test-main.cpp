@@ -2024,6 +2024,27 @@ TestResult runLanguageServerTest(TestContext* context, TestInput& input)
         return TestResult::Fail;
     }
 
+    List<UnownedStringSlice> lines;
+    StringUtil::calcLines(testFileContent.getUnownedSlice(), lines);
+
+    // Tests that change the files they depend on check which modules the server reloads,
+    // which it logs when tracing is verbose.
+    bool changesDependencies = false;
+    for (auto line : lines)
+    {
+        line = line.trimStart();
+        if (line.startsWith("//") && line.tail(2).trimStart().startsWith("CHANGE:"))
+            changesDependencies = true;
+    }
+    auto setTrace = [&](const char* value)
+    {
+        LanguageServerProtocol::SetTraceParams setTraceParams;
+        setTraceParams.value = value;
+        connection->sendCall(LanguageServerProtocol::SetTraceParams::methodName, &setTraceParams);
+    };
+    if (changesDependencies)
+        setTrace("verbose");
+
     LanguageServerProtocol::DidOpenTextDocumentParams openDocParams;
     openDocParams.textDocument.version = 0;
     openDocParams.textDocument.uri = URI::fromLocalFilePath(fullPath.getUnownedSlice()).uri;
@@ -2032,8 +2053,10 @@ TestResult runLanguageServerTest(TestContext* context, TestInput& input)
         LanguageServerProtocol::DidOpenTextDocumentParams::methodName,
         &openDocParams,
         JSONValue::makeInt(1));
+    List<String> changedDocURIs;
     List<LanguageServerProtocol::PublishDiagnosticsParams> diagnostics;
     bool diagnosticsReceived = false;
+    StringBuilder actualOutputSB;
     auto waitForNonDiagnosticResponse = [&]() -> SlangResult
     {
         repeat:
@@ -2052,14 +2075,18 @@ TestResult runLanguageServerTest(TestContext* context, TestInput& input)
                     diagnostics.add(arg);
                     goto repeat;
                 }
+                if (call.method == LanguageServerProtocol::LogMessageParams::methodName)
+                {
+                    LanguageServerProtocol::LogMessageParams arg;
+                    if (SLANG_FAILED(connection->getMessage(&arg)))
+                        return SLANG_FAIL;
+                    actualOutputSB << "--------\nlog: " << arg.message << "\n";
+                    goto repeat;
+                }
             }
             return SLANG_OK;
     };
 
-    List<UnownedStringSlice> lines;
-    StringUtil::calcLines(testFileContent.getUnownedSlice(), lines);
-
-    StringBuilder actualOutputSB;
     auto parseLocation = [&](UnownedStringSlice text, Index startPos, Int& linePos, Int& colPos)
     {
         linePos = StringUtil::parseIntAndAdvancePos(text.trimStart(), startPos);
@@ -2160,6 +2187,50 @@ TestResult runLanguageServerTest(TestContext* context, TestInput& input)
                 }
             }
         }
+        else if (line.startsWith("CHANGE:"))
+        {
+            // Open a file that the test file depends on with one of its lines replaced, as if
+            // it was being edited: `CHANGE:<path relative to the test file>:<line>:<text>`.
+            auto arg = line.tail(UnownedStringSlice("CHANGE:").getLength());
+            Index pathEnd = arg.indexOf(':');
+            if (pathEnd == -1)
+                return TestResult::Fail;
+            auto rest = arg.tail(pathEnd + 1);
+            Index lineEnd = rest.indexOf(':');
+            Int changedLineIndex = 0;
+            if (lineEnd == -1 ||
+                SLANG_FAILED(StringUtil::parseInt(rest.head(lineEnd).trim(), changedLineIndex)))
+                return TestResult::Fail;
+
+            String changedPath;
+            Path::getCanonical(
+                Path::combine(Path::getParentDirectory(fullPath), arg.head(pathEnd)),
+                changedPath);
+            String changedFileContent;
+            if (SLANG_FAILED(File::readAllText(changedPath, changedFileContent)))
+                return TestResult::Fail;
+            List<UnownedStringSlice> changedLines;
+            StringUtil::calcLines(changedFileContent.getUnownedSlice(), changedLines);
+            StringBuilder changedText;
+            for (Index i = 0; i < changedLines.getCount(); i++)
+            {
+                if (i == changedLineIndex - 1)
+                    changedText << rest.tail(lineEnd + 1) << "\n";
+                else
+                    changedText << changedLines[i] << "\n";
+            }
+
+            LanguageServerProtocol::DidOpenTextDocumentParams changeDocParams;
+            changeDocParams.textDocument.version = 0;
+            changeDocParams.textDocument.uri =
+                URI::fromLocalFilePath(changedPath.getUnownedSlice()).uri;
+            changeDocParams.textDocument.text = changedText.produceString();
+            connection->sendCall(
+                LanguageServerProtocol::DidOpenTextDocumentParams::methodName,
+                &changeDocParams,
+                JSONValue::makeInt(1));
+            changedDocURIs.add(changeDocParams.textDocument.uri);
+        }
         else if (line.startsWith("HOVER:"))
         {
             auto arg = line.tail(UnownedStringSlice("HOVER:").getLength());
@@ -2213,12 +2284,36 @@ TestResult runLanguageServerTest(TestContext* context, TestInput& input)
             }
         }
     }
+    if (changesDependencies)
+    {
+        // The server logs after it responds to the request that made it reload modules, so
+        // make one more request to receive the messages logged after the last response.
+        setTrace("off");
+        LanguageServerProtocol::HoverParams params;
+        params.textDocument.uri = openDocParams.textDocument.uri;
+        if (SLANG_FAILED(connection->sendCall(
+                LanguageServerProtocol::HoverParams::methodName,
+                &params,
+                JSONValue::makeInt(callId++))) ||
+            SLANG_FAILED(waitForNonDiagnosticResponse()))
+        {
+            return TestResult::Fail;
+        }
+    }
     LanguageServerProtocol::DidCloseTextDocumentParams closeDocParams;
     closeDocParams.textDocument.uri = URI::fromLocalFilePath(fullPath.getUnownedSlice()).uri;
     connection->sendCall(
         LanguageServerProtocol::DidCloseTextDocumentParams::methodName,
         &closeDocParams,
         JSONValue::makeInt(1));
+    for (auto& uri : changedDocURIs)
+    {
+        closeDocParams.textDocument.uri = uri;
+        connection->sendCall(
+            LanguageServerProtocol::DidCloseTextDocumentParams::methodName,
+            &closeDocParams,
+            JSONValue::makeInt(1));
+    }
 
     auto outputStem = input.outputStem;
     String expectedOutputPath = outputStem + ".expected.txt";
@@ -0,0 +1,90 @@
+// unit-test-binary-module-up-to-date.cpp
+
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-process.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that a precompiled module whose dependencies are files of the operating system is
+// only up to date while the contents of those files are the same.
+
+static bool _isUpToDate(
+    slang::IGlobalSession* globalSession,
+    const String& modulePath,
+    ISlangBlob* moduleBlob)
+{
+    slang::SessionDesc sessionDesc = {};
+    ComPtr<slang::ISession> session;
+    if (SLANG_FAILED(globalSession->createSession(sessionDesc, session.writeRef())))
+        return false;
+    return session->isBinaryModuleUpToDate(modulePath.getBuffer(), moduleBlob);
+}
+
+SLANG_UNIT_TEST(binaryModuleUpToDate)
+{
+    const char* includedSource = "int helper() { return 1; }\n";
+    const char* changedIncludedSource = "int helper() { return 2 + 3; }\n";
+
+    auto moduleName = "binaryModuleUpToDate" + String(Process::getId());
+    String modulePath = moduleName + ".slang";
+    String includedPath = moduleName + "-included.slang";
+
+    StringBuilder moduleSource;
+    moduleSource << "#include \"" << includedPath << "\"\n";
+    moduleSource << "public int f() { return helper(); }\n";
+
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(modulePath, moduleSource)));
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(includedPath, includedSource)));
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    ComPtr<ISlangBlob> moduleBlob;
+    {
+        slang::SessionDesc sessionDesc = {};
+        ComPtr<slang::ISession> session;
+        SLANG_CHECK_ABORT(
+            SLANG_SUCCEEDED(globalSession->createSession(sessionDesc, session.writeRef())));
+        auto module = session->loadModule(moduleName.getBuffer());
+        SLANG_CHECK_ABORT(module);
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(module->serialize(moduleBlob.writeRef())));
+    }
+
+    // Unchanged files are found to be the same from their size and modification time.
+    SLANG_CHECK(_isUpToDate(globalSession, modulePath, moduleBlob));
+
+    // A changed dependency makes the module out of date.
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(includedPath, changedIncludedSource)));
+    SLANG_CHECK(!_isUpToDate(globalSession, modulePath, moduleBlob));
+
+    // Writing back the original contents changes the modification time but not the contents,
+    // so the module is up to date again, with or without the digest the session remembered.
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(includedPath, includedSource)));
+    SLANG_CHECK(_isUpToDate(globalSession, modulePath, moduleBlob));
+    SLANG_CHECK(_isUpToDate(globalSession, modulePath, moduleBlob));
+
+    // A dependency changed after the module read it, but before the module was serialized,
+    // makes the module out of date, as its stat is the one from when it was read.
+    const char* sameSizeIncludedSource = "int helper() { return 7; }\n";
+    ComPtr<ISlangBlob> staleModuleBlob;
+    {
+        slang::SessionDesc sessionDesc = {};
+        ComPtr<slang::ISession> session;
+        SLANG_CHECK_ABORT(
+            SLANG_SUCCEEDED(globalSession->createSession(sessionDesc, session.writeRef())));
+        auto module = session->loadModule(moduleName.getBuffer());
+        SLANG_CHECK_ABORT(module);
+        SLANG_CHECK_ABORT(
+            SLANG_SUCCEEDED(File::writeAllText(includedPath, sameSizeIncludedSource)));
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(module->serialize(staleModuleBlob.writeRef())));
+    }
+    SLANG_CHECK(!_isUpToDate(globalSession, modulePath, staleModuleBlob));
+    SLANG_CHECK(!_isUpToDate(globalSession, modulePath, staleModuleBlob));
+
+    File::remove(modulePath);
+    File::remove(includedPath);
+}
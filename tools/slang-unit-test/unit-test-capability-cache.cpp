@@ -0,0 +1,116 @@
+// unit-test-capability-cache.cpp
+
+#include "../../source/core/slang-string-util.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that checking capabilities gives the same results when the capability sets involved
+// have been interned, and the results of operations on them cached, by an earlier session
+// as when they are computed for the first time.
+
+static const char* kSharedSource = R"(
+    RWStructuredBuffer<int> sideEffect;
+
+    void glslOnly()
+    {
+        __target_switch
+        {
+        case glsl:
+            sideEffect[0] = 1;
+        }
+    }
+)";
+
+// Calls a function only available for GLSL from code that requires SPIR-V.
+static const char* kIncompatibleSource = R"(
+    [require(spirv)]
+    public void usesGlslOnly()
+    {
+        glslOnly();
+    }
+)";
+
+// Calls a function only available for GLSL from code that requires GLSL.
+static const char* kCompatibleSource = R"(
+    [require(glsl)]
+    public void usesGlslOnly()
+    {
+        glslOnly();
+    }
+)";
+
+static bool _loadModule(
+    slang::IGlobalSession* globalSession,
+    const char* moduleName,
+    const char* source,
+    String& outDiagnostics)
+{
+    slang::SessionDesc sessionDesc = {};
+    ComPtr<slang::ISession> session;
+    if (SLANG_FAILED(globalSession->createSession(sessionDesc, session.writeRef())))
+        return false;
+
+    String moduleSource = String(kSharedSource) + source;
+    String modulePath = String(moduleName) + ".slang";
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        moduleName,
+        modulePath.getBuffer(),
+        moduleSource.getBuffer(),
+        diagnosticBlob.writeRef());
+    outDiagnostics = diagnosticBlob ? StringUtil::getString(diagnosticBlob) : String();
+    return module != nullptr;
+}
+
+SLANG_UNIT_TEST(capabilityCache)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    String firstIncompatibleDiagnostics;
+    SLANG_CHECK(!_loadModule(
+        globalSession,
+        "incompatible",
+        kIncompatibleSource,
+        firstIncompatibleDiagnostics));
+    SLANG_CHECK(firstIncompatibleDiagnostics.indexOf(UnownedStringSlice("error")) >= 0);
+
+    String firstCompatibleDiagnostics;
+    SLANG_CHECK(
+        _loadModule(globalSession, "compatible", kCompatibleSource, firstCompatibleDiagnostics));
+    SLANG_CHECK(firstCompatibleDiagnostics.indexOf(UnownedStringSlice("error")) < 0);
+
+    // Later sessions find the sets interned and the results of `join`, `implies` and
+    // `isIncompatibleWith` cached, in either order.
+    for (int i = 0; i < 2; ++i)
+    {
+        String compatibleDiagnostics;
+        SLANG_CHECK(
+            _loadModule(globalSession, "compatible", kCompatibleSource, compatibleDiagnostics));
+        SLANG_CHECK(compatibleDiagnostics == firstCompatibleDiagnostics);
+
+        String incompatibleDiagnostics;
+        SLANG_CHECK(!_loadModule(
+            globalSession,
+            "incompatible",
+            kIncompatibleSource,
+            incompatibleDiagnostics));
+        SLANG_CHECK(incompatibleDiagnostics == firstIncompatibleDiagnostics);
+    }
+
+    // A second global session shares the interned sets with the first.
+    ComPtr<slang::IGlobalSession> otherGlobalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, otherGlobalSession.writeRef()) == SLANG_OK);
+    String incompatibleDiagnostics;
+    SLANG_CHECK(!_loadModule(
+        otherGlobalSession,
+        "incompatible",
+        kIncompatibleSource,
+        incompatibleDiagnostics));
+    SLANG_CHECK(incompatibleDiagnostics == firstIncompatibleDiagnostics);
+}
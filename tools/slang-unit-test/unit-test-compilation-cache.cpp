@@ -0,0 +1,290 @@
+// unit-test-compilation-cache.cpp
+
+#include "../../source/core/slang-crypto.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-process.h"
+#include "../../source/core/slang-riff.h"
+#include "../../source/core/slang-string-util.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that entry point code is stored in and read from the persistent compilation
+// cache when a cache directory is specified for a session, along with the diagnostics
+// and metadata produced with it, and that the diagnostics of layout are reported when
+// code is read from the cache.
+
+static SlangResult _compileWithCache(
+    slang::IGlobalSession* globalSession,
+    const String& cacheDirectory,
+    ISlangBlob** outHash,
+    ISlangBlob** outCode,
+    ISlangBlob** outDiagnostics,
+    slang::IMetadata** outMetadata)
+{
+    const char* userSourceBody = R"(
+        RWStructuredBuffer<float> result;
+
+        [shader("compute")]
+        [numthreads(4, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID)
+        {
+            result[tid.x] = tid.x * 2.0f;
+        }
+    )";
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::CompilerOptionEntry compilerOption;
+    compilerOption.name = slang::CompilerOptionName::CompilationCacheDirectory;
+    compilerOption.value.kind = slang::CompilerOptionValueKind::String;
+    compilerOption.value.stringValue0 = cacheDirectory.getBuffer();
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.compilerOptionEntries = &compilerOption;
+    sessionDesc.compilerOptionEntryCount = 1;
+
+    ComPtr<slang::ISession> session;
+    SLANG_RETURN_ON_FAIL(globalSession->createSession(sessionDesc, session.writeRef()));
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        userSourceBody,
+        diagnosticBlob.writeRef());
+    if (!module)
+        return SLANG_FAIL;
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_RETURN_ON_FAIL(module->findEntryPointByName("computeMain", entryPoint.writeRef()));
+
+    slang::IComponentType* componentTypes[2] = {module, entryPoint.get()};
+    ComPtr<slang::IComponentType> composedProgram;
+    SLANG_RETURN_ON_FAIL(session->createCompositeComponentType(
+        componentTypes,
+        2,
+        composedProgram.writeRef(),
+        diagnosticBlob.writeRef()));
+
+    ComPtr<slang::IComponentType> linkedProgram;
+    SLANG_RETURN_ON_FAIL(composedProgram->link(linkedProgram.writeRef(), diagnosticBlob.writeRef()));
+
+    linkedProgram->getEntryPointHash(0, 0, outHash);
+    SLANG_RETURN_ON_FAIL(linkedProgram->getEntryPointCode(0, 0, outCode, outDiagnostics));
+    return linkedProgram->getEntryPointMetadata(0, 0, outMetadata, diagnosticBlob.writeRef());
+}
+
+static bool _isUAVRegisterUsed(slang::IMetadata* metadata, SlangUInt registerIndex)
+{
+    bool isUsed = false;
+    metadata->isParameterLocationUsed(
+        SLANG_PARAMETER_CATEGORY_UNORDERED_ACCESS,
+        0,
+        registerIndex,
+        isUsed);
+    return isUsed;
+}
+
+SLANG_UNIT_TEST(compilationCache)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    String cacheDirectory = Path::simplify(
+        Path::getParentDirectory(Path::getExecutablePath()) + "/compilation-cache-test" +
+        String(Process::getId()));
+    Path::removeNonEmpty(cacheDirectory);
+
+    // Compile once to populate the cache.
+    ComPtr<ISlangBlob> hash;
+    ComPtr<ISlangBlob> code;
+    ComPtr<ISlangBlob> diagnostics;
+    ComPtr<slang::IMetadata> metadata;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compileWithCache(
+        globalSession,
+        cacheDirectory,
+        hash.writeRef(),
+        code.writeRef(),
+        diagnostics.writeRef(),
+        metadata.writeRef())));
+    SLANG_CHECK_ABORT(hash && code && metadata);
+    SLANG_CHECK(_isUAVRegisterUsed(metadata, 0));
+
+    // The code should have been stored in the cache, keyed by the entry point hash.
+    String entryFileName =
+        Path::simplify(cacheDirectory + "/" + SHA1::Digest(hash.get()).toString());
+    SLANG_CHECK(File::exists(entryFileName));
+
+    // Replace the cached entry, and check that a new session returns its code, reports its
+    // diagnostics and uses its metadata instead of generating code again. An entry is a
+    // RIFF holding the code, the diagnostics, and the used binding ranges and other metadata.
+    const char cachedCode[] = "// cached code";
+    const char cachedDiagnostics[] = "m.slang: warning: cached warning\n";
+    {
+        RIFF::Builder riff;
+        RIFF::BuildCursor cursor(riff);
+        SLANG_SCOPED_RIFF_BUILDER_LIST_CHUNK(cursor, SLANG_FOUR_CC('S', 'E', 'P', 'R'));
+        cursor.addDataChunk(SLANG_FOUR_CC('c', 'o', 'd', 'e'), cachedCode, sizeof(cachedCode));
+        cursor.addDataChunk(
+            SLANG_FOUR_CC('d', 'i', 'a', 'g'),
+            cachedDiagnostics,
+            strlen(cachedDiagnostics));
+        {
+            SLANG_SCOPED_RIFF_BUILDER_LIST_CHUNK(cursor, SLANG_FOUR_CC('m', 'e', 't', 'a'));
+            SLANG_SCOPED_RIFF_BUILDER_DATA_CHUNK(cursor, SLANG_FOUR_CC('b', 'i', 'n', 'd'));
+            // A single UAV register, `u1` in space 0.
+            cursor.addData(UInt64(SLANG_PARAMETER_CATEGORY_UNORDERED_ACCESS));
+            cursor.addData(UInt64(0));
+            cursor.addData(UInt64(1));
+            cursor.addData(UInt64(1));
+        }
+        ComPtr<ISlangBlob> entryBlob;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(riff.writeToBlob(entryBlob.writeRef())));
+        SLANG_CHECK(SLANG_SUCCEEDED(File::writeAllBytes(
+            entryFileName,
+            entryBlob->getBufferPointer(),
+            entryBlob->getBufferSize())));
+    }
+
+    ComPtr<ISlangBlob> cachedHash;
+    ComPtr<ISlangBlob> cachedCodeBlob;
+    ComPtr<ISlangBlob> cachedDiagnosticsBlob;
+    ComPtr<slang::IMetadata> cachedMetadata;
+    SLANG_CHECK(SLANG_SUCCEEDED(_compileWithCache(
+        globalSession,
+        cacheDirectory,
+        cachedHash.writeRef(),
+        cachedCodeBlob.writeRef(),
+        cachedDiagnosticsBlob.writeRef(),
+        cachedMetadata.writeRef())));
+    SLANG_CHECK(
+        cachedHash && cachedHash->getBufferSize() == hash->getBufferSize() &&
+        ::memcmp(
+            cachedHash->getBufferPointer(),
+            hash->getBufferPointer(),
+            hash->getBufferSize()) == 0);
+    SLANG_CHECK(
+        cachedCodeBlob && cachedCodeBlob->getBufferSize() == sizeof(cachedCode) &&
+        ::memcmp(cachedCodeBlob->getBufferPointer(), cachedCode, sizeof(cachedCode)) == 0);
+    SLANG_CHECK(
+        cachedDiagnosticsBlob &&
+        UnownedStringSlice((const char*)cachedDiagnosticsBlob->getBufferPointer())
+                .indexOf(UnownedStringSlice("cached warning")) >= 0);
+    SLANG_CHECK_ABORT(cachedMetadata);
+    SLANG_CHECK(!_isUAVRegisterUsed(cachedMetadata, 0));
+    SLANG_CHECK(_isUAVRegisterUsed(cachedMetadata, 1));
+
+    Path::removeNonEmpty(cacheDirectory);
+}
+
+// Compile a program whose layout has a warning with an end-to-end compile request.
+static SlangResult _compileRequestWithCache(
+    SlangSession* session,
+    const String& cacheDirectory,
+    ISlangBlob** outHash,
+    String& outCode,
+    String& outDiagnostics)
+{
+    const char* userSource = R"(
+        Texture2D a : register(t0);
+        Texture2D b : register(t0);
+        RWStructuredBuffer<float4> result : register(u0);
+
+        [shader("compute")]
+        [numthreads(4, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID)
+        {
+            result[tid.x] = a.Load(int3(0)) + b.Load(int3(0));
+        }
+    )";
+
+    auto request = spCreateCompileRequest(session);
+    const char* args[] = {"-cache-dir", cacheDirectory.getBuffer()};
+    SlangResult result = spProcessCommandLineArguments(request, args, 2);
+
+    const int targetIndex = spAddCodeGenTarget(request, SLANG_HLSL);
+    spSetTargetProfile(request, targetIndex, spFindProfile(session, "sm_5_0"));
+    int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "m");
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "m.slang", userSource);
+    spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    if (SLANG_SUCCEEDED(result))
+        result = spCompile(request);
+    outDiagnostics = spGetDiagnosticOutput(request);
+
+    if (SLANG_SUCCEEDED(result))
+    {
+        ComPtr<ISlangBlob> code;
+        spGetEntryPointCodeBlob(request, 0, 0, code.writeRef());
+        outCode = code ? StringUtil::getString(code) : String();
+
+        ComPtr<slang::IComponentType> program;
+        result = spCompileRequest_getProgramWithEntryPoints(request, program.writeRef());
+        if (SLANG_SUCCEEDED(result))
+            program->getEntryPointHash(0, 0, outHash);
+    }
+
+    spDestroyCompileRequest(request);
+    return result;
+}
+
+SLANG_UNIT_TEST(compilationCacheLayoutDiagnostics)
+{
+    auto session = spCreateSession();
+
+    String cacheDirectory = Path::simplify(
+        Path::getParentDirectory(Path::getExecutablePath()) + "/compilation-cache-layout-test" +
+        String(Process::getId()));
+    Path::removeNonEmpty(cacheDirectory);
+
+    ComPtr<ISlangBlob> hash;
+    String code;
+    String diagnostics;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        _compileRequestWithCache(session, cacheDirectory, hash.writeRef(), code, diagnostics)));
+    SLANG_CHECK_ABORT(hash);
+    SLANG_CHECK(diagnostics.indexOf(toSlice("overlaps")) >= 0);
+
+    // Replace the cached entry with one that has code but no diagnostics. The warning of
+    // layout isn't stored in the cache, so it still has to be reported along with the
+    // cached code.
+    String entryFileName =
+        Path::simplify(cacheDirectory + "/" + SHA1::Digest(hash.get()).toString());
+    SLANG_CHECK_ABORT(File::exists(entryFileName));
+    const char cachedCode[] = "// cached code";
+    {
+        RIFF::Builder riff;
+        RIFF::BuildCursor cursor(riff);
+        SLANG_SCOPED_RIFF_BUILDER_LIST_CHUNK(cursor, SLANG_FOUR_CC('S', 'E', 'P', 'R'));
+        cursor.addDataChunk(SLANG_FOUR_CC('c', 'o', 'd', 'e'), cachedCode, strlen(cachedCode));
+        cursor.addDataChunk(SLANG_FOUR_CC('d', 'i', 'a', 'g'), "", 0);
+        ComPtr<ISlangBlob> entryBlob;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(riff.writeToBlob(entryBlob.writeRef())));
+        SLANG_CHECK(SLANG_SUCCEEDED(File::writeAllBytes(
+            entryFileName,
+            entryBlob->getBufferPointer(),
+            entryBlob->getBufferSize())));
+    }
+
+    ComPtr<ISlangBlob> cachedHash;
+    String cachedCodeString;
+    String cachedDiagnostics;
+    SLANG_CHECK(SLANG_SUCCEEDED(_compileRequestWithCache(
+        session,
+        cacheDirectory,
+        cachedHash.writeRef(),
+        cachedCodeString,
+        cachedDiagnostics)));
+    SLANG_CHECK(cachedCodeString == toSlice(cachedCode));
+    SLANG_CHECK(cachedDiagnostics.indexOf(toSlice("overlaps")) >= 0);
+
+    Path::removeNonEmpty(cacheDirectory);
+    spDestroySession(session);
+}
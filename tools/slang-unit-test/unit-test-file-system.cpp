@@ -525,6 +525,25 @@ static SlangResult _test(FileSystemType type)
 
         // Check the file systems contents are the same
         SLANG_RETURN_ON_FAIL(_checkEqual(loadedFileSystem, fileSystem));
+
+        // Loading from a blob may reference the contents of the archive instead of copying them
+        ComPtr<ISlangFileSystemExt> blobFileSystem;
+        SLANG_RETURN_ON_FAIL(loadArchiveFileSystem(archiveBlob, blobFileSystem));
+        SLANG_RETURN_ON_FAIL(_checkEqual(blobFileSystem, fileSystem));
+
+        if (type == FileSystemType::RiffUncompressed)
+        {
+            // The contents of uncompressed files are stored aligned, so they are used in place
+            ComPtr<ISlangBlob> fileBlob;
+            SLANG_RETURN_ON_FAIL(blobFileSystem->loadFile("a", fileBlob.writeRef()));
+
+            auto archiveData = (const char*)archiveBlob->getBufferPointer();
+            auto fileData = (const char*)fileBlob->getBufferPointer();
+            SLANG_CHECK(
+                fileData >= archiveData &&
+                fileData + fileBlob->getBufferSize() <=
+                    archiveData + archiveBlob->getBufferSize());
+        }
     }
 
     SLANG_RETURN_ON_FAIL(fileSystem->remove("d/a"));
@@ -575,3 +594,74 @@ SLANG_UNIT_TEST(fileSystem)
         }
     }
 }
+
+// Archives written before the format had a version have a header that only holds the
+// compression system, and no padding after paths.
+SLANG_UNIT_TEST(riffArchiveVersion0)
+{
+    const char path[] = "dir/file";
+    const char contents[] = "some contents";
+
+    RIFF::Builder builder;
+    RIFF::BuildCursor cursor(builder);
+    {
+        SLANG_SCOPED_RIFF_BUILDER_LIST_CHUNK(cursor, RiffFileSystemBinary::kContainerFourCC);
+
+        const uint32_t compressionSystemType = uint32_t(CompressionSystemType::None);
+        cursor.addDataChunk(
+            RiffFileSystemBinary::kHeaderFourCC,
+            &compressionSystemType,
+            sizeof(compressionSystemType));
+
+        SLANG_SCOPED_RIFF_BUILDER_DATA_CHUNK(cursor, RiffFileSystemBinary::kEntryFourCC);
+        RiffFileSystemBinary::Entry entry;
+        entry.compressedSize = uint32_t(sizeof(contents));
+        entry.uncompressedSize = uint32_t(sizeof(contents));
+        entry.pathSize = uint32_t(sizeof(path));
+        entry.pathType = SLANG_PATH_TYPE_FILE;
+        cursor.addData(&entry, sizeof(entry));
+        cursor.addData(path, sizeof(path));
+        cursor.addData(contents, sizeof(contents));
+    }
+    ComPtr<ISlangBlob> archiveBlob;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(builder.writeToBlob(archiveBlob.writeRef())));
+
+    ComPtr<ISlangFileSystemExt> fileSystem;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(loadArchiveFileSystem(archiveBlob, fileSystem)));
+
+    ComPtr<ISlangBlob> fileBlob;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(fileSystem->loadFile(path, fileBlob.writeRef())));
+    SLANG_CHECK(
+        fileBlob->getBufferSize() == sizeof(contents) &&
+        memcmp(fileBlob->getBufferPointer(), contents, sizeof(contents)) == 0);
+
+    // A newer archive has padding after the path that is not counted in `pathSize`.
+    ComPtr<ISlangMutableFileSystem> newFileSystem;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(createArchiveFileSystem(SLANG_ARCHIVE_TYPE_RIFF, newFileSystem)));
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(newFileSystem->createDirectory("dir")));
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(newFileSystem->saveFile(path, contents, sizeof(contents))));
+    IArchiveFileSystem* archiveFileSystem = as<IArchiveFileSystem>(newFileSystem);
+    SLANG_CHECK_ABORT(archiveFileSystem);
+    ComPtr<ISlangBlob> newArchiveBlob;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(archiveFileSystem->storeArchive(false, newArchiveBlob.writeRef())));
+
+    auto rootList = RIFF::RootChunk::getFromBlob(
+        newArchiveBlob->getBufferPointer(),
+        newArchiveBlob->getBufferSize());
+    SLANG_CHECK_ABORT(rootList);
+    auto headerChunk = rootList->findDataChunk(RiffFileSystemBinary::kHeaderFourCC);
+    SLANG_CHECK_ABORT(headerChunk);
+    auto header = headerChunk->readPayloadAs<RiffFileSystemBinary::Header>();
+    SLANG_CHECK(header.version == RiffFileSystemBinary::kVersion);
+    for (auto chunk : rootList->getChildren())
+    {
+        auto dataChunk = as<RIFF::DataChunk>(chunk);
+        if (!dataChunk || dataChunk->getType() != RiffFileSystemBinary::kEntryFourCC)
+            continue;
+        auto newEntry = dataChunk->readPayloadAs<RiffFileSystemBinary::Entry>();
+        if (newEntry.pathType == SLANG_PATH_TYPE_FILE)
+            SLANG_CHECK(newEntry.pathSize == sizeof(path));
+    }
+}
@@ -57,7 +57,57 @@ static SlangResult _checkGenerateTemporary()
     return SLANG_OK;
 }
 
+static SlangResult _checkMap()
+{
+    String path;
+    SLANG_RETURN_ON_FAIL(File::generateTemporary(toSlice("slang-map-test"), path));
+
+    // A mapped file has the same contents as when it is read
+    const char contents[] = "Mapped contents";
+    SLANG_RETURN_ON_FAIL(File::writeAllBytes(path, contents, sizeof(contents)));
+    {
+        ComPtr<ISlangBlob> blob;
+        SLANG_RETURN_ON_FAIL(File::map(path, blob));
+        SLANG_CHECK(blob->getBufferSize() == sizeof(contents));
+        SLANG_CHECK(memcmp(blob->getBufferPointer(), contents, sizeof(contents)) == 0);
+    }
+
+    // A mapped file can be replaced, and the blob keeps the old contents
+    {
+        ComPtr<ISlangBlob> blob;
+        SLANG_RETURN_ON_FAIL(File::map(path, blob));
+
+        const String newPath = path + ".new";
+        const char newContents[] = "Replacing contents";
+        SLANG_RETURN_ON_FAIL(File::writeAllBytes(newPath, newContents, sizeof(newContents)));
+        SLANG_RETURN_ON_FAIL(File::replace(newPath, path));
+        SLANG_CHECK(!File::exists(newPath));
+        SLANG_CHECK(memcmp(blob->getBufferPointer(), contents, sizeof(contents)) == 0);
+
+        ScopedAllocation data;
+        SLANG_RETURN_ON_FAIL(File::readAllBytes(path, data));
+        SLANG_CHECK(data.getSizeInBytes() == sizeof(newContents));
+        SLANG_CHECK(memcmp(data.getData(), newContents, sizeof(newContents)) == 0);
+    }
+
+    // An empty file can be mapped too
+    SLANG_RETURN_ON_FAIL(File::writeAllBytes(path, contents, 0));
+    {
+        ComPtr<ISlangBlob> blob;
+        SLANG_RETURN_ON_FAIL(File::map(path, blob));
+        SLANG_CHECK(blob->getBufferSize() == 0);
+    }
+
+    SLANG_RETURN_ON_FAIL(File::remove(path));
+
+    // A file that doesn't exist can't be mapped
+    ComPtr<ISlangBlob> blob;
+    SLANG_CHECK(SLANG_FAILED(File::map(path, blob)));
+    return SLANG_OK;
+}
+
 SLANG_UNIT_TEST(io)
 {
     SLANG_CHECK(SLANG_SUCCEEDED(_checkGenerateTemporary()));
+    SLANG_CHECK(SLANG_SUCCEEDED(_checkMap()));
 }
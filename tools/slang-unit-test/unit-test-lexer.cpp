@@ -0,0 +1,152 @@
+// unit-test-lexer.cpp
+
+#include "../../source/compiler-core/slang-lexer.h"
+#include "../../source/compiler-core/slang-name.h"
+#include "../../source/compiler-core/slang-source-loc.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that skipping runs of plain characters in bulk gives the same tokens and diagnostics as
+// lexing one character at a time, for input where the runs have to stop.
+
+namespace
+{
+
+struct LexResult
+{
+    /// Holds the content of tokens that had to be copied, e.g. for escaped newlines.
+    MemoryArena arena{4096};
+    TokenList tokens;
+    String diagnostics;
+};
+
+} // namespace
+
+static void _lex(
+    SourceManager* sourceManager,
+    NamePool* namePool,
+    const String& text,
+    bool bulk,
+    LexResult& outResult)
+{
+    DiagnosticSink sink(sourceManager, nullptr);
+    auto sourceFile = sourceManager->createSourceFileWithString(PathInfo::makeUnknown(), text);
+    auto sourceView = sourceManager->createSourceView(sourceFile, nullptr, SourceLoc());
+
+    Lexer lexer;
+    lexer.initialize(sourceView, &sink, namePool, &outResult.arena);
+    if (!bulk)
+        lexer.m_lexerFlags |= kLexerFlag_DisableBulkScan;
+
+    outResult.tokens = lexer.lexAllTokens();
+    outResult.diagnostics = sink.outputBuffer.produceString();
+}
+
+// Lex `text` both ways, and check that the results match.
+static bool _lexesTheSame(SourceManager* sourceManager, NamePool* namePool, const String& text)
+{
+    LexResult bulk;
+    _lex(sourceManager, namePool, text, true, bulk);
+    LexResult scalar;
+    _lex(sourceManager, namePool, text, false, scalar);
+    if (bulk.diagnostics != scalar.diagnostics)
+        return false;
+
+    const auto& bulkTokens = bulk.tokens.m_tokens;
+    const auto& scalarTokens = scalar.tokens.m_tokens;
+    if (bulkTokens.getCount() != scalarTokens.getCount())
+        return false;
+
+    // Each source view starts at a different location, so compare offsets into the source.
+    const SourceLoc bulkStart = bulkTokens[0].loc;
+    const SourceLoc scalarStart = scalarTokens[0].loc;
+    for (Index i = 0; i < bulkTokens.getCount(); ++i)
+    {
+        const Token& a = bulkTokens[i];
+        const Token& b = scalarTokens[i];
+        if (a.type != b.type || a.flags != b.flags ||
+            a.loc.getRaw() - bulkStart.getRaw() != b.loc.getRaw() - scalarStart.getRaw() ||
+            a.getContent() != b.getContent() || a.getNameOrNull() != b.getNameOrNull())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+SLANG_UNIT_TEST(lexerBulkScan)
+{
+    SourceManager sourceManager;
+    sourceManager.initialize(nullptr, nullptr);
+    RootNamePool rootPool;
+    NamePool namePool;
+    namePool.setRootNamePool(&rootPool);
+
+    // Each piece has something that stops a run: escaped newlines, newlines, NUL, non-ASCII
+    // bytes (valid and invalid UTF-8) and `*` in block comments.
+    const char* const pieces[] = {
+        "identifier",
+        "ident\\\nifier",
+        "ident\\\r\nifier",
+        "ident_1234567890_ABCDEFGHIJKLMNOPQRSTUVWXYZ_abcdefghijklmnopqrstuvwxyz",
+        "caf\xC3\xA9_name",
+        "\xE6\x97\xA5\xE6\x9C\xAC",
+        "x\xFFy",
+        "\x80",
+        "// line comment with some text in it\n",
+        "// line comment \\\n continued\n",
+        "// line comment \xC3\xA9 \xFF\r\n",
+        "/* block comment with some text in it */",
+        "/* block * comment ** with stars ***/",
+        "/* block \\\n comment \r\n over lines \n */",
+        "/* block \xE2\x82\xAC \x80 comment */",
+        "/* unterminated block comment",
+        "// unterminated line comment",
+        "                ",
+        " \t \t \t \t \t \t \t \t \t ",
+        "  \\\n  ",
+        "\r\n",
+        "\n",
+        "a + b * c",
+        "\"string literal with \\\"escapes\\\" and \xC3\xA9\"",
+        "1.0e10f",
+        "\\",
+    };
+
+    bool allSame = true;
+    for (const char* piece : pieces)
+    {
+        // Place each piece at every offset from a 16 byte boundary, after an identifier, after
+        // space and after a comment, and both with more input after it and at the end.
+        const char* const prefixes[] = {"a", " ", "/*", "//"};
+        for (const char* prefix : prefixes)
+        {
+            for (Index offset = 0; offset < 34; ++offset)
+            {
+                StringBuilder prefixText;
+                for (Index i = 0; i < offset; ++i)
+                    prefixText << prefix[i % strlen(prefix)];
+
+                String atEnd = prefixText + piece;
+                String inMiddle = atEnd + " next_identifier_after_the_piece */\n";
+                allSame = allSame && _lexesTheSame(&sourceManager, &namePool, atEnd);
+                allSame = allSame && _lexesTheSame(&sourceManager, &namePool, inMiddle);
+            }
+        }
+    }
+    SLANG_CHECK(allSame);
+
+    // All of the pieces one after another, so runs cross pieces.
+    StringBuilder allPieces;
+    for (const char* piece : pieces)
+        allPieces << piece << " ";
+    SLANG_CHECK(_lexesTheSame(&sourceManager, &namePool, allPieces));
+
+    // NUL bytes inside tokens.
+    const char nulText[] = "ident\0ifier // comment \0 text\n/* block \0 comment */ \0 x";
+    SLANG_CHECK(_lexesTheSame(
+        &sourceManager,
+        &namePool,
+        String(UnownedStringSlice(nulText, sizeof(nulText) - 1))));
+}
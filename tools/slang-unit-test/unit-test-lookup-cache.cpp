@@ -0,0 +1,125 @@
+// unit-test-lookup-cache.cpp
+
+#include "../../source/core/slang-memory-file-system.h"
+#include "../../source/core/slang-string-util.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that lookups from module and namespace scopes, whose results are cached while a module
+// is checked, find the right declarations, also after declarations are added to the scopes
+// they go through, and that the cached results are used.
+
+static void _addModuleFiles(ISlangMutableFileSystem* fileSystem)
+{
+    const char* files[][2] = {
+        {"helpers.slang",
+         "public struct Pair { public float a; public float b; }\n"
+         "public float combine(Pair p) { return p.a + p.b; }\n"
+         "public int combine(int a, int b) { return a * b; }\n"},
+        {"m.slang",
+         "import helpers;\n"
+         "\n"
+         "namespace inner\n"
+         "{\n"
+         // Only visible from inside the namespace, so a lookup of `combine` from there must
+         // not use the result of the lookup from the module scope.
+         "    float combine(float a, float b, float c) { return a + b + c; }\n"
+         "    float useInner(float x) { return combine(x, x, x) + combine(Pair(x, x)); }\n"
+         "}\n"
+         "\n"
+         "float combine(float a) { return a; }\n"
+         "\n"
+         // Checking the constructor calls synthesizes a constructor for `Pair`, which adds a
+         // member to `helpers` after lookups through its scope have been cached.
+         "float useOuter(float x)\n"
+         "{\n"
+         "    return combine(Pair(x, x)) + combine(int(x), 2) + combine(x) + combine(Pair(x, 1));\n"
+         "}\n"
+         "\n"
+         "RWStructuredBuffer<float> result;\n"
+         "\n"
+         "[shader(\"compute\")]\n"
+         "[numthreads(4, 1, 1)]\n"
+         "void computeMain(uint3 tid : SV_DispatchThreadID)\n"
+         "{\n"
+         "    float x = float(tid.x);\n"
+         "    result[tid.x] = inner::useInner(x) + useOuter(x) + combine(x);\n"
+         "}\n"},
+    };
+    for (const auto& file : files)
+        fileSystem->saveFile(file[0], file[1], strlen(file[1]));
+}
+
+// Get the value of the counter named `name` in the compile time profile.
+static int64_t _getProfileCounter(ISlangProfiler* profiler, const char* name)
+{
+    ComPtr<ISlangProfiler2> profiler2;
+    if (SLANG_FAILED(profiler->queryInterface(SLANG_IID_PPV_ARGS(profiler2.writeRef()))))
+        return 0;
+    for (uint32_t i = 0; i < uint32_t(profiler2->getCounterCount()); ++i)
+    {
+        if (UnownedStringSlice(profiler2->getCounterName(i)) == UnownedStringSlice(name))
+            return profiler2->getCounterValue(i);
+    }
+    return 0;
+}
+
+SLANG_UNIT_TEST(lookupCache)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    ComPtr<ISlangMutableFileSystem> fileSystem(new MemoryFileSystem());
+    _addModuleFiles(fileSystem);
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.fileSystem = fileSystem;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(globalSession->createSession(sessionDesc, session.writeRef())));
+
+    ComPtr<slang::ICompileRequest> request;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(session->createCompileRequest(request.writeRef())));
+    ComPtr<ISlangProfiler> profiler;
+    SLANG_CHECK(SLANG_SUCCEEDED(request->getCompileTimeProfile(profiler.writeRef(), true)));
+
+    // Any lookup that found the wrong overloads would fail to type check.
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModule("m", diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(module->findEntryPointByName("computeMain", entryPoint.writeRef())));
+    slang::IComponentType* componentTypes[2] = {module, entryPoint.get()};
+    ComPtr<slang::IComponentType> composedProgram;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(session->createCompositeComponentType(
+        componentTypes,
+        2,
+        composedProgram.writeRef(),
+        diagnosticBlob.writeRef())));
+    ComPtr<slang::IComponentType> linkedProgram;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        composedProgram->link(linkedProgram.writeRef(), diagnosticBlob.writeRef())));
+    ComPtr<slang::IBlob> code;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        linkedProgram->getEntryPointCode(0, 0, code.writeRef(), diagnosticBlob.writeRef())));
+
+    // The same names are looked up many times, e.g. `combine` and `float`, so lookups from
+    // module scopes use cached results.
+    SLANG_CHECK(SLANG_SUCCEEDED(request->getCompileTimeProfile(profiler.writeRef(), true)));
+    const int64_t hitCount = _getProfileCounter(profiler, "lookupCacheHits");
+    const int64_t missCount = _getProfileCounter(profiler, "lookupCacheMisses");
+    SLANG_CHECK(missCount > 0);
+    SLANG_CHECK(hitCount > 0);
+}
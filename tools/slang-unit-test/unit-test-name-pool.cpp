@@ -0,0 +1,161 @@
+// unit-test-name-pool.cpp
+
+#include "../../source/compiler-core/slang-lexer.h"
+#include "../../source/compiler-core/slang-name.h"
+#include "../../source/compiler-core/slang-source-loc.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-platform.h"
+#include "../../tools/platform/performance-counter.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <thread>
+
+using namespace Slang;
+
+SLANG_UNIT_TEST(namePool)
+{
+    RootNamePool rootPool;
+    NamePool namePool;
+    namePool.setRootNamePool(&rootPool);
+
+    // Looking up the same text gives the same name, however the text is held.
+    Name* name = namePool.getName(UnownedStringSlice("float4"));
+    SLANG_CHECK(name && name->text == "float4");
+    SLANG_CHECK(namePool.getName(String("float4")) == name);
+    SLANG_CHECK(namePool.tryGetName(String("float4")) == name);
+    SLANG_CHECK(namePool.tryGetName(String("float3")) == nullptr);
+
+    // Names stay unique as the pool grows, and from several threads at once.
+    const Index nameCount = 5000;
+    const Index threadCount = 4;
+    List<List<Name*>> threadNames;
+    threadNames.setCount(threadCount);
+
+    List<std::thread> threads;
+    for (Index t = 0; t < threadCount; ++t)
+    {
+        threads.add(std::thread(
+            [&, t]()
+            {
+                auto& names = threadNames[t];
+                for (Index i = 0; i < nameCount; ++i)
+                {
+                    StringBuilder text;
+                    text << "name" << i;
+                    names.add(namePool.getName(text.getUnownedSlice()));
+                }
+            }));
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    bool allSame = true;
+    for (Index i = 0; i < nameCount; ++i)
+    {
+        StringBuilder text;
+        text << "name" << i;
+        Name* expected = namePool.tryGetName(text);
+        allSame = allSame && expected && expected->text == text;
+        for (Index t = 0; t < threadCount; ++t)
+        {
+            allSame = allSame && threadNames[t][i] == expected;
+        }
+    }
+    SLANG_CHECK(allSame);
+    SLANG_CHECK(rootPool.getNameCount() == nameCount + 1);
+}
+
+// Measure lexing the core module sources into names. The first pass creates the names, and
+// the passes after it only look them up. The times are reported rather than checked, since
+// they depend on the machine.
+//
+// This is a benchmark rather than a test, so it is only run when the `SLANG_RUN_BENCHMARKS`
+// environment variable is set, from the root of the repository.
+SLANG_UNIT_TEST(namePoolBenchmark)
+{
+    StringBuilder runBenchmarks;
+    if (SLANG_FAILED(PlatformUtil::getEnvironmentVariable(
+            toSlice("SLANG_RUN_BENCHMARKS"),
+            runBenchmarks)) ||
+        runBenchmarks.getLength() == 0)
+    {
+        SLANG_IGNORE_TEST
+    }
+
+    const char* const paths[] = {
+        "source/slang/core.meta.slang",
+        "source/slang/hlsl.meta.slang",
+        "source/slang/glsl.meta.slang",
+        "source/slang/diff.meta.slang",
+    };
+
+    SourceManager sourceManager;
+    sourceManager.initialize(nullptr, nullptr);
+    DiagnosticSink sink(&sourceManager, nullptr);
+
+    List<SourceView*> sourceViews;
+    for (const char* path : paths)
+    {
+        String text;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::readAllText(path, text)));
+        auto sourceFile =
+            sourceManager.createSourceFileWithString(PathInfo::makePath(path), text);
+        sourceViews.add(sourceManager.createSourceView(sourceFile, nullptr, SourceLoc()));
+    }
+
+    RootNamePool rootPool;
+    NamePool namePool;
+    namePool.setRootNamePool(&rootPool);
+
+    const int passCount = 10;
+    Index identifierCount = 0;
+    Index namedTokenCount = 0;
+    Count nameCount = 0;
+    bool allMatch = true;
+    double firstPassTime = 0;
+    auto start = platform::PerformanceCounter::now();
+    for (int pass = 0; pass < passCount; ++pass)
+    {
+        for (auto sourceView : sourceViews)
+        {
+            MemoryArena arena(64 * 1024);
+            Lexer lexer;
+            lexer.initialize(sourceView, &sink, &namePool, &arena);
+            TokenList tokens = lexer.lexAllTokens();
+            for (const auto& token : tokens)
+            {
+                if (token.type != TokenType::Identifier)
+                    continue;
+                identifierCount++;
+                if (Name* name = token.getNameOrNull())
+                {
+                    namedTokenCount++;
+                    allMatch = allMatch && name->text == token.getContent();
+                }
+            }
+        }
+
+        // Every pass after the first finds the names created by the first one.
+        if (pass == 0)
+        {
+            firstPassTime = platform::PerformanceCounter::getElapsedTimeInSeconds(start);
+            nameCount = rootPool.getNameCount();
+        }
+        allMatch = allMatch && rootPool.getNameCount() == nameCount;
+    }
+    const double totalTime = platform::PerformanceCounter::getElapsedTimeInSeconds(start);
+    SLANG_CHECK(identifierCount > 0);
+    SLANG_CHECK(namedTokenCount == identifierCount);
+    SLANG_CHECK(allMatch);
+
+    StringBuilder message;
+    message << "namePoolBenchmark: " << identifierCount / passCount << " identifiers, "
+            << nameCount << " names, " << String(firstPassTime * 1000.0)
+            << "ms for the first pass, "
+            << String((totalTime - firstPassTime) * 1000.0 / (passCount - 1))
+            << "ms for each pass after it\n";
+    getTestReporter()->message(TestMessageType::Info, message.getBuffer());
+    getTestReporter()->addExecutionTime(totalTime);
+}
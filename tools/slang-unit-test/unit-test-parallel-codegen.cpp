@@ -0,0 +1,165 @@
+// unit-test-parallel-codegen.cpp
+
+#include "../../source/core/slang-string-util.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that generating code for entry points and targets in parallel produces
+// the same code and diagnostics as generating it serially.
+//
+// With dynamic dispatch, each entry point references a different pair of the
+// implementations of an interface. A serial compile numbers their witness tables in the
+// order it generates the entry points, while a parallel compile numbers them all up
+// front, so the code can differ from a serial compile, but must not depend on which
+// entry point is generated first.
+
+static const int kEntryPointCount = 8;
+static const int kTargetCount = 2;
+
+static const char* const kShapeTypes[] = {"Square", "Circle", "Triangle"};
+static const int kShapeTypeCount = SLANG_COUNT_OF(kShapeTypes);
+
+static SlangResult _compile(
+    SlangSession* session,
+    const char* threadCount,
+    bool useDynamicDispatch,
+    List<String>& outCode,
+    String& outDiagnostics)
+{
+    StringBuilder source;
+    source << "[anyValueSize(8)]\n";
+    source << "interface IShape { float area(); }\n";
+    for (int i = 0; i < kShapeTypeCount; ++i)
+    {
+        source << "struct " << kShapeTypes[i] << " : IShape\n";
+        source << "{\n";
+        source << "    float size;\n";
+        source << "    float area() { return size * " << (i + 1) << ".0f; }\n";
+        source << "}\n";
+    }
+    source << "RWStructuredBuffer<float> result;\n";
+    source << "RWStructuredBuffer<IShape> shapes;\n";
+    for (int i = 0; i < kEntryPointCount; ++i)
+    {
+        const char* firstShapeType = kShapeTypes[(kEntryPointCount - i) % kShapeTypeCount];
+        const char* secondShapeType = kShapeTypes[(kEntryPointCount - i + 1) % kShapeTypeCount];
+
+        source << "[numthreads(4, 1, 1)]\n";
+        source << "void main" << i << "(uint3 tid : SV_DispatchThreadID)\n";
+        source << "{\n";
+        // Every entry point has a diagnostic, so that the diagnostics are compared as well.
+        source << "    int unused" << i << ";\n";
+        if (useDynamicDispatch)
+        {
+            source << "    IShape shape = shapes[tid.x];\n";
+            source << "    if (tid.x == 1)\n";
+            source << "    {\n";
+            source << "        " << firstShapeType << " first;\n";
+            source << "        first.size = tid.x;\n";
+            source << "        shape = first;\n";
+            source << "    }\n";
+            source << "    else if (tid.x == 2)\n";
+            source << "    {\n";
+            source << "        " << secondShapeType << " second;\n";
+            source << "        second.size = tid.x;\n";
+            source << "        shape = second;\n";
+            source << "    }\n";
+        }
+        else
+        {
+            source << "    " << firstShapeType << " shape;\n";
+            source << "    shape.size = tid.x;\n";
+        }
+        source << "    result[tid.x] = shape.area() * " << i << ".0f;\n";
+        source << "}\n";
+    }
+
+    auto request = spCreateCompileRequest(session);
+
+    if (threadCount)
+    {
+        const char* args[] = {"-codegen-threads", threadCount};
+        SLANG_RETURN_ON_FAIL(spProcessCommandLineArguments(request, args, 2));
+    }
+
+    spAddCodeGenTarget(request, SLANG_HLSL);
+    spAddCodeGenTarget(request, SLANG_GLSL);
+
+    int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "m");
+    spAddTranslationUnitSourceString(
+        request,
+        translationUnitIndex,
+        "m.slang",
+        source.getBuffer());
+    for (int i = 0; i < kEntryPointCount; ++i)
+    {
+        String name = "main" + String(i);
+        spAddEntryPoint(request, translationUnitIndex, name.getBuffer(), SLANG_STAGE_COMPUTE);
+    }
+
+    SlangResult result = spCompile(request);
+    outDiagnostics = spGetDiagnosticOutput(request);
+
+    if (SLANG_SUCCEEDED(result))
+    {
+        for (int target = 0; target < kTargetCount; ++target)
+        {
+            for (int i = 0; i < kEntryPointCount; ++i)
+            {
+                ComPtr<ISlangBlob> code;
+                spGetEntryPointCodeBlob(request, i, target, code.writeRef());
+                outCode.add(code ? StringUtil::getString(code) : String());
+            }
+        }
+    }
+
+    spDestroyCompileRequest(request);
+    return result;
+}
+
+SLANG_UNIT_TEST(parallelCodeGen)
+{
+    auto session = spCreateSession();
+
+    for (bool useDynamicDispatch : {false, true})
+    {
+        List<String> serialCode;
+        String serialDiagnostics;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+            _compile(session, nullptr, useDynamicDispatch, serialCode, serialDiagnostics)));
+        SLANG_CHECK(serialCode.getCount() == kEntryPointCount * kTargetCount);
+
+        List<String> firstParallelCode;
+        for (const char* threadCount : {"4", "0", "4"})
+        {
+            List<String> parallelCode;
+            String parallelDiagnostics;
+            SLANG_CHECK(SLANG_SUCCEEDED(_compile(
+                session,
+                threadCount,
+                useDynamicDispatch,
+                parallelCode,
+                parallelDiagnostics)));
+            SLANG_CHECK(parallelDiagnostics == serialDiagnostics);
+
+            if (!useDynamicDispatch)
+            {
+                SLANG_CHECK(parallelCode == serialCode);
+            }
+            else if (firstParallelCode.getCount() == 0)
+            {
+                firstParallelCode = parallelCode;
+            }
+            else
+            {
+                SLANG_CHECK(parallelCode == firstParallelCode);
+            }
+        }
+        SLANG_CHECK(!useDynamicDispatch || firstParallelCode.getCount() == serialCode.getCount());
+    }
+
+    spDestroySession(session);
+}
@@ -0,0 +1,212 @@
+// unit-test-parallel-import.cpp
+
+#include "../../source/core/slang-memory-file-system.h"
+#include "../../source/core/slang-string-util.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <mutex>
+#include <thread>
+
+using namespace Slang;
+
+// Test that preprocessing imported modules in the background produces the same code,
+// diagnostics and file dependencies as preprocessing them as they are imported, and that
+// the results of preprocessing in the background are used.
+
+namespace
+{
+
+// A file system that records the threads that look for `common.h`, which is only included by
+// imported modules. Their results are only used if the compiling thread never looks for it.
+class IncludeRecordingFileSystem : public MemoryFileSystem
+{
+public:
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+    getPathType(const char* path, SlangPathType* pathTypeOut) SLANG_OVERRIDE
+    {
+        if (UnownedStringSlice(path).endsWith(toSlice("common.h")))
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (std::this_thread::get_id() == m_compilingThread)
+                m_compilingThreadLookupCount++;
+            else
+                m_otherThreadLookupCount++;
+        }
+        return MemoryFileSystem::getPathType(path, pathTypeOut);
+    }
+
+    /// Start recording, with the calling thread as the compiling thread.
+    void beginRecording()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_compilingThread = std::this_thread::get_id();
+        m_compilingThreadLookupCount = 0;
+        m_otherThreadLookupCount = 0;
+    }
+
+    void getLookupCounts(Index& outCompilingThreadCount, Index& outOtherThreadCount)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        outCompilingThreadCount = m_compilingThreadLookupCount;
+        outOtherThreadCount = m_otherThreadLookupCount;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::thread::id m_compilingThread;
+    Index m_compilingThreadLookupCount = 0;
+    Index m_otherThreadLookupCount = 0;
+};
+
+/// The outputs of a compile.
+struct CompileResult
+{
+    String code;
+    String diagnostics;
+    List<String> dependencies;
+    /// The number of times `common.h` was looked for by the compiling thread and others
+    Index compilingThreadLookupCount = 0;
+    Index otherThreadLookupCount = 0;
+};
+
+} // namespace
+
+static void _addModuleFiles(ISlangMutableFileSystem* fileSystem)
+{
+    const char* files[][2] = {
+        {"common.h",
+         "#ifndef COMMON_H\n"
+         "#define COMMON_H\n"
+         "#define SCALE 2.0f\n"
+         "#endif\n"},
+        {"shared.slang",
+         "#include \"common.h\"\n"
+         "public float scale(float x) { return x * SCALE; }\n"},
+        {"left.slang",
+         "import shared;\n"
+         "#include \"common.h\"\n"
+         "public float left(float x) { return scale(x) + SCALE; }\n"},
+        {"right.slang",
+         "import \"shared\";\n"
+         "public float right(float x) { return scale(x) - 1.0f; }\n"},
+        // A module with a diagnostic, which has to be preprocessed again when it is imported.
+        {"noisy.slang",
+         "#warning noisy module\n"
+         "public float noisy(float x) { return -x; }\n"},
+    };
+    for (const auto& file : files)
+        fileSystem->saveFile(file[0], file[1], strlen(file[1]));
+}
+
+static SlangResult _compile(
+    slang::IGlobalSession* globalSession,
+    IncludeRecordingFileSystem* fileSystem,
+    int threadCount,
+    CompileResult& outResult)
+{
+    const char* userSource = R"(
+        import left;
+        import right;
+        import noisy;
+
+        RWStructuredBuffer<float> result;
+
+        [shader("compute")]
+        [numthreads(4, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID)
+        {
+            result[tid.x] = left(tid.x) + right(tid.x) + noisy(tid.x);
+        }
+    )";
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::CompilerOptionEntry compilerOption;
+    compilerOption.name = slang::CompilerOptionName::ImportThreadCount;
+    compilerOption.value.kind = slang::CompilerOptionValueKind::Int;
+    compilerOption.value.intValue0 = threadCount;
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.compilerOptionEntries = &compilerOption;
+    sessionDesc.compilerOptionEntryCount = 1;
+    sessionDesc.fileSystem = fileSystem;
+
+    ComPtr<slang::ISession> session;
+    SLANG_RETURN_ON_FAIL(globalSession->createSession(sessionDesc, session.writeRef()));
+
+    fileSystem->beginRecording();
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module =
+        session->loadModuleFromSourceString("m", "m.slang", userSource, diagnosticBlob.writeRef());
+    fileSystem->getLookupCounts(
+        outResult.compilingThreadLookupCount,
+        outResult.otherThreadLookupCount);
+    if (diagnosticBlob)
+        outResult.diagnostics = StringUtil::getString(diagnosticBlob);
+    if (!module)
+        return SLANG_FAIL;
+
+    for (SlangInt32 i = 0; i < session->getLoadedModuleCount(); ++i)
+    {
+        auto loadedModule = session->getLoadedModule(i);
+        for (SlangInt32 j = 0; j < loadedModule->getDependencyFileCount(); ++j)
+            outResult.dependencies.add(loadedModule->getDependencyFilePath(j));
+    }
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_RETURN_ON_FAIL(module->findEntryPointByName("computeMain", entryPoint.writeRef()));
+
+    slang::IComponentType* componentTypes[2] = {module, entryPoint.get()};
+    ComPtr<slang::IComponentType> composedProgram;
+    SLANG_RETURN_ON_FAIL(session->createCompositeComponentType(
+        componentTypes,
+        2,
+        composedProgram.writeRef(),
+        diagnosticBlob.writeRef()));
+
+    ComPtr<slang::IComponentType> linkedProgram;
+    SLANG_RETURN_ON_FAIL(composedProgram->link(linkedProgram.writeRef(), diagnosticBlob.writeRef()));
+
+    ComPtr<slang::IBlob> code;
+    SLANG_RETURN_ON_FAIL(
+        linkedProgram->getEntryPointCode(0, 0, code.writeRef(), diagnosticBlob.writeRef()));
+    outResult.code = StringUtil::getString(code);
+    return SLANG_OK;
+}
+
+SLANG_UNIT_TEST(parallelImport)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    ComPtr<IncludeRecordingFileSystem> fileSystem(new IncludeRecordingFileSystem());
+    _addModuleFiles(fileSystem);
+
+    CompileResult serial;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compile(globalSession, fileSystem, 1, serial)));
+    SLANG_CHECK(serial.diagnostics.indexOf(UnownedStringSlice("noisy module")) >= 0);
+    SLANG_CHECK(serial.compilingThreadLookupCount > 0);
+    SLANG_CHECK(serial.otherThreadLookupCount == 0);
+
+    for (int threadCount : {4, 2, 0})
+    {
+        CompileResult parallel;
+        SLANG_CHECK(SLANG_SUCCEEDED(_compile(globalSession, fileSystem, threadCount, parallel)));
+        SLANG_CHECK(parallel.code == serial.code);
+        SLANG_CHECK(parallel.diagnostics == serial.diagnostics);
+        SLANG_CHECK(parallel.dependencies == serial.dependencies);
+
+        // `left` and `shared` include `common.h`, and are only preprocessed in the background.
+        // With one hardware thread, a count of 0 means a serial compile.
+        if (threadCount == 0 && std::thread::hardware_concurrency() <= 1)
+            continue;
+        SLANG_CHECK(parallel.compilingThreadLookupCount == 0);
+        SLANG_CHECK(parallel.otherThreadLookupCount > 0);
+    }
+}
@@ -0,0 +1,121 @@
+// unit-test-performance-profiler.cpp
+
+#include "../../source/core/slang-performance-profiler.h"
+#include "slang-com-ptr.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <thread>
+
+using namespace Slang;
+
+static void _profiledInner()
+{
+    SLANG_PROFILE_SECTION(profilerTestInner);
+    SLANG_PROFILE_COUNTER(profilerTestCounter, 2);
+}
+
+static void _profiledOuter()
+{
+    SLANG_PROFILE_SECTION(profilerTestOuter);
+    _profiledInner();
+    _profiledInner();
+}
+
+SLANG_UNIT_TEST(performanceProfiler)
+{
+    auto profiler = PerformanceProfiler::getProfiler();
+    profiler->clear();
+    profiler->beginTracing();
+
+    _profiledOuter();
+
+    // Scopes entered on other threads are reported along with those of this thread.
+    std::thread thread([]() { _profiledOuter(); });
+    thread.join();
+
+    profiler->endTracing();
+    SLANG_CHECK(!profiler->isTracingEnabled());
+
+    StringBuilder result;
+    profiler->getResult(result);
+
+    // Functions are reported with their total invocation count over all threads.
+    SLANG_CHECK(result.indexOf(UnownedStringSlice("profilerTestOuter \t2 \t")) >= 0);
+    SLANG_CHECK(result.indexOf(UnownedStringSlice("profilerTestInner \t4 \t")) >= 0);
+    SLANG_CHECK(result.indexOf(UnownedStringSlice("profilerTestCounter \t8\n")) >= 0);
+
+    // The call tree nests the inner scope under the outer one.
+    SLANG_CHECK(result.indexOf(UnownedStringSlice("\n  profilerTestOuter \t1 \t")) >= 0);
+    SLANG_CHECK(result.indexOf(UnownedStringSlice("\n    profilerTestInner \t2 \t")) >= 0);
+
+    StringBuilder trace;
+    profiler->getTraceResult(trace);
+    SLANG_CHECK(trace.startsWith("{\"traceEvents\":["));
+    SLANG_CHECK(trace.indexOf(UnownedStringSlice("\"name\":\"profilerTestInner\"")) >= 0);
+    SLANG_CHECK(trace.indexOf(UnownedStringSlice("\"ph\":\"C\"")) >= 0);
+
+    ComPtr<ISlangProfiler> slangProfiler(new SlangProfiler(profiler));
+    bool foundOuter = false;
+    for (uint32_t i = 0; i < slangProfiler->getEntryCount(); ++i)
+    {
+        if (UnownedStringSlice(slangProfiler->getEntryName(i)) == "profilerTestOuter")
+        {
+            foundOuter = slangProfiler->getEntryInvocationTimes(i) == 2;
+        }
+    }
+    SLANG_CHECK(foundOuter);
+
+    // The trace is available through the extended interface.
+    ComPtr<ISlangProfiler2> slangProfiler2;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        slangProfiler->queryInterface(SLANG_IID_PPV_ARGS(slangProfiler2.writeRef()))));
+    ComPtr<ISlangBlob> traceBlob;
+    SLANG_CHECK(SLANG_SUCCEEDED(slangProfiler2->getTraceJSON(traceBlob.writeRef())));
+    SLANG_CHECK(traceBlob && traceBlob->getBufferSize() == size_t(trace.getLength()));
+
+    // Counters are reported separately from the timed entries.
+    int64_t counterValue = 0;
+    for (uint32_t i = 0; i < slangProfiler2->getCounterCount(); ++i)
+    {
+        if (UnownedStringSlice(slangProfiler2->getCounterName(i)) == "profilerTestCounter")
+            counterValue = slangProfiler2->getCounterValue(i);
+        SLANG_CHECK(UnownedStringSlice(slangProfiler2->getCounterName(i)) != "profilerTestOuter");
+    }
+    SLANG_CHECK(counterValue == 8);
+    for (uint32_t i = 0; i < slangProfiler->getEntryCount(); ++i)
+    {
+        SLANG_CHECK(UnownedStringSlice(slangProfiler->getEntryName(i)) != "profilerTestCounter");
+    }
+
+    // Only what was recorded after a snapshot is reported relative to it, without clearing
+    // the results.
+    auto snapshot = profiler->takeSnapshot();
+    _profiledInner();
+    StringBuilder resultSinceSnapshot;
+    profiler->getResult(resultSinceSnapshot, snapshot);
+    SLANG_CHECK(resultSinceSnapshot.indexOf(UnownedStringSlice("profilerTestOuter")) < 0);
+    SLANG_CHECK(resultSinceSnapshot.indexOf(UnownedStringSlice("profilerTestInner \t1 \t")) >= 0);
+    SLANG_CHECK(resultSinceSnapshot.indexOf(UnownedStringSlice("profilerTestCounter \t2\n")) >= 0);
+
+    // The same goes for a profile taken relative to the snapshot.
+    ComPtr<ISlangProfiler> sinceProfiler(new SlangProfiler(profiler, snapshot));
+    uint32_t innerSinceCount = 0;
+    for (uint32_t i = 0; i < sinceProfiler->getEntryCount(); ++i)
+    {
+        UnownedStringSlice name(sinceProfiler->getEntryName(i));
+        SLANG_CHECK(name != "profilerTestOuter");
+        if (name == "profilerTestInner")
+            innerSinceCount = sinceProfiler->getEntryInvocationTimes(i);
+    }
+    SLANG_CHECK(innerSinceCount == 1);
+
+    StringBuilder resultAfterSnapshot;
+    profiler->getResult(resultAfterSnapshot);
+    SLANG_CHECK(resultAfterSnapshot.indexOf(UnownedStringSlice("profilerTestInner \t5 \t")) >= 0);
+
+    // Once cleared, nothing is reported.
+    profiler->clear();
+    StringBuilder clearedResult;
+    profiler->getResult(clearedResult);
+    SLANG_CHECK(clearedResult.indexOf(UnownedStringSlice("profilerTest")) < 0);
+}
@@ -303,6 +303,62 @@ struct EvictionTest : public PersistentCacheTest
     }
 };
 
+// Tests that evicting an entry only reads a few index slots instead of the whole index,
+// and that entries read since they were written are not evicted.
+struct EvictionCostTest : public PersistentCacheTest
+{
+    static const uint32_t kMaxEntryCount = 1024;
+    static const uint32_t kReadCount = 16;
+    static const uint32_t kEvictionCount = 64;
+    // A write reads the probe sequence of its key and the neighbors in the eviction order
+    // list, plus the list slots passed when moving an entry that was read.
+    static const uint32_t kMaxSlotReadsPerWrite = 64;
+
+    EvictionCostTest()
+        : PersistentCacheTest(kMaxEntryCount)
+    {
+    }
+
+    void run()
+    {
+        List<Entry> entries;
+        for (uint32_t i = 0; i < kMaxEntryCount + kEvictionCount; ++i)
+        {
+            auto data = createRandomBlob(64);
+            auto key = SHA1::compute(data->getBufferPointer(), data->getBufferSize());
+            entries.add(Entry{key, data});
+        }
+
+        for (uint32_t i = 0; i < kMaxEntryCount; ++i)
+        {
+            writeEntry(entries[i]);
+        }
+
+        // Read every other one of the oldest entries.
+        for (uint32_t i = 0; i < kReadCount; ++i)
+        {
+            SLANG_CHECK(readEntry(entries[i * 2]));
+        }
+
+        // Each write evicts the oldest entry that wasn't read.
+        const Count slotReadCount = cache->getStats().slotReadCount;
+        for (uint32_t i = kMaxEntryCount; i < kMaxEntryCount + kEvictionCount; ++i)
+        {
+            writeEntry(entries[i]);
+        }
+        const Count evictionSlotReadCount = cache->getStats().slotReadCount - slotReadCount;
+        SLANG_CHECK(evictionSlotReadCount <= kEvictionCount * kMaxSlotReadsPerWrite);
+        SLANG_CHECK(cache->getStats().entryCount == kMaxEntryCount);
+
+        // The entries that were read and all but the oldest unread entries remain.
+        const uint32_t firstKeptUnreadIndex = kReadCount + kEvictionCount;
+        for (uint32_t i = 0; i < kMaxEntryCount + kEvictionCount; ++i)
+        {
+            const bool wasRead = i < kReadCount * 2 && i % 2 == 0;
+            SLANG_CHECK(readEntry(entries[i]) == (wasRead || i >= firstKeptUnreadIndex));
+        }
+    }
+};
 
 // Tests the cache to be robust against various corruptions.
 // These can happen if the cache files are manipulated externally.
@@ -613,6 +669,71 @@ struct StressTest : public PersistentCacheTest
     }
 };
 
+// Benchmarks the latency of cache hits.
+// The index is a hash table, so the time to read an entry should not depend on the
+// number of entries stored in the cache. Timings are too noisy to compare on shared
+// machines, so they are only reported, and the test checks the number of index slots
+// read per hit instead, along with the hits, misses and that no entry was evicted.
+struct HitLatencyTest : public PersistentCacheTest
+{
+    static const uint32_t kSmallEntryCount = 64;
+    static const uint32_t kLargeEntryCount = 4096;
+    static const uint32_t kReadCount = 256;
+    // A hit reads the slots on the probe sequence of its key, a run of a few slots at a time.
+    static const uint32_t kMaxSlotReadsPerHit = 16;
+
+    List<Entry> entries;
+
+    // Fill the cache up to `entryCount` entries and return the average time of a hit.
+    double measureHitLatency(uint32_t entryCount)
+    {
+        while (entries.getCount() < Index(entryCount))
+        {
+            auto data = createRandomBlob(64);
+            auto key = SHA1::compute(data->getBufferPointer(), data->getBufferSize());
+            entries.add(Entry{key, data});
+            writeEntry(entries.getLast());
+        }
+
+        const Count slotReadCount = cache->getStats().slotReadCount;
+        auto startTime = std::chrono::high_resolution_clock::now();
+        for (uint32_t i = 0; i < kReadCount; ++i)
+        {
+            SLANG_CHECK(readEntry(entries[rng.nextInt32UpTo(int32_t(entryCount))]));
+        }
+        auto endTime = std::chrono::high_resolution_clock::now();
+        const Count hitSlotReadCount = cache->getStats().slotReadCount - slotReadCount;
+        SLANG_CHECK(hitSlotReadCount <= kReadCount * kMaxSlotReadsPerHit);
+        LOG("Slots read per hit (%u entries): %.2f\n",
+            entryCount,
+            double(hitSlotReadCount) / kReadCount);
+
+        return std::chrono::duration<double>(endTime - startTime).count() / kReadCount;
+    }
+
+    void run()
+    {
+        double smallLatency = measureHitLatency(kSmallEntryCount);
+        double largeLatency = measureHitLatency(kLargeEntryCount);
+
+        // A key that was never written misses.
+        auto missingData = createRandomBlob(64);
+        auto missingKey =
+            SHA1::compute(missingData->getBufferPointer(), missingData->getBufferSize());
+        SLANG_CHECK(!readEntry(Entry{missingKey, missingData}));
+
+        // The cache is unbounded, so no entry was evicted.
+        SLANG_CHECK(cache->getStats().entryCount == kLargeEntryCount);
+        SLANG_CHECK(cache->getStats().hitCount == kReadCount * 2);
+        SLANG_CHECK(cache->getStats().missCount == 1);
+
+        LOG("Hit latency (%u entries): %.3fus\n", kSmallEntryCount, smallLatency * 1e6);
+        LOG("Hit latency (%u entries): %.3fus\n", kLargeEntryCount, largeLatency * 1e6);
+
+        getTestReporter()->addExecutionTime(largeLatency * kReadCount);
+    }
+};
+
 SLANG_UNIT_TEST(persistentCacheBasic)
 {
     BasicTest test;
@@ -625,6 +746,12 @@ SLANG_UNIT_TEST(persistentCacheEviction)
     test.run();
 }
 
+SLANG_UNIT_TEST(persistentCacheEvictionCost)
+{
+    EvictionCostTest test;
+    test.run();
+}
+
 SLANG_UNIT_TEST(persistentCacheCorruption)
 {
     CorruptionTest test;
@@ -641,3 +768,9 @@ SLANG_UNIT_TEST(persistentCacheStress)
     StressTest test;
     test.run();
 }
+
+SLANG_UNIT_TEST(persistentCacheHitLatency)
+{
+    HitLatencyTest test;
+    test.run();
+}
@@ -0,0 +1,103 @@
+// unit-test-precompile-link-index.cpp
+
+#include "../../source/core/slang-string-util.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that linking a module after it was precompiled doesn't use what the linker
+// found in the module while it was being precompiled.
+//
+// Precompiling marks the public functions of a module as exported while it links the
+// module, and removes the marks again afterwards. A later link that still saw the
+// marks would keep `helper` in the output, although nothing references it.
+
+static SlangResult _getEntryPointCode(
+    slang::ISession* session,
+    slang::IModule* module,
+    String& outCode)
+{
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_RETURN_ON_FAIL(module->findEntryPointByName("computeMain", entryPoint.writeRef()));
+
+    slang::IComponentType* componentTypes[2] = {module, entryPoint.get()};
+    ComPtr<slang::IComponentType> composedProgram;
+    ComPtr<slang::IBlob> diagnosticBlob;
+    SLANG_RETURN_ON_FAIL(session->createCompositeComponentType(
+        componentTypes,
+        2,
+        composedProgram.writeRef(),
+        diagnosticBlob.writeRef()));
+
+    ComPtr<slang::IComponentType> linkedProgram;
+    SLANG_RETURN_ON_FAIL(
+        composedProgram->link(linkedProgram.writeRef(), diagnosticBlob.writeRef()));
+
+    ComPtr<slang::IBlob> code;
+    SLANG_RETURN_ON_FAIL(
+        linkedProgram->getEntryPointCode(0, 0, code.writeRef(), diagnosticBlob.writeRef()));
+    outCode = StringUtil::getString(code);
+    return SLANG_OK;
+}
+
+SLANG_UNIT_TEST(precompileLinkIndex)
+{
+    const char* userSource = R"(
+        public int helper(int x) { return x * 3 + 1; }
+
+        [shader("compute")]
+        [numthreads(4, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID, uniform RWStructuredBuffer<int> buffer)
+        {
+            buffer[tid.x] = int(tid.x);
+        }
+    )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(globalSession->createSession(sessionDesc, session.writeRef())));
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module =
+        session->loadModuleFromSourceString("m", "m.slang", userSource, diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module);
+
+    String codeBefore;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_getEntryPointCode(session, module, codeBefore)));
+    SLANG_CHECK(codeBefore.indexOf(UnownedStringSlice("helper")) < 0);
+
+    ComPtr<slang::IModulePrecompileService_Experimental> precompileService;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(module->queryInterface(
+        slang::SLANG_UUID_IModulePrecompileService_Experimental,
+        (void**)precompileService.writeRef())));
+
+    // Precompiling needs the downstream tools for the target, which may not be available.
+    auto precompileResult =
+        precompileService->precompileForTarget(SLANG_SPIRV, diagnosticBlob.writeRef());
+    if (SLANG_FAILED(precompileResult))
+    {
+        SLANG_IGNORE_TEST
+    }
+
+    ComPtr<slang::IBlob> precompiledCode;
+    SLANG_CHECK(SLANG_SUCCEEDED(precompileService->getPrecompiledTargetCode(
+        SLANG_SPIRV,
+        precompiledCode.writeRef(),
+        diagnosticBlob.writeRef())));
+
+    String codeAfter;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_getEntryPointCode(session, module, codeAfter)));
+    SLANG_CHECK(codeAfter.indexOf(UnownedStringSlice("helper")) < 0);
+}
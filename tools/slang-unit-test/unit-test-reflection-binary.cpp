@@ -0,0 +1,349 @@
+// unit-test-reflection-binary.cpp
+
+#include "../../source/core/slang-basic.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <string.h>
+
+using namespace Slang;
+
+// Test that the binary reflection written for a program answers queries the same way as
+// the live reflection, and keeps doing so once the session is gone.
+
+static bool _isSameString(char const* a, char const* b)
+{
+    if (!a || !b)
+        return !a && !b;
+    return strcmp(a, b) == 0;
+}
+
+static bool _isSameVarLayout(
+    slang::VariableLayoutReflection* varLayout,
+    slang::BinaryVariableLayoutReflection* binaryVarLayout,
+    int depth);
+
+static bool _isSameTypeLayout(
+    slang::TypeLayoutReflection* typeLayout,
+    slang::BinaryTypeLayoutReflection* binaryTypeLayout,
+    int depth)
+{
+    if (!typeLayout || !binaryTypeLayout)
+        return !typeLayout && !binaryTypeLayout;
+    if (depth == 0)
+        return true;
+
+    if (typeLayout->getKind() != binaryTypeLayout->getKind() ||
+        typeLayout->getParameterCategory() != binaryTypeLayout->getParameterCategory() ||
+        typeLayout->getCategoryCount() != binaryTypeLayout->getCategoryCount() ||
+        typeLayout->getFieldCount() != binaryTypeLayout->getFieldCount() ||
+        typeLayout->getBindingRangeCount() != binaryTypeLayout->getBindingRangeCount() ||
+        typeLayout->getDescriptorSetCount() != binaryTypeLayout->getDescriptorSetCount() ||
+        typeLayout->getSubObjectRangeCount() != binaryTypeLayout->getSubObjectRangeCount())
+        return false;
+
+    if (typeLayout->getType() &&
+        !_isSameString(typeLayout->getName(), binaryTypeLayout->getName()))
+        return false;
+
+    for (int category = 0; category < int(SLANG_PARAMETER_CATEGORY_COUNT); ++category)
+    {
+        auto c = SlangParameterCategory(category);
+        if (typeLayout->getSize(c) != binaryTypeLayout->getSize(c) ||
+            typeLayout->getStride(c) != binaryTypeLayout->getStride(c) ||
+            typeLayout->getAlignment(c) != binaryTypeLayout->getAlignment(c))
+            return false;
+    }
+
+    for (unsigned i = 0; i < typeLayout->getFieldCount(); ++i)
+    {
+        if (!_isSameVarLayout(
+                typeLayout->getFieldByIndex(i),
+                binaryTypeLayout->getFieldByIndex(i),
+                depth - 1))
+            return false;
+    }
+
+    for (SlangInt i = 0; i < typeLayout->getBindingRangeCount(); ++i)
+    {
+        if (typeLayout->getBindingRangeType(i) != binaryTypeLayout->getBindingRangeType(i) ||
+            typeLayout->getBindingRangeBindingCount(i) !=
+                binaryTypeLayout->getBindingRangeBindingCount(i) ||
+            typeLayout->getBindingRangeDescriptorSetIndex(i) !=
+                binaryTypeLayout->getBindingRangeDescriptorSetIndex(i))
+            return false;
+    }
+
+    for (SlangInt i = 0; i < typeLayout->getDescriptorSetCount(); ++i)
+    {
+        if (typeLayout->getDescriptorSetSpaceOffset(i) !=
+                binaryTypeLayout->getDescriptorSetSpaceOffset(i) ||
+            typeLayout->getDescriptorSetDescriptorRangeCount(i) !=
+                binaryTypeLayout->getDescriptorSetDescriptorRangeCount(i))
+            return false;
+    }
+
+    return _isSameTypeLayout(
+               typeLayout->getElementTypeLayout(),
+               binaryTypeLayout->getElementTypeLayout(),
+               depth - 1) &&
+           _isSameVarLayout(
+               typeLayout->getContainerVarLayout(),
+               binaryTypeLayout->getContainerVarLayout(),
+               depth - 1);
+}
+
+static bool _isSameVarLayout(
+    slang::VariableLayoutReflection* varLayout,
+    slang::BinaryVariableLayoutReflection* binaryVarLayout,
+    int depth)
+{
+    if (!varLayout || !binaryVarLayout)
+        return !varLayout && !binaryVarLayout;
+    if (depth == 0)
+        return true;
+
+    if (varLayout->getVariable() &&
+        !_isSameString(varLayout->getName(), binaryVarLayout->getName()))
+        return false;
+
+    for (int category = 0; category < int(SLANG_PARAMETER_CATEGORY_COUNT); ++category)
+    {
+        auto c = SlangParameterCategory(category);
+        if (varLayout->getOffset(c) != binaryVarLayout->getOffset(c) ||
+            varLayout->getBindingSpace(c) != binaryVarLayout->getBindingSpace(c))
+            return false;
+    }
+
+    return _isSameString(varLayout->getSemanticName(), binaryVarLayout->getSemanticName()) &&
+           _isSameTypeLayout(
+               varLayout->getTypeLayout(),
+               binaryVarLayout->getTypeLayout(),
+               depth - 1);
+}
+
+// Get the offset in `data` of what the 32 bit relative offset at `offset` points to.
+static size_t _followRelativeOffset(List<uint8_t> const& data, size_t offset)
+{
+    int32_t relativeOffset = 0;
+    memcpy(&relativeOffset, data.getBuffer() + offset, sizeof(relativeOffset));
+    return size_t(intptr_t(offset) + relativeOffset);
+}
+
+// Check that the data is rejected once the 32 bit relative offset at `offset` is changed to
+// point outside of it.
+static bool _isRejectedWithBadOffset(List<uint8_t> const& data, size_t offset)
+{
+    List<uint8_t> corrupted;
+    corrupted.addRange(data.getBuffer(), data.getCount());
+    const int32_t badOffsets[] = {int32_t(data.getCount()), -int32_t(offset) - 8};
+    for (int32_t badOffset : badOffsets)
+    {
+        memcpy(corrupted.getBuffer() + offset, &badOffset, sizeof(badOffset));
+        if (slang::BinaryProgramLayout::load(corrupted.getBuffer(), corrupted.getCount()))
+            return false;
+    }
+    return true;
+}
+
+SLANG_UNIT_TEST(reflectionBinary)
+{
+    const char* userSource = R"(
+        struct Material
+        {
+            float4 color;
+            Texture2D albedo;
+            SamplerState sampler;
+        };
+
+        cbuffer Params
+        {
+            float4x4 transform;
+            uint count;
+        };
+
+        ParameterBlock<Material> material;
+        RWStructuredBuffer<float4> result;
+        Texture2D textures[4];
+
+        [shader("compute")]
+        [numthreads(8, 4, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID)
+        {
+            float4 c = material.albedo.SampleLevel(material.sampler, float2(0, 0), 0);
+            result[tid.x] = mul(transform, c * material.color) + textures[count].Load(int3(0));
+        }
+    )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    List<uint8_t> data;
+    {
+        slang::TargetDesc targetDesc = {};
+        targetDesc.format = SLANG_SPIRV;
+        targetDesc.profile = globalSession->findProfile("spirv_1_5");
+        slang::SessionDesc sessionDesc = {};
+        sessionDesc.targetCount = 1;
+        sessionDesc.targets = &targetDesc;
+        ComPtr<slang::ISession> session;
+        SLANG_CHECK_ABORT(
+            SLANG_SUCCEEDED(globalSession->createSession(sessionDesc, session.writeRef())));
+
+        ComPtr<slang::IBlob> diagnosticBlob;
+        auto module = session->loadModuleFromSourceString(
+            "m",
+            "m.slang",
+            userSource,
+            diagnosticBlob.writeRef());
+        SLANG_CHECK_ABORT(module);
+
+        ComPtr<slang::IEntryPoint> entryPoint;
+        SLANG_CHECK_ABORT(
+            SLANG_SUCCEEDED(module->findEntryPointByName("computeMain", entryPoint.writeRef())));
+
+        slang::IComponentType* componentTypes[2] = {module, entryPoint.get()};
+        ComPtr<slang::IComponentType> composedProgram;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(session->createCompositeComponentType(
+            componentTypes,
+            2,
+            composedProgram.writeRef(),
+            diagnosticBlob.writeRef())));
+
+        ComPtr<slang::IComponentType> linkedProgram;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+            composedProgram->link(linkedProgram.writeRef(), diagnosticBlob.writeRef())));
+
+        auto layout = linkedProgram->getLayout();
+        SLANG_CHECK_ABORT(layout);
+
+        ComPtr<ISlangBlob> blob;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(layout->toBinary(blob.writeRef())));
+
+        // The data is read in place, so it is copied to check that it doesn't refer
+        // to anything outside of itself.
+        data.addRange((uint8_t const*)blob->getBufferPointer(), Index(blob->getBufferSize()));
+        auto binaryLayout = slang::BinaryProgramLayout::load(data.getBuffer(), data.getCount());
+        SLANG_CHECK_ABORT(binaryLayout);
+
+        SLANG_CHECK(binaryLayout->getParameterCount() == layout->getParameterCount());
+        for (unsigned i = 0; i < layout->getParameterCount(); ++i)
+        {
+            SLANG_CHECK(_isSameVarLayout(
+                layout->getParameterByIndex(i),
+                binaryLayout->getParameterByIndex(i),
+                8));
+        }
+        SLANG_CHECK(_isSameVarLayout(
+            layout->getGlobalParamsVarLayout(),
+            binaryLayout->getGlobalParamsVarLayout(),
+            8));
+        SLANG_CHECK(
+            binaryLayout->getGlobalConstantBufferSize() == layout->getGlobalConstantBufferSize());
+
+        SLANG_CHECK_ABORT(binaryLayout->getEntryPointCount() == 1);
+        auto entryPointLayout = layout->getEntryPointByIndex(0);
+        auto binaryEntryPoint = binaryLayout->getEntryPointByIndex(0);
+        SLANG_CHECK(binaryEntryPoint->getStage() == entryPointLayout->getStage());
+        SLANG_CHECK(_isSameVarLayout(
+            entryPointLayout->getVarLayout(),
+            binaryEntryPoint->getVarLayout(),
+            8));
+    }
+
+    // Nothing is needed from the session to read the data.
+    auto binaryLayout = slang::BinaryProgramLayout::load(data.getBuffer(), data.getCount());
+    SLANG_CHECK_ABORT(binaryLayout);
+
+    auto entryPoint = binaryLayout->findEntryPointByName("computeMain");
+    SLANG_CHECK_ABORT(entryPoint);
+    SlangUInt threadGroupSize[3] = {};
+    entryPoint->getComputeThreadGroupSize(3, threadGroupSize);
+    SLANG_CHECK(threadGroupSize[0] == 8 && threadGroupSize[1] == 4 && threadGroupSize[2] == 1);
+
+    auto globalTypeLayout = binaryLayout->getGlobalParamsTypeLayout();
+    SLANG_CHECK_ABORT(globalTypeLayout);
+    SlangInt materialIndex = globalTypeLayout->findFieldIndexByName("material");
+    SLANG_CHECK_ABORT(materialIndex >= 0);
+    auto material = globalTypeLayout->getFieldByIndex(unsigned(materialIndex));
+    auto materialTypeLayout = material->getTypeLayout();
+    SLANG_CHECK(
+        materialTypeLayout->getKind() == slang::TypeReflection::Kind::ParameterBlock);
+    auto materialElementTypeLayout = materialTypeLayout->getElementTypeLayout();
+    SLANG_CHECK_ABORT(materialElementTypeLayout);
+    SLANG_CHECK(_isSameString(materialElementTypeLayout->getName(), "Material"));
+    SLANG_CHECK(materialElementTypeLayout->getFieldCount() == 3);
+
+    SlangInt texturesIndex = globalTypeLayout->findFieldIndexByName("textures");
+    SLANG_CHECK_ABORT(texturesIndex >= 0);
+    auto textures = globalTypeLayout->getFieldByIndex(unsigned(texturesIndex));
+    SLANG_CHECK(textures->getTypeLayout()->getElementCount() == 4);
+
+    // Data that isn't binary reflection is rejected.
+    SLANG_CHECK(slang::BinaryProgramLayout::load(data.getBuffer(), 16) == nullptr);
+
+    // Data truncated to its header is rejected, also if the header is changed to claim the
+    // truncated size, which leaves the root value outside of the data. The header starts with 16
+    // magic bytes, followed by the 64 bit total size, 32 bits of flags and the 32 bit relative
+    // offset of the root value.
+    const size_t headerSize = 32;
+    const size_t totalSizeOffset = 16;
+    const size_t rootOffsetOffset = 28;
+    SLANG_CHECK(slang::BinaryProgramLayout::load(data.getBuffer(), headerSize) == nullptr);
+    List<uint8_t> truncated;
+    truncated.addRange(data.getBuffer(), Index(headerSize));
+    const uint64_t truncatedSize = headerSize;
+    memcpy(truncated.getBuffer() + totalSizeOffset, &truncatedSize, sizeof(truncatedSize));
+    SLANG_CHECK(slang::BinaryProgramLayout::load(truncated.getBuffer(), headerSize) == nullptr);
+
+    // A root value offset that points outside of the data is rejected.
+    List<uint8_t> badRoot;
+    badRoot.addRange(data.getBuffer(), data.getCount());
+    const int32_t rootOffsets[] = {int32_t(data.getCount()), -int32_t(rootOffsetOffset) - 4};
+    for (int32_t rootOffset : rootOffsets)
+    {
+        memcpy(badRoot.getBuffer() + rootOffsetOffset, &rootOffset, sizeof(rootOffset));
+        SLANG_CHECK(
+            slang::BinaryProgramLayout::load(badRoot.getBuffer(), badRoot.getCount()) == nullptr);
+    }
+
+    // The data is read in place, so it must be 8 byte aligned.
+    List<uint8_t> shifted;
+    shifted.setCount(data.getCount() + 8);
+    memcpy(shifted.getBuffer() + 4, data.getBuffer(), data.getCount());
+    SLANG_CHECK(
+        slang::BinaryProgramLayout::load(shifted.getBuffer() + 4, data.getCount()) == nullptr);
+    memcpy(shifted.getBuffer() + 8, data.getBuffer(), data.getCount());
+    SLANG_CHECK(
+        slang::BinaryProgramLayout::load(shifted.getBuffer() + 8, data.getCount()) != nullptr);
+    const char notReflection[] = "this is not binary reflection data, just some text";
+    SLANG_CHECK(slang::BinaryProgramLayout::load(notReflection, sizeof(notReflection)) == nullptr);
+
+    // Offsets below the root are checked when the data is loaded too. Follow the offsets from
+    // the root to the name of the type of the first parameter, and check that the data is
+    // rejected when any of them points outside of it. The root starts with 32 bit magic and
+    // version fields, followed by the offset of the list of parameters, each of which is the
+    // offset of a variable layout. A variable layout starts with the offset of its name,
+    // followed by the offset of its type layout, which starts with a 32 bit kind field followed
+    // by the offset of its name.
+    const size_t rootOffset = _followRelativeOffset(data, rootOffsetOffset);
+    const size_t parametersOffset = rootOffset + 8;
+    const size_t firstParameterOffset = _followRelativeOffset(data, parametersOffset);
+    const size_t varLayoutOffset = _followRelativeOffset(data, firstParameterOffset);
+    const size_t typeLayoutOffset = _followRelativeOffset(data, varLayoutOffset + 4);
+    SLANG_CHECK(_isRejectedWithBadOffset(data, parametersOffset));
+    SLANG_CHECK(_isRejectedWithBadOffset(data, firstParameterOffset));
+    SLANG_CHECK(_isRejectedWithBadOffset(data, varLayoutOffset));
+    SLANG_CHECK(_isRejectedWithBadOffset(data, varLayoutOffset + 4));
+    SLANG_CHECK(_isRejectedWithBadOffset(data, typeLayoutOffset + 4));
+
+    // Data that is truncated in the middle of a layout it refers to is rejected.
+    SLANG_CHECK(
+        slang::BinaryProgramLayout::load(data.getBuffer(), varLayoutOffset + 4) == nullptr);
+
+    // The entry points and the global parameters follow the parameters.
+    SLANG_CHECK(_isRejectedWithBadOffset(data, rootOffset + 12));
+    SLANG_CHECK(_isRejectedWithBadOffset(data, rootOffset + 16));
+}
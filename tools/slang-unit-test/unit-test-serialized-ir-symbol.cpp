@@ -0,0 +1,140 @@
+// unit-test-serialized-ir-symbol.cpp
+
+#include "../../source/core/slang-string-util.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test linking a single symbol from a module that was loaded from serialized IR, and then
+// reading the rest of the module.
+//
+// The IR of `lib` is only read as far as the linker looks it up, so linking `useScale`
+// reads `scaleValue` on its own. Serializing `lib` afterwards reads the whole module,
+// which has to reuse `scaleValue` as a global of the module, and `useBoth` then links
+// both functions from the complete module.
+
+static SlangResult _getEntryPointCode(
+    slang::ISession* session,
+    slang::IModule* module,
+    String& outCode)
+{
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_RETURN_ON_FAIL(module->findEntryPointByName("computeMain", entryPoint.writeRef()));
+
+    slang::IComponentType* componentTypes[2] = {module, entryPoint.get()};
+    ComPtr<slang::IComponentType> composedProgram;
+    ComPtr<slang::IBlob> diagnosticBlob;
+    SLANG_RETURN_ON_FAIL(session->createCompositeComponentType(
+        componentTypes,
+        2,
+        composedProgram.writeRef(),
+        diagnosticBlob.writeRef()));
+
+    ComPtr<slang::IComponentType> linkedProgram;
+    SLANG_RETURN_ON_FAIL(
+        composedProgram->link(linkedProgram.writeRef(), diagnosticBlob.writeRef()));
+
+    ComPtr<slang::IBlob> code;
+    SLANG_RETURN_ON_FAIL(
+        linkedProgram->getEntryPointCode(0, 0, code.writeRef(), diagnosticBlob.writeRef()));
+    outCode = StringUtil::getString(code);
+    return SLANG_OK;
+}
+
+SLANG_UNIT_TEST(serializedIRSymbol)
+{
+    const char* libSource = R"(
+        public int scaleValue(int x) { return x * 3 + 1; }
+        public int unusedHelper(int x) { return x * 5 + 2; }
+    )";
+
+    const char* useScaleSource = R"(
+        import lib;
+
+        [shader("compute")]
+        [numthreads(4, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID, uniform RWStructuredBuffer<int> buffer)
+        {
+            buffer[tid.x] = scaleValue(int(tid.x));
+        }
+    )";
+
+    const char* useBothSource = R"(
+        import lib;
+
+        [shader("compute")]
+        [numthreads(4, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID, uniform RWStructuredBuffer<int> buffer)
+        {
+            buffer[tid.x] = scaleValue(int(tid.x)) + unusedHelper(int(tid.x));
+        }
+    )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    ComPtr<slang::IBlob> libBlob;
+    {
+        ComPtr<slang::ISession> session;
+        SLANG_CHECK_ABORT(
+            SLANG_SUCCEEDED(globalSession->createSession(sessionDesc, session.writeRef())));
+        auto libModule = session->loadModuleFromSourceString(
+            "lib",
+            "lib.slang",
+            libSource,
+            diagnosticBlob.writeRef());
+        SLANG_CHECK_ABORT(libModule);
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(libModule->serialize(libBlob.writeRef())));
+    }
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(globalSession->createSession(sessionDesc, session.writeRef())));
+    auto libModule = session->loadModuleFromIRBlob(
+        "lib",
+        "lib.slang-module",
+        libBlob,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(libModule);
+
+    auto useScaleModule = session->loadModuleFromSourceString(
+        "useScale",
+        "useScale.slang",
+        useScaleSource,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(useScaleModule);
+
+    String useScaleCode;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(_getEntryPointCode(session, useScaleModule, useScaleCode)));
+    SLANG_CHECK(useScaleCode.indexOf(UnownedStringSlice("scaleValue")) >= 0);
+    SLANG_CHECK(useScaleCode.indexOf(UnownedStringSlice("unusedHelper")) < 0);
+
+    // Read the rest of `lib`.
+    ComPtr<slang::IBlob> rereadLibBlob;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(libModule->serialize(rereadLibBlob.writeRef())));
+    SLANG_CHECK(rereadLibBlob->getBufferSize() > 0);
+
+    auto useBothModule = session->loadModuleFromSourceString(
+        "useBoth",
+        "useBoth.slang",
+        useBothSource,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(useBothModule);
+
+    String useBothCode;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_getEntryPointCode(session, useBothModule, useBothCode)));
+    SLANG_CHECK(useBothCode.indexOf(UnownedStringSlice("scaleValue")) >= 0);
+    SLANG_CHECK(useBothCode.indexOf(UnownedStringSlice("unusedHelper")) >= 0);
+}
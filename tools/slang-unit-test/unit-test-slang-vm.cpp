@@ -1,6 +1,7 @@
 // unit-test-slang-vm.cpp
 
 #include "core/slang-memory-file-system.h"
+#include "core/slang-process.h"
 #include "slang-com-ptr.h"
 #include "slang.h"
 #include "unit-test/slang-unit-test.h"
@@ -100,3 +101,180 @@ SLANG_UNIT_TEST(slangVM)
     SLANG_CHECK(returnValSize == sizeof(int));
     SLANG_CHECK(*returnVal == 100);
 }
+
+static SlangResult _compileToByteCode(const char* source, slang::IBlob** outCode)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_RETURN_ON_FAIL(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()));
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HOST_VM;
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_RETURN_ON_FAIL(globalSession->createSession(sessionDesc, session.writeRef()));
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "bench",
+        "bench.slang",
+        source,
+        diagnosticBlob.writeRef());
+    if (!module)
+        return SLANG_FAIL;
+
+    ComPtr<slang::IComponentType> linkedProgram;
+    SLANG_RETURN_ON_FAIL(module->link(linkedProgram.writeRef()));
+    return linkedProgram->getTargetCode(0, outCode, diagnosticBlob.writeRef());
+}
+
+// Runs a loop heavy function with and without superinstructions, and checks that both
+// produce the same result. The timings are reported for information, but not checked, since
+// they depend on the machine.
+SLANG_UNIT_TEST(slangVMBenchmark)
+{
+    const char* benchSource = R"(
+        [shader("dispatch")]
+        int dispatchMain(uniform int n, out int c)
+        {
+            int sum = 0;
+            uint hash = 17;
+            for (int i = 0; i < n; i++)
+            {
+                if (i % 3 == 0)
+                    sum += i;
+                else
+                    sum -= 1;
+                hash = hash * 31 + uint(i);
+            }
+            c = sum;
+            return int(hash);
+        }
+    )";
+
+    ComPtr<slang::IBlob> code;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compileToByteCode(benchSource, code.writeRef())));
+
+    struct Params
+    {
+        int n;
+        int* result;
+    };
+
+    const int iterationCount = 100000;
+    int results[2] = {};
+    int returnValues[2] = {};
+    double seconds[2] = {};
+    for (int i = 0; i < 2; i++)
+    {
+        ComPtr<slang::IByteCodeRunner> runner;
+        slang::ByteCodeRunnerDesc runnerDesc = {};
+        runnerDesc.enableSuperInstructions = (i == 1);
+        SLANG_CHECK_ABORT(slang_createByteCodeRunner(&runnerDesc, runner.writeRef()) == SLANG_OK);
+        SLANG_CHECK_ABORT(runner->loadModule(code) == SLANG_OK);
+        SLANG_CHECK_ABORT(runner->selectFunctionByIndex(0) == SLANG_OK);
+
+        Params params = {iterationCount, &results[i]};
+        const uint64_t startTick = Process::getClockTick();
+        SLANG_CHECK(runner->execute(&params, sizeof(params)) == SLANG_OK);
+        const uint64_t endTick = Process::getClockTick();
+        seconds[i] = double(endTick - startTick) / double(Process::getClockFrequency());
+
+        size_t returnValSize = 0;
+        returnValues[i] = *(int*)runner->getReturnValue(&returnValSize);
+    }
+
+    int expectedSum = 0;
+    uint32_t expectedHash = 17;
+    for (int i = 0; i < iterationCount; i++)
+    {
+        if (i % 3 == 0)
+            expectedSum += i;
+        else
+            expectedSum -= 1;
+        expectedHash = expectedHash * 31 + uint32_t(i);
+    }
+    SLANG_CHECK(results[0] == expectedSum);
+    SLANG_CHECK(results[1] == expectedSum);
+    SLANG_CHECK(returnValues[0] == int(expectedHash));
+    SLANG_CHECK(returnValues[1] == int(expectedHash));
+
+    StringBuilder message;
+    message << "slangVMBenchmark: " << iterationCount << " iterations, "
+            << String(seconds[0] * 1000.0) << "ms without superinstructions, "
+            << String(seconds[1] * 1000.0) << "ms with superinstructions\n";
+    getTestReporter()->message(TestMessageType::Info, message.getBuffer());
+}
+
+SLANG_UNIT_TEST(slangVMBatch)
+{
+    const char* batchSource = R"(
+        [shader("dispatch")]
+        int dispatchMain(uniform int x, out int c)
+        {
+            int sum = 0;
+            for (int i = 0; i < x; i++)
+                sum += i;
+            c = sum;
+            return x * 2;
+        }
+    )";
+
+    ComPtr<slang::IBlob> code;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compileToByteCode(batchSource, code.writeRef())));
+
+    ComPtr<slang::IByteCodeRunner> runner;
+    slang::ByteCodeRunnerDesc runnerDesc = {};
+    SLANG_CHECK_ABORT(slang_createByteCodeRunner(&runnerDesc, runner.writeRef()) == SLANG_OK);
+    SLANG_CHECK_ABORT(runner->loadModule(code) == SLANG_OK);
+    SLANG_CHECK_ABORT(runner->selectFunctionByIndex(0) == SLANG_OK);
+
+    ComPtr<slang::IByteCodeBatchRunner> batchRunner;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(runner->queryInterface(
+        slang::IByteCodeBatchRunner::getTypeGuid(),
+        (void**)batchRunner.writeRef())));
+
+    struct Params
+    {
+        int x;
+        int* result;
+    };
+
+    const uint32_t invocationCount = 1000;
+    List<Params> params;
+    List<int> results;
+    List<int> returnValues;
+    params.setCount(invocationCount);
+    results.setCount(invocationCount);
+    returnValues.setCount(invocationCount);
+
+    // Run the batch on the calling thread and on multiple threads.
+    for (uint32_t threadCount : {1u, 4u})
+    {
+        for (uint32_t i = 0; i < invocationCount; i++)
+        {
+            params[i] = {int(i), &results[i]};
+            results[i] = -1;
+            returnValues[i] = -1;
+        }
+
+        slang::ByteCodeBatchDesc batchDesc;
+        batchDesc.invocationCount = invocationCount;
+        batchDesc.argumentData = params.getBuffer();
+        batchDesc.argumentSize = sizeof(Params);
+        batchDesc.argumentStride = sizeof(Params);
+        batchDesc.returnValueData = returnValues.getBuffer();
+        batchDesc.returnValueStride = sizeof(int);
+        batchDesc.threadCount = threadCount;
+        SLANG_CHECK(batchRunner->executeBatch(&batchDesc) == SLANG_OK);
+
+        bool allCorrect = true;
+        for (uint32_t i = 0; i < invocationCount; i++)
+        {
+            if (results[i] != int(i * (i - 1) / 2) || returnValues[i] != int(i * 2))
+                allCorrect = false;
+        }
+        SLANG_CHECK(allCorrect);
+    }
+}
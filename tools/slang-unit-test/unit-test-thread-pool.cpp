@@ -0,0 +1,44 @@
+// unit-test-thread-pool.cpp
+
+#include "../../source/core/slang-thread-pool.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <atomic>
+
+using namespace Slang;
+
+SLANG_UNIT_TEST(threadPool)
+{
+    for (Count threadCount : {1, 4})
+    {
+        RefPtr<ThreadPool> pool = new ThreadPool(threadCount);
+        SLANG_CHECK(pool->getThreadCount() == threadCount);
+
+        // Every task should be run exactly once, and all of them should have completed
+        // by the time forEach returns.
+        const Index taskCount = 1000;
+        List<int> runCounts;
+        runCounts.setCount(taskCount);
+        for (auto& runCount : runCounts)
+            runCount = 0;
+
+        std::atomic<Index> total{0};
+        pool->forEach(taskCount, [&](Index i) {
+            runCounts[i]++;
+            total += i;
+        });
+
+        SLANG_CHECK(total == taskCount * (taskCount - 1) / 2);
+        bool allRunOnce = true;
+        for (auto runCount : runCounts)
+            allRunOnce = allRunOnce && runCount == 1;
+        SLANG_CHECK(allRunOnce);
+
+        // The pool should be reusable for further batches.
+        std::atomic<Index> secondTotal{0};
+        pool->forEach(10, [&](Index i) { secondTotal += i + 1; });
+        SLANG_CHECK(secondTotal == 55);
+
+        pool->forEach(0, [&](Index) { SLANG_CHECK(false); });
+    }
+}
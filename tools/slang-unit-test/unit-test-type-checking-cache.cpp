@@ -0,0 +1,142 @@
+// unit-test-type-checking-cache.cpp
+
+#include "../../source/core/slang-memory-file-system.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that the type checking cache of a session looks up the results it doesn't have in the
+// results published by sessions that were destroyed before it was created, and that it doesn't
+// see the results of sessions that are still alive.
+
+static void _addModuleFiles(ISlangMutableFileSystem* fileSystem)
+{
+    const char* files[][2] = {
+        {"published.slang",
+         "public float published(float a, int b, uint c)\n"
+         "{\n"
+         "    return a * b + c - a / b;\n"
+         "}\n"},
+        {"sibling.slang",
+         "public float published(float a, int b, uint c)\n"
+         "{\n"
+         "    return a * b + c - a / b;\n"
+         "}\n"
+         // Not resolved by the first session, so both siblings have to resolve these.
+         "public double sibling(double a, half b, int64_t c, uint16_t d)\n"
+         "{\n"
+         "    return a * b + c * d - (a < b ? c : d);\n"
+         "}\n"},
+    };
+    for (const auto& file : files)
+        fileSystem->saveFile(file[0], file[1], strlen(file[1]));
+}
+
+struct TypeCheckingCacheCounters
+{
+    int64_t parentHits = 0;
+    int64_t misses = 0;
+};
+
+// Get the counters that destroyed sessions reported to the compile time profile since it was
+// last read, and clear them.
+static TypeCheckingCacheCounters _takeCounters(slang::ICompileRequest* request)
+{
+    ComPtr<ISlangProfiler> profiler;
+    SLANG_CHECK(SLANG_SUCCEEDED(request->getCompileTimeProfile(profiler.writeRef(), true)));
+
+    ComPtr<ISlangProfiler2> profiler2;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(profiler->queryInterface(SLANG_IID_PPV_ARGS(profiler2.writeRef()))));
+
+    TypeCheckingCacheCounters counters;
+    for (uint32_t i = 0; i < uint32_t(profiler2->getCounterCount()); ++i)
+    {
+        UnownedStringSlice name(profiler2->getCounterName(i));
+        int64_t value = profiler2->getCounterValue(i);
+        if (name == toSlice("typeCheckingCacheParentHits"))
+            counters.parentHits = value;
+        else if (name == toSlice("typeCheckingCacheMisses"))
+            counters.misses = value;
+    }
+    return counters;
+}
+
+static ComPtr<slang::ISession> _createSession(
+    slang::IGlobalSession* globalSession,
+    ISlangMutableFileSystem* fileSystem)
+{
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.fileSystem = fileSystem;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK(SLANG_SUCCEEDED(globalSession->createSession(sessionDesc, session.writeRef())));
+    return session;
+}
+
+static bool _loadModule(slang::ISession* session, const char* name)
+{
+    ComPtr<slang::IBlob> diagnosticBlob;
+    return session->loadModule(name, diagnosticBlob.writeRef()) != nullptr;
+}
+
+SLANG_UNIT_TEST(typeCheckingCache)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    ComPtr<ISlangMutableFileSystem> fileSystem(new MemoryFileSystem());
+    _addModuleFiles(fileSystem);
+
+    // The profile is read through a compile request of a session that doesn't check anything.
+    auto profileSession = _createSession(globalSession, fileSystem);
+    SLANG_CHECK_ABORT(profileSession);
+    ComPtr<slang::ICompileRequest> request;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(profileSession->createCompileRequest(request.writeRef())));
+    _takeCounters(request);
+
+    // A destroyed session publishes its results.
+    {
+        auto session = _createSession(globalSession, fileSystem);
+        SLANG_CHECK_ABORT(session && _loadModule(session, "published"));
+    }
+    auto publishedCounters = _takeCounters(request);
+    SLANG_CHECK(publishedCounters.misses > 0);
+
+    // Two sessions that are alive at the same time check the same module. The results of the
+    // first one are not visible to the second one, so both have to resolve what the destroyed
+    // session didn't.
+    auto first = _createSession(globalSession, fileSystem);
+    auto second = _createSession(globalSession, fileSystem);
+    SLANG_CHECK_ABORT(first && second);
+    SLANG_CHECK_ABORT(_loadModule(first, "sibling"));
+    SLANG_CHECK_ABORT(_loadModule(second, "sibling"));
+
+    second = nullptr;
+    auto secondCounters = _takeCounters(request);
+    first = nullptr;
+    auto firstCounters = _takeCounters(request);
+
+    // The results for `published` are found in the results of the destroyed session.
+    SLANG_CHECK(firstCounters.parentHits > 0);
+    SLANG_CHECK(secondCounters.parentHits > 0);
+
+    // Both have been published now, so a new session finds the results that the siblings had
+    // to resolve in its parent.
+    {
+        auto session = _createSession(globalSession, fileSystem);
+        SLANG_CHECK_ABORT(session && _loadModule(session, "sibling"));
+    }
+    auto laterCounters = _takeCounters(request);
+    SLANG_CHECK(laterCounters.parentHits > firstCounters.parentHits);
+    SLANG_CHECK(laterCounters.misses < firstCounters.misses);
+    SLANG_CHECK(laterCounters.misses < secondCounters.misses);
+}